@@ -0,0 +1,94 @@
+// l1_reproducible.cpp: example program measuring the throughput of the reproducible reductions against the memory bandwidth
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+#include "common.hpp"
+#include <universal/posit/exceptions.hpp>
+#include <universal/bitblock/bitblock.hpp>
+#include <universal/posit/value.hpp>
+#include <universal/float/reproducible.hpp>
+
+// best time out of a few runs of a reduction, in seconds: the value of the last run is returned in result, which
+// keeps the reduction from being elided
+template<typename Reduction>
+double BestTime(Reduction reduce, double& result) {
+	using namespace std::chrono;
+	double best = 0.0;
+	for (int run = 0; run < 5; ++run) {
+		steady_clock::time_point begin = steady_clock::now();
+		result = reduce();
+		double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+		if (run == 0 || elapsed < best) best = elapsed;
+	}
+	return best;
+}
+
+// the naive loops stream the arrays once and run at the memory bandwidth: the reproducible reductions read
+// the same bytes, so their throughput relative to the naive loops is the fraction of the bandwidth they reach
+void Benchmark(size_t N, size_t nrOfThreads) {
+	using namespace std;
+	using namespace sw::ieee;
+
+	mt19937_64 generator(N);
+	uniform_real_distribution<double> distribution(-1.0, 1.0);
+	vector<double> x(N), y(N);
+	for (double& d : x) d = distribution(generator);
+	for (double& d : y) d = distribution(generator);
+
+	double gigabytes = double(N * sizeof(double)) / 1.0e9;
+	double naiveSumValue, sum1Value, sumNValue, naiveDotValue, dot1Value, dotNValue;
+	double naiveSum = BestTime([&]() { return accumulate(x.begin(), x.end(), 0.0); }, naiveSumValue);
+	double sum1 = BestTime([&]() { return reproducible_sum(x, 1); }, sum1Value);
+	double sumN = BestTime([&]() { return reproducible_sum(x, nrOfThreads); }, sumNValue);
+	double naiveDot = BestTime([&]() { return inner_product(x.begin(), x.end(), y.begin(), 0.0); }, naiveDotValue);
+	double dot1 = BestTime([&]() { return reproducible_dot(x, y, 1); }, dot1Value);
+	double dotN = BestTime([&]() { return reproducible_dot(x, y, nrOfThreads); }, dotNValue);
+
+	cout << "sum of " << N << " doubles" << endl;
+	cout << "  naive loop                  " << setw(8) << gigabytes / naiveSum << " GB/s" << endl;
+	cout << "  reproducible, 1 thread      " << setw(8) << gigabytes / sum1 << " GB/s  " << setw(6) << 100.0 * naiveSum / sum1 << "% of the naive loop" << endl;
+	cout << "  reproducible, " << setw(2) << nrOfThreads << " threads    " << setw(8) << gigabytes / sumN << " GB/s  " << setw(6) << 100.0 * naiveSum / sumN << "% of the naive loop" << endl;
+	cout << "  sum naive " << naiveSumValue << ", reproducible " << sum1Value << (sum1Value == sumNValue ? ", identical" : ", DIFFERENT") << " with " << nrOfThreads << " threads" << endl;
+	cout << "dot product of " << N << " doubles" << endl;
+	cout << "  naive loop                  " << setw(8) << 2 * gigabytes / naiveDot << " GB/s" << endl;
+	cout << "  reproducible, 1 thread      " << setw(8) << 2 * gigabytes / dot1 << " GB/s  " << setw(6) << 100.0 * naiveDot / dot1 << "% of the naive loop" << endl;
+	cout << "  reproducible, " << setw(2) << nrOfThreads << " threads    " << setw(8) << 2 * gigabytes / dotN << " GB/s  " << setw(6) << 100.0 * naiveDot / dotN << "% of the naive loop" << endl;
+	cout << "  dot naive " << naiveDotValue << ", reproducible " << dot1Value << (dot1Value == dotNValue ? ", identical" : ", DIFFERENT") << " with " << nrOfThreads << " threads" << endl;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	size_t nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+	streamsize prec = cout.precision();
+	cout << setprecision(4);
+
+	cout << "Throughput of the bitwise reproducible reductions relative to loops that stream the arrays at the memory bandwidth" << endl;
+	Benchmark(size_t(1) << 23, nrOfThreads);
+
+	cout << setprecision(prec);
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+// l2_gemv.cpp: example program comparing the fused matrix-vector product and triangular solve to naive loops
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// use the fast implementation of the standard posit<32,2>
+#define POSIT_FAST_POSIT_32_2 1
+// enable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <random>
+#include <thread>
+#include "common.hpp"
+#include <universal/posit/posit>
+
+// y = A * x with a rounding after every multiply and every add, A row-major
+template<typename Scalar>
+void naive_gemv(size_t N, const std::vector<Scalar>& A, const std::vector<Scalar>& x, std::vector<Scalar>& y) {
+	for (size_t i = 0; i < N; ++i) {
+		Scalar sum = 0;
+		for (size_t j = 0; j < N; ++j) sum = sum + A[i * N + j] * x[j];
+		y[i] = sum;
+	}
+}
+
+// solve L * x = b by forward substitution with rounded operations, L lower triangular and row-major, b in x
+template<typename Scalar>
+void naive_trsv(size_t N, const std::vector<Scalar>& L, std::vector<Scalar>& x) {
+	for (size_t i = 0; i < N; ++i) {
+		Scalar sum = x[i];
+		for (size_t j = 0; j < i; ++j) sum = sum - L[i * N + j] * x[j];
+		x[i] = sum / L[i * N + i];
+	}
+}
+
+// largest relative difference of the elements of v to the double precision reference
+template<typename Scalar>
+double MaxRelativeError(const std::vector<Scalar>& v, const std::vector<double>& reference) {
+	double error = 0.0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (reference[i] != 0.0) error = std::max(error, std::abs((double(v[i]) - reference[i]) / reference[i]));
+	}
+	return error;
+}
+
+// time and accuracy of the naive and the fused kernels for a random N x N matrix
+template<size_t nbits, size_t es>
+void Benchmark(size_t N, size_t nrOfThreads) {
+	using namespace std;
+	using namespace std::chrono;
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+
+	mt19937_64 generator(N);
+	uniform_real_distribution<double> distribution(-1.0, 1.0);
+	vector<Posit> A(N * N), x(N), y(N), naive(N);
+	for (Posit& p : A) p = distribution(generator);
+	for (Posit& p : x) p = distribution(generator);
+	// a dominant diagonal makes the lower triangle of A a well-conditioned triangular matrix
+	for (size_t i = 0; i < N; ++i) A[i * N + i] = double(N);
+	// the products of posit<32,2> values are exact in long double
+	vector<double> reference(N);
+	for (size_t i = 0; i < N; ++i) {
+		long double sum = 0.0l;
+		for (size_t j = 0; j < N; ++j) sum += (long double)(A[i * N + j]) * (long double)(x[j]);
+		reference[i] = double(sum);
+	}
+
+	steady_clock::time_point begin = steady_clock::now();
+	naive_gemv(N, A, x, naive);
+	duration<double> naiveTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	begin = steady_clock::now();
+	gemv(Posit(1), matrix_view<const Posit>(A.data(), N, N), vector_view<const Posit>(x), Posit(0), vector_view<Posit>(y), 1);
+	duration<double> fusedTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	begin = steady_clock::now();
+	gemv(Posit(1), matrix_view<const Posit>(A.data(), N, N), vector_view<const Posit>(x), Posit(0), vector_view<Posit>(y), nrOfThreads);
+	duration<double> parallelTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	double products = double(N) * double(N);
+	cout << "gemv posit<" << nbits << "," << es << "> " << setw(4) << N << "x" << N
+		<< "  naive " << setw(10) << naiveTime.count() << " sec " << setw(8) << products / naiveTime.count() / 1.0e6 << " Mmacs"
+		<< "  gemv " << setw(10) << fusedTime.count() << " sec " << setw(8) << products / fusedTime.count() / 1.0e6 << " Mmacs"
+		<< "  gemv " << nrOfThreads << " threads " << setw(10) << parallelTime.count() << " sec" << endl;
+	cout << "    max relative error  naive " << MaxRelativeError(naive, reference) << "  gemv " << MaxRelativeError(y, reference) << endl;
+
+	// solve L * x = b for the lower triangle L of A and b = L * x rounded once: the solution is x up to the rounding of b
+	vector<Posit> solution(y), naiveSolution(y);
+	vector<double> exact(N);
+	for (size_t i = 0; i < N; ++i) {
+		long double sum = 0.0l;
+		for (size_t j = 0; j <= i; ++j) sum += (long double)(A[i * N + j]) * (long double)(x[j]);
+		naiveSolution[i] = solution[i] = Posit(double(sum));
+		exact[i] = double(x[i]);
+	}
+
+	begin = steady_clock::now();
+	naive_trsv(N, A, naiveSolution);
+	naiveTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	begin = steady_clock::now();
+	trsv(matrix_triangle::lower, matrix_diagonal::non_unit, matrix_view<const Posit>(A.data(), N, N), vector_view<Posit>(solution), nrOfThreads);
+	fusedTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	cout << "trsv posit<" << nbits << "," << es << "> " << setw(4) << N << "x" << N
+		<< "  naive " << setw(10) << naiveTime.count() << " sec"
+		<< "  trsv " << nrOfThreads << " threads " << setw(10) << fusedTime.count() << " sec" << endl;
+	cout << "    max relative error  naive " << MaxRelativeError(naiveSolution, exact) << "  trsv " << MaxRelativeError(solution, exact) << endl;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+	streamsize prec = cout.precision();
+	cout << setprecision(5);
+
+	cout << "Fused matrix-vector product and triangular solve versus naive loops of rounded multiplies and adds" << endl;
+	for (size_t N : { 64, 256, 1024 }) Benchmark<32, 2>(N, nrOfThreads);
+
+	cout << setprecision(prec);
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
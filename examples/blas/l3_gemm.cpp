@@ -0,0 +1,120 @@
+// l3_gemm.cpp: example program comparing the blocked fused matrix-matrix multiplication to a naive triple loop
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// use the fast implementation of the standard posit<32,2>
+#define POSIT_FAST_POSIT_32_2 1
+// enable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <random>
+#include <thread>
+#include "common.hpp"
+#include <universal/posit/posit>
+
+// C = A * B with a rounding after every multiply and every add, all matrices row-major
+template<typename Scalar>
+void naive_gemm(size_t M, size_t N, size_t K, const std::vector<Scalar>& A, const std::vector<Scalar>& B, std::vector<Scalar>& C) {
+	for (size_t i = 0; i < M; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			Scalar sum = 0;
+			for (size_t k = 0; k < K; ++k) sum = sum + A[i * K + k] * B[k * N + j];
+			C[i * N + j] = sum;
+		}
+	}
+}
+
+// largest relative difference of the elements of C to the double precision reference
+template<typename Scalar>
+double MaxRelativeError(const std::vector<Scalar>& C, const std::vector<double>& reference) {
+	double error = 0.0;
+	for (size_t i = 0; i < C.size(); ++i) {
+		if (reference[i] != 0.0) error = std::max(error, std::abs((double(C[i]) - reference[i]) / reference[i]));
+	}
+	return error;
+}
+
+// time and accuracy of the naive and the fused matrix multiplication of two random N x N matrices
+template<size_t nbits, size_t es>
+void Benchmark(size_t N, size_t nrOfThreads) {
+	using namespace std;
+	using namespace std::chrono;
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+
+	mt19937_64 generator(N);
+	uniform_real_distribution<double> distribution(-1.0, 1.0);
+	vector<Posit> A(N * N), B(N * N), C(N * N), naive(N * N);
+	vector<double> reference(N * N, 0.0);
+	for (Posit& p : A) p = distribution(generator);
+	for (Posit& p : B) p = distribution(generator);
+	// the products of posit<32,2> values are exact in long double
+	for (size_t i = 0; i < N; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			long double sum = 0.0l;
+			for (size_t k = 0; k < N; ++k) sum += (long double)(A[i * N + k]) * (long double)(B[k * N + j]);
+			reference[i * N + j] = double(sum);
+		}
+	}
+
+	steady_clock::time_point begin = steady_clock::now();
+	naive_gemm(N, N, N, A, B, naive);
+	duration<double> naiveTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	begin = steady_clock::now();
+	gemm(matrix_view<const Posit>(A.data(), N, N), matrix_view<const Posit>(B.data(), N, N), matrix_view<Posit>(C.data(), N, N), 1);
+	duration<double> fusedTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	begin = steady_clock::now();
+	gemm(matrix_view<const Posit>(A.data(), N, N), matrix_view<const Posit>(B.data(), N, N), matrix_view<Posit>(C.data(), N, N), nrOfThreads);
+	duration<double> parallelTime = duration_cast<duration<double>>(steady_clock::now() - begin);
+
+	double products = double(N) * double(N) * double(N);
+	cout << "posit<" << nbits << "," << es << "> " << setw(4) << N << "x" << N
+		<< "  naive " << setw(10) << naiveTime.count() << " sec " << setw(8) << products / naiveTime.count() / 1.0e6 << " Mmacs"
+		<< "  gemm " << setw(10) << fusedTime.count() << " sec " << setw(8) << products / fusedTime.count() / 1.0e6 << " Mmacs"
+		<< "  gemm " << nrOfThreads << " threads " << setw(10) << parallelTime.count() << " sec"
+		<< "  speedup " << setw(6) << naiveTime.count() / fusedTime.count() << endl;
+	cout << "    max relative error  naive " << MaxRelativeError(naive, reference) << "  gemm " << MaxRelativeError(C, reference) << endl;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+	streamsize prec = cout.precision();
+	cout << setprecision(5);
+
+	cout << "Blocked fused matrix-matrix multiplication versus a naive triple loop of rounded multiplies and adds" << endl;
+	for (size_t N : { 32, 64, 128, 256 }) Benchmark<32, 2>(N, nrOfThreads);
+
+	cout << setprecision(prec);
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,759 @@
+#pragma once
+//  limbs.hpp : word-level multi-precision arithmetic on arrays of 64-bit limbs
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <cstddef>
+#include <bitset>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// A limb array is a little-endian array of uint64_t words: limb[0] holds the least significant 64 bits.
+// The number of limbs is a template argument so that the compiler can unroll the loops
+// for the common single and double limb cases.
+
+namespace sw {
+	namespace unum {
+
+#if defined(__SIZEOF_INT128__)
+		__extension__ typedef unsigned __int128 uint128_limb_t;
+#define LIMBS_HAVE_INT128 1
+#else
+#define LIMBS_HAVE_INT128 0
+#endif
+
+// LIMBS_CONSTANT_EVALUATED() is true when the compiler evaluates a constant expression, so that constexpr
+// functions can use intrinsics at run time. LIMBS_HAVE_CONSTANT_EVALUATED is 0 when the compiler cannot tell.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 9)
+#define LIMBS_HAVE_CONSTANT_EVALUATED 1
+#elif defined(__clang__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define LIMBS_HAVE_CONSTANT_EVALUATED 1
+#endif
+#elif defined(_MSC_VER) && (_MSC_VER >= 1925)
+#define LIMBS_HAVE_CONSTANT_EVALUATED 1
+#endif
+#if defined(LIMBS_HAVE_CONSTANT_EVALUATED)
+#define LIMBS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define LIMBS_HAVE_CONSTANT_EVALUATED 0
+#define LIMBS_CONSTANT_EVALUATED() false
+#endif
+
+		// number of 64-bit limbs required to hold nbits
+		constexpr size_t nr_limbs(size_t nbits) { return (nbits + 63) / 64; }
+
+		// count leading zeros of a 64-bit word: returns 64 for a zero word
+		// constexpr so that the native posit engine can round in constant expressions
+		inline constexpr unsigned clz64(uint64_t x) {
+			if (x == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+			return unsigned(__builtin_clzll(x));
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+			// the intrinsic is not constexpr: compilers that cannot tell a constant evaluation always use it
+			if (!LIMBS_CONSTANT_EVALUATED()) {
+				unsigned long index;
+				_BitScanReverse64(&index, x);
+				return 63u - unsigned(index);
+			}
+#endif
+			unsigned n = 0;
+			if (!(x & 0xFFFFFFFF00000000ull)) { n += 32; x <<= 32; }
+			if (!(x & 0xFFFF000000000000ull)) { n += 16; x <<= 16; }
+			if (!(x & 0xFF00000000000000ull)) { n += 8;  x <<= 8; }
+			if (!(x & 0xF000000000000000ull)) { n += 4;  x <<= 4; }
+			if (!(x & 0xC000000000000000ull)) { n += 2;  x <<= 2; }
+			if (!(x & 0x8000000000000000ull)) { n += 1; }
+			return n;
+#endif
+		}
+
+		// full 64x64 -> 128 bit product: returns the lower 64 bits, and the upper 64 bits in hi
+		inline uint64_t mul64x64(uint64_t a, uint64_t b, uint64_t& hi) {
+#if LIMBS_HAVE_INT128
+			uint128_limb_t p = uint128_limb_t(a) * b;
+			hi = uint64_t(p >> 64);
+			return uint64_t(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			return _umul128(a, b, &hi);
+#else
+			uint64_t a0 = a & 0xFFFFFFFFull, a1 = a >> 32;
+			uint64_t b0 = b & 0xFFFFFFFFull, b1 = b >> 32;
+			uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+			uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFull) + (p10 & 0xFFFFFFFFull);
+			hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+			return (mid << 32) | (p00 & 0xFFFFFFFFull);
+#endif
+		}
+
+		// 128 / 64 -> 64 bit division of (hi, lo) by d: returns the quotient, and the remainder in rem
+		// requires hi < d so that the quotient fits in 64 bits
+		inline uint64_t div128by64(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+			uint64_t q;
+			__asm__("divq %4" : "=a"(q), "=d"(rem) : "a"(lo), "d"(hi), "rm"(d));
+			return q;
+#elif LIMBS_HAVE_INT128
+			uint128_limb_t n = (uint128_limb_t(hi) << 64) | lo;
+			rem = uint64_t(n % d);
+			return uint64_t(n / d);
+#else
+			// restoring division, one quotient bit per step
+			uint64_t q = 0;
+			for (int i = 63; i >= 0; --i) {
+				bool carry = (hi >> 63) != 0;
+				hi = (hi << 1) | (lo >> 63);
+				lo <<= 1;
+				q <<= 1;
+				if (carry || hi >= d) {
+					hi -= d;
+					q |= 1;
+				}
+			}
+			rem = hi;
+			return q;
+#endif
+		}
+
+		template<size_t N>
+		inline void limbs_clear(uint64_t* a) {
+			for (size_t i = 0; i < N; ++i) a[i] = 0;
+		}
+
+		template<size_t N>
+		inline bool limbs_iszero(const uint64_t* a) {
+			uint64_t any = 0;
+			for (size_t i = 0; i < N; ++i) any |= a[i];
+			return any == 0;
+		}
+
+		template<size_t N>
+		inline bool limbs_test(const uint64_t* a, size_t bit) {
+			return (a[bit >> 6] >> (bit & 63)) & 0x1;
+		}
+
+		template<size_t N>
+		inline void limbs_set(uint64_t* a, size_t bit) {
+			a[bit >> 6] |= uint64_t(1) << (bit & 63);
+		}
+
+		// OR a value of at most 64 bits into the limbs with its lsb at bit position lsb
+		template<size_t N>
+		inline void limbs_or_word(uint64_t* a, uint64_t value, size_t lsb) {
+			size_t limb = lsb >> 6, shift = lsb & 63;
+			if (limb < N) a[limb] |= value << shift;
+			if (shift != 0 && limb + 1 < N) a[limb + 1] |= value >> (64 - shift);
+		}
+
+		// number of leading zeros of the limb array, returns 64*N for a zero array
+		template<size_t N>
+		inline unsigned limbs_clz(const uint64_t* a) {
+			unsigned n = 0;
+			for (size_t i = N; i-- > 0; ) {
+				if (a[i] != 0) return n + clz64(a[i]);
+				n += 64;
+			}
+			return n;
+		}
+
+		// true if any of the bits below bit position msb (exclusive) are set
+		template<size_t N>
+		inline bool limbs_any_below(const uint64_t* a, size_t msb) {
+			size_t limb = msb >> 6;
+			if (limb >= N) return !limbs_iszero<N>(a);
+			uint64_t any = a[limb] & ((uint64_t(1) << (msb & 63)) - 1);
+			for (size_t i = 0; i < limb; ++i) any |= a[i];
+			return any != 0;
+		}
+
+		// logical shift left
+		template<size_t N>
+		inline void limbs_shl(uint64_t* a, size_t shift) {
+			if (shift == 0) return;
+			if (shift >= 64 * N) { limbs_clear<N>(a); return; }
+			size_t limbShift = shift >> 6, bitShift = shift & 63;
+			if (bitShift == 0) {
+				for (size_t i = N; i-- > limbShift; ) a[i] = a[i - limbShift];
+			}
+			else {
+				for (size_t i = N; i-- > limbShift + 1; ) {
+					a[i] = (a[i - limbShift] << bitShift) | (a[i - limbShift - 1] >> (64 - bitShift));
+				}
+				a[limbShift] = a[0] << bitShift;
+			}
+			for (size_t i = 0; i < limbShift; ++i) a[i] = 0;
+		}
+
+		// logical shift right, returns true if any set bits were shifted out (the sticky bit)
+		template<size_t N>
+		inline bool limbs_shr(uint64_t* a, size_t shift) {
+			if (shift == 0) return false;
+			if (shift >= 64 * N) {
+				bool sticky = !limbs_iszero<N>(a);
+				limbs_clear<N>(a);
+				return sticky;
+			}
+			bool sticky = limbs_any_below<N>(a, shift);
+			size_t limbShift = shift >> 6, bitShift = shift & 63;
+			if (bitShift == 0) {
+				for (size_t i = 0; i + limbShift < N; ++i) a[i] = a[i + limbShift];
+			}
+			else {
+				for (size_t i = 0; i + limbShift + 1 < N; ++i) {
+					a[i] = (a[i + limbShift] >> bitShift) | (a[i + limbShift + 1] << (64 - bitShift));
+				}
+				a[N - 1 - limbShift] = a[N - 1] >> bitShift;
+			}
+			for (size_t i = N - limbShift; i < N; ++i) a[i] = 0;
+			return sticky;
+		}
+
+		// r = a + b, returns the carry out
+		template<size_t N>
+		inline uint64_t limbs_add(uint64_t* r, const uint64_t* a, const uint64_t* b) {
+			uint64_t carry = 0;
+			for (size_t i = 0; i < N; ++i) {
+				uint64_t s = a[i] + carry;
+				carry = (s < carry);
+				r[i] = s + b[i];
+				carry += (r[i] < s);
+			}
+			return carry;
+		}
+
+		// r = a - b, returns the borrow out
+		template<size_t N>
+		inline uint64_t limbs_sub(uint64_t* r, const uint64_t* a, const uint64_t* b) {
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < N; ++i) {
+				uint64_t d = a[i] - borrow;
+				borrow = (a[i] < borrow);
+				borrow += (d < b[i]);
+				r[i] = d - b[i];
+			}
+			return borrow;
+		}
+
+		// a += 1, returns the carry out
+		template<size_t N>
+		inline uint64_t limbs_increment(uint64_t* a) {
+			for (size_t i = 0; i < N; ++i) {
+				if (++a[i] != 0) return 0;
+			}
+			return 1;
+		}
+
+		// a -= 1, returns the borrow out
+		template<size_t N>
+		inline uint64_t limbs_decrement(uint64_t* a) {
+			for (size_t i = 0; i < N; ++i) {
+				if (a[i]-- != 0) return 0;
+			}
+			return 1;
+		}
+
+		// two's complement of the full limb array
+		template<size_t N>
+		inline void limbs_twos_complement(uint64_t* a) {
+			for (size_t i = 0; i < N; ++i) a[i] = ~a[i];
+			limbs_increment<N>(a);
+		}
+
+		// magnitude comparison: returns -1, 0, or 1
+		template<size_t N>
+		inline int limbs_compare(const uint64_t* a, const uint64_t* b) {
+			for (size_t i = N; i-- > 0; ) {
+				if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+			}
+			return 0;
+		}
+
+		// schoolbook multiplication: r[N+M] = a[N] * b[M]
+		template<size_t N, size_t M>
+		inline void limbs_mul(uint64_t* r, const uint64_t* a, const uint64_t* b) {
+			limbs_clear<N + M>(r);
+			for (size_t j = 0; j < M; ++j) {
+				uint64_t carry = 0;
+				for (size_t i = 0; i < N; ++i) {
+					uint64_t hi;
+					uint64_t lo = mul64x64(a[i], b[j], hi);
+					lo += carry;
+					hi += (lo < carry);
+					r[i + j] += lo;
+					hi += (r[i + j] < lo);
+					carry = hi;
+				}
+				r[j + N] = carry;
+			}
+		}
+
+		// long division of limb arrays: q[N] = u[N] / v[M], r[M] = u[N] % v[M]
+		// Knuth's algorithm D operating on 32-bit digits so that all intermediates fit in 64 bits.
+		// Returns false when the divisor is zero.
+		template<size_t N, size_t M>
+		bool limbs_divmod(const uint64_t* u, const uint64_t* v, uint64_t* q, uint64_t* r) {
+			constexpr size_t UD = 2 * N, VD = 2 * M;
+			constexpr uint64_t b = 0x100000000ull;
+			uint32_t ud[UD], vd[VD], qd[UD], un[UD + 1], vn[VD];
+			for (size_t i = 0; i < N; ++i) { ud[2 * i] = uint32_t(u[i]); ud[2 * i + 1] = uint32_t(u[i] >> 32); }
+			for (size_t i = 0; i < M; ++i) { vd[2 * i] = uint32_t(v[i]); vd[2 * i + 1] = uint32_t(v[i] >> 32); }
+			for (size_t i = 0; i < UD; ++i) qd[i] = 0;
+			limbs_clear<N>(q);
+			limbs_clear<M>(r);
+
+			int n = int(VD);
+			while (n > 0 && vd[n - 1] == 0) --n;
+			if (n == 0) return false;
+			int m = int(UD);
+			while (m > 0 && ud[m - 1] == 0) --m;
+			if (m < n) {  // quotient is zero, remainder is the dividend
+				for (size_t i = 0; i < N && i < M; ++i) r[i] = u[i];
+				return true;
+			}
+
+			if (n == 1) {
+				uint64_t k = 0;
+				for (int j = m - 1; j >= 0; --j) {
+					uint64_t t = k * b + ud[j];
+					qd[j] = uint32_t(t / vd[0]);
+					k = t - uint64_t(qd[j]) * vd[0];
+				}
+				for (size_t i = 0; i < N; ++i) q[i] = uint64_t(qd[2 * i]) | (uint64_t(qd[2 * i + 1]) << 32);
+				r[0] = k;
+				return true;
+			}
+
+			// normalize so that the most significant digit of the divisor has its msb set
+			unsigned s = clz64(vd[n - 1]) - 32;
+			for (int i = n - 1; i > 0; --i) vn[i] = uint32_t((uint64_t(vd[i]) << s) | (uint64_t(vd[i - 1]) >> (32 - s)));
+			vn[0] = vd[0] << s;
+			un[m] = uint32_t(uint64_t(ud[m - 1]) >> (32 - s));
+			for (int i = m - 1; i > 0; --i) un[i] = uint32_t((uint64_t(ud[i]) << s) | (uint64_t(ud[i - 1]) >> (32 - s)));
+			un[0] = ud[0] << s;
+
+			for (int j = m - n; j >= 0; --j) {
+				uint64_t numerator = uint64_t(un[j + n]) * b + un[j + n - 1];
+				uint64_t qhat = numerator / vn[n - 1];
+				uint64_t rhat = numerator - qhat * vn[n - 1];
+				while (qhat >= b || qhat * vn[n - 2] > b * rhat + un[j + n - 2]) {
+					--qhat;
+					rhat += vn[n - 1];
+					if (rhat >= b) break;
+				}
+				// multiply and subtract
+				int64_t t = 0;
+				uint64_t k = 0;
+				for (int i = 0; i < n; ++i) {
+					uint64_t p = qhat * vn[i];
+					t = int64_t(un[i + j]) - int64_t(k) - int64_t(p & 0xFFFFFFFFull);
+					un[i + j] = uint32_t(t);
+					k = (p >> 32) - uint64_t(t >> 32);
+				}
+				t = int64_t(un[j + n]) - int64_t(k);
+				un[j + n] = uint32_t(t);
+				qd[j] = uint32_t(qhat);
+				if (t < 0) {  // subtracted too much: add back
+					--qd[j];
+					k = 0;
+					for (int i = 0; i < n; ++i) {
+						uint64_t sum = uint64_t(un[i + j]) + vn[i] + k;
+						un[i + j] = uint32_t(sum);
+						k = sum >> 32;
+					}
+					un[j + n] = uint32_t(uint64_t(un[j + n]) + k);
+				}
+			}
+			for (size_t i = 0; i < N; ++i) q[i] = uint64_t(qd[2 * i]) | (uint64_t(qd[2 * i + 1]) << 32);
+			// unnormalize the remainder
+			uint32_t rd[VD];
+			for (size_t i = 0; i < VD; ++i) rd[i] = 0;
+			for (int i = 0; i < n - 1; ++i) rd[i] = uint32_t((uint64_t(un[i]) >> s) | (uint64_t(un[i + 1]) << (32 - s)));
+			rd[n - 1] = un[n - 1] >> s;
+			for (size_t i = 0; i < M; ++i) r[i] = uint64_t(rd[2 * i]) | (uint64_t(rd[2 * i + 1]) << 32);
+			return true;
+		}
+
+		// reciprocal square root of a normalized word: u / 2^62 lies in [1, 4), and the result y / 2^63
+		// approximates 1 / sqrt(u / 2^62) to precision bits, at most 60. A table on the leading
+		// 8 bits of u seeds the division free Newton iteration y = y + y (1 - u y^2) / 2 with 8 correct bits,
+		// and each step doubles them.
+		inline uint64_t word_rsqrt(uint64_t u, unsigned precision = 60) {
+			// 2^15 / sqrt(x) at the midpoints of the intervals [i / 64, (i + 1) / 64) for i = 64 .. 255
+			static constexpr uint16_t seed[192] = {
+				0x7f81, 0x7e87, 0x7d92, 0x7ca3, 0x7bb9, 0x7ad5, 0x79f5, 0x791a, 0x7843, 0x7771, 0x76a3, 0x75d9,
+				0x7514, 0x7452, 0x7393, 0x72d9, 0x7221, 0x716e, 0x70bd, 0x7010, 0x6f66, 0x6ebe, 0x6e1a, 0x6d78,
+				0x6cda, 0x6c3d, 0x6ba4, 0x6b0d, 0x6a78, 0x69e6, 0x6956, 0x68c9, 0x683e, 0x67b4, 0x672d, 0x66a8,
+				0x6625, 0x65a4, 0x6525, 0x64a7, 0x642c, 0x63b2, 0x633a, 0x62c3, 0x624f, 0x61db, 0x616a, 0x60fa,
+				0x608b, 0x601e, 0x5fb2, 0x5f48, 0x5edf, 0x5e78, 0x5e11, 0x5dac, 0x5d49, 0x5ce6, 0x5c85, 0x5c25,
+				0x5bc6, 0x5b68, 0x5b0b, 0x5ab0, 0x5a55, 0x59fc, 0x59a3, 0x594c, 0x58f6, 0x58a0, 0x584c, 0x57f8,
+				0x57a5, 0x5754, 0x5703, 0x56b3, 0x5664, 0x5615, 0x55c8, 0x557b, 0x5530, 0x54e4, 0x549a, 0x5451,
+				0x5408, 0x53c0, 0x5378, 0x5332, 0x52ec, 0x52a7, 0x5262, 0x521e, 0x51db, 0x5198, 0x5156, 0x5115,
+				0x50d4, 0x5094, 0x5054, 0x5015, 0x4fd7, 0x4f99, 0x4f5c, 0x4f1f, 0x4ee3, 0x4ea7, 0x4e6c, 0x4e31,
+				0x4df7, 0x4dbe, 0x4d85, 0x4d4c, 0x4d14, 0x4cdc, 0x4ca5, 0x4c6e, 0x4c38, 0x4c02, 0x4bcd, 0x4b98,
+				0x4b63, 0x4b2f, 0x4afc, 0x4ac8, 0x4a95, 0x4a63, 0x4a31, 0x49ff, 0x49ce, 0x499d, 0x496d, 0x493d,
+				0x490d, 0x48dd, 0x48ae, 0x4880, 0x4851, 0x4823, 0x47f6, 0x47c8, 0x479b, 0x476f, 0x4742, 0x4716,
+				0x46eb, 0x46bf, 0x4694, 0x4669, 0x463f, 0x4615, 0x45eb, 0x45c1, 0x4598, 0x456f, 0x4546, 0x451e,
+				0x44f6, 0x44ce, 0x44a6, 0x447f, 0x4458, 0x4431, 0x440a, 0x43e4, 0x43be, 0x4398, 0x4373, 0x434d,
+				0x4328, 0x4303, 0x42df, 0x42ba, 0x4296, 0x4272, 0x424e, 0x422b, 0x4208, 0x41e5, 0x41c2, 0x419f,
+				0x417d, 0x415b, 0x4139, 0x4117, 0x40f5, 0x40d4, 0x40b3, 0x4092, 0x4071, 0x4051, 0x4030, 0x4010,
+			};
+			const uint64_t one = uint64_t(1) << 63;
+			uint64_t y = uint64_t(seed[(u >> 56) - 64]) << 48;
+			for (unsigned good = 8; good < precision; good = 2 * good - 1) {
+				uint64_t hi, lo;
+				lo = mul64x64(y, y, hi);
+				uint64_t y2 = (hi << 1) | (lo >> 63);  // y^2 / 2^63
+				lo = mul64x64(u, y2, hi);
+				uint64_t uy2 = (hi << 2) | (lo >> 62); // u y^2 / 2^63, close to one
+				if (uy2 <= one) {
+					mul64x64(y, one - uy2, hi);
+					y += hi;
+				}
+				else {
+					mul64x64(y, uy2 - one, hi);
+					y -= hi;
+				}
+			}
+			return y;
+		}
+
+		// reciprocal square root of a normalized limb array: v / 2^(64N-2) lies in [1, 4), and the result
+		// y / 2^(64N-1) approximates 1 / sqrt(v / 2^(64N-2)) to at least precision bits, at most 64N - 4.
+		// The word estimate of the leading limb is refined by the Newton iteration of word_rsqrt on all N limbs.
+		// Returns the number of correct bits, so that y is within 2^(64N-1-bits) units of the exact value.
+		template<size_t N>
+		inline size_t limbs_rsqrt_estimate(const uint64_t* v, uint64_t* y, size_t precision = 64 * N - 4) {
+			limbs_clear<N>(y);
+			// the truncations of the word iteration limit its estimate to 60 correct bits
+			y[N - 1] = word_rsqrt(v[N - 1], unsigned(precision < 60 ? precision : 60));
+			size_t good = 8;
+			while (good < precision && good < 60) good = 2 * good - 1;
+			if (good > 60) good = 60;
+			uint64_t p[2 * N], y2[N], d[N], one[N];
+			limbs_clear<N>(one);
+			limbs_set<N>(one, 64 * N - 1);
+			for (; good < precision; good = 2 * good - 2) {
+				limbs_mul<N, N>(p, y, y);
+				limbs_shl<2 * N>(p, 1);
+				for (size_t i = 0; i < N; ++i) y2[i] = p[N + i];     // y^2 / 2^(64N-1)
+				limbs_mul<N, N>(p, v, y2);
+				limbs_shl<2 * N>(p, 2);
+				for (size_t i = 0; i < N; ++i) d[i] = p[N + i];      // v y^2 / 2^(64N-1), close to one
+				bool below = limbs_compare<N>(d, one) <= 0;
+				if (below) limbs_sub<N>(d, one, d); else limbs_sub<N>(d, d, one);
+				limbs_mul<N, N>(p, y, d);
+				if (below) limbs_add<N>(y, y, p + N); else limbs_sub<N>(y, y, p + N);
+			}
+			return good < 64 * N - 4 ? good : 64 * N - 4;
+		}
+
+		// an estimate that is within 2^margin units of the exact root decides the root when the surplus bits
+		// below the root stay 2^margin units clear of a multiple of 2^surplus: the root is their floor, and inexact
+		template<size_t N>
+		inline bool limbs_root_decided(const uint64_t* estimate, size_t surplus, size_t margin) {
+			if (surplus < margin + 2) return false;
+			uint64_t low;
+			if (surplus >= 64) {
+				// the 64 surplus bits just below the root
+				uint64_t tmp[N];
+				for (size_t i = 0; i < N; ++i) tmp[i] = estimate[i];
+				limbs_shr<N>(tmp, surplus - 64);
+				low = tmp[0];
+				margin = (margin + 64 > surplus ? margin + 64 - surplus : 0);
+			}
+			else {
+				low = estimate[0] & ((uint64_t(1) << surplus) - 1);
+			}
+			uint64_t max = ~uint64_t(0) >> (surplus >= 64 ? 0 : 64 - surplus);
+			uint64_t clear = uint64_t(1) << margin;
+			return low >= clear && low <= max - clear;
+		}
+
+		// integer square root: root[N] = floor(sqrt(a[N])), returns true when the root leaves a remainder
+		// The radicand is normalized by an even shift and its root is estimated as v / sqrt(v) with the
+		// reciprocal square root recurrence. The estimate carries more bits than the root: when the surplus
+		// bits are clear of a rounding boundary they decide the root, otherwise its square is compared to a.
+		template<size_t N>
+		bool limbs_isqrt(const uint64_t* a, uint64_t* root) {
+			limbs_clear<N>(root);
+			unsigned lz = limbs_clz<N>(a);
+			if (lz == 64 * N) return false;
+			lz &= ~1u;
+			uint64_t v[N], y[N], p[2 * N];
+			for (size_t i = 0; i < N; ++i) v[i] = a[i];
+			limbs_shl<N>(v, lz);
+			size_t good = limbs_rsqrt_estimate<N>(v, y);
+			// v y / 2^(64N-2) approximates sqrt(v / 2^(64N-2)) 2^(64N-2), that is sqrt(a) 2^(32N-1+lz/2)
+			limbs_mul<N, N>(p, v, y);
+			limbs_shl<2 * N>(p, 1);
+			for (size_t i = 0; i < N; ++i) root[i] = p[N + i];
+			size_t surplus = 32 * N - 1 + lz / 2;
+			if (limbs_root_decided<N>(root, surplus, 64 * N + 2 - good)) {
+				limbs_shr<N>(root, surplus);
+				return true;
+			}
+			limbs_shr<N>(root, surplus);
+			uint64_t radicand[2 * N], sq[2 * N], next[N];
+			for (size_t i = 0; i < N; ++i) {
+				radicand[i] = a[i];
+				radicand[N + i] = 0;
+			}
+			limbs_mul<N, N>(sq, root, root);
+			while (limbs_compare<2 * N>(sq, radicand) > 0) {
+				limbs_decrement<N>(root);
+				limbs_mul<N, N>(sq, root, root);
+			}
+			for (;;) {
+				for (size_t i = 0; i < N; ++i) next[i] = root[i];
+				limbs_increment<N>(next);
+				limbs_mul<N, N>(p, next, next);
+				if (limbs_compare<2 * N>(p, radicand) > 0) break;
+				for (size_t i = 0; i < N; ++i) root[i] = next[i];
+				for (size_t i = 0; i < 2 * N; ++i) sq[i] = p[i];
+			}
+			return limbs_compare<2 * N>(sq, radicand) != 0;
+		}
+
+		// square root of a normalized fraction: root[N] = floor(sqrt(v / 2^(64N-2)) 2^(bits-1)) for a
+		// normalized v in [2^(64N-2), 2^(64N)) and bits <= 64N - 2, returns true when the root is inexact.
+		// Undecided estimates are corrected with the exact test root^2 2^(64N-2) <= v 2^(2 bits - 2).
+		template<size_t N>
+		bool limbs_fraction_sqrt(const uint64_t* v, size_t bits, uint64_t* root) {
+			uint64_t y[N], p[2 * N];
+			// 12 bits beyond the root leave few estimates undecided
+			size_t good = limbs_rsqrt_estimate<N>(v, y, bits + 12);
+			limbs_mul<N, N>(p, v, y);
+			limbs_shl<2 * N>(p, 1);
+			for (size_t i = 0; i < N; ++i) root[i] = p[N + i];   // sqrt(v / 2^(64N-2)) 2^(64N-2)
+			size_t surplus = 64 * N - 1 - bits;
+			bool decided = limbs_root_decided<N>(root, surplus, 64 * N + 2 - good);
+			limbs_shr<N>(root, surplus);
+			if (decided) return true;
+			uint64_t target[3 * N], sq[3 * N], next[N];
+			limbs_clear<3 * N>(target);
+			for (size_t i = 0; i < N; ++i) target[i] = v[i];
+			limbs_shl<3 * N>(target, 2 * bits - 2);
+			auto square = [&sq](const uint64_t* r) {
+				limbs_clear<3 * N>(sq);
+				limbs_mul<N, N>(sq, r, r);
+				limbs_shl<3 * N>(sq, 64 * N - 2);
+			};
+			square(root);
+			while (limbs_compare<3 * N>(sq, target) > 0) {
+				limbs_decrement<N>(root);
+				square(root);
+			}
+			bool inexact = limbs_compare<3 * N>(sq, target) != 0;
+			for (;;) {
+				for (size_t i = 0; i < N; ++i) next[i] = root[i];
+				limbs_increment<N>(next);
+				square(next);
+				int c = limbs_compare<3 * N>(sq, target);
+				if (c > 0) break;
+				for (size_t i = 0; i < N; ++i) root[i] = next[i];
+				inexact = (c != 0);
+			}
+			return inexact;
+		}
+
+		// reciprocal square root of a normalized fraction: root[N] = floor(2^(bits-1) / sqrt(v / 2^(64N-2))) for a
+		// normalized v in [2^(64N-2), 2^(64N)) and bits <= 64N - 2, returns true when the root is inexact.
+		// Undecided estimates are corrected with the exact test root^2 v <= 2^(2 bits + 64N - 4).
+		template<size_t N>
+		bool limbs_fraction_rsqrt(const uint64_t* v, size_t bits, uint64_t* root) {
+			size_t good = limbs_rsqrt_estimate<N>(v, root, bits + 12);
+			size_t surplus = 64 * N - bits;
+			bool decided = limbs_root_decided<N>(root, surplus, 64 * N + 2 - good);
+			limbs_shr<N>(root, surplus);
+			if (decided) return true;
+			uint64_t target[3 * N], p[3 * N], sq[2 * N], next[N];
+			limbs_clear<3 * N>(target);
+			limbs_set<3 * N>(target, 2 * bits + 64 * N - 4);
+			limbs_mul<N, N>(sq, root, root);
+			limbs_mul<2 * N, N>(p, sq, v);
+			while (limbs_compare<3 * N>(p, target) > 0) {
+				limbs_decrement<N>(root);
+				limbs_mul<N, N>(sq, root, root);
+				limbs_mul<2 * N, N>(p, sq, v);
+			}
+			bool inexact = limbs_compare<3 * N>(p, target) != 0;
+			for (;;) {
+				for (size_t i = 0; i < N; ++i) next[i] = root[i];
+				limbs_increment<N>(next);
+				limbs_mul<N, N>(sq, next, next);
+				limbs_mul<2 * N, N>(p, sq, v);
+				int c = limbs_compare<3 * N>(p, target);
+				if (c > 0) break;
+				for (size_t i = 0; i < N; ++i) root[i] = next[i];
+				inexact = (c != 0);
+			}
+			return inexact;
+		}
+
+		// reciprocal of a normalized word d >= 2^63: returns v = floor((2^128 - 1) / d) - 2^64, the reciprocal
+		// that replaces the division by d with multiplications in word_divide. A table on the leading 9 bits of d
+		// seeds it with 11 bits, three Newton steps on truncated words refine it to 64 bits, and a final step
+		// corrects it to the exact floor (Moller and Granlund, Improved division by invariant integers).
+		inline uint64_t word_reciprocal(uint64_t d) {
+			// floor((2^19 - 3 * 2^8) / i) for i = 256 .. 511
+			static constexpr uint16_t seed[256] = {
+				0x7fd, 0x7f5, 0x7ed, 0x7e5, 0x7dd, 0x7d5, 0x7ce, 0x7c6, 0x7bf, 0x7b7, 0x7b0, 0x7a8, 0x7a1, 0x79a, 0x792, 0x78b,
+				0x784, 0x77d, 0x776, 0x76f, 0x768, 0x761, 0x75b, 0x754, 0x74d, 0x747, 0x740, 0x739, 0x733, 0x72c, 0x726, 0x720,
+				0x719, 0x713, 0x70d, 0x707, 0x700, 0x6fa, 0x6f4, 0x6ee, 0x6e8, 0x6e2, 0x6dc, 0x6d6, 0x6d1, 0x6cb, 0x6c5, 0x6bf,
+				0x6ba, 0x6b4, 0x6ae, 0x6a9, 0x6a3, 0x69e, 0x698, 0x693, 0x68d, 0x688, 0x683, 0x67d, 0x678, 0x673, 0x66e, 0x669,
+				0x664, 0x65e, 0x659, 0x654, 0x64f, 0x64a, 0x645, 0x640, 0x63c, 0x637, 0x632, 0x62d, 0x628, 0x624, 0x61f, 0x61a,
+				0x616, 0x611, 0x60c, 0x608, 0x603, 0x5ff, 0x5fa, 0x5f6, 0x5f1, 0x5ed, 0x5e9, 0x5e4, 0x5e0, 0x5dc, 0x5d7, 0x5d3,
+				0x5cf, 0x5cb, 0x5c6, 0x5c2, 0x5be, 0x5ba, 0x5b6, 0x5b2, 0x5ae, 0x5aa, 0x5a6, 0x5a2, 0x59e, 0x59a, 0x596, 0x592,
+				0x58e, 0x58a, 0x586, 0x583, 0x57f, 0x57b, 0x577, 0x574, 0x570, 0x56c, 0x568, 0x565, 0x561, 0x55e, 0x55a, 0x556,
+				0x553, 0x54f, 0x54c, 0x548, 0x545, 0x541, 0x53e, 0x53a, 0x537, 0x534, 0x530, 0x52d, 0x52a, 0x526, 0x523, 0x520,
+				0x51c, 0x519, 0x516, 0x513, 0x50f, 0x50c, 0x509, 0x506, 0x503, 0x500, 0x4fc, 0x4f9, 0x4f6, 0x4f3, 0x4f0, 0x4ed,
+				0x4ea, 0x4e7, 0x4e4, 0x4e1, 0x4de, 0x4db, 0x4d8, 0x4d5, 0x4d2, 0x4cf, 0x4cc, 0x4ca, 0x4c7, 0x4c4, 0x4c1, 0x4be,
+				0x4bb, 0x4b9, 0x4b6, 0x4b3, 0x4b0, 0x4ad, 0x4ab, 0x4a8, 0x4a5, 0x4a3, 0x4a0, 0x49d, 0x49b, 0x498, 0x495, 0x493,
+				0x490, 0x48d, 0x48b, 0x488, 0x486, 0x483, 0x481, 0x47e, 0x47c, 0x479, 0x477, 0x474, 0x472, 0x46f, 0x46d, 0x46a,
+				0x468, 0x465, 0x463, 0x461, 0x45e, 0x45c, 0x459, 0x457, 0x455, 0x452, 0x450, 0x44e, 0x44b, 0x449, 0x447, 0x444,
+				0x442, 0x440, 0x43e, 0x43b, 0x439, 0x437, 0x435, 0x432, 0x430, 0x42e, 0x42c, 0x42a, 0x428, 0x425, 0x423, 0x421,
+				0x41f, 0x41d, 0x41b, 0x419, 0x417, 0x414, 0x412, 0x410, 0x40e, 0x40c, 0x40a, 0x408, 0x406, 0x404, 0x402, 0x400,
+			};
+			uint64_t d0 = d & 0x1, d40 = (d >> 24) + 1, d63 = (d >> 1) + d0;
+			uint64_t v0 = seed[(d >> 55) - 256];
+			uint64_t v1 = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+			uint64_t v2 = (v1 << 13) + ((v1 * ((uint64_t(1) << 60) - v1 * d40)) >> 47);
+			uint64_t hi, lo;
+			uint64_t e = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+			mul64x64(v2, e, hi);
+			uint64_t v3 = (v2 << 31) + (hi >> 1);
+			lo = mul64x64(v3, d, hi);
+			lo += d;
+			hi += (lo < d);
+			return v3 - hi - d;
+		}
+
+		// 128 / 64 -> 64 bit division of (hi, lo) by a normalized d with its reciprocal v = word_reciprocal(d):
+		// returns the quotient, and the remainder in rem, and requires hi < d. The quotient estimate v hi + 2^64 hi + lo
+		// is at most one short or one over, and the remainder corrects it.
+		inline uint64_t word_divide(uint64_t hi, uint64_t lo, uint64_t d, uint64_t v, uint64_t& rem) {
+			uint64_t q1, q0 = mul64x64(v, hi, q1);
+			q0 += lo;
+			q1 += hi + 1 + (q0 < lo);
+			uint64_t r = lo - q1 * d;
+			if (r > q0) {
+				--q1;
+				r += d;
+			}
+			if (r >= d) {
+				++q1;
+				r -= d;
+			}
+			rem = r;
+			return q1;
+		}
+
+		// quotient of normalized fractions: q[N] = floor(a / b 2^(bits-1)) for normalized a and b in
+		// [2^(64N-1), 2^(64N)) and bits <= 64N, returns true when the quotient is inexact.
+		// Long division with 64-bit digits: each quotient digit is estimated from the leading remainder and divisor
+		// limbs with the reciprocal of the leading divisor limb, which takes the hardware divide out of the loop.
+		// The estimate is refined with the second divisor limb, and the rare estimate that remains one too large
+		// is corrected by adding the divisor back.
+		template<size_t N>
+		bool limbs_fraction_divide(const uint64_t* a, const uint64_t* b, size_t bits, uint64_t* q) {
+			uint64_t u[2 * N];
+			limbs_clear<2 * N>(u);
+			for (size_t i = 0; i < N; ++i) u[i] = a[i];
+			limbs_shl<2 * N>(u, bits - 1);
+			const uint64_t top = b[N - 1], v = word_reciprocal(top);
+			// the quotient fits N digits because the leading N limbs of the numerator are smaller than b
+			for (size_t j = N; j-- > 0; ) {
+				uint64_t qhat, rhat;
+				bool refine = true;
+				if (u[j + N] == top) {
+					// the estimate saturates at 2^64 - 1
+					qhat = ~uint64_t(0);
+					rhat = u[j + N - 1] + top;
+					refine = (rhat >= top);
+				}
+				else {
+					qhat = word_divide(u[j + N], u[j + N - 1], top, v, rhat);
+				}
+				if (N > 1) {
+					// the second divisor limb leaves the estimate at most one too large
+					while (refine) {
+						uint64_t hi, lo = mul64x64(qhat, b[N - 2], hi);
+						if (hi < rhat || (hi == rhat && lo <= u[j + N - 2])) break;
+						--qhat;
+						rhat += top;
+						refine = (rhat >= top);
+					}
+				}
+				// u[j .. j+N] -= qhat b
+				uint64_t carry = 0, borrow = 0;
+				for (size_t i = 0; i < N; ++i) {
+					uint64_t hi, lo = mul64x64(qhat, b[i], hi);
+					lo += carry;
+					hi += (lo < carry);
+					uint64_t t = u[i + j] - lo;
+					uint64_t c = (u[i + j] < lo);
+					u[i + j] = t - borrow;
+					c += (t < borrow);
+					borrow = c;
+					carry = hi;
+				}
+				uint64_t t = u[j + N] - carry;
+				bool negative = (u[j + N] < carry) || (t < borrow);
+				u[j + N] = t - borrow;
+				if (negative) {
+					--qhat;
+					uint64_t c = 0;
+					for (size_t i = 0; i < N; ++i) {
+						uint64_t s = u[i + j] + c;
+						c = (s < c);
+						u[i + j] = s + b[i];
+						c += (u[i + j] < s);
+					}
+					u[j + N] += c;
+				}
+				q[j] = qhat;
+			}
+			return !limbs_iszero<N>(u);
+		}
+
+		// copy a std::bitset into a limb array
+		template<size_t nbits, size_t N>
+		inline void bitset_to_limbs(const std::bitset<nbits>& bits, uint64_t* a) {
+			static_assert(N * 64 >= nbits, "limb array is too small to hold the bitset");
+			if (nbits <= 64) {
+				a[0] = bits.to_ullong();
+				for (size_t i = 1; i < N; ++i) a[i] = 0;
+			}
+			else {
+				const std::bitset<nbits> mask(0xFFFFFFFFFFFFFFFFull);
+				std::bitset<nbits> tmp(bits);
+				for (size_t i = 0; i < N; ++i) {
+					a[i] = (tmp & mask).to_ullong();
+					tmp >>= 64;
+				}
+			}
+		}
+
+		// copy a limb array into a std::bitset
+		template<size_t nbits, size_t N>
+		inline void limbs_to_bitset(const uint64_t* a, std::bitset<nbits>& bits) {
+			if (nbits <= 64) {
+				bits = std::bitset<nbits>(a[0]);
+			}
+			else {
+				bits.reset();
+				for (size_t i = N; i-- > 0; ) {
+					bits <<= 64;
+					bits |= std::bitset<nbits>(a[i]);
+				}
+			}
+		}
+
+	} // namespace unum
+
+} // namespace sw
@@ -1,33 +1,79 @@
 #pragma once
 // quire.hpp: definition of a parameterized quire configurations for IEEE float/double/long double
 //
-// Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include <type_traits>
+#include "../posit/exceptions.hpp"
+#include "../bitblock/bitblock.hpp"
+#include "../bitblock/limbs.hpp"
+#include "../posit/value.hpp"
 
 namespace sw {
 	namespace ieee {
 
+// decompose a finite IEEE value into a sign and an integer significand scaled by 2^exponent, straight from its bit pattern
+// subnormals carry no hidden bit and share the exponent of the smallest normal
+inline void decompose(double v, bool& sign, int& exponent, uint64_t& significand) {
+	uint64_t bits;
+	std::memcpy(&bits, &v, sizeof(bits));
+	sign = (bits >> 63) != 0;
+	int biased = int((bits >> 52) & 0x7FF);
+	significand = bits & 0x000FFFFFFFFFFFFFull;
+	if (biased == 0x7FF) throw operand_too_large_for_quire("operand is not a finite value");
+	if (biased == 0) {
+		exponent = -1074;
+	}
+	else {
+		significand |= 0x0010000000000000ull;
+		exponent = biased - 1075;
+	}
+}
+inline void decompose(float v, bool& sign, int& exponent, uint64_t& significand) {
+	uint32_t bits;
+	std::memcpy(&bits, &v, sizeof(bits));
+	sign = (bits >> 31) != 0;
+	int biased = int((bits >> 23) & 0xFF);
+	significand = bits & 0x007FFFFFu;
+	if (biased == 0xFF) throw operand_too_large_for_quire("operand is not a finite value");
+	if (biased == 0) {
+		exponent = -149;
+	}
+	else {
+		significand |= 0x00800000u;
+		exponent = biased - 150;
+	}
+}
+
 // template class representing a quire associated with an ieee float configuration
 // capacity indicates the power of 2 number of accumulations the quire can support
 template<size_t nbits, size_t es, size_t capacity = 30>
 class quire {
 public:
-	// fixed-point representation of a float multiply requires 1 + 2*(2^ebits + mbits), where ebits and mbits are the number of bits in exponent and mantissa, respectively
-//	type	size	ebits	mbits	exponent range	capacity	quire size	total
-//	float	 32		 8		 24		256				30			561			  591
-//	double	 64		11		 53		2048			30			4203		 4233
-//	lng dbl	128		15		113		32768			30			65763		65793
+	// fixed-point representation of a float multiply needs to cover the products of the smallest subnormals
+	// up to the square of the largest normal, as well as the capacity bits to absorb the carries of the sum
+//	type	size	ebits	mbits	lower range	upper range	capacity	quire size
+//	float	 32		 8		 24		  298		  256		  30		  584
+//	double	 64		11		 53		 2148		 2048		  30		 4226
 
 	static constexpr size_t ebits = es;
-	static constexpr size_t mbits = nbits - es;
-	static constexpr size_t escale = 2*((size_t(1) << es) + mbits + 1);
-	static constexpr size_t range = escale; 		  // dynamic range of the float configuration
-	static constexpr size_t half_range = range >> 1;          // position of the fixed point
-	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
-	static constexpr size_t qbits = range + capacity;         // size of the quire minus the sign bit: we are managing the sign explicitly
-	
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	static constexpr size_t mbits = nbits - es;                              // significand bits, hidden bit included
+	static constexpr size_t bias = (size_t(1) << (es - 1)) - 1;
+	static constexpr size_t half_range = 2 * (bias - 1 + mbits - 1);         // position of the fixed point: lsb of minsub^2
+	static constexpr size_t upper_range = 2 * (bias + 1);                    // size of the upper accumulator: msb of maxpos^2
+	static constexpr size_t escale = half_range + upper_range;
+	static constexpr size_t range = escale; 		                         // dynamic range of the float configuration
+	static constexpr size_t qbits = range + capacity;                        // size of the quire minus the sign bit
+	static constexpr size_t qlimbs = sw::unum::nr_limbs(qbits + 1);          // two's complement accumulator, sign bit included
+
+	quire() { reset(); }
 	quire(int8_t initial_value) {
 		*this = initial_value;
 	}
@@ -53,524 +99,371 @@ public:
 	quire(const sw::unum::value<fbits>& rhs) {
 		*this = rhs;
 	}
-	// TODO: we are clamping the values of the RHS to be withing the dynamic range of the float
-	// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity to accept larger scale values than the dynamic range of the float.
-	// TODO: is that a good idea?
+
 	template<size_t fbits>
 	quire& operator=(const sw::unum::value<fbits>& rhs) {
 		reset();
-		_sign = rhs.sign();
-		int i,f, scale = rhs.scale();
-		if (scale > int(half_range)) {
-			throw operand_too_large_for_quire{};
-		}
-		if (scale < -int(half_range)) {
-			throw operand_too_small_for_quire{};
-		}
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
+		*this += rhs;
 		return *this;
 	}
-	quire& operator=(signed char rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int8_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(short int rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int16_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(int rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int32_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(long long rhs) {
-		clear();
-		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
-		unsigned msb = sw::unum::findMostSignificantBit(magnitude);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+	quire& operator=(int64_t rhs) {
+		bool negative = rhs < 0;
+		*this = negative ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs);
+		if (negative) sw::unum::limbs_twos_complement<qlimbs>(_accu);
 		return *this;
 	}
-	quire& operator=(long long unsigned rhs) {
+	quire& operator=(uint64_t rhs) {
 		reset();
-		unsigned msb = sw::unum::findMostSignificantBit(rhs);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		// the integer lands with its lsb on the radix point
+		add_magnitude<1>(&rhs, int(half_range), false);
 		return *this;
 	}
 	quire& operator=(float rhs) {
-		constexpr int bits = std::numeric_limits<float>::digits - 1;
-		*this = sw::unum::value<bits>(rhs);
-		return *this;
+		reset();
+		return *this += rhs;
 	}
 	quire& operator=(double rhs) {
-		constexpr int bits = std::numeric_limits<double>::digits - 1;
-		*this = sw::unum::value<bits>(rhs);
-		return *this;
+		reset();
+		return *this += rhs;
 	}
 	quire& operator=(long double rhs) {
-		constexpr int bits = std::numeric_limits<long double>::digits - 1;	
+		constexpr int bits = std::numeric_limits<long double>::digits - 1;
 		*this = sw::unum::value<bits>(rhs);
 		return *this;
 	}
-	
+
+	// add a normalized (sign, scale, fraction) triplet
 	template<size_t fbits>
 	quire& operator+=(const sw::unum::value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
-		int i, f, scale = rhs.scale();
-		if (scale >  int(half_range)) {
-			throw operand_too_large_for_quire{};
-		}
-		if (scale < -int(half_range)) {
-			throw operand_too_small_for_quire{};
-		}
-		if (rhs.sign()) {			// subtract
-			// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-			int lsb = scale - int(fbits);  
-			bool borrow = false;
-			sw::unum::bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the lower accumulator
-				while (borrow && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) { // borrow propagate to the _upper accumulator
-							  // need to decrement the _upper
-					i = 0;
-					while (borrow && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-					if (borrow) {
-						// propagate the borrow into the capacity segment
-						i = 0;
-						while (borrow && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = _a ^ borrow;
-							borrow = borrow & !_a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
-			else {   // lsb < 0 && scale >= 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}			
+		if (rhs.isinf() || rhs.isnan()) throw operand_too_large_for_quire("operand is not a finite value");
+		constexpr size_t N = sw::unum::nr_limbs(fbits + 1);
+		uint64_t m[N];
+		sw::unum::bitset_to_limbs<fbits, N>(rhs.fraction(), m);
+		sw::unum::limbs_set<N>(m, fbits);
+		// scale is the location of the msb, so the lsb of the significand lands at bit half_range + scale - fbits
+		add_magnitude<N>(m, int(half_range) + rhs.scale() - int(fbits), rhs.sign());
+		return *this;
+	}
+	template<size_t fbits>
+	quire& operator-=(const sw::unum::value<fbits>& rhs) {
+		return *this += -rhs;
+	}
+	// add and subtract native values: decomposed from their bit pattern, no normalization
+	quire& operator+=(float rhs)  { add_native(rhs, false); return *this; }
+	quire& operator+=(double rhs) { add_native(rhs, false); return *this; }
+	quire& operator-=(float rhs)  { add_native(rhs, true);  return *this; }
+	quire& operator-=(double rhs) { add_native(rhs, true);  return *this; }
+
+	// add two quires: the accumulators are aligned two's complement numbers, so this is a single carry chain
+	quire& operator+=(const quire& q) {
+		sw::unum::limbs_add<qlimbs>(_accu, _accu, q._accu);
+		return *this;
+	}
+	quire& operator-=(const quire& q) {
+		sw::unum::limbs_sub<qlimbs>(_accu, _accu, q._accu);
+		return *this;
+	}
+
+	// fused multiply-accumulate: add the exact product of two native values
+	template<typename Real>
+	quire& fma(Real a, Real b) {
+		add_product(a, b);
+		return *this;
+	}
+	// add n native values: summation in a quire is exact, so the result does not depend on the order of the values
+	template<typename Real>
+	quire& accumulate(const Real* x, size_t n) {
+		static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value, "accumulate requires float or double values");
+		int64_t digit[ndigits];
+		for (size_t i = 0; i < n; ) {
+			std::fill(digit, digit + ndigits, int64_t(0));
+			for (size_t end = std::min(n, i + digit_headroom); i < end; ++i) {
+				bool sign;
+				int exponent;
+				uint64_t significand;
+				decompose(x[i], sign, exponent, significand);
+				int lsb = int(half_range) + exponent;
+				if (lsb >= 0 && lsb + 64 <= int(qbits)) add_digits<3>(digit, significand, 0, lsb, sign); else add_wide(significand, 0, lsb, sign);
 			}
+			fold(digit);
 		}
-		else {			// add
-			// scale is the location of the msb in the fixed point representation
-			// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-			// and scale = -1 is the first bit of the fraction
-			// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-			int lsb = scale - int(fbits);
-			bool carry = false;
-			sw::unum::bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// propagate any carries to the end of the lower accumulator
-				while (carry && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {  // carry propagate to the _upper accumulator
-							  // need to increment the _upper
-					i = 0;
-					while (carry && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-					if (carry) {
-						// next add the bits to the capacity segment
-						i = 0;
-						while (carry && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = _a ^ carry;
-							carry = carry & _a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
-			else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// propagate any carries to the end of the upper accumulator
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				// next add the bits to the capacity segment
-				if (carry) {
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
+		return *this;
+	}
+	// add the exact dot product of n pairs of native values: the product of the integer significands is at most 106 bits
+	template<typename Real>
+	quire& dot(const Real* x, const Real* y, size_t n) {
+		static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value, "dot requires float or double values");
+		int64_t digit[ndigits];
+		for (size_t i = 0; i < n; ) {
+			std::fill(digit, digit + ndigits, int64_t(0));
+			for (size_t end = std::min(n, i + digit_headroom); i < end; ++i) {
+				bool sa, sb;
+				int ea, eb;
+				uint64_t ma, mb;
+				decompose(x[i], sa, ea, ma);
+				decompose(y[i], sb, eb, mb);
+				uint64_t hi, lo = sw::unum::mul64x64(ma, mb, hi);
+				int lsb = int(half_range) + ea + eb;
+				if (lsb >= 0 && lsb + 128 <= int(qbits)) add_digits<5>(digit, lo, hi, lsb, sa != sb); else add_wide(lo, hi, lsb, sa != sb);
 			}
+			fold(digit);
 		}
 		return *this;
 	}
+
 	// reset the state of a quire to zero
 	void reset() {
-		_sign  = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		sw::unum::limbs_clear<qlimbs>(_accu);
 	}
 	// clear the state of a quire to zero
 	void clear() { reset(); }
 	int dynamic_range() const { return range; }
 	int radix_point() const { return half_range; }
-	int max_scale() const { return half_range; }
+	int max_scale() const { return int(upper_range) - 1; }
 	int min_scale() const { return -int(half_range); }
 	int capacity_range() const { return capacity; }
-	bool isneg() const { return _sign; }
-	bool ispos() const { return !_sign; }
-	bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	bool isneg() const { return get_sign(); }
+	bool ispos() const { return !get_sign(); }
+	bool iszero() const { return sw::unum::limbs_iszero<qlimbs>(_accu); }
+	// scale of the msb of the magnitude, a zero quire reports the scale just below the lsb of the lower accumulator
+	int scale() const {
+		uint64_t m[qlimbs];
+		magnitude(m);
+		return int(64 * qlimbs - 1 - sw::unum::limbs_clz<qlimbs>(m)) - int(half_range);
+	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
-	bool get_sign() const { return _sign; }
-	float sign_value() const {	return (_sign ? -1.0 : 1.0); }
+	bool get_sign() const { return (_accu[qlimbs - 1] >> 63) != 0; }
+	float sign_value() const {	return (get_sign() ? -1.0f : 1.0f); }
 	sw::unum::value<qbits> to_value() const {
-		// find the MSB and build the fraction
+		uint64_t m[qlimbs];
+		bool negative = magnitude(m);
 		sw::unum::bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _lower[i];
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
+		unsigned lz = sw::unum::limbs_clz<qlimbs>(m);
+		if (lz == 64 * qlimbs) return sw::unum::value<qbits>(false, 0, fraction, true, false);
+		int scale = int(64 * qlimbs - 1 - lz) - int(half_range);
+		sw::unum::limbs_shl<qlimbs>(m, lz + 1);                 // remove the leading zeros and the hidden bit
+		sw::unum::limbs_shr<qlimbs>(m, 64 * qlimbs - qbits);    // the fraction is msb aligned in qbits
+		sw::unum::limbs_to_bitset<qbits, qlimbs>(m, fraction);
+		return sw::unum::value<qbits>(negative, scale, fraction, false, false);
+	}
+	// the value of the quire scaled by 2^-shift, rounded to nearest, ties to even, in a native floating-point type
+	template<typename Real>
+	Real to_native(int shift = 0) const {
+		constexpr int digits = std::numeric_limits<Real>::digits;
+		constexpr int emin = std::numeric_limits<Real>::min_exponent - 1;   // scale of the smallest normal
+		uint64_t m[qlimbs];
+		bool negative = magnitude(m);
+		int radix = int(half_range) + shift;
+		unsigned lz = sw::unum::limbs_clz<qlimbs>(m);
+		if (lz == 64 * qlimbs) return Real(0);
+		int msb = int(64 * qlimbs - 1 - lz);
+		int scale = msb - radix;
+		if (scale >= std::numeric_limits<Real>::max_exponent) return negative ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity();
+		// position of the lsb of the rounded significand: digits below the msb, but not below the smallest subnormal
+		int lsb = std::max(scale - digits + 1, emin - digits + 1) + radix;
+		uint64_t significand = extract(m, lsb);
+		if (lsb > 0) {
+			bool guard = sw::unum::limbs_test<qlimbs>(m, size_t(lsb - 1));
+			bool sticky = sw::unum::limbs_any_below<qlimbs>(m, size_t(lsb - 1));
+			if (guard && (sticky || (significand & 1))) ++significand;
 		}
-		return sw::unum::value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		// the significand is exact in Real, and scaling it into the subnormal range is exact as it sits on the subnormal grid
+		Real v = std::ldexp(Real(significand), lsb - radix);
+		return negative ? -v : v;
 	}
+	explicit operator float() const { return to_native<float>(); }
+	explicit operator double() const { return to_native<double>(); }
 
 private:
-	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	// TODO: don't pull a type from sw::unum
-	sw::unum::bitblock<half_range>   _lower;
-	sw::unum::bitblock<upper_range>  _upper;
-	sw::unum::bitblock<capacity>     _capacity;
+	// two's complement accumulator, least significant limb first: bit i has weight 2^(i - half_range)
+	uint64_t _accu[qlimbs];
 
-#if TEMPLATIZED_TYPE
-	//  when we figure out how to templatize the extraction of exponent bits from type
+	// the magnitude of the accumulator, returns the sign
+	bool magnitude(uint64_t* m) const {
+		for (size_t i = 0; i < qlimbs; ++i) m[i] = _accu[i];
+		bool negative = get_sign();
+		if (negative) sw::unum::limbs_twos_complement<qlimbs>(m);
+		return negative;
+	}
+	// the 64 bits of m starting at bit position lsb, which may be negative
+	static uint64_t extract(const uint64_t* m, int lsb) {
+		if (lsb < 0) return m[0] << -lsb;    // only reached when all the bits of the quire fit in the significand
+		size_t w = size_t(lsb) >> 6;
+		unsigned s = unsigned(lsb) & 63;
+		uint64_t bits = w < qlimbs ? m[w] >> s : 0;
+		if (s && w + 1 < qlimbs) bits |= m[w + 1] << (64 - s);
+		return bits;
+	}
 
-	// template parameters need names different from class template parameters (for gcc and clang)
-	template<typename TTy, size_t ncapacity>
-	friend std::ostream& operator<< (std::ostream& ostr, const quire<TTy,ncapacity>& q);
-	template<typename TTy, size_t ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<TTy, ncapacity>& q);
+	// add a native value, negated when negate is set
+	template<typename Real>
+	void add_native(Real v, bool negate) {
+		bool sign;
+		int exponent;
+		uint64_t significand;
+		decompose(v, sign, exponent, significand);
+		add_wide(significand, 0, int(half_range) + exponent, sign != negate);
+	}
+	// add the exact product of two native values: the product of the integer significands is at most 106 bits
+	template<typename Real>
+	void add_product(Real a, Real b) {
+		bool sa, sb;
+		int ea, eb;
+		uint64_t ma, mb;
+		decompose(a, sa, ea, ma);
+		decompose(b, sb, eb, mb);
+		uint64_t hi, lo = sw::unum::mul64x64(ma, mb, hi);
+		add_wide(lo, hi, int(half_range) + ea + eb, sa != sb);
+	}
+	// The batch operations add into signed 64-bit digits that each cover 32 bits of the accumulator, so a value
+	// touches three digits and a product five, without carries and without a branch on the sign. A digit absorbs
+	// 2^31 additions of less than 2^32 before its carries must be resolved into the quire.
+	static constexpr size_t ndigits = 2 * qlimbs + 4;          // guard digits take the zero top digits of a product
+	static constexpr size_t digit_headroom = size_t(1) << 30;
 
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator==(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator!=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator< (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator> (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator<=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator>=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
+	// add the magnitude hi:lo shifted to bit position lsb, negated when negative is set, to D digits
+	template<size_t D>
+	static void add_digits(int64_t* digit, uint64_t lo, uint64_t hi, int lsb, bool negative) {
+		size_t k = size_t(lsb) >> 5;
+		unsigned s = unsigned(lsb) & 31;
+		uint64_t w0 = lo << s;
+		uint64_t w1 = s ? (hi << s) | (lo >> (64 - s)) : hi;
+		// conditional negation of the 32-bit parts
+		int64_t mask = -int64_t(negative);
+		int64_t* d = digit + k;
+		d[0] += (int64_t(w0 & 0xFFFFFFFFu) ^ mask) - mask;
+		d[1] += (int64_t(w0 >> 32) ^ mask) - mask;
+		d[2] += (int64_t(w1 & 0xFFFFFFFFu) ^ mask) - mask;
+		if (D > 3) {
+			uint64_t w2 = s ? hi >> (64 - s) : 0;
+			d[3] += (int64_t(w1 >> 32) ^ mask) - mask;
+			d[4] += (int64_t(w2 & 0xFFFFFFFFu) ^ mask) - mask;
+		}
+	}
+	// resolve the carries of the digits and add them to the quire
+	void fold(const int64_t* digit) {
+		uint64_t sum[qlimbs];
+		int64_t carry = 0;
+		for (size_t i = 0; i < qlimbs; ++i) {
+			int64_t lo = digit[2 * i] + carry;
+			carry = lo >> 32;
+			int64_t hi = digit[2 * i + 1] + carry;
+			carry = hi >> 32;
+			sum[i] = (uint64_t(hi) << 32) | (uint64_t(lo) & 0xFFFFFFFFu);
+		}
+		// the carry out and the guard digits lie beyond the two's complement accumulator
+		sw::unum::limbs_add<qlimbs>(_accu, _accu, sum);
+	}
+	// add, or subtract when negative is set, the 128-bit magnitude hi:lo with its lsb at bit position lsb
+	// a magnitude that lands inside the accumulator touches three limbs and then ripples the carry,
+	// everything else, including zero and range violations, goes through the general path
+	void add_wide(uint64_t lo, uint64_t hi, int lsb, bool negative) {
+		if (lsb < 0 || lsb + 128 > int(qbits)) {
+			uint64_t m[2] = { lo, hi };
+			add_magnitude<2>(m, lsb, negative);
+			return;
+		}
+		size_t i = size_t(lsb) >> 6;
+		unsigned s = unsigned(lsb) & 63;
+		uint64_t w0 = lo << s;
+		uint64_t w1 = s ? (hi << s) | (lo >> (64 - s)) : hi;
+		uint64_t w2 = s ? hi >> (64 - s) : 0;
+		uint64_t* a = _accu + i;
+		if (!negative) {
+			uint64_t carry, t;
+			a[0] += w0;
+			carry = (a[0] < w0);
+			t = a[1] + carry;
+			carry = (t < carry);
+			a[1] = t + w1;
+			carry += (a[1] < t);
+			t = a[2] + carry;
+			carry = (t < carry);
+			a[2] = t + w2;
+			carry += (a[2] < t);
+			for (i += 3; carry && i < qlimbs; ++i) carry = (++_accu[i] == 0);
+		}
+		else {
+			uint64_t borrow, d;
+			borrow = (a[0] < w0);
+			a[0] -= w0;
+			d = a[1] - borrow;
+			borrow = (a[1] < borrow);
+			borrow += (d < w1);
+			a[1] = d - w1;
+			d = a[2] - borrow;
+			borrow = (a[2] < borrow);
+			borrow += (d < w2);
+			a[2] = d - w2;
+			for (i += 3; borrow && i < qlimbs; ++i) borrow = (_accu[i]-- == 0);
+		}
+	}
 
-#else
+	// add, or subtract when negative is set, the N limb magnitude m shifted to bit position lsb
+	// bits below the lsb of the accumulator are dropped, values beyond its range are rejected
+	template<size_t N>
+	void add_magnitude(const uint64_t* m, int lsb, bool negative) {
+		if (sw::unum::limbs_iszero<N>(m)) return;
+		uint64_t aligned[N + 1];
+		for (size_t i = 0; i < N; ++i) aligned[i] = m[i];
+		aligned[N] = 0;
+		int msb = lsb + int(64 * N - 1 - sw::unum::limbs_clz<N>(m));
+		if (msb >= int(qbits)) throw operand_too_large_for_quire{};
+		if (msb < 0) throw operand_too_small_for_quire{};
+		if (lsb < 0) {
+			sw::unum::limbs_shr<N + 1>(aligned, size_t(-lsb));
+			lsb = 0;
+		}
+		else {
+			sw::unum::limbs_shl<N + 1>(aligned, size_t(lsb) & 63);
+		}
+		size_t i = size_t(lsb) >> 6;
+		if (!negative) {
+			uint64_t carry = 0;
+			for (size_t k = 0; k <= N && i < qlimbs; ++k, ++i) {
+				uint64_t sum = _accu[i] + carry;
+				carry = (sum < carry);
+				_accu[i] = sum + aligned[k];
+				carry += (_accu[i] < sum);
+			}
+			for (; carry && i < qlimbs; ++i) carry = (++_accu[i] == 0);
+		}
+		else {
+			uint64_t borrow = 0;
+			for (size_t k = 0; k <= N && i < qlimbs; ++k, ++i) {
+				uint64_t d = _accu[i] - borrow;
+				borrow = (_accu[i] < borrow);
+				borrow += (d < aligned[k]);
+				_accu[i] = d - aligned[k];
+			}
+			for (; borrow && i < qlimbs; ++i) borrow = (_accu[i]-- == 0);
+		}
+	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend std::ostream& operator<< (std::ostream& ostr, const quire<nnbits, nes, ncapacity>& q);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<nnbits, nes, ncapacity>& q);
 
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend bool operator==(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
 	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator!=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend bool operator< (const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator> (const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator<=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator>=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-
-#endif // TEMPLATIZED_TYPE
 };
 
-#if TEMPLATIZED_TYPE
-
-// QUIRE BINARY ARITHMETIC OPERATORS
-template<typename Ty, size_t capacity>
-inline quire<Ty, capacity> operator+(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) {
-	quire<Ty, capacity> sum = lhs;
-	sum += rhs;
-	return sum;
-}
-
-
-////////////////// QUIRE operators
-template<typename Ty, size_t capacity>
-inline std::ostream& operator<<(std::ostream& ostr, const quire<Ty, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
-}
-
-template<typename Ty, size_t capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<Ty, capacity>& q) {
-	istr >> q._accu;
-	return istr;
-}
-
-template<typename Ty, size_t capacity>
-inline bool operator==(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
-template<typename Ty, size_t capacity>
-inline bool operator!=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator==(lhs, rhs); }
-template<typename Ty, size_t capacity>
-inline bool operator< (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { 
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
-	}
-	return bSmaller;
-}
-template<typename Ty, size_t capacity>
-inline bool operator> (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return  operator< (rhs, lhs); }
-template<typename Ty, size_t capacity>
-inline bool operator<=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
-template<typename Ty, size_t capacity>
-inline bool operator>=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-
-#else
-
 // QUIRE BINARY ARITHMETIC OPERATORS
 template<size_t nbits, size_t es, size_t capacity>
 inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
@@ -578,51 +471,46 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 	sum += rhs;
 	return sum;
 }
-
+template<size_t nbits, size_t es, size_t capacity>
+inline quire<nbits, es, capacity> operator-(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	quire<nbits, es, capacity> difference = lhs;
+	difference -= rhs;
+	return difference;
+}
 
 ////////////////// QUIRE operators
+// format is " 1: capacity_upper.lower" of the magnitude
 template<size_t nnbits, size_t nes, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nnbits, nes, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
+	using Quire = quire<nnbits, nes, capacity>;
+	uint64_t m[Quire::qlimbs];
+	ostr << (q.magnitude(m) ? "-1" : " 1") << ": ";
+	for (size_t i = Quire::qbits; i-- > 0; ) {
+		ostr << (sw::unum::limbs_test<Quire::qlimbs>(m, i) ? '1' : '0');
+		if (i == Quire::half_range + Quire::upper_range) ostr << '_';
+		if (i == Quire::half_range) ostr << '.';
+	}
 	return ostr;
 }
 
-template<size_t nnbits, size_t nes, size_t capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<nnbits, nes, capacity>& q) {
-	istr >> q._accu;
-	return istr;
-}
-
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	return sw::unum::limbs_compare<quire<nbits, es, capacity>::qlimbs>(lhs._accu, rhs._accu) == 0;
+}
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-		bSmaller = true;
-	}
-	else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-		bSmaller = true;
-	}
-	else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-		bSmaller = true;
-	}
-}
-return bSmaller;
+	// two's complement numbers of the same sign order like their unsigned limbs
+	if (lhs.get_sign() != rhs.get_sign()) return lhs.get_sign();
+	return sw::unum::limbs_compare<quire<nbits, es, capacity>::qlimbs>(lhs._accu, rhs._accu) < 0;
 }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator> (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return  operator< (rhs, lhs); }
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
+inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-#endif
+inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs); }
 
 }  // namespace ieee
 
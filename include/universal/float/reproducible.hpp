@@ -0,0 +1,91 @@
+#pragma once
+// reproducible.hpp: parallel reductions of float and double arrays that are bitwise reproducible
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../utility/parallel.hpp"
+#include "quire.hpp"
+
+// Every thread accumulates a contiguous part of the arrays into its own quire, and the partial quires
+// are added before the one and only rounding step. Quire accumulation and quire addition are exact,
+// so the result does not depend on the number of threads, the partitioning, or the order of the elements.
+
+namespace sw {
+	namespace ieee {
+
+// the quire that holds the exact sums and dot products of a native floating-point type
+template<typename Real> struct reproducible_quire;
+template<> struct reproducible_quire<float>  { using type = quire<32, 8>; };
+template<> struct reproducible_quire<double> { using type = quire<64, 11>; };
+
+// smallest part of a reduction that is given its own thread
+constexpr size_t reproducible_min_elements_per_thread = 8192;
+
+// exact reduction of n elements by nrOfThreads threads: reduce(q, begin, count) adds elements [begin, begin+count) to q
+template<typename Real, typename Reduction>
+typename reproducible_quire<Real>::type reproducible_reduce(size_t n, size_t nrOfThreads, Reduction reduce) {
+	using Quire = typename reproducible_quire<Real>::type;
+	size_t threads = sw::unum::parallel_thread_count(n, nrOfThreads, reproducible_min_elements_per_thread);
+	size_t chunk = (n + threads - 1) / threads;
+	std::vector<Quire> partial(threads);
+	sw::unum::parallel_parts(threads, [&](size_t t) {
+		size_t begin = t * chunk;
+		if (begin < n) reduce(partial[t], begin, std::min(chunk, n - begin));
+	});
+	for (size_t t = 1; t < threads; ++t) partial[0] += partial[t];
+	return partial[0];
+}
+
+// sum of x[0..n), correctly rounded
+template<typename Real>
+Real reproducible_sum(const Real* x, size_t n, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	auto q = reproducible_reduce<Real>(n, nrOfThreads, [x](typename reproducible_quire<Real>::type& partial, size_t begin, size_t count) {
+		partial.accumulate(x + begin, count);
+	});
+	return q.template to_native<Real>();
+}
+template<typename Real>
+Real reproducible_sum(const std::vector<Real>& x, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	return reproducible_sum(x.data(), x.size(), nrOfThreads);
+}
+
+// dot product of x[0..n) and y[0..n), correctly rounded
+template<typename Real>
+Real reproducible_dot(const Real* x, const Real* y, size_t n, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	auto q = reproducible_reduce<Real>(n, nrOfThreads, [x, y](typename reproducible_quire<Real>::type& partial, size_t begin, size_t count) {
+		partial.dot(x + begin, y + begin, count);
+	});
+	return q.template to_native<Real>();
+}
+template<typename Real>
+Real reproducible_dot(const std::vector<Real>& x, const std::vector<Real>& y, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	if (x.size() != y.size()) throw std::invalid_argument("reproducible_dot: the vectors have different lengths");
+	return reproducible_dot(x.data(), y.data(), x.size(), nrOfThreads);
+}
+
+// Euclidean norm of x[0..n)
+// The sum of squares is exact and is rounded once after scaling by an even power of two, so it can neither
+// overflow nor underflow; the square root of the scaled sum is scaled back. The result is within an ulp.
+template<typename Real>
+Real reproducible_nrm2(const Real* x, size_t n, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	auto q = reproducible_reduce<Real>(n, nrOfThreads, [x](typename reproducible_quire<Real>::type& partial, size_t begin, size_t count) {
+		partial.dot(x + begin, x + begin, count);
+	});
+	if (q.iszero()) return Real(0);
+	int shift = q.scale() & ~1;    // the scaled sum of squares lies in [1, 4)
+	return std::ldexp(std::sqrt(q.template to_native<Real>(shift)), shift / 2);
+}
+template<typename Real>
+Real reproducible_nrm2(const std::vector<Real>& x, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	return reproducible_nrm2(x.data(), x.size(), nrOfThreads);
+}
+
+}  // namespace ieee
+
+}  // namespace sw
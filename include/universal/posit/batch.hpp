@@ -0,0 +1,779 @@
+#pragma once
+// batch.hpp: element-wise arithmetic on arrays of posit<16,1> and posit<32,2>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../bitblock/limbs.hpp"
+#include "../utility/span.hpp"
+#include "native_engine.hpp"
+
+// The batch API applies an operator to every element of posit arrays:
+//
+//   sw::unum::batch::add(a, b, out, n);        out[i] = a[i] + b[i]
+//   sw::unum::batch::fma(a, b, c, out, n);     out[i] = a[i] * b[i] + c[i] with a single rounding
+//   sw::unum::batch::less(a, b, mask, n);      mask[i] = a[i] < b[i] ? 1 : 0
+//
+// The operators also take spans, which must all have the same size, and std::vectors.
+//
+// On x86-64 processors with AVX2 the arithmetic operators decode, compute, and round the elements without
+// data-dependent branches in four 64-bit SIMD lanes per vector, which hold the exact products and aligned sums;
+// an iteration runs four vectors of posit<16,1> or two of posit<32,2>. negate, abs, and the comparisons work
+// on the encodings in packed 16-bit or 32-bit lanes, 16 posit<16,1> or 8 posit<32,2> per vector.
+// The instruction set is selected at runtime, and the scalar fallback uses the posit operators.
+// Both paths produce the same encodings as the scalar posit operators.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define POSIT_BATCH_AVX2 1
+#define POSIT_BATCH_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define POSIT_BATCH_AVX2 1
+#define POSIT_BATCH_TARGET_AVX2
+#else
+#define POSIT_BATCH_AVX2 0
+#endif
+
+namespace sw {
+	namespace unum {
+		namespace batch {
+
+			// instruction set used by the batch operators
+			enum class isa { scalar, avx2 };
+
+			namespace detail {
+
+				// the batch operators are implemented for the standard posit<16,1> and posit<32,2>
+				template<size_t nbits, size_t es>
+				struct supported {
+					static constexpr bool value = (nbits == 16 && es == 1) || (nbits == 32 && es == 2);
+				};
+
+				template<size_t nbits>
+				using storage_t = typename std::conditional<(nbits <= 16), uint16_t, uint32_t>::type;
+
+				// posit arrays can be processed in place when a posit is just its encoding
+				template<size_t nbits, size_t es>
+				struct raw_layout {
+					static constexpr bool value = sizeof(posit<nbits, es>) == sizeof(storage_t<nbits>) && std::is_trivially_copyable<posit<nbits, es>>::value;
+				};
+
+				inline isa detect_isa() {
+#if POSIT_BATCH_AVX2
+#if defined(_MSC_VER)
+					int info[4];
+					__cpuid(info, 0);
+					if (info[0] < 7) return isa::scalar;
+					__cpuid(info, 1);
+					bool osxsave = (info[2] & (1 << 27)) != 0;
+					bool avx = (info[2] & (1 << 28)) != 0;
+					if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return isa::scalar;
+					__cpuidex(info, 7, 0);
+					return (info[1] & (1 << 5)) ? isa::avx2 : isa::scalar;
+#else
+					__builtin_cpu_init();
+					return __builtin_cpu_supports("avx2") ? isa::avx2 : isa::scalar;
+#endif
+#else
+					return isa::scalar;
+#endif
+				}
+
+				inline isa& selected_isa() {
+					static isa selected = detect_isa();
+					return selected;
+				}
+
+				// fused multiply-add on encodings: a * b + c rounded once
+				template<size_t nbits, size_t es>
+				uint64_t scalar_fma(uint64_t a, uint64_t b, uint64_t c) {
+					using engine = native_engine<nbits, es>;
+					if (engine::isnar(a) || engine::isnar(b) || engine::isnar(c)) return engine::sign_mask;
+					if (engine::iszero(a) || engine::iszero(b)) return c;
+					bool sa, sb, sc;
+					int xa, xb, xc;
+					uint64_t fa, fb, fc;
+					engine::decode(a, sa, xa, fa);
+					engine::decode(b, sb, xb, fb);
+					// the exact product in the upper two limbs with its msb at bit 190
+					uint64_t x[3] = { 0, 0, 0 };
+					x[1] = mul64x64(fa, fb, x[2]);
+					unsigned msb = 191 - clz64(x[2]);
+					limbs_shr<3>(x, msb - 190);
+					int ex = xa + xb + int(msb) - 190;
+					bool sx = sa ^ sb;
+					if (engine::iszero(c)) return engine::encode(sx, ex, x[2] << 1, x[1] != 0);
+					engine::decode(c, sc, xc, fc);
+					uint64_t y[3] = { 0, 0, fc >> 1 };
+					int ey = xc;
+					// order the operands by magnitude and align the smaller one
+					if (ey > ex || (ey == ex && limbs_compare<3>(y, x) > 0)) {
+						for (size_t i = 0; i < 3; ++i) std::swap(x[i], y[i]);
+						std::swap(ex, ey);
+						std::swap(sx, sc);
+					}
+					bool sticky = limbs_shr<3>(y, size_t(ex - ey));
+					uint64_t sum[3];
+					if (sx == sc) {
+						limbs_add<3>(sum, x, y);
+					}
+					else {
+						limbs_sub<3>(sum, x, y);
+						if (sticky) limbs_decrement<3>(sum);
+						if (limbs_iszero<3>(sum)) return 0;
+					}
+					unsigned lz = limbs_clz<3>(sum);
+					limbs_shl<3>(sum, lz);
+					sticky |= (sum[1] | sum[0]) != 0;
+					return engine::encode(sx, ex + 1 - int(lz), sum[2], sticky);
+				}
+
+#if POSIT_BATCH_AVX2
+				// AVX2 kernels: four posits are widened into 64-bit lanes, which leaves room for
+				// the exact products and aligned sums of posit<32,2> significands
+				namespace avx2 {
+
+					POSIT_BATCH_TARGET_AVX2 inline __m256i set1(long long v) { return _mm256_set1_epi64x(v); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i select(__m256i mask, __m256i t, __m256i f) { return _mm256_blendv_epi8(f, t, mask); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i is_set(__m256i x) { return _mm256_andnot_si256(_mm256_cmpeq_epi64(x, _mm256_setzero_si256()), set1(-1)); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i nonzero_bit(__m256i x) { return _mm256_andnot_si256(_mm256_cmpeq_epi64(x, _mm256_setzero_si256()), set1(1)); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i max0(__m256i x) { return select(_mm256_cmpgt_epi64(x, _mm256_setzero_si256()), x, _mm256_setzero_si256()); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i low_mask(__m256i n) { return _mm256_sub_epi64(_mm256_sllv_epi64(set1(1), n), set1(1)); }
+
+					// integers below 2^52 convert exactly to and from double through the exponent of 2^52
+					POSIT_BATCH_TARGET_AVX2 inline __m256d to_double(__m256i x) {
+						const __m256i magic = set1(0x4330000000000000ll);
+						return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(x, magic)), _mm256_castsi256_pd(magic));
+					}
+					POSIT_BATCH_TARGET_AVX2 inline __m256i to_integer(__m256d d) {
+						const __m256i magic = set1(0x4330000000000000ll);
+						return _mm256_xor_si256(_mm256_castpd_si256(_mm256_add_pd(d, _mm256_castsi256_pd(magic))), magic);
+					}
+					// index of the most significant set bit of x < 2^52, -1023 for zero
+					POSIT_BATCH_TARGET_AVX2 inline __m256i msb52(__m256i x) {
+						return _mm256_sub_epi64(_mm256_srli_epi64(_mm256_castpd_si256(to_double(x)), 52), set1(1023));
+					}
+					// index of the most significant set bit of 0 < x < 2^64
+					POSIT_BATCH_TARGET_AVX2 inline __m256i msb64(__m256i x) {
+						__m256i hi = _mm256_srli_epi64(x, 32);
+						__m256i lo = _mm256_and_si256(x, set1(0xFFFFFFFFll));
+						return select(_mm256_cmpeq_epi64(hi, _mm256_setzero_si256()), msb52(lo), _mm256_add_epi64(msb52(hi), set1(32)));
+					}
+
+					template<size_t nbits, size_t es>
+					struct lanes {
+						static constexpr int fbits = int(nbits) - 3 - int(es);
+						static constexpr int P = fbits + 2;   // fraction bits carried into the rounding: guard and round bits
+						static constexpr int maxscale = (int(nbits) - 2) << es;
+						static constexpr long long mask = (1ll << nbits) - 1;
+						static constexpr long long body_mask = (1ll << (nbits - 1)) - 1;
+						static constexpr long long nar = 1ll << (nbits - 1);
+
+						static POSIT_BATCH_TARGET_AVX2 __m256i load(const storage_t<nbits>* p) {
+							return load_lanes(p);
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i load_lanes(const uint16_t* p) {
+							return _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i load_lanes(const uint32_t* p) {
+							return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+						}
+						static POSIT_BATCH_TARGET_AVX2 void store(storage_t<nbits>* p, __m256i v) {
+							store_lanes(p, _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6))));
+						}
+						static POSIT_BATCH_TARGET_AVX2 void store_lanes(uint16_t* p, __m128i v) {
+							_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_shuffle_epi8(v, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1)));
+						}
+						static POSIT_BATCH_TARGET_AVX2 void store_lanes(uint32_t* p, __m128i v) {
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+						}
+
+						// decode encodings that are neither zero nor NaR into sign mask, scale, and significand with the hidden bit at fbits
+						static POSIT_BATCH_TARGET_AVX2 void decode(__m256i x, __m256i& neg, __m256i& scale, __m256i& sig) {
+							const __m256i zero = _mm256_setzero_si256();
+							const __m256i one = set1(1);
+							neg = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_srli_epi64(x, nbits - 1), one), one);
+							__m256i u = _mm256_and_si256(select(neg, _mm256_sub_epi64(zero, x), x), set1(body_mask));
+							// the regime run ends at the most significant bit that differs from the first regime bit
+							__m256i r0 = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_srli_epi64(u, nbits - 2), one), one);
+							__m256i w = select(r0, _mm256_xor_si256(u, set1(body_mask)), u);
+							__m256i t = msb52(w);
+							t = select(_mm256_cmpgt_epi64(t, set1(-1)), t, set1(-1));  // the run fills the posit
+							__m256i m = _mm256_sub_epi64(set1(nbits - 2), t);
+							__m256i k = select(r0, _mm256_sub_epi64(m, one), _mm256_sub_epi64(zero, m));
+							// the bits below the regime termination hold the exponent and fraction, left align them
+							__m256i remaining = max0(t);
+							__m256i y = _mm256_sllv_epi64(_mm256_and_si256(u, low_mask(remaining)), _mm256_sub_epi64(set1(nbits - 3), remaining));
+							scale = _mm256_add_epi64(_mm256_slli_epi64(k, es), _mm256_srli_epi64(y, fbits));
+							sig = _mm256_or_si256(_mm256_and_si256(y, set1((1ll << fbits) - 1)), set1(1ll << fbits));
+						}
+
+						// round sign, scale, and significand with the hidden bit at P, plus a 0/1 sticky lane, to the nearest encoding
+						static POSIT_BATCH_TARGET_AVX2 __m256i encode(__m256i neg, __m256i scale, __m256i sig, __m256i sticky) {
+							const __m256i zero = _mm256_setzero_si256();
+							const __m256i one = set1(1);
+							constexpr long long bias = 1ll << 20;  // arithmetic shift of the scale through a positive bias
+							__m256i k = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_add_epi64(scale, set1(bias)), es), set1(bias >> es));
+							__m256i e = _mm256_and_si256(scale, set1((1ll << es) - 1));
+							__m256i kpos = _mm256_cmpgt_epi64(k, set1(-1));
+							__m256i run = select(kpos, _mm256_add_epi64(k, one), _mm256_sub_epi64(zero, k));
+							__m256i regime = select(kpos, _mm256_slli_epi64(low_mask(run), 1), one);
+							// regime, exponent, and fraction as one bit string of rl + es + P bits
+							__m256i bits = _mm256_or_si256(_mm256_slli_epi64(regime, es + P), _mm256_or_si256(_mm256_slli_epi64(e, P), _mm256_and_si256(sig, set1((1ll << P) - 1))));
+							__m256i length = _mm256_add_epi64(run, set1(1 + es + P));
+							__m256i sh = _mm256_sub_epi64(length, set1(nbits - 1));
+							__m256i shg = _mm256_sub_epi64(sh, one);
+							__m256i body = _mm256_srlv_epi64(bits, sh);
+							__m256i guard = _mm256_and_si256(_mm256_srlv_epi64(bits, shg), one);
+							sticky = _mm256_or_si256(sticky, nonzero_bit(_mm256_and_si256(bits, low_mask(shg))));
+							body = _mm256_add_epi64(body, _mm256_and_si256(guard, _mm256_or_si256(sticky, _mm256_and_si256(body, one))));
+							// posits saturate at maxpos and minpos
+							body = select(_mm256_cmpgt_epi64(scale, set1(maxscale)), set1(body_mask), body);
+							body = select(_mm256_cmpgt_epi64(set1(-maxscale), scale), one, body);
+							return select(neg, _mm256_and_si256(_mm256_sub_epi64(zero, body), set1(mask)), body);
+						}
+
+						// shift a significand with its msb at position msb to the hidden bit position P
+						static POSIT_BATCH_TARGET_AVX2 __m256i normalize(__m256i v, __m256i msb, __m256i& sticky) {
+							__m256i rs = _mm256_sub_epi64(msb, set1(P));
+							__m256i right = max0(rs);
+							__m256i left = max0(_mm256_sub_epi64(_mm256_setzero_si256(), rs));
+							sticky = _mm256_or_si256(sticky, nonzero_bit(_mm256_and_si256(v, low_mask(right))));
+							return _mm256_srlv_epi64(_mm256_sllv_epi64(v, left), right);
+						}
+
+						// add two values with significands x and y that have their msb at bit 61
+						static POSIT_BATCH_TARGET_AVX2 __m256i add_aligned(__m256i nx, __m256i ex, __m256i x, __m256i ny, __m256i ey, __m256i y) {
+							const __m256i one = set1(1);
+							__m256i swap = _mm256_or_si256(_mm256_cmpgt_epi64(ey, ex), _mm256_and_si256(_mm256_cmpeq_epi64(ex, ey), _mm256_cmpgt_epi64(y, x)));
+							__m256i nbig = select(swap, ny, nx), nsmall = select(swap, nx, ny);
+							__m256i ebig = select(swap, ey, ex), esmall = select(swap, ex, ey);
+							__m256i big = select(swap, y, x), small = select(swap, x, y);
+							__m256i d = _mm256_sub_epi64(ebig, esmall);
+							__m256i sticky = nonzero_bit(_mm256_and_si256(small, low_mask(d)));
+							small = _mm256_srlv_epi64(small, d);
+							// the shifted out bits reduce a difference below the truncated result
+							__m256i same = _mm256_cmpeq_epi64(nbig, nsmall);
+							__m256i sum = select(same, _mm256_add_epi64(big, small), _mm256_sub_epi64(_mm256_sub_epi64(big, small), sticky));
+							__m256i cancel = _mm256_cmpeq_epi64(sum, _mm256_setzero_si256());
+							__m256i msb = msb64(select(cancel, one, sum));
+							__m256i scale = _mm256_add_epi64(ebig, _mm256_sub_epi64(msb, set1(61)));
+							__m256i sig = normalize(sum, msb, sticky);
+							return _mm256_andnot_si256(cancel, encode(nbig, scale, sig, sticky));
+						}
+
+						static POSIT_BATCH_TARGET_AVX2 __m256i is_nar(__m256i x) { return _mm256_cmpeq_epi64(x, set1(nar)); }
+						static POSIT_BATCH_TARGET_AVX2 __m256i is_zero(__m256i x) { return _mm256_cmpeq_epi64(x, _mm256_setzero_si256()); }
+						// an operand that is zero or NaR is replaced by one to keep the decoder in range
+						static POSIT_BATCH_TARGET_AVX2 __m256i regular(__m256i x) { return select(_mm256_or_si256(is_zero(x), is_nar(x)), set1(1ll << (nbits - 2)), x); }
+
+						static POSIT_BATCH_TARGET_AVX2 __m256i add(__m256i a, __m256i b) {
+							__m256i na, xa, ma, nb, xb, mb;
+							decode(regular(a), na, xa, ma);
+							decode(regular(b), nb, xb, mb);
+							__m256i r = add_aligned(na, xa, _mm256_slli_epi64(ma, 61 - fbits), nb, xb, _mm256_slli_epi64(mb, 61 - fbits));
+							r = select(is_zero(b), a, r);
+							r = select(is_zero(a), b, r);
+							return select(_mm256_or_si256(is_nar(a), is_nar(b)), set1(nar), r);
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i sub(__m256i a, __m256i b) {
+							return add(a, _mm256_and_si256(_mm256_sub_epi64(_mm256_setzero_si256(), b), set1(mask)));
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i mul(__m256i a, __m256i b) {
+							__m256i na, xa, ma, nb, xb, mb;
+							decode(regular(a), na, xa, ma);
+							decode(regular(b), nb, xb, mb);
+							__m256i product = _mm256_mul_epu32(ma, mb);
+							__m256i msb = _mm256_add_epi64(set1(2 * fbits), _mm256_and_si256(_mm256_srli_epi64(product, 2 * fbits + 1), set1(1)));
+							__m256i scale = _mm256_add_epi64(_mm256_add_epi64(xa, xb), _mm256_sub_epi64(msb, set1(2 * fbits)));
+							__m256i sticky = _mm256_setzero_si256();
+							__m256i sig = normalize(product, msb, sticky);
+							__m256i r = encode(_mm256_xor_si256(na, nb), scale, sig, sticky);
+							r = _mm256_andnot_si256(_mm256_or_si256(is_zero(a), is_zero(b)), r);
+							return select(_mm256_or_si256(is_nar(a), is_nar(b)), set1(nar), r);
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i div(__m256i a, __m256i b) {
+							constexpr int s = P + 1;   // the quotient carries P + 1 or P + 2 bits
+							const __m256i one = set1(1);
+							__m256i na, xa, ma, nb, xb, mb;
+							decode(regular(a), na, xa, ma);
+							decode(regular(b), nb, xb, mb);
+							// the double quotient of the exact operands is within one of the integer quotient
+							__m256d dn = _mm256_mul_pd(to_double(ma), _mm256_set1_pd(double(1ll << s)));
+							__m256i q = to_integer(_mm256_floor_pd(_mm256_div_pd(dn, to_double(mb))));
+							__m256i r = _mm256_sub_epi64(_mm256_slli_epi64(ma, s), _mm256_mul_epu32(q, mb));
+							__m256i under = _mm256_cmpgt_epi64(_mm256_setzero_si256(), r);
+							q = select(under, _mm256_sub_epi64(q, one), q);
+							r = select(under, _mm256_add_epi64(r, mb), r);
+							__m256i over = _mm256_cmpgt_epi64(r, _mm256_sub_epi64(mb, one));
+							q = select(over, _mm256_add_epi64(q, one), q);
+							r = select(over, _mm256_sub_epi64(r, mb), r);
+							__m256i sticky = nonzero_bit(r);
+							__m256i msb = _mm256_add_epi64(set1(s - 1), _mm256_and_si256(_mm256_srli_epi64(q, s), one));
+							__m256i scale = _mm256_add_epi64(_mm256_sub_epi64(xa, xb), _mm256_sub_epi64(msb, set1(s)));
+							__m256i sig = normalize(q, msb, sticky);
+							__m256i result = encode(_mm256_xor_si256(na, nb), scale, sig, sticky);
+							result = _mm256_andnot_si256(is_zero(a), result);
+							return select(_mm256_or_si256(_mm256_or_si256(is_nar(a), is_nar(b)), is_zero(b)), set1(nar), result);
+						}
+						static POSIT_BATCH_TARGET_AVX2 __m256i fma(__m256i a, __m256i b, __m256i c) {
+							__m256i na, xa, ma, nb, xb, mb, nc, xc, mc;
+							decode(regular(a), na, xa, ma);
+							decode(regular(b), nb, xb, mb);
+							decode(regular(c), nc, xc, mc);
+							// the exact product and the addend with their msb at bit 61
+							__m256i product = _mm256_mul_epu32(ma, mb);
+							__m256i msb = _mm256_add_epi64(set1(2 * fbits), _mm256_and_si256(_mm256_srli_epi64(product, 2 * fbits + 1), set1(1)));
+							__m256i x = _mm256_sllv_epi64(product, _mm256_sub_epi64(set1(61), msb));
+							__m256i ex = _mm256_add_epi64(_mm256_add_epi64(xa, xb), _mm256_sub_epi64(msb, set1(2 * fbits)));
+							__m256i czero = is_zero(c);
+							__m256i y = _mm256_andnot_si256(czero, _mm256_slli_epi64(mc, 61 - fbits));
+							__m256i ey = select(czero, set1(-(1ll << 16)), xc);
+							__m256i r = add_aligned(_mm256_xor_si256(na, nb), ex, x, nc, ey, y);
+							r = select(_mm256_or_si256(is_zero(a), is_zero(b)), c, r);
+							return select(_mm256_or_si256(_mm256_or_si256(is_nar(a), is_nar(b)), is_nar(c)), set1(nar), r);
+						}
+					};
+
+					// posit<16,1> encodings in 16-bit lanes and posit<32,2> encodings in 32-bit lanes
+					POSIT_BATCH_TARGET_AVX2 inline __m256i negate(__m256i x, uint16_t) { return _mm256_sub_epi16(_mm256_setzero_si256(), x); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i negate(__m256i x, uint32_t) { return _mm256_sub_epi32(_mm256_setzero_si256(), x); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i absolute(__m256i x, uint16_t) { return _mm256_abs_epi16(x); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i absolute(__m256i x, uint32_t) { return _mm256_abs_epi32(x); }
+					// posits order as two's complement integers
+					POSIT_BATCH_TARGET_AVX2 inline __m256i less(__m256i a, __m256i b, uint16_t) { return _mm256_cmpgt_epi16(b, a); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i less(__m256i a, __m256i b, uint32_t) { return _mm256_cmpgt_epi32(b, a); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i equal(__m256i a, __m256i b, uint16_t) { return _mm256_cmpeq_epi16(a, b); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i equal(__m256i a, __m256i b, uint32_t) { return _mm256_cmpeq_epi32(a, b); }
+					// store lane masks as 0/1 bytes
+					POSIT_BATCH_TARGET_AVX2 inline void store_mask(uint8_t* mask, __m256i m, uint16_t) {
+						__m256i bytes = _mm256_permute4x64_epi64(_mm256_packs_epi16(m, _mm256_setzero_si256()), 0xD8);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(mask), _mm_and_si128(_mm256_castsi256_si128(bytes), _mm_set1_epi8(1)));
+					}
+					POSIT_BATCH_TARGET_AVX2 inline void store_mask(uint8_t* mask, __m256i m, uint32_t) {
+						__m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(m, _mm256_setzero_si256()), 0xD8);
+						__m128i bytes = _mm_packs_epi16(_mm256_castsi256_si128(words), _mm_setzero_si128());
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(mask), _mm_and_si128(bytes, _mm_set1_epi8(1)));
+					}
+
+					enum class opcode { add, sub, mul, div };
+
+					template<size_t nbits, size_t es, opcode op>
+					POSIT_BATCH_TARGET_AVX2 size_t binary(const storage_t<nbits>* a, const storage_t<nbits>* b, storage_t<nbits>* out, size_t n) {
+						using L = lanes<nbits, es>;
+						constexpr size_t step = 256 / nbits;
+						size_t i = 0;
+						for (; i + step <= n; i += step) {
+							for (size_t j = i; j < i + step; j += 4) {
+								__m256i x = L::load(a + j), y = L::load(b + j), r;
+								switch (op) {
+								case opcode::add: r = L::add(x, y); break;
+								case opcode::sub: r = L::sub(x, y); break;
+								case opcode::mul: r = L::mul(x, y); break;
+								default:          r = L::div(x, y); break;
+								}
+								L::store(out + j, r);
+							}
+						}
+						return i;
+					}
+					template<size_t nbits, size_t es>
+					POSIT_BATCH_TARGET_AVX2 size_t fma(const storage_t<nbits>* a, const storage_t<nbits>* b, const storage_t<nbits>* c, storage_t<nbits>* out, size_t n) {
+						using L = lanes<nbits, es>;
+						constexpr size_t step = 256 / nbits;
+						size_t i = 0;
+						for (; i + step <= n; i += step) {
+							for (size_t j = i; j < i + step; j += 4) {
+								L::store(out + j, L::fma(L::load(a + j), L::load(b + j), L::load(c + j)));
+							}
+						}
+						return i;
+					}
+					template<typename Storage>
+					POSIT_BATCH_TARGET_AVX2 size_t negate(const Storage* a, Storage* out, size_t n, bool absolute_value) {
+						constexpr size_t step = 32 / sizeof(Storage);
+						size_t i = 0;
+						for (; i + step <= n; i += step) {
+							__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+							__m256i r = absolute_value ? absolute(x, Storage()) : negate(x, Storage());
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+						}
+						return i;
+					}
+					template<typename Storage>
+					POSIT_BATCH_TARGET_AVX2 size_t compare(const Storage* a, const Storage* b, uint8_t* mask, size_t n, bool lt, bool eq) {
+						constexpr size_t step = 32 / sizeof(Storage);
+						size_t i = 0;
+						for (; i + step <= n; i += step) {
+							__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+							__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+							__m256i m = _mm256_setzero_si256();
+							if (lt) m = _mm256_or_si256(m, less(x, y, Storage()));
+							if (eq) m = _mm256_or_si256(m, equal(x, y, Storage()));
+							store_mask(mask + i, m, Storage());
+						}
+						return i;
+					}
+
+				} // namespace avx2
+#endif // POSIT_BATCH_AVX2
+
+				// the operators work on encodings: posits that are not laid out as their encoding are staged through a buffer
+				constexpr size_t staging_size = 256;
+
+				template<size_t nbits, size_t es>
+				void gather(const posit<nbits, es>* p, storage_t<nbits>* raw, size_t n) {
+					for (size_t i = 0; i < n; ++i) raw[i] = storage_t<nbits>(p[i].get().to_ullong());
+				}
+				template<size_t nbits, size_t es>
+				void scatter(const storage_t<nbits>* raw, posit<nbits, es>* p, size_t n) {
+					for (size_t i = 0; i < n; ++i) p[i].set_raw_bits(raw[i]);
+				}
+
+				// apply a kernel on encodings to posit arrays, the kernel returns the number of elements it processed
+				template<size_t nbits, size_t es, typename Kernel>
+				size_t apply(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* out, size_t n, Kernel kernel, std::true_type) {
+					using raw_t = storage_t<nbits>;
+					return kernel(reinterpret_cast<const raw_t*>(a), reinterpret_cast<const raw_t*>(b), reinterpret_cast<const raw_t*>(c), reinterpret_cast<raw_t*>(out), n);
+				}
+				template<size_t nbits, size_t es, typename Kernel>
+				size_t apply(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* out, size_t n, Kernel kernel, std::false_type) {
+					using raw_t = storage_t<nbits>;
+					raw_t x[staging_size], y[staging_size], z[staging_size], r[staging_size];
+					size_t done = 0;
+					while (done < n) {
+						size_t count = (n - done < staging_size ? n - done : staging_size);
+						gather(a + done, x, count);
+						if (b) gather(b + done, y, count);
+						if (c) gather(c + done, z, count);
+						size_t processed = kernel(x, y, z, r, count);
+						scatter(r, out + done, processed);
+						done += processed;
+						if (processed < count) break;   // the remainder is left to the scalar loop
+					}
+					return done;
+				}
+				template<size_t nbits, size_t es, typename Kernel>
+				size_t apply(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* out, size_t n, Kernel kernel) {
+					return apply(a, b, c, out, n, kernel, std::integral_constant<bool, raw_layout<nbits, es>::value>());
+				}
+
+			} // namespace detail
+
+			// instruction set detected on this processor
+			inline isa detected_isa() { return detail::detect_isa(); }
+			// instruction set used by the batch operators
+			inline isa active_isa() { return detail::selected_isa(); }
+			// select the instruction set, a request for an instruction set that is not available selects the scalar operators
+			inline void select_isa(isa requested) {
+				detail::selected_isa() = (requested == isa::avx2 && detail::detect_isa() != isa::avx2) ? isa::scalar : requested;
+			}
+
+#if POSIT_BATCH_AVX2
+#define POSIT_BATCH_BINARY_KERNEL(op) \
+			[](const raw_t* x, const raw_t* y, const raw_t*, raw_t* z, size_t count) { return detail::avx2::binary<nbits, es, detail::avx2::opcode::op>(x, y, z, count); }
+#endif
+
+			// out[i] = a[i] + b[i]
+			template<size_t nbits, size_t es>
+			void add(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) i = detail::apply(a, b, (const posit<nbits, es>*)nullptr, out, n, POSIT_BATCH_BINARY_KERNEL(add));
+#endif
+				for (; i < n; ++i) out[i] = a[i] + b[i];
+			}
+
+			// out[i] = a[i] - b[i]
+			template<size_t nbits, size_t es>
+			void sub(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) i = detail::apply(a, b, (const posit<nbits, es>*)nullptr, out, n, POSIT_BATCH_BINARY_KERNEL(sub));
+#endif
+				for (; i < n; ++i) out[i] = a[i] - b[i];
+			}
+
+			// out[i] = a[i] * b[i]
+			template<size_t nbits, size_t es>
+			void mul(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) i = detail::apply(a, b, (const posit<nbits, es>*)nullptr, out, n, POSIT_BATCH_BINARY_KERNEL(mul));
+#endif
+				for (; i < n; ++i) out[i] = a[i] * b[i];
+			}
+
+			// out[i] = a[i] / b[i]
+			template<size_t nbits, size_t es>
+			void div(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) i = detail::apply(a, b, (const posit<nbits, es>*)nullptr, out, n, POSIT_BATCH_BINARY_KERNEL(div));
+#endif
+				for (; i < n; ++i) out[i] = a[i] / b[i];
+			}
+
+			// out[i] = a[i] * b[i] + c[i] with a single rounding
+			template<size_t nbits, size_t es>
+			void fma(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				using raw_t = detail::storage_t<nbits>;
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				if (active_isa() == isa::avx2) {
+					i = detail::apply(a, b, c, out, n, [](const raw_t* x, const raw_t* y, const raw_t* z, raw_t* r, size_t count) { return detail::avx2::fma<nbits, es>(x, y, z, r, count); });
+				}
+#endif
+				for (; i < n; ++i) {
+					uint64_t r = detail::scalar_fma<nbits, es>(a[i].get().to_ullong(), b[i].get().to_ullong(), c[i].get().to_ullong());
+					out[i].set_raw_bits(raw_t(r));
+				}
+			}
+
+			// out[i] = -a[i]
+			template<size_t nbits, size_t es>
+			void negate(const posit<nbits, es>* a, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) {
+					i = detail::apply(a, a, a, out, n, [](const raw_t* x, const raw_t*, const raw_t*, raw_t* r, size_t count) { return detail::avx2::negate(x, r, count, false); });
+				}
+#endif
+				for (; i < n; ++i) out[i] = -a[i];
+			}
+
+			// out[i] = |a[i]|
+			template<size_t nbits, size_t es>
+			void abs(const posit<nbits, es>* a, posit<nbits, es>* out, size_t n) {
+				static_assert(detail::supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+				size_t i = 0;
+#if POSIT_BATCH_AVX2
+				using raw_t = detail::storage_t<nbits>;
+				if (active_isa() == isa::avx2) {
+					i = detail::apply(a, a, a, out, n, [](const raw_t* x, const raw_t*, const raw_t*, raw_t* r, size_t count) { return detail::avx2::negate(x, r, count, true); });
+				}
+#endif
+				for (; i < n; ++i) out[i] = a[i].isneg() ? -a[i] : a[i];
+			}
+
+			namespace detail {
+				template<size_t nbits, size_t es>
+				void compare(const posit<nbits, es>* a, const posit<nbits, es>* b, uint8_t* mask, size_t n, bool lt, bool eq) {
+					static_assert(supported<nbits, es>::value, "batch operators are provided for posit<16,1> and posit<32,2>");
+					size_t i = 0;
+#if POSIT_BATCH_AVX2
+					using raw_t = storage_t<nbits>;
+					if (active_isa() == isa::avx2) {
+						if (raw_layout<nbits, es>::value) {
+							i = avx2::compare(reinterpret_cast<const raw_t*>(a), reinterpret_cast<const raw_t*>(b), mask, n, lt, eq);
+						}
+						else {
+							raw_t x[staging_size], y[staging_size];
+							while (i + staging_size <= n) {
+								gather(a + i, x, staging_size);
+								gather(b + i, y, staging_size);
+								i += avx2::compare(x, y, mask + i, staging_size, lt, eq);
+							}
+						}
+					}
+#endif
+					for (; i < n; ++i) mask[i] = uint8_t((lt && a[i] < b[i]) || (eq && a[i] == b[i]));
+				}
+			}
+
+			// mask[i] = a[i] < b[i]
+			template<size_t nbits, size_t es>
+			void less(const posit<nbits, es>* a, const posit<nbits, es>* b, uint8_t* mask, size_t n) {
+				detail::compare(a, b, mask, n, true, false);
+			}
+			// mask[i] = a[i] <= b[i]
+			template<size_t nbits, size_t es>
+			void less_equal(const posit<nbits, es>* a, const posit<nbits, es>* b, uint8_t* mask, size_t n) {
+				detail::compare(a, b, mask, n, true, true);
+			}
+			// mask[i] = a[i] == b[i]
+			template<size_t nbits, size_t es>
+			void equal(const posit<nbits, es>* a, const posit<nbits, es>* b, uint8_t* mask, size_t n) {
+				detail::compare(a, b, mask, n, false, true);
+			}
+
+			namespace detail {
+				inline void require_size(size_t size, size_t expected, const char* op) {
+					if (size != expected) throw std::invalid_argument(std::string("batch::") + op + ": the operands differ in size");
+				}
+			}
+
+			// std::vector interface: the operands must have the same size, and the output is resized to it
+			template<size_t nbits, size_t es>
+			void add(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<posit<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "add");
+				out.resize(a.size());
+				add(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void sub(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<posit<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "sub");
+				out.resize(a.size());
+				sub(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void mul(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<posit<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "mul");
+				out.resize(a.size());
+				mul(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void div(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<posit<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "div");
+				out.resize(a.size());
+				div(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void fma(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, const std::vector<posit<nbits, es>>& c, std::vector<posit<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "fma");
+				detail::require_size(c.size(), a.size(), "fma");
+				out.resize(a.size());
+				fma(a.data(), b.data(), c.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void negate(const std::vector<posit<nbits, es>>& a, std::vector<posit<nbits, es>>& out) {
+				out.resize(a.size());
+				negate(a.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void abs(const std::vector<posit<nbits, es>>& a, std::vector<posit<nbits, es>>& out) {
+				out.resize(a.size());
+				abs(a.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void less(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<uint8_t>& mask) {
+				detail::require_size(b.size(), a.size(), "less");
+				mask.resize(a.size());
+				less(a.data(), b.data(), mask.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void less_equal(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<uint8_t>& mask) {
+				detail::require_size(b.size(), a.size(), "less_equal");
+				mask.resize(a.size());
+				less_equal(a.data(), b.data(), mask.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void equal(const std::vector<posit<nbits, es>>& a, const std::vector<posit<nbits, es>>& b, std::vector<uint8_t>& mask) {
+				detail::require_size(b.size(), a.size(), "equal");
+				mask.resize(a.size());
+				equal(a.data(), b.data(), mask.data(), a.size());
+			}
+
+			namespace detail {
+				// a span operand views posits of the type of the output
+				template<typename T, size_t nbits, size_t es>
+				struct operand_of {
+					static constexpr bool value = std::is_same<typename std::remove_const<T>::type, posit<nbits, es>>::value;
+				};
+				template<typename T>
+				struct is_posit : std::false_type {};
+				template<size_t nbits, size_t es>
+				struct is_posit< posit<nbits, es> > : std::true_type {};
+			}
+
+			// span interface: every operand must have the size of the output
+			template<typename TA, typename TB, size_t nbits, size_t es>
+			void add(span<TA> a, span<TB> b, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value && detail::operand_of<TB, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "add");
+				detail::require_size(b.size(), out.size(), "add");
+				add(a.data(), b.data(), out.data(), out.size());
+			}
+			template<typename TA, typename TB, size_t nbits, size_t es>
+			void sub(span<TA> a, span<TB> b, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value && detail::operand_of<TB, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "sub");
+				detail::require_size(b.size(), out.size(), "sub");
+				sub(a.data(), b.data(), out.data(), out.size());
+			}
+			template<typename TA, typename TB, size_t nbits, size_t es>
+			void mul(span<TA> a, span<TB> b, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value && detail::operand_of<TB, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "mul");
+				detail::require_size(b.size(), out.size(), "mul");
+				mul(a.data(), b.data(), out.data(), out.size());
+			}
+			template<typename TA, typename TB, size_t nbits, size_t es>
+			void div(span<TA> a, span<TB> b, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value && detail::operand_of<TB, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "div");
+				detail::require_size(b.size(), out.size(), "div");
+				div(a.data(), b.data(), out.data(), out.size());
+			}
+			template<typename TA, typename TB, typename TC, size_t nbits, size_t es>
+			void fma(span<TA> a, span<TB> b, span<TC> c, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value && detail::operand_of<TB, nbits, es>::value && detail::operand_of<TC, nbits, es>::value,
+					"batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "fma");
+				detail::require_size(b.size(), out.size(), "fma");
+				detail::require_size(c.size(), out.size(), "fma");
+				fma(a.data(), b.data(), c.data(), out.data(), out.size());
+			}
+			template<typename TA, size_t nbits, size_t es>
+			void negate(span<TA> a, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "negate");
+				negate(a.data(), out.data(), out.size());
+			}
+			template<typename TA, size_t nbits, size_t es>
+			void abs(span<TA> a, span<posit<nbits, es>> out) {
+				static_assert(detail::operand_of<TA, nbits, es>::value, "batch operands must have the posit type of the output");
+				detail::require_size(a.size(), out.size(), "abs");
+				abs(a.data(), out.data(), out.size());
+			}
+			template<typename TA, typename TB>
+			void less(span<TA> a, span<TB> b, span<uint8_t> mask) {
+				using Posit = typename std::remove_const<TA>::type;
+				static_assert(detail::is_posit<Posit>::value && std::is_same<typename std::remove_const<TB>::type, Posit>::value, "batch comparisons require two spans of the same posit type");
+				detail::require_size(a.size(), mask.size(), "less");
+				detail::require_size(b.size(), mask.size(), "less");
+				less(a.data(), b.data(), mask.data(), mask.size());
+			}
+			template<typename TA, typename TB>
+			void less_equal(span<TA> a, span<TB> b, span<uint8_t> mask) {
+				using Posit = typename std::remove_const<TA>::type;
+				static_assert(detail::is_posit<Posit>::value && std::is_same<typename std::remove_const<TB>::type, Posit>::value, "batch comparisons require two spans of the same posit type");
+				detail::require_size(a.size(), mask.size(), "less_equal");
+				detail::require_size(b.size(), mask.size(), "less_equal");
+				less_equal(a.data(), b.data(), mask.data(), mask.size());
+			}
+			template<typename TA, typename TB>
+			void equal(span<TA> a, span<TB> b, span<uint8_t> mask) {
+				using Posit = typename std::remove_const<TA>::type;
+				static_assert(detail::is_posit<Posit>::value && std::is_same<typename std::remove_const<TB>::type, Posit>::value, "batch comparisons require two spans of the same posit type");
+				detail::require_size(a.size(), mask.size(), "equal");
+				detail::require_size(b.size(), mask.size(), "equal");
+				equal(a.data(), b.data(), mask.data(), mask.size());
+			}
+
+#if POSIT_BATCH_AVX2
+#undef POSIT_BATCH_BINARY_KERNEL
+#endif
+
+		} // namespace batch
+	} // namespace unum
+} // namespace sw
@@ -0,0 +1,1305 @@
+#pragma once
+// decimal.hpp: exact conversion of posits to and from decimal text
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <ostream>
+#include <string>
+#include "../bitblock/limbs.hpp"
+#include "limb_engine.hpp"
+#include "native_engine.hpp"
+
+// A posit is a dyadic rational, so its decimal expansion is finite and can be generated exactly
+// with integer arithmetic. The digits are generated with the free-format algorithm of Steele & White
+// and Burger & Dybvig: the value and its rounding interval are scaled into integers r/s, m-/s, m+/s,
+// and the digit loop stops as soon as the digits written so far identify the posit. The rounding interval
+// of a posit is bounded by the posits of nbits+1 bits that sit between it and its neighbors, and a tie
+// rounds to the even encoding, so the interval is closed for even encodings and open for odd ones.
+//
+// The integers are fixed capacity limb arrays sized for the dynamic range of the posit configuration,
+// so no memory is allocated, and the arithmetic only touches the limbs in use: for posits up to 64 bits
+// the integers are a couple of limbs wide, the wide posits use the same code on longer limb arrays.
+//
+// Decimal text is rounded into a posit from its leading digits, enough of them to leave at most one
+// rounding boundary between the leading digits and the next decimal unit. Those few digits fit in
+// 64-bit integer arithmetic for the common literals. When more digits follow, the text is compared
+// digit by digit with the exact decimal expansion of that boundary, so that any literal rounds correctly.
+
+namespace sw {
+namespace unum {
+
+template<size_t nbits, size_t es> class posit;
+
+// unsigned integer on a fixed capacity little-endian limb array that tracks the number of limbs in use
+template<size_t N>
+class decimal_bignum {
+public:
+	decimal_bignum() : _size(0) {}
+
+	void assign(uint64_t v) {
+		_limb[0] = v;
+		_size = (v != 0 ? 1 : 0);
+	}
+	void assign(const uint64_t* a, size_t n) {
+		for (size_t i = 0; i < n; ++i) _limb[i] = a[i];
+		_size = n;
+		trim();
+	}
+	void assign(const decimal_bignum& b) {
+		for (size_t i = 0; i < b._size; ++i) _limb[i] = b._limb[i];
+		_size = b._size;
+	}
+	bool iszero() const { return _size == 0; }
+	size_t size() const { return _size; }
+	const uint64_t* data() const { return _limb; }
+
+	// this <<= shift
+	void shl(size_t shift) {
+		if (_size == 0) return;
+		size_t limbs = shift >> 6, bits = shift & 63;
+		if (bits != 0) {
+			uint64_t carry = _limb[_size - 1] >> (64 - bits);
+			for (size_t i = _size - 1; i > 0; --i) _limb[i] = (_limb[i] << bits) | (_limb[i - 1] >> (64 - bits));
+			_limb[0] <<= bits;
+			if (carry != 0) _limb[_size++] = carry;
+		}
+		if (limbs != 0) {
+			for (size_t i = _size; i-- > 0; ) _limb[i + limbs] = _limb[i];
+			for (size_t i = 0; i < limbs; ++i) _limb[i] = 0;
+			_size += limbs;
+		}
+	}
+	// this *= m
+	void mul(uint64_t m) {
+		uint64_t carry = 0;
+		for (size_t i = 0; i < _size; ++i) {
+			uint64_t hi;
+			uint64_t lo = mul64x64(_limb[i], m, hi);
+			lo += carry;
+			carry = hi + (lo < carry ? 1 : 0);
+			_limb[i] = lo;
+		}
+		if (carry != 0) _limb[_size++] = carry;
+	}
+	// this *= 10^k
+	void mul_pow10(unsigned k) {
+		static constexpr uint64_t pow10_19 = 10000000000000000000ull;
+		for (; k >= 19; k -= 19) mul(pow10_19);
+		uint64_t m = 1;
+		for (; k > 0; --k) m *= 10;
+		if (m != 1) mul(m);
+	}
+	// this += b
+	void add(const decimal_bignum& b) {
+		size_t n = (_size > b._size ? _size : b._size);
+		uint64_t carry = 0;
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t a = (i < _size ? _limb[i] : 0);
+			uint64_t s = a + carry;
+			carry = (s < a ? 1 : 0);
+			if (i < b._size) {
+				s += b._limb[i];
+				carry += (s < b._limb[i] ? 1 : 0);
+			}
+			_limb[i] = s;
+		}
+		_size = n;
+		if (carry != 0) _limb[_size++] = carry;
+	}
+	// this -= b, requires this >= b
+	void sub(const decimal_bignum& b) {
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < _size; ++i) {
+			uint64_t bi = (i < b._size ? b._limb[i] : 0);
+			uint64_t d = _limb[i] - bi;
+			uint64_t nb = (_limb[i] < bi ? 1 : 0);
+			nb += (d < borrow ? 1 : 0);
+			_limb[i] = d - borrow;
+			borrow = nb;
+		}
+		trim();
+	}
+	// quotient of this / s when it is less than 10, the remainder is left in this
+	unsigned divmod_digit(const decimal_bignum& s) {
+		if (_size < s._size) return 0;
+		// estimate the quotient from the leading 64 bits of s and the bits of this at the same position:
+		// the estimate is at most one too small
+		size_t n = s._size;
+		unsigned lz = clz64(s._limb[n - 1]);
+		uint64_t stop = s._limb[n - 1] << lz;
+		if (lz != 0 && n > 1) stop |= s._limb[n - 2] >> (64 - lz);
+		uint64_t hi = (_size > n ? _limb[n] : 0), lo = _limb[n - 1];
+		if (lz != 0) {
+			hi = (hi << lz) | (lo >> (64 - lz));
+			lo = (lo << lz) | (n > 1 ? _limb[n - 2] >> (64 - lz) : 0);
+		}
+		uint64_t q = 0;
+		if (stop != ~uint64_t(0)) {
+			uint64_t rem;
+			q = (hi < stop + 1 ? div128by64(hi, lo, stop + 1, rem) : 9);
+		}
+		if (q > 0) submul(s, q);
+		while (compare(*this, s) >= 0) {
+			sub(s);
+			++q;
+		}
+		return unsigned(q);
+	}
+
+	// this -= q * b, requires this >= q * b
+	void submul(const decimal_bignum& b, uint64_t q) {
+		uint64_t borrow = 0, carry = 0;
+		for (size_t i = 0; i < _size; ++i) {
+			uint64_t hi = 0;
+			uint64_t lo = (i < b._size ? mul64x64(b._limb[i], q, hi) : 0);
+			lo += carry;
+			carry = hi + (lo < carry ? 1 : 0);
+			uint64_t d = _limb[i] - lo;
+			uint64_t nb = (_limb[i] < lo ? 1 : 0);
+			nb += (d < borrow ? 1 : 0);
+			_limb[i] = d - borrow;
+			borrow = nb;
+		}
+		trim();
+	}
+
+	// sign of a - b
+	friend int compare(const decimal_bignum& a, const decimal_bignum& b) {
+		if (a._size != b._size) return (a._size < b._size ? -1 : 1);
+		for (size_t i = a._size; i-- > 0; ) {
+			if (a._limb[i] != b._limb[i]) return (a._limb[i] < b._limb[i] ? -1 : 1);
+		}
+		return 0;
+	}
+
+private:
+	uint64_t _limb[N];
+	size_t   _size;
+
+	void trim() {
+		while (_size > 0 && _limb[_size - 1] == 0) --_size;
+	}
+};
+
+// the value of a positive posit<nbits, es> encoding that is neither zero nor NaR, and the boundaries of its rounding interval.
+// Each is an integer significand with its trailing zeros removed and the binary exponent of its least significant bit.
+template<size_t nbits, size_t es>
+struct decimal_boundaries {
+	using wide = limb_engine<nbits + 1, es>;                 // posits of nbits+1 bits hold the rounding boundaries
+	static constexpr size_t nlimbs = nr_limbs(nbits);
+	static constexpr size_t flimbs = wide::flimbs;
+
+	uint64_t v[flimbs], lo[flimbs], hi[flimbs];
+	int  ev, elo, ehi;
+	int  scale;          // scale of the value
+	bool ismaxpos;       // anything beyond maxpos rounds to maxpos: there is no upper boundary
+	bool isminpos;       // anything between zero and minpos rounds to minpos: the lower boundary is zero
+	bool inclusive;      // a tie rounds to the even encoding, so the interval of an even encoding is closed
+
+	explicit decimal_boundaries(const uint64_t* raw) : ev(0), elo(0), ehi(0), scale(0) {
+		uint64_t next[nlimbs];
+		for (size_t i = 0; i < nlimbs; ++i) next[i] = raw[i];
+		limbs_increment<nlimbs>(next);
+		ismaxpos = limbs_test<nlimbs>(next, nbits - 1);
+		isminpos = (raw[0] == 1) && limbs_clz<nlimbs>(raw) == 64 * nlimbs - 1;
+		inclusive = (raw[0] & 0x1) == 0;
+
+		// the value is the wider encoding 2*raw, the boundaries are 2*raw - 1 and 2*raw + 1
+		uint64_t ext[wide::nlimbs];
+		for (size_t i = 0; i < wide::nlimbs; ++i) ext[i] = (i < nlimbs ? raw[i] : 0);
+		limbs_shl<wide::nlimbs>(ext, 1);
+		decode(ext, v, ev, std::integral_constant<bool, native_engine_supported<nbits + 1, es>::value>());
+		scale = ev;
+		ext[0] |= 1;
+		decode(ext, hi, ehi, std::integral_constant<bool, native_engine_supported<nbits + 1, es>::value>());
+		ext[0] &= ~uint64_t(1);
+		uint64_t one[wide::nlimbs] = { 1 };
+		limbs_sub<wide::nlimbs>(ext, ext, one);
+		decode(ext, lo, elo, std::integral_constant<bool, native_engine_supported<nbits + 1, es>::value>());
+		ev = strip(v, ev);
+		ehi = strip(hi, ehi);
+		elo = strip(lo, elo);
+	}
+
+private:
+	// decode into a left aligned significand and its scale
+	static void decode(const uint64_t* ext, uint64_t* sig, int& e, std::true_type) {
+		bool sign = false;
+		native_engine<nbits + 1, es>::decode(ext[0], sign, e, sig[0]);
+	}
+	static void decode(const uint64_t* ext, uint64_t* sig, int& e, std::false_type) {
+		typename wide::triple t;
+		wide::decode(ext, t);
+		for (size_t i = 0; i < flimbs; ++i) sig[i] = t.sig[i];
+		e = t.scale;
+	}
+	// shift a left aligned significand right over its trailing zeros and
+	// return the binary exponent of its least significant bit
+	static int strip(uint64_t* sig, int scale) {
+		unsigned tz = 0;
+		size_t i = 0;
+		while (i < flimbs && sig[i] == 0) { tz += 64; ++i; }
+		if (i < flimbs) tz += 63 - clz64(sig[i] & (~sig[i] + 1));   // position of the lowest set bit
+		limbs_shr<flimbs>(sig, tz);
+		return scale - int(64 * flimbs - 1) + int(tz);
+	}
+};
+
+namespace internal {
+	// Grisu3 of Florian Loitsch, "Printing floating-point numbers quickly and accurately with integers", PLDI 2010,
+	// on the rounding interval of a posit instead of the interval of an IEEE-754 double.
+	// The digits are generated from a 64-bit approximation of the scaled value and boundaries,
+	// and the algorithm reports when the approximation cannot certify the shortest and closest digits.
+
+	// a 64-bit significand and a binary exponent: f * 2^e
+	struct diy_fp {
+		uint64_t f;
+		int      e;
+	};
+
+	// the 64 most significant bits of the product, rounded
+	inline diy_fp diy_multiply(const diy_fp& a, const diy_fp& b) {
+		uint64_t hi;
+		uint64_t lo = mul64x64(a.f, b.f, hi);
+		hi += (lo >> 63);
+		return diy_fp{ hi, a.e + b.e + 64 };
+	}
+
+	// normalized powers of ten 10^k for k = -348, -340, ..., 340, rounded to 64 bits
+	struct cached_power {
+		uint64_t significand;
+		int16_t  binary_exponent;
+		int16_t  decimal_exponent;
+	};
+	static const cached_power cached_powers[] = {
+	{ 0xfa8fd5a0081c0288ull, -1220, -348 },
+	{ 0xbaaee17fa23ebf76ull, -1193, -340 },
+	{ 0x8b16fb203055ac76ull, -1166, -332 },
+	{ 0xcf42894a5dce35eaull, -1140, -324 },
+	{ 0x9a6bb0aa55653b2dull, -1113, -316 },
+	{ 0xe61acf033d1a45dfull, -1087, -308 },
+	{ 0xab70fe17c79ac6caull, -1060, -300 },
+	{ 0xff77b1fcbebcdc4full, -1034, -292 },
+	{ 0xbe5691ef416bd60cull, -1007, -284 },
+	{ 0x8dd01fad907ffc3cull,  -980, -276 },
+	{ 0xd3515c2831559a83ull,  -954, -268 },
+	{ 0x9d71ac8fada6c9b5ull,  -927, -260 },
+	{ 0xea9c227723ee8bcbull,  -901, -252 },
+	{ 0xaecc49914078536dull,  -874, -244 },
+	{ 0x823c12795db6ce57ull,  -847, -236 },
+	{ 0xc21094364dfb5637ull,  -821, -228 },
+	{ 0x9096ea6f3848984full,  -794, -220 },
+	{ 0xd77485cb25823ac7ull,  -768, -212 },
+	{ 0xa086cfcd97bf97f4ull,  -741, -204 },
+	{ 0xef340a98172aace5ull,  -715, -196 },
+	{ 0xb23867fb2a35b28eull,  -688, -188 },
+	{ 0x84c8d4dfd2c63f3bull,  -661, -180 },
+	{ 0xc5dd44271ad3cdbaull,  -635, -172 },
+	{ 0x936b9fcebb25c996ull,  -608, -164 },
+	{ 0xdbac6c247d62a584ull,  -582, -156 },
+	{ 0xa3ab66580d5fdaf6ull,  -555, -148 },
+	{ 0xf3e2f893dec3f126ull,  -529, -140 },
+	{ 0xb5b5ada8aaff80b8ull,  -502, -132 },
+	{ 0x87625f056c7c4a8bull,  -475, -124 },
+	{ 0xc9bcff6034c13053ull,  -449, -116 },
+	{ 0x964e858c91ba2655ull,  -422, -108 },
+	{ 0xdff9772470297ebdull,  -396, -100 },
+	{ 0xa6dfbd9fb8e5b88full,  -369,  -92 },
+	{ 0xf8a95fcf88747d94ull,  -343,  -84 },
+	{ 0xb94470938fa89bcfull,  -316,  -76 },
+	{ 0x8a08f0f8bf0f156bull,  -289,  -68 },
+	{ 0xcdb02555653131b6ull,  -263,  -60 },
+	{ 0x993fe2c6d07b7facull,  -236,  -52 },
+	{ 0xe45c10c42a2b3b06ull,  -210,  -44 },
+	{ 0xaa242499697392d3ull,  -183,  -36 },
+	{ 0xfd87b5f28300ca0eull,  -157,  -28 },
+	{ 0xbce5086492111aebull,  -130,  -20 },
+	{ 0x8cbccc096f5088ccull,  -103,  -12 },
+	{ 0xd1b71758e219652cull,   -77,   -4 },
+	{ 0x9c40000000000000ull,   -50,    4 },
+	{ 0xe8d4a51000000000ull,   -24,   12 },
+	{ 0xad78ebc5ac620000ull,     3,   20 },
+	{ 0x813f3978f8940984ull,    30,   28 },
+	{ 0xc097ce7bc90715b3ull,    56,   36 },
+	{ 0x8f7e32ce7bea5c70ull,    83,   44 },
+	{ 0xd5d238a4abe98068ull,   109,   52 },
+	{ 0x9f4f2726179a2245ull,   136,   60 },
+	{ 0xed63a231d4c4fb27ull,   162,   68 },
+	{ 0xb0de65388cc8ada8ull,   189,   76 },
+	{ 0x83c7088e1aab65dbull,   216,   84 },
+	{ 0xc45d1df942711d9aull,   242,   92 },
+	{ 0x924d692ca61be758ull,   269,  100 },
+	{ 0xda01ee641a708deaull,   295,  108 },
+	{ 0xa26da3999aef774aull,   322,  116 },
+	{ 0xf209787bb47d6b85ull,   348,  124 },
+	{ 0xb454e4a179dd1877ull,   375,  132 },
+	{ 0x865b86925b9bc5c2ull,   402,  140 },
+	{ 0xc83553c5c8965d3dull,   428,  148 },
+	{ 0x952ab45cfa97a0b3ull,   455,  156 },
+	{ 0xde469fbd99a05fe3ull,   481,  164 },
+	{ 0xa59bc234db398c25ull,   508,  172 },
+	{ 0xf6c69a72a3989f5cull,   534,  180 },
+	{ 0xb7dcbf5354e9beceull,   561,  188 },
+	{ 0x88fcf317f22241e2ull,   588,  196 },
+	{ 0xcc20ce9bd35c78a5ull,   614,  204 },
+	{ 0x98165af37b2153dfull,   641,  212 },
+	{ 0xe2a0b5dc971f303aull,   667,  220 },
+	{ 0xa8d9d1535ce3b396ull,   694,  228 },
+	{ 0xfb9b7cd9a4a7443cull,   720,  236 },
+	{ 0xbb764c4ca7a44410ull,   747,  244 },
+	{ 0x8bab8eefb6409c1aull,   774,  252 },
+	{ 0xd01fef10a657842cull,   800,  260 },
+	{ 0x9b10a4e5e9913129ull,   827,  268 },
+	{ 0xe7109bfba19c0c9dull,   853,  276 },
+	{ 0xac2820d9623bf429ull,   880,  284 },
+	{ 0x80444b5e7aa7cf85ull,   907,  292 },
+	{ 0xbf21e44003acdd2dull,   933,  300 },
+	{ 0x8e679c2f5e44ff8full,   960,  308 },
+	{ 0xd433179d9c8cb841ull,   986,  316 },
+	{ 0x9e19db92b4e31ba9ull,  1013,  324 },
+	{ 0xeb96bf6ebadf77d9ull,  1039,  332 },
+	{ 0xaf87023b9bf0ee6bull,  1066,  340 },
+	};
+	static constexpr int cached_powers_offset = 348;        // -1 * the first decimal exponent
+	static constexpr int cached_powers_distance = 8;        // decimal exponent distance between entries
+	static constexpr int grisu_min_exponent = -60;          // binary exponent range of the scaled values
+	static constexpr int grisu_max_exponent = -32;
+
+	// cached power of ten whose product with a normalized significand at binary exponent e lands in the target range
+	inline void grisu_cached_power(int e, diy_fp& power, int& decimal_exponent) {
+		int min_exponent = grisu_min_exponent - (e + 64);
+		int k = int(std::ceil((min_exponent + 63) * 0.30102999566398114));
+		int index = (cached_powers_offset + k - 1) / cached_powers_distance + 1;
+		const cached_power& p = cached_powers[index];
+		power = diy_fp{ p.significand, p.binary_exponent };
+		decimal_exponent = p.decimal_exponent;
+	}
+
+	// move the last digit towards the value while it stays in the safe interval, and certify the result
+	inline bool grisu_round_weed(char* digits, int n, uint64_t distance_too_high_w, uint64_t unsafe_interval,
+		uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+		uint64_t small_distance = distance_too_high_w - unit;
+		uint64_t big_distance = distance_too_high_w + unit;
+		while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+			(rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+			--digits[n - 1];
+			rest += ten_kappa;
+		}
+		if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+			(rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)) {
+			return false;
+		}
+		return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+	}
+
+	// generate the shortest digits of the scaled value w in the interval (low, high): the result is digits * 10^kappa
+	inline bool grisu_digit_gen(diy_fp low, diy_fp w, diy_fp high, char* digits, int& n, int& kappa) {
+		uint64_t unit = 1;
+		diy_fp too_low{ low.f - unit, low.e };
+		diy_fp too_high{ high.f + unit, high.e };
+		uint64_t unsafe_interval = too_high.f - too_low.f;
+		unsigned shift = unsigned(-w.e);
+		uint64_t one = uint64_t(1) << shift;
+		uint32_t integrals = uint32_t(too_high.f >> shift);
+		uint64_t fractionals = too_high.f & (one - 1);
+		uint32_t divisor = 1;
+		kappa = 0;
+		while (divisor <= integrals / 10) { divisor *= 10; ++kappa; }
+		if (integrals != 0) ++kappa;
+		if (integrals == 0) divisor = 0;
+		n = 0;
+		while (kappa > 0 && divisor != 0) {
+			digits[n++] = char('0' + integrals / divisor);
+			integrals %= divisor;
+			--kappa;
+			uint64_t rest = (uint64_t(integrals) << shift) + fractionals;
+			if (rest < unsafe_interval) {
+				return grisu_round_weed(digits, n, too_high.f - w.f, unsafe_interval, rest, uint64_t(divisor) << shift, unit);
+			}
+			divisor /= 10;
+		}
+		for (;;) {
+			fractionals *= 10;
+			unit *= 10;
+			unsafe_interval *= 10;
+			digits[n++] = char('0' + (fractionals >> shift));
+			fractionals &= one - 1;
+			--kappa;
+			if (fractionals < unsafe_interval) {
+				return grisu_round_weed(digits, n, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one, unit);
+			}
+		}
+	}
+}
+
+// decimal digit generation for a positive posit<nbits, es> encoding that is neither zero nor NaR
+template<size_t nbits, size_t es>
+class decimal_converter {
+	using boundaries = decimal_boundaries<nbits, es>;
+	static constexpr size_t flimbs = boundaries::flimbs;
+public:
+	static constexpr int maxscale = int(nbits - 2) * (1 << es);
+	// capacity of the integers: the dynamic range, the significand, and headroom for the digit loop
+	static constexpr size_t blimbs = nr_limbs(size_t(maxscale) + 64 * (flimbs + 3));
+	// upper bound on the number of significant digits of the shortest representation
+	static constexpr int max_shortest_digits = int((64 * flimbs * 30103ull) / 100000) + 2;
+	// upper bound on the number of significant digits of the exact value: a significand times 2^-q
+	// has the digits of the significand times 5^q
+	static constexpr int max_exact_digits = int(((unsigned long long)(nbits) * 30103ull + (unsigned long long)(maxscale + int(nbits)) * 69898ull) / 100000) + 2;
+	// upper bound on the number of decimal exponent digits
+	static constexpr int max_exponent_digits = (maxscale < 300 ? 2 : (maxscale < 3300 ? 3 : (maxscale < 33000 ? 4 : 5)));
+	// the 64-bit approximation of Grisu3 covers posits whose boundaries fit in a 64-bit significand,
+	// and whose dynamic range is covered by the cached powers of ten
+	static constexpr bool grisu = (flimbs == 1) && (maxscale < 1000);
+
+	explicit decimal_converter(const uint64_t* raw) : _b(raw), _scale(_b.scale), _k(0), _inclusive(_b.inclusive), _prepared(false), _initialized(false) {}
+
+	// shortest digit string that rounds back to the posit: returns the number of digits,
+	// the value is 0.d1d2...dn * 10^k
+	int shortest(char* digits, int& k) {
+		int n = 0;
+		if (grisu && fast_shortest(digits, n, k)) return n;
+		initialize();
+		return exact_shortest(digits, k);
+	}
+
+private:
+	boundaries _b;
+	decimal_bignum<blimbs> _r, _s, _mm, _mp, _t;
+	int  _scale;
+	int  _k;
+	bool _inclusive;
+	bool _prepared;
+	bool _initialized;
+
+	// Grisu3 on the value and boundaries at a common binary exponent, returns false when it cannot certify the digits
+	bool fast_shortest(char* digits, int& n, int& k) const {
+		if (_b.ismaxpos || _b.isminpos) return false;
+		int e = _b.elo;
+		if (_b.ev < e) e = _b.ev;
+		if (_b.ehi < e) e = _b.ehi;
+		unsigned hbits = 64 - clz64(_b.hi[0]) + unsigned(_b.ehi - e);
+		if (hbits > 64) return false;
+		unsigned lz = 64 - hbits;
+		internal::diy_fp w{ _b.v[0] << (unsigned(_b.ev - e) + lz), e - int(lz) };
+		internal::diy_fp low{ _b.lo[0] << (unsigned(_b.elo - e) + lz), w.e };
+		internal::diy_fp high{ _b.hi[0] << (unsigned(_b.ehi - e) + lz), w.e };
+		internal::diy_fp power{ 0, 0 };
+		int mk = 0;
+		internal::grisu_cached_power(w.e, power, mk);
+		int kappa = 0;
+		if (!internal::grisu_digit_gen(internal::diy_multiply(low, power), internal::diy_multiply(w, power),
+			internal::diy_multiply(high, power), digits, n, kappa)) return false;
+		// digits * 10^(kappa - mk) = 0.digits * 10^k
+		k = kappa - mk + n;
+		return true;
+	}
+
+	// scale the value and its boundaries into the integers of the exact digit generation
+	void initialize() {
+		if (_initialized) return;
+		_initialized = true;
+		// lowest binary exponent of the three
+		int e = _b.ev;
+		if (!_b.isminpos && _b.elo < e) e = _b.elo;
+		if (!_b.ismaxpos && _b.ehi < e) e = _b.ehi;
+
+		// R, L, and H as integers at binary exponent e
+		decimal_bignum<blimbs> R, L, H;
+		R.assign(_b.v, flimbs);
+		R.shl(size_t(_b.ev - e));
+		if (_b.isminpos) {
+			L.assign(0);
+		}
+		else {
+			L.assign(_b.lo, flimbs);
+			L.shl(size_t(_b.elo - e));
+		}
+		if (_b.ismaxpos) {
+			H.assign(R);       // any upper bound beyond maxpos will do
+			H.shl(1);
+		}
+		else {
+			H.assign(_b.hi, flimbs);
+			H.shl(size_t(_b.ehi - e));
+		}
+
+		// r/s = value, mm/s and mp/s are the distances to the boundaries
+		_mm.assign(R);
+		_mm.sub(L);
+		_mp.assign(H);
+		_mp.sub(R);
+		_r.assign(R);
+		_s.assign(1);
+		if (e >= 0) {
+			_r.shl(size_t(e));
+			_mm.shl(size_t(e));
+			_mp.shl(size_t(e));
+		}
+		else {
+			_s.shl(size_t(-e));
+		}
+	}
+
+public:
+	// decimal exponent k of the value, 10^(k-1) <= value < 10^k
+	int exponent10() {
+		if (_prepared) return _k;
+		initialize();
+		int k = estimate();
+		if (k >= 0) _s.mul_pow10(unsigned(k)); else _r.mul_pow10(unsigned(-k));
+		while (compare(_r, _s) >= 0) {
+			_s.mul(10);
+			++k;
+		}
+		_t.assign(_r);
+		_t.mul(10);
+		while (compare(_t, _s) < 0) {
+			_r.mul(10);
+			_t.mul(10);
+			--k;
+		}
+		_prepared = true;
+		_k = k;
+		return k;
+	}
+
+	// the first n significant digits rounded to nearest even: returns the number of digits written,
+	// which is n, or 1 when a value below the first digit position rounds up, or 0 when it rounds to zero.
+	// The value is 0.d1d2...dn * 10^k
+	int rounded(char* digits, int n, int& k) {
+		k = exponent10();
+		if (n < 0) return 0;
+
+		for (int i = 0; i < n; ++i) {
+			if (_r.iszero()) {
+				digits[i] = '0';
+				continue;
+			}
+			_r.mul(10);
+			digits[i] = char('0' + _r.divmod_digit(_s));
+		}
+		// round to nearest even on the remainder
+		_t.assign(_r);
+		_t.add(_r);
+		int half = compare(_t, _s);
+		bool odd = (n > 0 && ((digits[n - 1] - '0') & 0x1));
+		if (half > 0 || (half == 0 && odd)) {
+			int i = n - 1;
+			while (i >= 0 && digits[i] == '9') digits[i--] = '0';
+			if (i >= 0) {
+				++digits[i];
+			}
+			else {
+				// carry out of the leading digit: 99.9 -> 100
+				digits[0] = '1';
+				for (int j = 1; j < n; ++j) digits[j] = '0';
+				++k;
+				if (n == 0) return 1;
+			}
+		}
+		else if (n == 0) {
+			return 0;
+		}
+		return n;
+	}
+
+	// sign of the decimal 0.d1d2... * 10^x minus the upper boundary of the rounding interval.
+	// The digits come from digits.next(), which returns -1 after the last digit, d1 is not zero.
+	// The posit must not be maxpos, which has no upper boundary
+	template<typename DigitSource>
+	int compare_upper(DigitSource& digits, int x) {
+		initialize();
+		decimal_bignum<blimbs> t, s;
+		t.assign(_r);
+		t.add(_mp);
+		s.assign(_s);
+		// scale the boundary t/s into [0.1, 1) * 10^k
+		int k = estimate();
+		if (k >= 0) s.mul_pow10(unsigned(k)); else t.mul_pow10(unsigned(-k));
+		while (compare(t, s) >= 0) {
+			s.mul(10);
+			++k;
+		}
+		_t.assign(t);
+		_t.mul(10);
+		while (compare(_t, s) < 0) {
+			t.mul(10);
+			_t.mul(10);
+			--k;
+		}
+		if (x != k) return (x < k ? -1 : 1);
+		for (;;) {
+			int d = digits.next();
+			if (d < 0) return (t.iszero() ? 0 : -1);
+			// the digits of the boundary are exhausted: any nonzero digit is above it
+			if (t.iszero()) {
+				if (d != 0) return 1;
+				continue;
+			}
+			t.mul(10);
+			int b = int(t.divmod_digit(s));
+			if (d != b) return (d < b ? -1 : 1);
+		}
+	}
+
+private:
+	// digits of the free-format algorithm on the exact integers
+	int exact_shortest(char* digits, int& k) {
+		k = estimate();
+		if (k >= 0) _s.mul_pow10(unsigned(k)); else { _r.mul_pow10(unsigned(-k)); _mm.mul_pow10(unsigned(-k)); _mp.mul_pow10(unsigned(-k)); }
+		// fix up the estimate so that the upper boundary is below 10^k
+		_t.assign(_r);
+		_t.add(_mp);
+		while (above_high(_t, _s)) {
+			_s.mul(10);
+			++k;
+		}
+		_t.mul(10);
+		while (!above_high(_t, _s)) {
+			_r.mul(10);
+			_mm.mul(10);
+			_mp.mul(10);
+			_t.mul(10);
+			--k;
+		}
+
+		int n = 0;
+		for (;;) {
+			_r.mul(10);
+			_mm.mul(10);
+			_mp.mul(10);
+			unsigned d = _r.divmod_digit(_s);
+			int c = compare(_r, _mm);
+			bool tc1 = (_inclusive ? c <= 0 : c < 0);
+			_t.assign(_r);
+			_t.add(_mp);
+			bool tc2 = above_high(_t, _s);
+			if (!tc1 && !tc2) {
+				digits[n++] = char('0' + d);
+				continue;
+			}
+			if (tc1 && tc2) {
+				// both d and d+1 identify the posit: pick the one closest to the value
+				_t.assign(_r);
+				_t.add(_r);
+				int half = compare(_t, _s);
+				if (half > 0 || (half == 0 && (d & 0x1))) ++d;
+			}
+			else if (tc2) {
+				++d;
+			}
+			digits[n++] = char('0' + d);
+			break;
+		}
+		return n;
+	}
+
+	// estimate of k = ceil(log10(value)), the callers correct it by one
+	int estimate() const {
+		double k = std::ceil(double(_scale) * 0.30102999566398120 - 1.0e-10);
+		return int(k);
+	}
+	// true when r/s reaches the upper boundary of the rounding interval
+	bool above_high(const decimal_bignum<blimbs>& t, const decimal_bignum<blimbs>& s) const {
+		int c = compare(t, s);
+		return (_inclusive ? c >= 0 : c > 0);
+	}
+};
+
+namespace internal {
+	// bounds checked character writer: with a sink, a full buffer is written to the stream instead of failing
+	struct decimal_writer {
+		char* first;
+		char* p;
+		char* last;
+		std::ostream* sink;
+		size_t count;   // characters put, including the ones that did not fit
+		bool  ok;
+		decimal_writer(char* begin, char* end, std::ostream* stream = nullptr) : first(begin), p(begin), last(end), sink(stream), count(0), ok(true) {}
+		void put(char c) {
+			++count;
+			if (p == last) {
+				if (sink == nullptr || first == last) {
+					ok = false;
+					return;
+				}
+				flush();
+			}
+			*p++ = c;
+		}
+		void put(char c, int n) {
+			for (int i = 0; i < n; ++i) put(c);
+		}
+		void put(const char* s, int n) {
+			for (int i = 0; i < n; ++i) put(s[i]);
+		}
+		void exponent(int x, bool uppercase) {
+			put(uppercase ? 'E' : 'e');
+			put(x < 0 ? '-' : '+');
+			unsigned ux = unsigned(x < 0 ? -x : x);
+			char tmp[12];
+			int n = 0;
+			do { tmp[n++] = char('0' + ux % 10); ux /= 10; } while (ux != 0);
+			if (n < 2) tmp[n++] = '0';
+			while (n > 0) put(tmp[--n]);
+		}
+		void flush() {
+			if (sink != nullptr && p != first) sink->write(first, std::streamsize(p - first));
+			p = first;
+		}
+		char* end() const { return ok ? p : nullptr; }
+	};
+
+	// d1.d2...dn e x, with trailing zeros appended up to decimals digits after the point
+	inline void write_scientific(decimal_writer& w, const char* digits, int n, int x, int decimals, bool point, bool uppercase) {
+		w.put(n > 0 ? digits[0] : '0');
+		if (decimals > 0 || point) w.put('.');
+		int frac = (n > 1 ? n - 1 : 0);
+		if (frac > decimals) frac = decimals;
+		w.put(digits + 1, frac);
+		w.put('0', decimals - frac);
+		w.exponent(x, uppercase);
+	}
+
+	// digits placed around the decimal point of 0.d1...dn * 10^k, with trailing zeros up to decimals digits after the point
+	inline void write_fixed(decimal_writer& w, const char* digits, int n, int k, int decimals, bool point) {
+		if (k <= 0) {
+			w.put('0');
+		}
+		else {
+			w.put(digits, (n < k ? n : k));
+			if (n < k) w.put('0', k - n);
+		}
+		if (decimals > 0 || point) w.put('.');
+		int written = 0;
+		if (k < 0) {
+			int zeros = (-k < decimals ? -k : decimals);
+			w.put('0', zeros);
+			written = zeros;
+		}
+		int first = (k > 0 ? k : 0);
+		for (int i = first; i < n && written < decimals; ++i, ++written) w.put(digits[i]);
+		w.put('0', decimals - written);
+	}
+
+	template<size_t nbits, size_t es>
+	inline bool posit_magnitude(const posit<nbits, es>& p, uint64_t* raw) {
+		constexpr size_t nlimbs = nr_limbs(nbits);
+		bitset_to_limbs<nbits, nlimbs>(p.get(), raw);
+		bool sign = limbs_test<nlimbs>(raw, nbits - 1);
+		if (sign) {
+			limbs_twos_complement<nlimbs>(raw);
+			if (nbits % 64) raw[nlimbs - 1] &= (~uint64_t(0)) >> (64 - nbits % 64);
+		}
+		return sign;
+	}
+}
+
+// upper bound on the number of characters the shortest decimal representation of a posit<nbits, es> needs:
+// a sign, the significant digits, a decimal point, up to four leading zeros, and the exponent
+template<size_t nbits, size_t es>
+constexpr size_t max_decimal_chars() {
+	return size_t(decimal_converter<nbits, es>::max_shortest_digits + decimal_converter<nbits, es>::max_exponent_digits + 10);
+}
+
+// write the shortest decimal representation that reads back as the same posit into [first, last)
+// returns the end of the text, or nullptr when the buffer is too small. NaR is written as "nar".
+// Values with a decimal exponent in [-4, 17) are written in fixed notation, the others in scientific notation.
+template<size_t nbits, size_t es>
+inline char* to_chars(char* first, char* last, const posit<nbits, es>& p) {
+	internal::decimal_writer w(first, last);
+	if (p.isnar()) {
+		w.put("nar", 3);
+		return w.end();
+	}
+	if (p.iszero()) {
+		w.put('0');
+		return w.end();
+	}
+	uint64_t raw[nr_limbs(nbits)];
+	bool sign = internal::posit_magnitude(p, raw);
+	decimal_converter<nbits, es> converter(raw);
+	char digits[decimal_converter<nbits, es>::max_shortest_digits];
+	int k = 0;
+	int n = converter.shortest(digits, k);
+	if (sign) w.put('-');
+	int x = k - 1;
+	if (x >= -4 && x < 17) {
+		internal::write_fixed(w, digits, n, k, (n > k ? n - k : 0), false);
+	}
+	else {
+		internal::write_scientific(w, digits, n, x, n - 1, false, false);
+	}
+	return w.end();
+}
+
+namespace internal {
+	// a posit rounded for a floating-point format of an iostream: the digits are generated once,
+	// after which the text can be counted and written any number of times. Digits past the exact
+	// value are zeros, so the digits are held on the stack and the writers append the zeros.
+	template<size_t nbits, size_t es>
+	class decimal_format {
+	public:
+		decimal_format(const posit<nbits, es>& p, std::ios_base::fmtflags flags, std::streamsize precision) : _n(0), _k(1) {
+			_uppercase = (flags & std::ios_base::uppercase) != 0;
+			_point = (flags & std::ios_base::showpoint) != 0;
+			_showpos = (flags & std::ios_base::showpos) != 0;
+			std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+			_fixed = (floatfield == std::ios_base::fixed);
+			_scientific = (floatfield == std::ios_base::scientific);
+			_prec = int(precision < 0 ? 6 : precision);
+			_nar = p.isnar();
+			_sign = false;
+			if (_nar) return;
+			uint64_t raw[nr_limbs(nbits)];
+			_sign = posit_magnitude(p, raw);
+			if (p.iszero()) return;
+			// digits of the rounded value: fixed rounds at a position, the other formats at a number of significant digits
+			decimal_converter<nbits, es> converter(raw);
+			int n = (_fixed ? converter.exponent10() + _prec : (_scientific ? _prec + 1 : (_prec == 0 ? 1 : _prec)));
+			if (n > capacity) n = capacity;
+			_n = converter.rounded(_digits, n, _k);
+		}
+
+		template<typename Writer>
+		void write(Writer& w) const {
+			if (_nar) {
+				w.put(_uppercase ? "NAR" : "nar", 3);
+				return;
+			}
+			if (_sign) w.put('-'); else if (_showpos) w.put('+');
+			if (_fixed) {
+				write_fixed(w, _digits, _n, _k, _prec, _point);
+			}
+			else if (_scientific) {
+				write_scientific(w, _digits, _n, (_n > 0 ? _k - 1 : 0), _prec, _point, _uppercase);
+			}
+			else {
+				// general notation: scientific for exponents below -4 or at least the precision
+				int P = (_prec == 0 ? 1 : _prec);
+				int x = (_n > 0 ? _k - 1 : 0);
+				int m = _n;
+				if (!_point) while (m > 0 && _digits[m - 1] == '0') --m;
+				if (x < -4 || x >= P) {
+					write_scientific(w, _digits, m, x, (_point ? P - 1 : (m > 0 ? m - 1 : 0)), _point, _uppercase);
+				}
+				else {
+					int decimals = (_point ? P - 1 - x : (m > _k ? m - _k : 0));
+					write_fixed(w, _digits, m, (_n > 0 ? _k : 1), decimals, _point);
+				}
+			}
+		}
+
+		// number of characters of the text
+		size_t size() const {
+			decimal_writer counter(nullptr, nullptr);
+			write(counter);
+			return counter.count;
+		}
+
+	private:
+		static constexpr int capacity = decimal_converter<nbits, es>::max_exact_digits;
+		char _digits[capacity];
+		int  _n, _k, _prec;
+		bool _uppercase, _point, _showpos, _fixed, _scientific, _nar, _sign;
+	};
+}
+
+// write a posit like an iostream writes a floating-point value with the given precision and the
+// fixed, scientific, showpos, showpoint, and uppercase format flags, rounding the exact value of the posit.
+// returns the end of the text, or nullptr when the buffer is too small
+template<size_t nbits, size_t es>
+inline char* to_chars(char* first, char* last, const posit<nbits, es>& p, std::ios_base::fmtflags flags, std::streamsize precision) {
+	internal::decimal_writer w(first, last);
+	internal::decimal_format<nbits, es>(p, flags, precision).write(w);
+	return w.end();
+}
+
+// format a posit as a stream would format a floating-point value with the given precision and format flags
+template<size_t nbits, size_t es>
+inline std::string to_decimal_string(const posit<nbits, es>& p, std::ios_base::fmtflags flags, std::streamsize precision) {
+	internal::decimal_format<nbits, es> text(p, flags, precision);
+	std::string txt(text.size(), '\0');
+	internal::decimal_writer w(&txt[0], &txt[0] + txt.size());
+	text.write(w);
+	return txt;
+}
+
+// write a posit to a stream as the stream writes a floating-point value with the given format flags, padded
+// to the width of the stream with its fill character, through a buffer on the stack
+template<size_t nbits, size_t es>
+inline std::ostream& write_decimal(std::ostream& ostr, const posit<nbits, es>& p, std::ios_base::fmtflags flags) {
+	internal::decimal_format<nbits, es> text(p, flags, ostr.precision());
+	std::streamsize width = ostr.width(0);
+	std::streamsize size = std::streamsize(width > 0 ? text.size() : 0);
+	int padding = int(width > size ? width - size : 0);
+	char buffer[128];
+	internal::decimal_writer w(buffer, buffer + sizeof(buffer), &ostr);
+	bool left = (ostr.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+	if (!left) w.put(ostr.fill(), padding);
+	text.write(w);
+	if (left) w.put(ostr.fill(), padding);
+	w.flush();
+	return ostr;
+}
+
+
+namespace internal {
+	// the significant digits of a decimal literal: the value is 0.d1d2...dn * 10^exponent with d1 != 0
+	struct decimal_literal {
+		const char* first;     // first significant digit
+		const char* last;      // end of the significant digits, the decimal point may sit in between
+		int         exponent;
+		// the next digit, or -1 after the last one
+		int next() {
+			if (first < last && *first == '.') ++first;
+			return (first < last ? *first++ - '0' : -1);
+		}
+	};
+
+	inline bool is_decimal_digit(char c) { return c >= '0' && c <= '9'; }
+	inline int hex_digit_value(char c) {
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+	inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
+	inline const char* skip_space(const char* first, const char* last) {
+		while (first < last && is_space(*first)) ++first;
+		return first;
+	}
+	// case insensitive match of a lowercase word: returns the end of the word or nullptr
+	inline const char* match_word(const char* first, const char* last, const char* word) {
+		for (; *word != 0; ++word, ++first) {
+			if (first == last || (*first | 0x20) != *word) return nullptr;
+		}
+		return first;
+	}
+
+	// scan digits[.digits][(e|E)[+|-]digits] with at least one digit in the mantissa: returns the end of the literal
+	// or nullptr. An exponent without digits is not part of the literal.
+	inline const char* scan_decimal(const char* first, const char* last, decimal_literal& lit, bool& zero) {
+		constexpr long long bound = 1ll << 30;   // beyond the range of any posit
+		const char* p = first;
+		long long before = 0;    // digits in front of the decimal point
+		long long leading = 0;   // zeros in front of the first significant digit
+		bool point = false, digits = false;
+		lit.first = lit.last = nullptr;
+		for (; p < last; ++p) {
+			if (*p == '.') {
+				if (point) break;
+				point = true;
+				continue;
+			}
+			if (!is_decimal_digit(*p)) break;
+			digits = true;
+			if (!point) ++before;
+			if (*p != '0') {
+				if (lit.first == nullptr) lit.first = p;
+				lit.last = p + 1;   // trailing zeros are not significant
+			}
+			else if (lit.first == nullptr) {
+				++leading;
+			}
+		}
+		if (!digits) return nullptr;
+		zero = (lit.first == nullptr);
+		long long x = before - leading;
+		if (p < last && (*p == 'e' || *p == 'E')) {
+			const char* q = p + 1;
+			bool negative = false;
+			if (q < last && (*q == '+' || *q == '-')) negative = (*q++ == '-');
+			if (q < last && is_decimal_digit(*q)) {
+				long long e = 0;
+				for (; q < last && is_decimal_digit(*q); ++q) {
+					if (e < bound) e = 10 * e + (*q - '0');
+				}
+				x += (negative ? -e : e);
+				p = q;
+			}
+		}
+		lit.exponent = int(x > bound ? bound : (x < -bound ? -bound : x));
+		return p;
+	}
+
+	// scan the hexadecimal posit format nbits.esxHEX[p] of hex_format into the encoding of a posit<nbits, es>:
+	// returns the end of the text or nullptr. A wider pattern is truncated to its most significant nbits.
+	template<size_t nbits>
+	inline const char* scan_posit_format(const char* first, const char* last, uint64_t* raw) {
+		constexpr size_t nlimbs = nr_limbs(nbits);
+		const char* p = first;
+		size_t nbits_in = 0;
+		if (p == last || !is_decimal_digit(*p)) return nullptr;
+		for (; p < last && is_decimal_digit(*p); ++p) {
+			if (nbits_in < 100000) nbits_in = 10 * nbits_in + size_t(*p - '0');
+		}
+		if (p == last || *p++ != '.') return nullptr;
+		if (p == last || !is_decimal_digit(*p)) return nullptr;
+		while (p < last && is_decimal_digit(*p)) ++p;
+		if (p == last || (*p != 'x' && *p != 'X')) return nullptr;
+		const char* hex = ++p;
+		while (p < last && hex_digit_value(*p) >= 0) ++p;
+		if (p == hex) return nullptr;
+		size_t drop = (nbits_in > nbits ? nbits_in - nbits : 0);
+		limbs_clear<nlimbs>(raw);
+		size_t bit = 4 * size_t(p - hex);
+		for (const char* h = hex; h < p; ++h) {
+			unsigned v = unsigned(hex_digit_value(*h));
+			for (int b = 3; b >= 0; --b) {
+				--bit;
+				if (((v >> b) & 0x1) && bit >= drop && bit - drop < nbits) limbs_set<nlimbs>(raw, bit - drop);
+			}
+		}
+		if (p < last && *p == 'p') ++p;
+		return p;
+	}
+
+	// powers of ten that fit in 64 bits
+	static const uint64_t pow10_64[20] = {
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+		10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+		1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+	};
+
+	// round a left aligned significand of S limbs to the magnitude of a posit
+	template<size_t nbits, size_t es, size_t S>
+	inline void encode_magnitude(int scale, const uint64_t* sig, bool sticky, uint64_t* raw, std::true_type) {
+		for (size_t i = 0; i + 1 < S; ++i) sticky |= (sig[i] != 0);
+		raw[0] = native_engine<nbits, es>::encode(false, scale, sig[S - 1], sticky);
+	}
+	template<size_t nbits, size_t es, size_t S>
+	inline void encode_magnitude(int scale, const uint64_t* sig, bool sticky, uint64_t* raw, std::false_type) {
+		limb_engine<nbits, es>::template encode<S>(false, scale, sig, sticky, raw);
+	}
+
+	// the leading bits of a nonzero integer x[N] into the left aligned significand sig[S]:
+	// returns the position of the msb of x, the bits below the significand are collected in sticky
+	template<size_t N, size_t S>
+	inline int leading_bits(uint64_t* x, uint64_t* sig, bool& sticky) {
+		unsigned lz = limbs_clz<N>(x);
+		limbs_shl<N>(x, lz);
+		for (size_t i = 0; i < S; ++i) sig[S - 1 - i] = (i < N ? x[N - 1 - i] : 0);
+		for (size_t i = 0; i + S < N; ++i) sticky |= (x[i] != 0);
+		return int(64 * N - 1 - lz);
+	}
+
+	// round a positive decimal literal to the magnitude of the nearest posit<nbits, es>
+	template<size_t nbits, size_t es>
+	inline void decimal_to_magnitude(const decimal_literal& lit, uint64_t* raw) {
+		using engine = limb_engine<nbits, es>;
+		using native = std::integral_constant<bool, native_engine_supported<nbits, es>::value>;
+		constexpr size_t nlimbs = engine::nlimbs;
+		constexpr size_t S = nr_limbs(engine::fhbits + 2);                                // the significand and the guard bit
+		constexpr int maxdigits = int((engine::fhbits * 30103ull) / 100000) + 2;          // a decimal unit in the last digit is below the posit ulp
+		constexpr int xmax = int((unsigned long long)(engine::maxscale) * 30103ull / 100000) + 2;
+		constexpr size_t plimbs = nr_limbs(4 * size_t(xmax + maxdigits) + 64 * S + 64);
+
+		limbs_clear<nlimbs>(raw);
+		// values beyond the dynamic range project to maxpos or minpos
+		if (lit.exponent > xmax) {
+			for (size_t i = 0; i < nbits - 1; ++i) limbs_set<nlimbs>(raw, i);
+			return;
+		}
+		if (lit.exponent < -xmax) {
+			raw[0] = 1;
+			return;
+		}
+
+		// the value is (t + tail) * 10^e, with t the integer of the leading digits and 0 <= tail < 1
+		decimal_literal digits = lit;
+		uint64_t t64 = 0;
+		int taken = 0, d = 0;
+		while (taken < 19 && taken < maxdigits && (d = digits.next()) >= 0) {
+			t64 = 10 * t64 + uint64_t(d);
+			++taken;
+		}
+		decimal_bignum<plimbs> t;
+		t.assign(t64);
+		if (taken == 19 && maxdigits > 19) {
+			// the wide posits take more digits than fit in 64 bits
+			decimal_bignum<plimbs> chunk;
+			while (taken < maxdigits) {
+				uint64_t c = 0;
+				int n = 0;
+				while (n < 19 && taken + n < maxdigits && (d = digits.next()) >= 0) {
+					c = 10 * c + uint64_t(d);
+					++n;
+				}
+				if (n == 0) break;
+				t.mul_pow10(unsigned(n));
+				chunk.assign(c);
+				t.add(chunk);
+				taken += n;
+				if (n < 19 && taken < maxdigits) break;
+			}
+		}
+		bool tail = (digits.next() >= 0);   // the trailing zeros are stripped: any digit that remains is significant
+		int e = lit.exponent - taken;
+
+		uint64_t sig[S];
+		for (size_t i = 0; i < S; ++i) sig[i] = 0;
+		bool sticky = tail;
+		int scale = 0;
+		if (taken <= 19 && e >= -19 && e <= 19) {
+			// the common literals: the leading bits of t * 10^e with a 64-bit multiplication or two 128 by 64 bit divisions
+			uint64_t hi = 0, lo = 0;
+			int shift = 0;
+			if (e >= 0) {
+				lo = mul64x64(t64, pow10_64[e], hi);
+			}
+			else {
+				// t / 10^-e = (t << lz) * 2^64 / 10^-e * 2^-(64 + lz)
+				uint64_t P = pow10_64[-e];
+				unsigned lz = clz64(t64);
+				uint64_t n = t64 << lz;
+				hi = n / P;
+				uint64_t rem = n - hi * P, rem2 = 0;
+				lo = div128by64(rem, 0, P, rem2);
+				sticky |= (rem2 != 0);
+				shift = 64 + int(lz);
+			}
+			if (hi != 0) {
+				unsigned lz = clz64(hi);
+				sig[S - 1] = (lz != 0 ? (hi << lz) | (lo >> (64 - lz)) : hi);
+				sticky |= (lz != 0 ? (lo << lz) != 0 : lo != 0);
+				scale = 127 - int(lz) - shift;
+			}
+			else {
+				unsigned lz = clz64(lo);
+				sig[S - 1] = lo << lz;
+				scale = 63 - int(lz) - shift;
+			}
+		}
+		else {
+			uint64_t x[plimbs];
+			if (e >= 0) {
+				t.mul_pow10(unsigned(e));
+				limbs_clear<plimbs>(x);
+				for (size_t i = 0; i < t.size(); ++i) x[i] = t.data()[i];
+				scale = leading_bits<plimbs, S>(x, sig, sticky);
+			}
+			else {
+				// a quotient with more bits than the significand: t * 2^shift / 10^-e
+				decimal_bignum<plimbs> p10;
+				p10.assign(1);
+				p10.mul_pow10(unsigned(-e));
+				int pbits = int(64 * p10.size()) - int(clz64(p10.data()[p10.size() - 1]));
+				int tbits = int(64 * t.size()) - int(clz64(t.data()[t.size() - 1]));
+				int shift = pbits - tbits + int(64 * S) + 1;
+				if (shift < 0) shift = 0;
+				t.shl(size_t(shift));
+				uint64_t y[plimbs], q[plimbs], r[plimbs];
+				limbs_clear<plimbs>(x);
+				limbs_clear<plimbs>(y);
+				for (size_t i = 0; i < t.size(); ++i) x[i] = t.data()[i];
+				for (size_t i = 0; i < p10.size(); ++i) y[i] = p10.data()[i];
+				limbs_divmod<plimbs, plimbs>(x, y, q, r);
+				sticky |= !limbs_iszero<plimbs>(r);
+				scale = leading_bits<plimbs, S>(q, sig, sticky) - shift;
+			}
+		}
+		encode_magnitude<nbits, es, S>(scale, sig, sticky, raw, native());
+
+		if (tail) {
+			// the digits that were left out decide between the posit and its successor: the value sits
+			// above the leading digits and less than a posit ulp above them, so the only boundary it
+			// can cross is the upper boundary of the rounding interval
+			uint64_t next[nlimbs];
+			for (size_t i = 0; i < nlimbs; ++i) next[i] = raw[i];
+			limbs_increment<nlimbs>(next);
+			if (limbs_test<nlimbs>(next, nbits - 1)) return;   // maxpos
+			decimal_converter<nbits, es> converter(raw);
+			decimal_literal all = lit;
+			int c = converter.compare_upper(all, lit.exponent);
+			if (c > 0 || (c == 0 && (raw[0] & 0x1))) {
+				for (size_t i = 0; i < nlimbs; ++i) raw[i] = next[i];
+			}
+		}
+	}
+
+	inline bool is_separator(char c) { return c == ',' || is_space(c); }
+}
+
+// parse a decimal or scientific literal, "nar", or the hexadecimal posit format nbits.esxHEXp of hex_format
+// at the start of [first, last) and round it to the nearest posit. No memory is allocated.
+// Returns the end of the text that was parsed, or nullptr when the text does not start with a number,
+// in which case the posit is left unchanged. NaN and infinity are accepted as NaR.
+template<size_t nbits, size_t es>
+inline const char* from_chars(const char* first, const char* last, posit<nbits, es>& p) {
+	constexpr size_t nlimbs = nr_limbs(nbits);
+	uint64_t raw[nlimbs];
+	const char* end = internal::scan_posit_format<nbits>(first, last, raw);
+	if (end == nullptr) {
+		const char* s = first;
+		bool sign = false;
+		if (s < last && (*s == '+' || *s == '-')) sign = (*s++ == '-');
+		internal::decimal_literal lit;
+		bool zero = false;
+		end = internal::scan_decimal(s, last, lit, zero);
+		if (end == nullptr) {
+			end = internal::match_word(s, last, "nar");
+			if (end == nullptr) end = internal::match_word(s, last, "nan");
+			if (end == nullptr) end = internal::match_word(s, last, "infinity");
+			if (end == nullptr) end = internal::match_word(s, last, "inf");
+			if (end == nullptr) return nullptr;
+			limbs_clear<nlimbs>(raw);
+			limbs_set<nlimbs>(raw, nbits - 1);
+		}
+		else if (zero) {
+			limbs_clear<nlimbs>(raw);
+		}
+		else {
+			internal::decimal_to_magnitude<nbits, es>(lit, raw);
+			if (sign) {
+				limbs_twos_complement<nlimbs>(raw);
+				if (nbits % 64) raw[nlimbs - 1] &= (~uint64_t(0)) >> (64 - nbits % 64);
+			}
+		}
+	}
+	bitblock<nbits> bits;
+	limbs_to_bitset<nbits, nlimbs>(raw, bits);
+	p.set(bits);
+	return end;
+}
+
+// parse the text [txt, txt + length), which must hold a single number surrounded by optional white space
+// returns false when the text is not a number, in which case the posit is left unchanged
+template<size_t nbits, size_t es>
+inline bool parse(const char* txt, size_t length, posit<nbits, es>& p) {
+	const char* last = txt + length;
+	posit<nbits, es> v;
+	const char* end = from_chars(internal::skip_space(txt, last), last, v);
+	if (end == nullptr || internal::skip_space(end, last) != last) return false;
+	p = v;
+	return true;
+}
+
+// parse the numbers in [txt, txt + length), separated by commas, white space, or line breaks, into values[0, capacity)
+// Empty fields are skipped. Returns the number of values parsed: parsing stops at the first field that is not a number,
+// or when the capacity is reached, and stop, when given, receives the position where parsing stopped.
+template<size_t nbits, size_t es>
+inline size_t parse_many(const char* txt, size_t length, posit<nbits, es>* values, size_t capacity, const char** stop = nullptr) {
+	const char* p = txt;
+	const char* last = txt + length;
+	size_t n = 0;
+	for (;;) {
+		while (p < last && internal::is_separator(*p)) ++p;
+		if (p == last || n == capacity) break;
+		posit<nbits, es> v;
+		const char* end = from_chars(p, last, v);
+		if (end == nullptr || (end < last && !internal::is_separator(*end))) break;
+		values[n++] = v;
+		p = end;
+	}
+	if (stop != nullptr) *stop = p;
+	return n;
+}
+
+}  // namespace unum
+}  // namespace sw
@@ -0,0 +1,26 @@
+#pragma once
+// engine_switches.hpp: defaults of the switches that select the arithmetic engine of the generic posit
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// calling environment may define the switches before including <posit> or posit.hpp
+
+// enable the 64-bit limb arithmetic engine for the generic posit<nbits, es>
+// the limb engine produces the same encodings as the bitblock arithmetic modules
+#if !defined(POSIT_LIMB_ARITHMETIC)
+// default is to use the bitblock arithmetic modules
+#define POSIT_LIMB_ARITHMETIC 0
+#endif
+
+// enable the native integer arithmetic engine for the generic posit<nbits, es> with nbits <= 64
+// POSIT_FAST_SPECIALIZATION turns it on together with the fast specializations
+#if !defined(POSIT_FAST_NATIVE_ARITHMETIC)
+#if defined(POSIT_FAST_SPECIALIZATION)
+#define POSIT_FAST_NATIVE_ARITHMETIC 1
+#else
+// default is to use the bitblock arithmetic modules
+#define POSIT_FAST_NATIVE_ARITHMETIC 0
+#endif
+#endif
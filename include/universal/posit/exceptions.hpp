@@ -163,3 +163,9 @@ struct operand_too_small_for_quire
 	operand_too_small_for_quire(const std::string& error = "operand value too small for quire") : quire_exception(error) {}
 };
 
+struct quire_wire_format_error
+	: public quire_exception
+{
+	quire_wire_format_error(const std::string& error = "malformed quire wire format") : quire_exception(error) {}
+};
+
@@ -5,7 +5,10 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <algorithm>
+#include <thread>
 #include <vector>
+#include "../utility/parallel.hpp"
 
 namespace sw {
 	namespace unum {
@@ -29,26 +32,32 @@ Ty dot(size_t n, const std::vector<Ty>& x, size_t incx, const std::vector<Ty>& y
 /// fdp_qc         fused dot product with quire continuation
 /// fdp_stride     fused dot product with non-negative stride
 /// fdp            fused dot product of two vectors
+/// fdp_parallel   fused dot product of two vectors computed by multiple threads
 
 // Fused dot product with quire continuation
 template<typename Qy, typename Vector>
 void fdp_qc(Qy& sum_of_products, size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
 	size_t ix, iy;
 	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		sum_of_products += sw::unum::quire_mul(x[ix], y[iy]);
+		sum_of_products.fma(x[ix], y[iy]);
 	}
 }
 
 // Resolved fused dot product, with the option to control capacity bits in the quire
-template<typename Vector, size_t capacity = 10>
+template<typename Vector, size_t capacity = quire_capacity<Vector::value_type::nbits, Vector::value_type::es, 10>::value>
 typename Vector::value_type fdp_stride(size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
 	constexpr size_t nbits = Vector::value_type::nbits;
 	constexpr size_t es = Vector::value_type::es;
 	quire<nbits, es, capacity> q = 0;
-	size_t ix, iy;
-	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
-		if (sw::unum::_trace_quire_add) std::cout << q << '\n';
+	if (incx == 1 && incy == 1 && n > 0 && !sw::unum::_trace_quire_add) {
+		q.accumulate(&x[0], &y[0], n);
+	}
+	else {
+		size_t ix, iy;
+		for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
+			q.fma(x[ix], y[iy]);
+			if (sw::unum::_trace_quire_add) std::cout << q << '\n';
+		}
 	}
 	typename Vector::value_type sum;
 	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
@@ -59,15 +68,13 @@ typename Vector::value_type fdp_stride(size_t n, const Vector& x, size_t incx, c
 /* Microsoft Visual Studio. --------------------------------- */
 // Specialized resolved fused dot product that assumes unit stride and a standard vector,
 // with the option to control capacity bits in the quire
-template<typename Vector, size_t capacity = 10>
+template<typename Vector, size_t capacity = quire_capacity<Vector::value_type::nbits, Vector::value_type::es, 10>::value>
 typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 	constexpr size_t nbits = Vector::value_type::nbits;
 	constexpr size_t es = Vector::value_type::es;
 	quire<nbits, es, capacity> q = 0;
-	size_t ix, iy, n = size(x);
-	for (ix = 0, iy = 0; ix < n && iy < n; ++ix, ++iy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
-	}
+	size_t n = size(x);
+	if (n > 0) q.accumulate(&x[0], &y[0], n);
 	typename Vector::value_type sum;
 	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
 	return sum;
@@ -75,21 +82,44 @@ typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 #else
 // Specialized resolved fused dot product that assumes unit stride and a standard vector,
 // with the option to control capacity bits in the quire
-template<typename Vector, size_t capacity = 10>
+template<typename Vector, size_t capacity = quire_capacity<Vector::value_type::nbits, Vector::value_type::es, 10>::value>
 typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 	constexpr size_t nbits = Vector::value_type::nbits;
 	constexpr size_t es = Vector::value_type::es;
 	quire<nbits, es, capacity> q = 0;
-	size_t ix, iy, n = x.size();
-	for (ix = 0, iy = 0; ix < n && iy < n; ++ix, ++iy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
-	}
+	size_t n = x.size();
+	if (n > 0) q.accumulate(&x[0], &y[0], n);
 	typename Vector::value_type sum;
 	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
 	return sum;
 }
 #endif
 
+// smallest part of fdp_parallel that is given its own thread
+constexpr size_t fdp_min_elements_per_thread = 4096;
+
+// Resolved fused dot product computed by nrOfThreads threads: each thread accumulates a contiguous
+// part of the vectors into its own quire, and the partial quires are added before the one rounding step.
+// Quire addition is exact, so the result is identical to fdp for any number of threads.
+template<typename Vector, size_t capacity = quire_capacity<Vector::value_type::nbits, Vector::value_type::es, 10>::value>
+typename Vector::value_type fdp_parallel(const Vector& x, const Vector& y, size_t nrOfThreads) {
+	constexpr size_t nbits = Vector::value_type::nbits;
+	constexpr size_t es = Vector::value_type::es;
+	using Quire = quire<nbits, es, capacity>;
+	size_t n = std::min(x.size(), y.size());
+	size_t threads = parallel_thread_count(n, nrOfThreads, fdp_min_elements_per_thread);
+	size_t chunk = (n + threads - 1) / threads;
+	std::vector<Quire> partial(threads);
+	parallel_parts(threads, [&](size_t t) {
+		size_t begin = t * chunk;
+		if (begin < n) partial[t].accumulate(&x[begin], &y[begin], std::min(chunk, n - begin));
+	});
+	for (size_t t = 1; t < threads; ++t) partial[0] += partial[t];
+	typename Vector::value_type sum;
+	convert(partial[0].to_value(), sum);     // one and only rounding step of the fused-dot product
+	return sum;
+}
+
 } // namespace unum
 } // namespace sw
 
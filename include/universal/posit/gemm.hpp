@@ -0,0 +1,312 @@
+#pragma once
+// gemm.hpp: blocked matrix-matrix multiplication of posit matrices with one rounding per element
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../bitblock/limbs.hpp"
+#include "../utility/matrix_view.hpp"
+#include "../utility/parallel.hpp"
+#include "native_engine.hpp"
+
+// gemm(A, B, C) computes C = A * B where every element of C is the fused dot product of a row of A
+// and a column of B: the products are accumulated exactly and rounded once, so each element is
+// identical to fdp of that row and column.
+//
+// C is computed in tiles of at most gemm_mc x gemm_nc elements, and the tiles are split across threads.
+// A tile shrinks until its accumulators fit in gemm_tile_bytes, so that the wide accumulators of the
+// larger posits stay in the L2 cache next to the packed blocks instead of streaming through memory.
+// For each tile the inner dimension is traversed in blocks of gemm_kc: the block of A and the block
+// of B are packed into micro-panels of gemm_mr rows and gemm_nr columns, so the micro-kernel streams
+// both operands from contiguous memory whatever the layout and leading dimension of A and B.
+// Configurations that the native engine supports are decoded once, while packing, into
+// (sign, scale, fraction) operands, and the micro-kernel multiplies the fractions as integers and
+// adds the exact products into lazy-carry fixed-point accumulators with the range of the quire.
+// Other configurations pack posits and accumulate them in quires.
+
+namespace sw {
+	namespace unum {
+
+// blocking of the matrix multiplication
+constexpr size_t gemm_mr = 4;     // rows of a micro-panel of A and of a micro-tile of C
+constexpr size_t gemm_nr = 4;     // columns of a micro-panel of B and of a micro-tile of C
+constexpr size_t gemm_mc = 64;    // largest number of rows of a tile of C
+constexpr size_t gemm_nc = 64;    // largest number of columns of a tile of C
+constexpr size_t gemm_kc = 128;   // inner dimension of a packed block of A and B
+constexpr size_t gemm_tile_bytes = size_t(1) << 17;   // storage of the accumulators of a tile of C
+static_assert(gemm_mc == gemm_nc && gemm_mr == gemm_nr, "the tiles of C are square");
+
+// rows and columns of a tile of C whose accumulators fit in gemm_tile_bytes: a multiple of the micro-tile
+constexpr size_t gemm_tile_side(size_t accumulator_bytes) {
+	size_t side = gemm_mc;
+	while (side > gemm_mr && side * side * accumulator_bytes > gemm_tile_bytes) side -= gemm_mr;
+	return side;
+}
+
+// smallest number of products that is given its own thread
+constexpr size_t gemm_min_products_per_thread = size_t(1) << 18;
+
+// micro-kernel on pre-decoded operands for posit configurations with a native engine
+template<size_t nbits, size_t es, size_t capacity>
+class gemm_decoded_kernel {
+public:
+	using Posit = posit<nbits, es>;
+	using Quire = quire<nbits, es, capacity>;
+	using engine = native_engine<nbits, es>;
+
+	// a decoded posit: the fraction is an integer with the hidden bit at bit fbits, and sign is 0 or -1
+	struct operand {
+		uint64_t sig;
+		int32_t  scale;
+		int32_t  sign;
+	};
+
+	// The accumulator is a quire in 32-bit digits held in 64-bit words that absorb the carries of many
+	// products before they are resolved. A product lands at bit half_range + scale_a + scale_b - 2 fbits
+	// of the quire, which is never below -2 fbits: guard digits below the quire keep every product in range.
+	static constexpr size_t fbits = engine::fbits;
+	static constexpr size_t parts = (2 * engine::fhbits <= 64 ? 2 : 4);              // 32-bit parts of a product
+	static constexpr size_t guard = (2 * fbits + 31) / 32;                           // digits below the quire lsb
+	static constexpr size_t ndigits = (guard + (Quire::qbits + 32) / 32 + parts + 2) & ~size_t(1);
+	static constexpr size_t mlimbs = ndigits / 2;
+	static constexpr int    offset = int(32 * guard + Quire::half_range) - 2 * int(fbits);
+	// every product changes a digit by less than 2^33: resolve the carries before the digits can overflow
+	static constexpr size_t headroom = size_t(1) << 29;
+
+	struct accumulator {
+		int64_t digit[ndigits];
+	};
+
+	static operand zero() { return operand{ 0, 0, 0 }; }
+	static operand decode(const Posit& p) {
+		uint64_t raw = uint64_t(p.encoding());
+		if (engine::isnar(raw)) throw operand_is_nar{};
+		if (engine::iszero(raw)) return zero();
+		bool sign; int scale; uint64_t sig;
+		engine::decode(raw, sign, scale, sig);
+		return operand{ sig >> (64 - engine::fhbits), int32_t(scale), sign ? -1 : 0 };
+	}
+
+	static void clear(accumulator& acc) {
+		for (size_t i = 0; i < ndigits; ++i) acc.digit[i] = 0;
+	}
+	// resolve the carries, leaving the digits in [0, 2^32) and the sign in the top digit
+	static void normalize(accumulator& acc) {
+		for (size_t i = 0; i + 1 < ndigits; ++i) {
+			acc.digit[i + 1] += acc.digit[i] >> 32;
+			acc.digit[i] &= 0xFFFFFFFFll;
+		}
+	}
+
+	// c[i * ldc + j] += sum over p of a[p * gemm_mr + i] * b[p * gemm_nr + j]
+	static void multiply(accumulator* c, size_t ldc, const operand* a, const operand* b, size_t kc) {
+		for (size_t p = 0; p < kc; ++p, a += gemm_mr, b += gemm_nr) {
+			for (size_t i = 0; i < gemm_mr; ++i) {
+				accumulator* row = c + i * ldc;
+				for (size_t j = 0; j < gemm_nr; ++j) add_product(row[j], a[i], b[j]);
+			}
+		}
+	}
+
+	// sign and magnitude of the accumulator: the magnitude has tlimbs limbs and its lsb has weight 2^lsb
+	static constexpr size_t tlimbs = mlimbs;
+	static bool magnitude(const accumulator& acc, uint64_t* m, int& lsb) {
+		int64_t carry = 0;
+		for (size_t i = 0; i < ndigits; i += 2) {
+			int64_t lo = acc.digit[i] + carry;
+			int64_t hi = acc.digit[i + 1] + (lo >> 32);
+			carry = hi >> 32;
+			m[i / 2] = (uint64_t(hi) << 32) | (uint64_t(lo) & 0xFFFFFFFFull);
+		}
+		bool negative = carry < 0;
+		if (negative) limbs_twos_complement<mlimbs>(m);
+		if (int(64 * mlimbs) - int(limbs_clz<mlimbs>(m)) > int(32 * guard + Quire::qbits + 1)) throw operand_too_large_for_quire{};
+		lsb = -int(32 * guard + Quire::half_range);
+		return negative;
+	}
+
+	// round the accumulator to the nearest posit
+	static Posit round(const accumulator& acc) {
+		uint64_t m[mlimbs];
+		int lsb;
+		bool negative = magnitude(acc, m, lsb);
+		Posit p;
+		unsigned lz = limbs_clz<mlimbs>(m);
+		if (lz == 64 * mlimbs) return p.set_raw_bits(0);
+		int scale = int(64 * mlimbs - 1 - lz) + lsb;
+		limbs_shl<mlimbs>(m, lz);
+		bool sticky = false;
+		for (size_t i = 0; i + 1 < mlimbs; ++i) sticky |= (m[i] != 0);
+		return p.set_raw_bits(engine::encode(negative, scale, m[mlimbs - 1], sticky));
+	}
+
+	// add the exact product of two operands: the 32-bit parts of the product are shifted into place and
+	// split over parts + 1 digits, and a negative product is added with a branch-free conditional negation
+	static void add_product(accumulator& acc, const operand& a, const operand& b) {
+		constexpr uint64_t low = 0xFFFFFFFFull;
+		int lsb = offset + a.scale + b.scale;
+		int64_t mask = int64_t(a.sign ^ b.sign);
+		int64_t* d = acc.digit + (lsb >> 5);
+		unsigned shift = unsigned(lsb) & 31;
+		uint64_t part[parts];
+		if (parts == 2) {
+			uint64_t product = a.sig * b.sig;
+			part[0] = product & low;
+			part[1] = product >> 32;
+		}
+		else {
+			uint64_t hi, lo = mul64x64(a.sig, b.sig, hi);
+			part[0] = lo & low;
+			part[1] = lo >> 32;
+			part[parts - 2] = hi & low;
+			part[parts - 1] = hi >> 32;
+		}
+		uint64_t spill = 0;
+		for (size_t k = 0; k < parts; ++k) {
+			uint64_t v = part[k] << shift;
+			d[k] += (int64_t(spill + (v & low)) ^ mask) - mask;
+			spill = v >> 32;
+		}
+		d[parts] += (int64_t(spill) ^ mask) - mask;
+	}
+};
+
+// micro-kernel on packed posits and quires for the configurations without a native engine
+template<size_t nbits, size_t es, size_t capacity>
+class gemm_quire_kernel {
+public:
+	using Posit = posit<nbits, es>;
+	using operand = Posit;
+	using accumulator = quire<nbits, es, capacity>;
+	static constexpr size_t headroom = size_t(-1);
+
+	static operand zero() { return Posit(0); }
+	static operand decode(const Posit& p) {
+		if (p.isnar()) throw operand_is_nar{};
+		return p;
+	}
+	static void clear(accumulator& acc) { acc.reset(); }
+	static void normalize(accumulator&) {}
+	static void multiply(accumulator* c, size_t ldc, const operand* a, const operand* b, size_t kc) {
+		for (size_t p = 0; p < kc; ++p, a += gemm_mr, b += gemm_nr) {
+			for (size_t i = 0; i < gemm_mr; ++i) {
+				accumulator* row = c + i * ldc;
+				for (size_t j = 0; j < gemm_nr; ++j) row[j].fma(a[i], b[j]);
+			}
+		}
+	}
+	static void add_product(accumulator& acc, const operand& a, const operand& b) { acc.fma(a, b); }
+	// the quire value holds every bit of the accumulation
+	static constexpr size_t tlimbs = nr_limbs(accumulator::qbits + 1);
+	static bool magnitude(const accumulator& acc, uint64_t* m, int& lsb) {
+		constexpr size_t qbits = accumulator::qbits;
+		value<qbits> v = acc.to_value();
+		limbs_clear<tlimbs>(m);
+		lsb = 0;
+		if (v.iszero()) return false;
+		bitset_to_limbs<qbits, tlimbs>(v.fraction(), m);
+		limbs_set<tlimbs>(m, qbits);
+		lsb = v.scale() - int(qbits);
+		return v.sign();
+	}
+	static Posit round(const accumulator& acc) {
+		Posit p;
+		convert(acc.to_value(), p);
+		return p;
+	}
+};
+
+// the capacity is clamped to the carry guard bits of the fixed-width standard quires
+template<size_t nbits, size_t es, size_t capacity>
+using gemm_kernel = typename std::conditional<native_engine_supported<nbits, es>::value,
+	gemm_decoded_kernel<nbits, es, quire_capacity<nbits, es, capacity>::value>, gemm_quire_kernel<nbits, es, quire_capacity<nbits, es, capacity>::value>>::type;
+
+// compute the tiles t, t + step, t + 2 step, ... of C = A * B
+template<typename Kernel, typename Posit>
+void gemm_tiles(const matrix_view<const Posit>& A, const matrix_view<const Posit>& B, const matrix_view<Posit>& C, size_t t, size_t step) {
+	using operand = typename Kernel::operand;
+	using accumulator = typename Kernel::accumulator;
+	constexpr size_t mc = gemm_tile_side(sizeof(accumulator)), nc = mc;
+	size_t M = C.rows(), N = C.cols(), K = A.cols();
+	size_t mtiles = (M + mc - 1) / mc, ntiles = (N + nc - 1) / nc;
+	std::vector<accumulator> acc(mc * nc);
+	std::vector<operand> apanel(mc * gemm_kc), bpanel(gemm_kc * nc);
+	for (; t < mtiles * ntiles; t += step) {
+		// consecutive tiles share their columns of C and the block of B
+		size_t i0 = (t % mtiles) * mc, j0 = (t / mtiles) * nc;
+		size_t mb = std::min(mc, M - i0), nb = std::min(nc, N - j0);
+		for (accumulator& a : acc) Kernel::clear(a);
+		size_t pending = 0;
+		for (size_t p0 = 0; p0 < K; p0 += gemm_kc) {
+			size_t kb = std::min(gemm_kc, K - p0);
+			// micro-panels of gemm_mr rows of A and gemm_nr columns of B, padded with zeros
+			for (size_t ir = 0; ir < mb; ir += gemm_mr) {
+				operand* panel = &apanel[ir * kb];
+				for (size_t i = 0; i < gemm_mr; ++i) {
+					if (ir + i < mb) {
+						for (size_t p = 0; p < kb; ++p) panel[p * gemm_mr + i] = Kernel::decode(A(i0 + ir + i, p0 + p));
+					}
+					else {
+						for (size_t p = 0; p < kb; ++p) panel[p * gemm_mr + i] = Kernel::zero();
+					}
+				}
+			}
+			for (size_t jr = 0; jr < nb; jr += gemm_nr) {
+				operand* panel = &bpanel[jr * kb];
+				for (size_t j = 0; j < gemm_nr; ++j) {
+					if (jr + j < nb) {
+						for (size_t p = 0; p < kb; ++p) panel[p * gemm_nr + j] = Kernel::decode(B(p0 + p, j0 + jr + j));
+					}
+					else {
+						for (size_t p = 0; p < kb; ++p) panel[p * gemm_nr + j] = Kernel::zero();
+					}
+				}
+			}
+			for (size_t jr = 0; jr < nb; jr += gemm_nr) {
+				for (size_t ir = 0; ir < mb; ir += gemm_mr) {
+					Kernel::multiply(&acc[ir * nc + jr], nc, &apanel[ir * kb], &bpanel[jr * kb], kb);
+				}
+			}
+			pending += kb;
+			if (pending > Kernel::headroom - gemm_kc) {
+				for (accumulator& a : acc) Kernel::normalize(a);
+				pending = 0;
+			}
+		}
+		// the one and only rounding step of every element
+		for (size_t j = 0; j < nb; ++j) {
+			for (size_t i = 0; i < mb; ++i) C(i0 + i, j0 + j) = Kernel::round(acc[i * nc + j]);
+		}
+	}
+}
+
+// C = A * B for posit matrices of any layout, with nrOfThreads threads computing the tiles of C.
+// Each element of C is the fused dot product of a row of A and a column of B with a single rounding,
+// and the result does not depend on the number of threads.
+template<size_t capacity = 30, typename TA, typename TB, typename Posit>
+void gemm(const matrix_view<TA>& A, const matrix_view<TB>& B, const matrix_view<Posit>& C, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	static_assert(std::is_same<typename std::remove_const<TA>::type, Posit>::value && std::is_same<typename std::remove_const<TB>::type, Posit>::value,
+		"gemm requires A, B, and C to have the same posit type");
+	using Kernel = gemm_kernel<Posit::nbits, Posit::es, capacity>;
+	if (A.rows() != C.rows() || B.cols() != C.cols() || A.cols() != B.rows()) {
+		throw std::invalid_argument("gemm: the dimensions of A, B, and C do not agree");
+	}
+	size_t M = C.rows(), N = C.cols(), K = A.cols();
+	if (M == 0 || N == 0) return;
+	matrix_view<const Posit> a(A), b(B);
+	constexpr size_t side = gemm_tile_side(sizeof(typename Kernel::accumulator));
+	size_t tiles = ((M + side - 1) / side) * ((N + side - 1) / side);
+	size_t threads = parallel_thread_count(M * N * std::max(K, size_t(1)), std::min(nrOfThreads, tiles), gemm_min_products_per_thread);
+	parallel_parts(threads, [&](size_t t) {
+		gemm_tiles<Kernel>(a, b, C, t, threads);
+	});
+}
+
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,206 @@
+#pragma once
+// ieee754.hpp: bit level decomposition and rounding of IEEE-754 binary floating-point values
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "../bitblock/limbs.hpp"
+
+// The posit engines convert from and to float and double on the IEEE-754 bit pattern.
+// A value is decomposed with a few shifts and masks into the (sign, scale, significand) triple
+// with the hidden bit at bit 63 that the engines round from, and a triple is rounded to nearest even
+// onto the IEEE-754 format, including gradual underflow into the subnormals and overflow to infinity.
+// long double has no portable layout: it is decomposed with frexp, and composed with a single ldexp
+// of a significand rounded in integer arithmetic.
+
+// POSIT_CONSTANT_EVALUATED() is true when the compiler evaluates a constant expression.
+// The bit level conversions copy the bit pattern with memcpy, which is not constexpr,
+// so the constexpr conversions use them only at run time. Compilers that cannot tell a constant
+// evaluation, POSIT_HAVE_CONSTANT_EVALUATED is 0, always take the bit level conversions.
+#define POSIT_HAVE_CONSTANT_EVALUATED LIMBS_HAVE_CONSTANT_EVALUATED
+#define POSIT_CONSTANT_EVALUATED() LIMBS_CONSTANT_EVALUATED()
+
+namespace sw {
+namespace unum {
+
+// field layout of the IEEE-754 binary interchange formats
+template<typename Real>
+struct ieee754_layout {
+	static constexpr bool bit_level = false;
+};
+template<>
+struct ieee754_layout<float> {
+	static constexpr bool bit_level = std::numeric_limits<float>::is_iec559;
+	using bits_t = uint32_t;
+	static constexpr unsigned nbits = 32;
+	static constexpr unsigned fbits = 23;
+	static constexpr int      bias  = 127;
+};
+template<>
+struct ieee754_layout<double> {
+	static constexpr bool bit_level = std::numeric_limits<double>::is_iec559;
+	using bits_t = uint64_t;
+	static constexpr unsigned nbits = 64;
+	static constexpr unsigned fbits = 52;
+	static constexpr int      bias  = 1023;
+};
+
+template<typename Real>
+using ieee754_bit_level = std::integral_constant<bool, ieee754_layout<Real>::bit_level>;
+
+enum class ieee754_class { zero, finite, nonfinite };
+
+// decompose an IEEE-754 value into sign, scale, and a significand with the hidden bit at bit 63
+// subnormals are normalized, sticky is set when the significand is wider than 64 bits
+template<typename Real>
+inline ieee754_class ieee754_decompose(Real v, bool& sign, int& scale, uint64_t& sig, bool& sticky, std::true_type) {
+	using layout = ieee754_layout<Real>;
+	constexpr unsigned ebits = layout::nbits - 1 - layout::fbits;
+	constexpr uint64_t emax = (uint64_t(1) << ebits) - 1;
+	typename layout::bits_t raw = 0;
+	std::memcpy(&raw, &v, sizeof(Real));
+	uint64_t bits = uint64_t(raw);
+	sign = (bits >> (layout::nbits - 1)) != 0;
+	sticky = false;
+	uint64_t e = (bits >> layout::fbits) & emax;
+	uint64_t f = bits & ((uint64_t(1) << layout::fbits) - 1);
+	if (e == emax) return ieee754_class::nonfinite;
+	if (e == 0) {
+		if (f == 0) return ieee754_class::zero;
+		unsigned lz = clz64(f);
+		sig = f << lz;
+		scale = 1 - layout::bias - int(layout::fbits) + (63 - int(lz));
+	}
+	else {
+		sig = (f | (uint64_t(1) << layout::fbits)) << (63 - layout::fbits);
+		scale = int(e) - layout::bias;
+	}
+	return ieee754_class::finite;
+}
+template<typename Real>
+inline ieee754_class ieee754_decompose(Real v, bool& sign, int& scale, uint64_t& sig, bool& sticky, std::false_type) {
+	sticky = false;
+	if (std::isnan(v) || std::isinf(v)) return ieee754_class::nonfinite;
+	if (v == Real(0)) return ieee754_class::zero;
+	sign = std::signbit(v);
+	int exponent = 0;
+	Real fr = std::frexp(sign ? -v : v, &exponent);   // fr in [0.5, 1.0)
+	Real scaled = std::ldexp(fr, 64);
+	sig = uint64_t(scaled);
+	sticky = (scaled - Real(sig)) != Real(0);
+	scale = exponent - 1;
+	return ieee754_class::finite;
+}
+template<typename Real>
+inline ieee754_class ieee754_decompose(Real v, bool& sign, int& scale, uint64_t& sig, bool& sticky) {
+	return ieee754_decompose(v, sign, scale, sig, sticky, ieee754_bit_level<Real>());
+}
+
+// round (sign, scale, a 128-bit significand hi:lo with the hidden bit at bit 63 of hi, sticky) to nearest even
+// onto a type without a known bit layout, such as long double: the significand is rounded in integer arithmetic
+// to the precision that Real has at this scale, so that the single ldexp composing the value is exact
+template<typename Real>
+inline Real ieee754_compose(bool sign, int scale, uint64_t hi, uint64_t lo, bool sticky) {
+	using limits = std::numeric_limits<Real>;
+	// significand bits Real keeps at this scale: fewer in the subnormal range
+	int p = limits::digits;
+	if (scale < limits::min_exponent - 1) p -= (limits::min_exponent - 1) - scale;
+	if (p > 128) p = 128;
+	if (p < 0) return sign ? -Real(0) : Real(0);
+	if (p == 0) {
+		// the leading bit is the guard bit of the smallest subnormal: ties round to the even zero
+		Real v = ((hi << 1) != 0 || lo != 0 || sticky) ? std::ldexp(Real(1), scale + 1) : Real(0);
+		return sign ? -v : v;
+	}
+	unsigned drop = 128 - unsigned(p);
+	if (drop > 0) {
+		unsigned g = drop - 1;   // position of the guard bit
+		bool guard = (((g < 64) ? lo >> g : hi >> (g - 64)) & 0x1) != 0;
+		sticky |= (g < 64) ? (lo & ((uint64_t(1) << g) - 1)) != 0 : (lo != 0 || (hi & ((uint64_t(1) << (g - 64)) - 1)) != 0);
+		if (drop < 64) {
+			lo &= ~((uint64_t(1) << drop) - 1);
+		}
+		else {
+			lo = 0;
+			hi &= ~((uint64_t(1) << (drop - 64)) - 1);
+		}
+		bool odd = (((drop < 64) ? lo >> drop : hi >> (drop - 64)) & 0x1) != 0;
+		if (guard && (sticky || odd)) {
+			if (drop < 64) {
+				uint64_t t = lo + (uint64_t(1) << drop);
+				if (t < lo) ++hi;
+				lo = t;
+			}
+			else {
+				hi += uint64_t(1) << (drop - 64);
+			}
+			// a carry out of the significand lands on the next binade
+			if (hi == 0) {
+				hi = uint64_t(1) << 63;
+				++scale;
+			}
+		}
+	}
+	// hi and lo hold at most p significant bits between them, so their sum is exact in Real
+	constexpr Real two_m64 = Real(1) / Real(18446744073709551616.0);
+	Real v = std::ldexp(Real(hi) + Real(lo) * two_m64, scale - 63);
+	return sign ? -v : v;
+}
+
+// round (sign, scale, significand with the hidden bit at bit 63, sticky) to the nearest IEEE-754 value
+template<typename Real>
+inline Real ieee754_round(bool sign, int scale, uint64_t sig, bool sticky, std::true_type) {
+	using layout = ieee754_layout<Real>;
+	constexpr unsigned ebits = layout::nbits - 1 - layout::fbits;
+	constexpr int emax = (1 << ebits) - 1;
+	constexpr uint64_t infinity = uint64_t(emax) << layout::fbits;
+	int e = scale + layout::bias;   // biased exponent
+	uint64_t bits = 0;
+	if (e >= emax) {
+		bits = infinity;
+	}
+	else {
+		// a subnormal keeps fewer significand bits
+		int s = int(63 - layout::fbits) + (e <= 0 ? 1 - e : 0);
+		unsigned shift = unsigned(s > 65 ? 65 : s);
+		uint64_t m = 0;
+		bool guard = false;
+		if (shift < 64) {
+			m = sig >> shift;
+			guard = ((sig >> (shift - 1)) & 0x1) != 0;
+			sticky |= (sig & ((uint64_t(1) << (shift - 1)) - 1)) != 0;
+		}
+		else if (shift == 64) {
+			guard = (sig >> 63) != 0;
+			sticky |= (sig << 1) != 0;
+		}
+		else {
+			sticky |= (sig != 0);
+		}
+		if (guard && (sticky || (m & 0x1))) ++m;
+		// the hidden bit of m increments the exponent field, so that a carry out of the
+		// significand or out of the subnormal range lands on the next binade
+		bits = (e > 0 ? (uint64_t(e - 1) << layout::fbits) : 0) + m;
+	}
+	if (sign) bits |= uint64_t(1) << (layout::nbits - 1);
+	typename layout::bits_t raw = typename layout::bits_t(bits);
+	Real v = 0;
+	std::memcpy(&v, &raw, sizeof(Real));
+	return v;
+}
+template<typename Real>
+inline Real ieee754_round(bool sign, int scale, uint64_t sig, bool sticky, std::false_type) {
+	return ieee754_compose<Real>(sign, scale, sig, 0, sticky);
+}
+template<typename Real>
+inline Real ieee754_round(bool sign, int scale, uint64_t sig, bool sticky) {
+	return ieee754_round<Real>(sign, scale, sig, sticky, ieee754_bit_level<Real>());
+}
+
+}  // namespace unum
+}  // namespace sw
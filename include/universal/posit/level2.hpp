@@ -0,0 +1,351 @@
+#pragma once
+// level2.hpp: BLAS level 2 kernels for posit matrices and vectors with one rounding per element
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../bitblock/limbs.hpp"
+#include "../utility/matrix_view.hpp"
+#include "../utility/parallel.hpp"
+#include "limb_engine.hpp"
+#include "gemm.hpp"
+
+// gemv(alpha, A, x, beta, y)   y = alpha * A * x + beta * y
+// ger(alpha, x, y, A)          A = A + alpha * x * y^T
+// trsv(uplo, diag, T, x)       x = T^-1 * x for a lower or upper triangular T
+//
+// Every element of the result is rounded once. The dot products of gemv and trsv accumulate in the
+// accumulators of the gemm micro-kernels, and the remaining terms, the scaling by alpha, the product
+// beta * y, and the right-hand side and the diagonal of trsv, are combined with the exact dot product
+// in limb arithmetic before the one rounding step, or the one correctly rounded division of trsv.
+//
+// The matrices may be row-major or column-major with any leading dimension, and the vectors strided.
+// Rows are processed in blocks that traverse a row-major matrix along its rows and a column-major
+// matrix down its columns, and the rows are split across nrOfThreads threads.
+
+namespace sw {
+	namespace unum {
+
+// the triangle of a matrix that holds a triangular matrix, and whether its diagonal is implicitly one
+enum class matrix_triangle { lower, upper };
+enum class matrix_diagonal { non_unit, unit };
+
+// rows of a block of accumulators
+constexpr size_t level2_rows = 64;
+
+// smallest number of matrix elements that is given its own thread
+constexpr size_t level2_min_elements_per_thread = size_t(1) << 14;
+
+// an exact value (-1)^sign * m * 2^lsb with an N limb magnitude
+template<size_t N>
+struct exact_term {
+	bool     sign;
+	int      lsb;
+	uint64_t m[N];
+};
+
+// exact products and sums of posits and accumulated dot products, rounded once to posit<nbits, es>
+template<size_t nbits, size_t es>
+class level2_terms {
+public:
+	using Posit = posit<nbits, es>;
+	using engine = limb_engine<nbits, es>;
+	static constexpr size_t F = engine::flimbs;
+	// A sum whose terms are further apart than margin bits only depends on the sign of the smaller term:
+	// the margin exceeds the bits below the larger term that a rounding, or a rounded quotient, can observe.
+	static constexpr int margin = 64 * (2 * int(F) + 1);
+	using term = exact_term<F>;
+
+	// a posit as an exact term with its hidden bit at the msb of the significand
+	static term decode(const Posit& p) {
+		term t;
+		t.sign = false;
+		t.lsb = 0;
+		uint64_t raw[engine::nlimbs];
+		encoding(p, raw, std::integral_constant<bool, (nbits <= 64)>());
+		if (engine::isnar(raw)) throw operand_is_nar{};
+		if (engine::iszero(raw)) {
+			limbs_clear<F>(t.m);
+			return t;
+		}
+		typename engine::triple v;
+		engine::decode(raw, v);
+		t.sign = v.sign;
+		t.lsb = v.scale - int(64 * F - 1);
+		for (size_t i = 0; i < F; ++i) t.m[i] = v.sig[i];
+		return t;
+	}
+	template<size_t N>
+	static bool iszero(const exact_term<N>& t) { return limbs_iszero<N>(t.m); }
+
+	template<size_t N, size_t M>
+	static exact_term<N + M> product(const exact_term<N>& a, const exact_term<M>& b) {
+		exact_term<N + M> r;
+		limbs_mul<N, M>(r.m, a.m, b.m);
+		r.sign = a.sign != b.sign;
+		r.lsb = a.lsb + b.lsb;
+		return r;
+	}
+
+	// a + b, where a smaller term that lies below the margin of the larger one is replaced by a single bit
+	// of the same sign at that margin, which rounds and divides to the same posit
+	template<size_t N, size_t M>
+	static exact_term<N + M + 2 * F + 2> sum(const exact_term<N>& a, const exact_term<M>& b) {
+		constexpr size_t W = N + M + 2 * F + 2;
+		exact_term<W> x = widen<W>(a), y = widen<W>(b);
+		if (iszero(y)) return x;
+		if (iszero(x)) return y;
+		int xtop = x.lsb + int(64 * W - limbs_clz<W>(x.m)), ytop = y.lsb + int(64 * W - limbs_clz<W>(y.m));
+		exact_term<W>& big = (xtop >= ytop ? x : y);
+		exact_term<W>& small = (xtop >= ytop ? y : x);
+		if (std::max(xtop, ytop) - std::min(x.lsb, y.lsb) > int(64 * W - 2)) {
+			limbs_clear<W>(small.m);
+			small.m[0] = 1;
+			small.lsb = big.lsb - margin;
+		}
+		int lsb = std::min(x.lsb, y.lsb);
+		limbs_shl<W>(x.m, size_t(x.lsb - lsb));
+		limbs_shl<W>(y.m, size_t(y.lsb - lsb));
+		exact_term<W> r;
+		r.lsb = lsb;
+		if (x.sign == y.sign) {
+			limbs_add<W>(r.m, x.m, y.m);
+			r.sign = x.sign;
+		}
+		else if (limbs_compare<W>(x.m, y.m) >= 0) {
+			limbs_sub<W>(r.m, x.m, y.m);
+			r.sign = x.sign;
+		}
+		else {
+			limbs_sub<W>(r.m, y.m, x.m);
+			r.sign = y.sign;
+		}
+		return r;
+	}
+
+	// round a term to the nearest posit: sticky marks nonzero bits below the term
+	template<size_t N>
+	static Posit round(const exact_term<N>& t, bool sticky = false) {
+		uint64_t m[N], raw[engine::nlimbs];
+		for (size_t i = 0; i < N; ++i) m[i] = t.m[i];
+		unsigned lz = limbs_clz<N>(m);
+		if (lz == 64 * N) {
+			limbs_clear<engine::nlimbs>(raw);
+		}
+		else {
+			limbs_shl<N>(m, lz);
+			engine::template encode<N>(t.sign, int(64 * N - 1 - lz) + t.lsb, m, sticky, raw);
+		}
+		return to_posit(raw, std::integral_constant<bool, (nbits <= 64)>());
+	}
+
+	// round the quotient of a term and a nonzero posit: the long division yields more than fbits + 2 quotient bits
+	// and the remainder becomes the sticky bit, so the quotient is correctly rounded
+	template<size_t N>
+	static Posit round_quotient(const exact_term<N>& t, const term& d) {
+		constexpr size_t U = N + 2 * F + 1;
+		exact_term<U> q;
+		uint64_t u[U], r[F];
+		limbs_clear<U>(u);
+		for (size_t i = 0; i < N; ++i) u[i + 2 * F + 1] = t.m[i];
+		limbs_divmod<U, F>(u, d.m, q.m, r);
+		q.sign = t.sign != d.sign;
+		q.lsb = t.lsb - 64 * int(2 * F + 1) - d.lsb;
+		return round(q, !limbs_iszero<F>(r));
+	}
+
+	// the accumulated dot product of a gemm micro-kernel accumulator
+	template<typename Kernel>
+	static exact_term<Kernel::tlimbs> accumulated(const typename Kernel::accumulator& acc) {
+		exact_term<Kernel::tlimbs> t;
+		t.sign = Kernel::magnitude(acc, t.m, t.lsb);
+		return t;
+	}
+
+private:
+	template<size_t W, size_t N>
+	static exact_term<W> widen(const exact_term<N>& t) {
+		exact_term<W> w;
+		w.sign = t.sign;
+		w.lsb = t.lsb;
+		limbs_clear<W>(w.m);
+		for (size_t i = 0; i < N; ++i) w.m[i] = t.m[i];
+		return w;
+	}
+	// posits up to 64 bits expose their encoding as an integer, wider posits as a bitblock
+	static void encoding(const Posit& p, uint64_t* raw, std::true_type) { raw[0] = uint64_t(p.encoding()); }
+	static void encoding(const Posit& p, uint64_t* raw, std::false_type) { bitset_to_limbs<nbits, engine::nlimbs>(p.get(), raw); }
+	static Posit to_posit(const uint64_t* raw, std::true_type) {
+		Posit p;
+		return p.set_raw_bits(raw[0]);
+	}
+	static Posit to_posit(const uint64_t* raw, std::false_type) {
+		bitblock<nbits> bits;
+		limbs_to_bitset<nbits, engine::nlimbs>(raw, bits);
+		Posit p;
+		return p.set(bits);
+	}
+};
+
+// run rows(begin, count) on nrOfThreads contiguous parts of [0, nrOfRows)
+template<typename Rows>
+void level2_parallel(size_t nrOfRows, size_t nrOfColumns, size_t nrOfThreads, Rows rows) {
+	size_t threads = parallel_thread_count(nrOfRows * nrOfColumns, std::min(nrOfThreads, nrOfRows), level2_min_elements_per_thread);
+	size_t chunk = (nrOfRows + threads - 1) / threads;
+	parallel_parts(threads, [&](size_t t) {
+		size_t begin = t * chunk;
+		if (begin < nrOfRows) rows(begin, std::min(chunk, nrOfRows - begin));
+	});
+}
+
+// acc[k] += sum over j in [j0, j1) of A(i0 + k, j) * x[j] for k in [0, rb): a row-major matrix is traversed
+// along its rows, a column-major matrix down its columns
+template<typename Kernel, typename Posit>
+void level2_accumulate(typename Kernel::accumulator* acc, const matrix_view<const Posit>& A, const typename Kernel::operand* x, size_t i0, size_t rb, size_t j0, size_t j1) {
+	size_t rs = A.row_stride(), cs = A.col_stride();
+	while (j0 < j1) {
+		size_t je = j0 + std::min(j1 - j0, Kernel::headroom);
+		if (A.layout() == matrix_layout::row_major) {
+			for (size_t k = 0; k < rb; ++k) {
+				const Posit* a = &A(i0 + k, j0);
+				for (size_t j = j0; j < je; ++j, a += cs) Kernel::add_product(acc[k], Kernel::decode(*a), x[j]);
+			}
+		}
+		else {
+			for (size_t j = j0; j < je; ++j) {
+				const Posit* a = &A(i0, j);
+				for (size_t k = 0; k < rb; ++k, a += rs) Kernel::add_product(acc[k], Kernel::decode(*a), x[j]);
+			}
+		}
+		if (je < j1) for (size_t k = 0; k < rb; ++k) Kernel::normalize(acc[k]);
+		j0 = je;
+	}
+}
+
+// y = alpha * A * x + beta * y with one rounding per element of y
+// As in the reference BLAS, A and x are not read when alpha is zero, and y is not read when beta is zero.
+template<size_t capacity = 30, typename TA, typename TX, typename Posit>
+void gemv(const typename vector_view<Posit>::value_type& alpha, const matrix_view<TA>& A, const vector_view<TX>& x, const typename vector_view<Posit>::value_type& beta, const vector_view<Posit>& y, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	static_assert(std::is_same<typename std::remove_const<TA>::type, Posit>::value && std::is_same<typename std::remove_const<TX>::type, Posit>::value,
+		"gemv requires A, x, and y to have the same posit type");
+	using Kernel = gemm_kernel<Posit::nbits, Posit::es, capacity>;
+	using Terms = level2_terms<Posit::nbits, Posit::es>;
+	using accumulator = typename Kernel::accumulator;
+	if (A.rows() != y.size() || A.cols() != x.size()) throw std::invalid_argument("gemv: the dimensions of A, x, and y do not agree");
+	size_t M = y.size(), N = x.size();
+	typename Terms::term a = Terms::decode(alpha), b = Terms::decode(beta);
+	bool product = !Terms::iszero(a) && N > 0;
+	matrix_view<const Posit> matrix(A);
+	std::vector<typename Kernel::operand> xd(product ? N : 0);
+	for (size_t j = 0; j < xd.size(); ++j) xd[j] = Kernel::decode(x[j]);
+	level2_parallel(M, N, nrOfThreads, [&](size_t begin, size_t count) {
+		std::vector<accumulator> acc(level2_rows);
+		for (size_t i0 = begin; i0 < begin + count; i0 += level2_rows) {
+			size_t rb = std::min(level2_rows, begin + count - i0);
+			for (size_t k = 0; k < rb; ++k) Kernel::clear(acc[k]);
+			if (product) level2_accumulate<Kernel>(acc.data(), matrix, xd.data(), i0, rb, 0, N);
+			for (size_t k = 0; k < rb; ++k) {
+				typename Terms::term yi = Terms::decode(Terms::iszero(b) ? Posit(0) : y[i0 + k]);
+				y[i0 + k] = Terms::round(Terms::sum(Terms::product(Terms::template accumulated<Kernel>(acc[k]), a), Terms::product(b, yi)));
+			}
+		}
+	});
+}
+
+// A = A + alpha * x * y^T with one rounding per element of A
+template<typename TX, typename TY, typename Posit>
+void ger(const typename matrix_view<Posit>::value_type& alpha, const vector_view<TX>& x, const vector_view<TY>& y, const matrix_view<Posit>& A, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	static_assert(std::is_same<typename std::remove_const<TX>::type, Posit>::value && std::is_same<typename std::remove_const<TY>::type, Posit>::value,
+		"ger requires x, y, and A to have the same posit type");
+	using Terms = level2_terms<Posit::nbits, Posit::es>;
+	constexpr size_t F = Terms::F;
+	if (A.rows() != x.size() || A.cols() != y.size()) throw std::invalid_argument("ger: the dimensions of x, y, and A do not agree");
+	size_t M = x.size(), N = y.size();
+	typename Terms::term a = Terms::decode(alpha);
+	if (Terms::iszero(a) || M == 0 || N == 0) return;
+	// alpha * x[i] is exact in twice the significand
+	std::vector< exact_term<2 * F> > ax(M);
+	std::vector< typename Terms::term > yd(N);
+	for (size_t i = 0; i < M; ++i) ax[i] = Terms::product(a, Terms::decode(x[i]));
+	for (size_t j = 0; j < N; ++j) yd[j] = Terms::decode(y[j]);
+	level2_parallel(M, N, nrOfThreads, [&](size_t begin, size_t count) {
+		auto update = [&](size_t i, size_t j) {
+			A(i, j) = Terms::round(Terms::sum(Terms::product(ax[i], yd[j]), Terms::decode(A(i, j))));
+		};
+		if (A.layout() == matrix_layout::row_major) {
+			for (size_t i = begin; i < begin + count; ++i) {
+				for (size_t j = 0; j < N; ++j) update(i, j);
+			}
+		}
+		else {
+			for (size_t j = 0; j < N; ++j) {
+				for (size_t i = begin; i < begin + count; ++i) update(i, j);
+			}
+		}
+	});
+}
+
+// solve T * x = b for a triangular T, where x holds b on entry and the solution on exit:
+// each element of x is the correctly rounded quotient of its exact numerator, b[i] minus the quire
+// accumulated row sum of the solved elements, and the diagonal element, or the rounded numerator for a unit diagonal.
+// The rows are solved in blocks, and the rows below the block accumulate its products in parallel.
+template<size_t capacity = 30, typename TT, typename Posit>
+void trsv(matrix_triangle uplo, matrix_diagonal diag, const matrix_view<TT>& T, const vector_view<Posit>& x, size_t nrOfThreads = std::thread::hardware_concurrency()) {
+	static_assert(std::is_same<typename std::remove_const<TT>::type, Posit>::value, "trsv requires T and x to have the same posit type");
+	using Kernel = gemm_kernel<Posit::nbits, Posit::es, capacity>;
+	using Terms = level2_terms<Posit::nbits, Posit::es>;
+	using accumulator = typename Kernel::accumulator;
+	if (T.rows() != x.size() || T.cols() != x.size()) throw std::invalid_argument("trsv: the dimensions of T and x do not agree");
+	size_t n = x.size();
+	bool lower = (uplo == matrix_triangle::lower);
+	matrix_view<const Posit> t(T);
+	std::vector<accumulator> acc(n);
+	for (accumulator& a : acc) Kernel::clear(a);
+	std::vector<typename Kernel::operand> xd(n);
+	size_t pending = 0;
+	for (size_t solved = 0; solved < n; solved += level2_rows) {
+		size_t rb = std::min(level2_rows, n - solved);
+		size_t i0 = (lower ? solved : n - solved - rb), i1 = i0 + rb;
+		// the diagonal block, one row at a time
+		for (size_t s = 0; s < rb; ++s) {
+			size_t i = (lower ? i0 + s : i1 - 1 - s);
+			if (lower) {
+				level2_accumulate<Kernel>(&acc[i], t, xd.data(), i, 1, i0, i);
+			}
+			else {
+				level2_accumulate<Kernel>(&acc[i], t, xd.data(), i, 1, i + 1, i1);
+			}
+			exact_term<Kernel::tlimbs> rowsum = Terms::template accumulated<Kernel>(acc[i]);
+			rowsum.sign = !rowsum.sign;
+			auto numerator = Terms::sum(Terms::decode(x[i]), rowsum);
+			if (diag == matrix_diagonal::unit) {
+				x[i] = Terms::round(numerator);
+			}
+			else {
+				typename Terms::term d = Terms::decode(t(i, i));
+				if (Terms::iszero(d)) throw divide_by_zero{};
+				x[i] = Terms::round_quotient(numerator, d);
+			}
+			xd[i] = Kernel::decode(x[i]);
+		}
+		// the remaining rows accumulate the products of the block
+		size_t r0 = (lower ? i1 : 0), r1 = (lower ? n : i0);
+		level2_parallel(r1 - r0, rb, nrOfThreads, [&](size_t begin, size_t count) {
+			level2_accumulate<Kernel>(&acc[r0 + begin], t, xd.data(), r0 + begin, count, i0, i1);
+		});
+		pending += rb;
+		if (pending > Kernel::headroom - level2_rows) {
+			for (accumulator& a : acc) Kernel::normalize(a);
+			pending = 0;
+		}
+	}
+}
+
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,346 @@
+#pragma once
+// limb_engine.hpp: word-level arithmetic engine for arbitrary posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "../bitblock/bitblock.hpp"
+#include "../bitblock/limbs.hpp"
+#include "ieee754.hpp"
+
+// The limb engine decodes, aligns, adds, multiplies, divides, takes square roots and reciprocal
+// square roots, and rounds posits on 64-bit words instead of walking the bitblock one bit at a time.
+// The engine is selected for the generic posit<nbits, es> by setting POSIT_LIMB_ARITHMETIC to 1
+// and yields the same encodings as the bitblock based arithmetic modules in value.hpp.
+//
+// Internally a posit is represented as a (sign, scale, significand) triple where the significand
+// is a left aligned limb array: the hidden bit sits at the msb of the most significant limb.
+// Rounding keeps an explicit sticky bit so that the final round-to-nearest-even
+// onto the posit encoding sees the exact result.
+
+namespace sw {
+namespace unum {
+
+template<size_t nbits, size_t es>
+class limb_engine {
+public:
+	static constexpr size_t fbits  = (es + 2 >= nbits ? 0 : nbits - 3 - es);  // maximum number of fraction bits
+	static constexpr size_t fhbits = fbits + 1;                               // fraction bits + hidden bit
+	static constexpr size_t nlimbs = nr_limbs(nbits);                          // limbs of the posit encoding
+	static constexpr size_t flimbs = nr_limbs(fhbits);                         // limbs of a decoded significand
+	static constexpr size_t alimbs = nr_limbs(fhbits + 3);                     // limbs of the adder: carry + 2 guard bits
+	static constexpr size_t mlimbs = 2 * flimbs;                               // limbs of the multiplier output
+	static constexpr size_t qlimbs = nr_limbs(fhbits + 4);                     // limbs of the divider operands and quotient
+	static constexpr size_t rlimbs = nr_limbs(fhbits + 4);                     // limbs of the square root operand
+	static constexpr int    maxscale = int(nbits - 2) * (1 << es);             // scale of maxpos
+
+	// decoded posit
+	struct triple {
+		bool     sign;
+		int      scale;
+		uint64_t sig[flimbs];  // significand with the hidden bit at the msb
+	};
+
+	// decode a posit encoding into a (sign, scale, significand) triple: zero and NaR must be handled by the caller
+	static void decode(const uint64_t* raw, triple& v) {
+		uint64_t tmp[nlimbs];
+		for (size_t i = 0; i < nlimbs; ++i) tmp[i] = raw[i];
+		v.sign = limbs_test<nlimbs>(tmp, nbits - 1);
+		if (v.sign) limbs_twos_complement<nlimbs>(tmp);
+		// left align the bits that follow the sign bit, this also clears the sign bit
+		limbs_shl<nlimbs>(tmp, 64 * nlimbs - nbits + 1);
+		bool r0 = (tmp[nlimbs - 1] >> 63) & 0x1;
+		unsigned m;  // regime run length
+		if (r0) {
+			uint64_t inv[nlimbs];
+			for (size_t i = 0; i < nlimbs; ++i) inv[i] = ~tmp[i];
+			m = limbs_clz<nlimbs>(inv);
+		}
+		else {
+			m = limbs_clz<nlimbs>(tmp);
+		}
+		int k = r0 ? int(m) - 1 : -int(m);
+		limbs_shl<nlimbs>(tmp, m + 1);  // remove the regime run and its termination bit
+		uint64_t e = 0;
+		if (es > 0) {
+			e = tmp[nlimbs - 1] >> (64 - es);
+			limbs_shl<nlimbs>(tmp, es);
+		}
+		v.scale = k * (1 << es) + int(e);
+		// the remaining bits are the fraction: prepend the hidden bit
+		limbs_shr<nlimbs>(tmp, 1);
+		tmp[nlimbs - 1] |= uint64_t(1) << 63;
+		for (size_t i = 0; i < flimbs; ++i) v.sig[i] = tmp[nlimbs - flimbs + i];
+	}
+
+	// round a (sign, scale, significand, sticky) value to the nearest posit encoding
+	// the significand sig is a left aligned array of N limbs, with the hidden bit at the msb
+	template<size_t N>
+	static void encode(bool sign, int scale, const uint64_t* sig, bool sticky, uint64_t* raw) {
+		limbs_clear<nlimbs>(raw);
+		if (scale > maxscale) {          // project to maxpos
+			for (size_t i = 0; i < nbits - 1; ++i) limbs_set<nlimbs>(raw, i);
+		}
+		else if (scale < -maxscale) {    // project to minpos
+			raw[0] = 1;
+		}
+		else {
+			constexpr size_t W = (nlimbs + 1 > N ? nlimbs + 1 : N);
+			uint64_t t[W];
+			limbs_clear<W>(t);
+			for (size_t i = 0; i < N; ++i) t[W - N + i] = sig[i];
+			limbs_shl<W>(t, 1);   // remove the hidden bit
+
+			bool r = (scale >= 0);
+			unsigned run = unsigned(r ? 1 + (scale >> es) : -(scale >> es));
+			uint64_t esval = uint64_t(scale) & ((uint64_t(1) << es) - 1);
+			size_t rl = run + 1;   // regime bits including the termination bit
+			sticky |= limbs_shr<W>(t, rl + es);
+			// compose regime, exponent and fraction
+			if (r) {
+				for (size_t i = 0; i < run; ++i) limbs_set<W>(t, 64 * W - 1 - i);
+			}
+			else {
+				limbs_set<W>(t, 64 * W - 1 - run);
+			}
+			if (es > 0) limbs_or_word<W>(t, esval, 64 * W - rl - es);
+			// the nbits-1 bits of the posit body are followed by the guard bit
+			sticky |= limbs_shr<W>(t, 64 * W - nbits);
+			bool guard = t[0] & 0x1;
+			limbs_shr<W>(t, 1);
+			if (guard && (sticky || (t[0] & 0x1))) limbs_increment<W>(t);
+			for (size_t i = 0; i < nlimbs; ++i) raw[i] = t[i];
+		}
+		if (sign) twos_complement(raw);
+	}
+
+	// two's complement within the nbits of the encoding
+	static void twos_complement(uint64_t* raw) {
+		limbs_twos_complement<nlimbs>(raw);
+		mask(raw);
+	}
+	static void mask(uint64_t* raw) {
+		if (nbits % 64) raw[nlimbs - 1] &= (uint64_t(1) << (nbits % 64)) - 1;
+	}
+	static bool iszero(const uint64_t* raw) {
+		return limbs_iszero<nlimbs>(raw);
+	}
+	static bool isnar(const uint64_t* raw) {
+		uint64_t tmp[nlimbs];
+		for (size_t i = 0; i < nlimbs; ++i) tmp[i] = raw[i];
+		uint64_t msb = uint64_t(1) << ((nbits - 1) % 64);
+		if (!(tmp[nlimbs - 1] & msb)) return false;
+		tmp[nlimbs - 1] &= ~msb;
+		return limbs_iszero<nlimbs>(tmp);
+	}
+
+	// r = a + b, or a - b when subtract is set: operands must not be zero or NaR
+	static void add(const uint64_t* a, const uint64_t* b, uint64_t* r, bool subtract = false) {
+		triple va, vb;
+		decode(a, va);
+		decode(b, vb);
+		if (subtract) vb.sign = !vb.sign;
+		uint64_t x[alimbs], y[alimbs];
+		align_for_add(va, x);
+		align_for_add(vb, y);
+		// order the operands by magnitude
+		int cmp = (va.scale != vb.scale) ? (va.scale < vb.scale ? -1 : 1) : limbs_compare<alimbs>(x, y);
+		if (cmp < 0) {
+			std::swap(va, vb);
+			for (size_t i = 0; i < alimbs; ++i) std::swap(x[i], y[i]);
+		}
+		bool sticky = limbs_shr<alimbs>(y, size_t(va.scale - vb.scale));
+		uint64_t sum[alimbs];
+		if (va.sign == vb.sign) {
+			limbs_add<alimbs>(sum, x, y);
+		}
+		else {
+			limbs_sub<alimbs>(sum, x, y);
+			// the shifted out bits of y reduce the difference below the truncated result
+			if (sticky) limbs_decrement<alimbs>(sum);
+			if (limbs_iszero<alimbs>(sum)) {
+				limbs_clear<nlimbs>(r);
+				return;
+			}
+		}
+		// normalize: the hidden bit of the larger operand sits one below the msb
+		unsigned lz = limbs_clz<alimbs>(sum);
+		limbs_shl<alimbs>(sum, lz);
+		encode<alimbs>(va.sign, va.scale + 1 - int(lz), sum, sticky, r);
+	}
+
+	// r = a * b: operands must not be zero or NaR
+	static void mul(const uint64_t* a, const uint64_t* b, uint64_t* r) {
+		triple va, vb;
+		decode(a, va);
+		decode(b, vb);
+		uint64_t product[mlimbs];
+		limbs_mul<flimbs, flimbs>(product, va.sig, vb.sig);
+		// the product of two left aligned significands has its msb at position 2*64*flimbs - 1 or - 2
+		unsigned lz = limbs_clz<mlimbs>(product);
+		limbs_shl<mlimbs>(product, lz);
+		encode<mlimbs>(va.sign ^ vb.sign, va.scale + vb.scale + 1 - int(lz), product, false, r);
+	}
+
+	// r = a / b: operands must not be zero or NaR
+	static void div(const uint64_t* a, const uint64_t* b, uint64_t* r) {
+		triple va, vb;
+		decode(a, va);
+		decode(b, vb);
+		// load the significands as normalized fractions of qlimbs limbs
+		uint64_t n[qlimbs], d[qlimbs], quotient[qlimbs];
+		limbs_clear<qlimbs>(n);
+		limbs_clear<qlimbs>(d);
+		for (size_t i = 0; i < flimbs; ++i) {
+			n[qlimbs - flimbs + i] = va.sig[i];
+			d[qlimbs - flimbs + i] = vb.sig[i];
+		}
+		// quotient / 2^(fhbits+2) = a / b in (1/2, 2): fhbits + 3 bits carry the significand, a guard bit, and a spare bit
+		bool sticky = limbs_fraction_divide<qlimbs>(n, d, fhbits + 3, quotient);
+		unsigned lz = limbs_clz<qlimbs>(quotient);
+		limbs_shl<qlimbs>(quotient, lz);
+		int msb = int(64 * qlimbs) - 1 - int(lz);
+		encode<qlimbs>(va.sign ^ vb.sign, va.scale - vb.scale + msb - int(fhbits + 2), quotient, sticky, r);
+	}
+
+	// r = sqrt(a): operand must be positive and not zero or NaR
+	static void sqrt(const uint64_t* a, uint64_t* r) {
+		uint64_t v[rlimbs], root[rlimbs];
+		int e = root_operand(a, v);
+		bool sticky = limbs_fraction_sqrt<rlimbs>(v, fhbits + 2, root);
+		// root / 2^(fhbits+1) = sqrt(v) in [1, 2)
+		root_encode(root, sticky, e / 2, r);
+	}
+
+	// r = 1 / sqrt(a): operand must be positive and not zero or NaR
+	static void rsqrt(const uint64_t* a, uint64_t* r) {
+		uint64_t v[rlimbs], root[rlimbs];
+		int e = root_operand(a, v);
+		bool sticky = limbs_fraction_rsqrt<rlimbs>(v, fhbits + 2, root);
+		// root / 2^(fhbits+1) = 1 / sqrt(v) in (1/2, 1]
+		root_encode(root, sticky, -e / 2, r);
+	}
+
+	// a = v * 2^e with v in [1, 4) and e even: load v as a normalized fraction of rlimbs limbs and return e
+	static int root_operand(const uint64_t* a, uint64_t* v) {
+		triple va;
+		decode(a, va);
+		limbs_clear<rlimbs>(v);
+		for (size_t i = 0; i < flimbs; ++i) v[rlimbs - flimbs + i] = va.sig[i];
+		if (!(va.scale & 0x1)) limbs_shr<rlimbs>(v, 1);
+		return va.scale - (va.scale & 0x1);
+	}
+
+	// round a root of fhbits + 2 bits, the last one a guard bit below the significand, that is scaled by 2^scale
+	static void root_encode(uint64_t* root, bool sticky, int scale, uint64_t* r) {
+		unsigned lz = limbs_clz<rlimbs>(root);
+		limbs_shl<rlimbs>(root, lz);
+		encode<rlimbs>(false, int(64 * rlimbs - 1 - lz) - int(fhbits + 1) + scale, root, sticky, r);
+	}
+
+	// round an IEEE floating-point value to the nearest encoding: NaN and infinities project to NaR
+	template<typename Real>
+	static void from_ieee(Real v, uint64_t* raw) {
+		bool sign = false, sticky = false;
+		int scale = 0;
+		uint64_t sig = 0;
+		limbs_clear<nlimbs>(raw);
+		switch (ieee754_decompose(v, sign, scale, sig, sticky)) {
+		case ieee754_class::zero:
+			break;
+		case ieee754_class::nonfinite:
+			limbs_set<nlimbs>(raw, nbits - 1);
+			break;
+		default:
+			encode<1>(sign, scale, &sig, sticky, raw);
+		}
+	}
+
+	// the value of an encoding rounded to nearest even onto an IEEE floating-point type: NaR projects to NaN
+	template<typename Real>
+	static Real to_ieee(const uint64_t* raw) {
+		if (iszero(raw)) return Real(0);
+		if (isnar(raw)) return std::numeric_limits<Real>::quiet_NaN();
+		triple v;
+		decode(raw, v);
+		constexpr size_t top = flimbs - 1;
+		if (!ieee754_layout<Real>::bit_level) {
+			// long double is rounded from the two leading limbs, the limbs below them are sticky
+			bool sticky = false;
+			for (size_t i = 0; i + 1 < top; ++i) sticky |= (v.sig[i] != 0);
+			return ieee754_compose<Real>(v.sign, v.scale, v.sig[top], (top > 0 ? v.sig[top - 1] : 0), sticky);
+		}
+		// the limbs below the leading limb only contribute to the sticky bit
+		bool sticky = false;
+		for (size_t i = 0; i < top; ++i) sticky |= (v.sig[i] != 0);
+		return ieee754_round<Real>(v.sign, v.scale, v.sig[top], sticky);
+	}
+
+	////////////////////////////////////////////////////////////////////
+	// bitblock interface used by the generic posit<nbits, es>
+
+	static bitblock<nbits> add(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return binary_op(a, b, [](const uint64_t* x, const uint64_t* y, uint64_t* z) { add(x, y, z, false); });
+	}
+	static bitblock<nbits> sub(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return binary_op(a, b, [](const uint64_t* x, const uint64_t* y, uint64_t* z) { add(x, y, z, true); });
+	}
+	static bitblock<nbits> mul(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return binary_op(a, b, [](const uint64_t* x, const uint64_t* y, uint64_t* z) { mul(x, y, z); });
+	}
+	static bitblock<nbits> div(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return binary_op(a, b, [](const uint64_t* x, const uint64_t* y, uint64_t* z) { div(x, y, z); });
+	}
+	static bitblock<nbits> sqrt(const bitblock<nbits>& a) {
+		uint64_t x[nlimbs], z[nlimbs];
+		bitset_to_limbs<nbits, nlimbs>(a, x);
+		sqrt(x, z);
+		bitblock<nbits> result;
+		limbs_to_bitset<nbits, nlimbs>(z, result);
+		return result;
+	}
+	static bitblock<nbits> rsqrt(const bitblock<nbits>& a) {
+		uint64_t x[nlimbs], z[nlimbs];
+		bitset_to_limbs<nbits, nlimbs>(a, x);
+		rsqrt(x, z);
+		bitblock<nbits> result;
+		limbs_to_bitset<nbits, nlimbs>(z, result);
+		return result;
+	}
+	template<typename Real>
+	static bitblock<nbits> ieee_to_bitblock(Real v) {
+		uint64_t z[nlimbs];
+		from_ieee(v, z);
+		bitblock<nbits> result;
+		limbs_to_bitset<nbits, nlimbs>(z, result);
+		return result;
+	}
+	template<typename Real>
+	static Real bitblock_to_ieee(const bitblock<nbits>& a) {
+		uint64_t x[nlimbs];
+		bitset_to_limbs<nbits, nlimbs>(a, x);
+		return to_ieee<Real>(x);
+	}
+
+private:
+	// place a significand in the adder with the hidden bit one below the msb to catch the carry
+	static void align_for_add(const triple& v, uint64_t* x) {
+		limbs_clear<alimbs>(x);
+		for (size_t i = 0; i < flimbs; ++i) x[alimbs - flimbs + i] = v.sig[i];
+		limbs_shr<alimbs>(x, 1);
+	}
+
+	template<typename BinaryOp>
+	static bitblock<nbits> binary_op(const bitblock<nbits>& a, const bitblock<nbits>& b, BinaryOp op) {
+		uint64_t x[nlimbs], y[nlimbs], z[nlimbs];
+		bitset_to_limbs<nbits, nlimbs>(a, x);
+		bitset_to_limbs<nbits, nlimbs>(b, y);
+		op(x, y, z);
+		bitblock<nbits> result;
+		limbs_to_bitset<nbits, nlimbs>(z, result);
+		return result;
+	}
+};
+
+}  // namespace unum
+}  // namespace sw
@@ -43,5 +43,14 @@ constexpr double m_log10e   = 0.434294481903251827651; // log10(e)
 constexpr double m_ln2      = 0.693147180559945309417; // ln(2)
 constexpr double m_ln10     = 2.30258509299404568402;  // ln(10)
 
+// constants rounded to the target number system: these are constant expressions
+// for the number systems that have constexpr conversions, such as the specialized posits
+template<typename Real>
+constexpr Real pi_v()  { return Real(m_pi); }
+template<typename Real>
+constexpr Real e_v()   { return Real(m_e); }
+template<typename Real>
+constexpr Real ln2_v() { return Real(m_ln2); }
+
 }  // namespace unum
 }  // namespace sw
@@ -0,0 +1,2403 @@
+#pragma once
+// elementary.hpp: correctly rounded evaluation engine for the elementary functions of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+// The posit standard requires every elementary function to return the correctly rounded posit for every input.
+// The engine evaluates a function in a binary floating-point format, wide_float, whose precision is a run-time
+// number of 64-bit limbs. Each kernel reduces its argument, sums a series, and returns a bound on the relative
+// error of its result. Ziv's strategy turns this into a correctly rounded posit: when the result minus and plus
+// the error bound round to the same posit, that posit is the answer, otherwise the kernel runs again with more
+// limbs. The precision is capped by the dynamic range of the posit, which is enough for the argument reduction
+// of sin(maxpos) and the cancellation in erfc(x) close to minpos.
+//
+// Ziv's loop can not decide a result that sits exactly on a rounding boundary, so arguments for which the
+// function value is a dyadic rational, such as exp2 of an integer, log2 of a power of 2, or pow of a perfect
+// power, are detected beforehand and rounded exactly. For all other arguments the function value is transcendental
+// or has more significant bits than a posit midpoint, and the loop terminates.
+
+namespace sw {
+namespace unum {
+namespace internal {
+
+// binary floating-point value with a precision of n limbs, chosen at run-time: the value is
+// (-1)^sign * m * 2^(exp - 64n + 1), with the msb of m[n - 1] set. Arithmetic truncates toward zero,
+// which makes the relative error of each operation smaller than 2^(1 - 64n).
+template<size_t CAP>
+class wide_float {
+public:
+	bool     sign;
+	bool     zero;
+	int      exp;     // scale of the leading bit
+	size_t   n;       // limbs in use
+	uint64_t m[CAP];
+
+	explicit wide_float(size_t limbs = 1) : sign(false), zero(true), exp(0), n(limbs) {}
+	wide_float(const wide_float& rhs) : sign(rhs.sign), zero(rhs.zero), exp(rhs.exp), n(rhs.n) {
+		if (!zero) for (size_t i = 0; i < n; ++i) m[i] = rhs.m[i];
+	}
+	wide_float& operator=(const wide_float& rhs) {
+		sign = rhs.sign; zero = rhs.zero; exp = rhs.exp; n = rhs.n;
+		if (!zero) for (size_t i = 0; i < n; ++i) m[i] = rhs.m[i];
+		return *this;
+	}
+
+	// the 64 bits of the integer x[len] that start at bit offset off, which may be negative
+	static uint64_t window(const uint64_t* x, size_t len, long long off) {
+		long long q = (off >= 0 ? off / 64 : -((-off + 63) / 64));
+		unsigned r = unsigned(off - 64 * q);
+		uint64_t lo = (q >= 0 && q < (long long)len) ? x[q] : 0;
+		if (r == 0) return lo;
+		uint64_t hi = (q + 1 >= 0 && q + 1 < (long long)len) ? x[q + 1] : 0;
+		return (lo >> r) | (hi << (64 - r));
+	}
+
+	// assign the nonnegative integer x[len] times 2^lsb, truncated to n limbs: x must not alias m
+	void assign(const uint64_t* x, size_t len, long long lsb, bool negative = false) {
+		size_t top = len;
+		while (top > 0 && x[top - 1] == 0) --top;
+		sign = negative;
+		if (top == 0) {
+			zero = true;
+			exp = 0;
+			return;
+		}
+		zero = false;
+		long long msb = 64 * (long long)top - 1 - clz64(x[top - 1]);
+		long long off = msb - (64 * (long long)n - 1);
+		for (size_t j = 0; j < n; ++j) m[j] = window(x, len, off + 64 * (long long)j);
+		exp = int(lsb + msb);
+	}
+	void assign(uint64_t v, bool negative = false) {
+		assign(&v, 1, 0, negative);
+	}
+	void assign(double v) {
+		if (v == 0.0) {
+			zero = true;
+			sign = false;
+			exp = 0;
+			return;
+		}
+		int e = 0;
+		uint64_t s = uint64_t(std::ldexp(std::frexp(std::fabs(v), &e), 64));
+		assign(&s, 1, (long long)e - 64, v < 0);
+	}
+	// the leading limbs of a value of any capacity
+	template<size_t C>
+	void assign(const wide_float<C>& v) {
+		sign = v.sign;
+		zero = v.zero;
+		exp = v.exp;
+		if (zero) return;
+		for (size_t j = 0; j < n; ++j) m[n - 1 - j] = (j < v.n ? v.m[v.n - 1 - j] : 0);
+	}
+
+	// change the number of limbs in use, truncating or padding with zeros
+	void set_precision(size_t limbs) {
+		if (!zero) {
+			if (limbs > n) {
+				size_t d = limbs - n;
+				for (size_t i = limbs; i-- > 0; ) m[i] = (i >= d ? m[i - d] : 0);
+			}
+			else if (limbs < n) {
+				size_t d = n - limbs;
+				for (size_t i = 0; i < limbs; ++i) m[i] = m[i + d];
+			}
+		}
+		n = limbs;
+	}
+
+	double to_double() const {
+		if (zero) return 0.0;
+		double v = std::ldexp(double(m[n - 1]), exp - 63);
+		return sign ? -v : v;
+	}
+	bool isone() const {
+		if (zero || sign || exp != 0 || m[n - 1] != (uint64_t(1) << 63)) return false;
+		for (size_t i = 0; i + 1 < n; ++i) if (m[i]) return false;
+		return true;
+	}
+	// compare magnitudes of values of the same precision
+	static int compare_magnitude(const wide_float& a, const wide_float& b) {
+		if (a.zero || b.zero) return (a.zero ? 0 : 1) - (b.zero ? 0 : 1);
+		if (a.exp != b.exp) return a.exp < b.exp ? -1 : 1;
+		for (size_t i = a.n; i-- > 0; ) {
+			if (a.m[i] != b.m[i]) return a.m[i] < b.m[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	// this = a + b, or a - b, at the precision of a
+	void add(const wide_float& a, const wide_float& b, bool subtract = false) {
+		size_t prec = a.n;
+		bool bsign = b.sign ^ subtract;
+		if (b.zero) {
+			*this = a;
+			return;
+		}
+		if (a.zero) {
+			*this = b;
+			sign = bsign;
+			set_precision(prec);
+			return;
+		}
+		const wide_float* big = &a;
+		const wide_float* small = &b;
+		bool bigsign = a.sign, smallsign = bsign;
+		if (b.exp > a.exp || (b.exp == a.exp && compare_mantissa(b, a) > 0)) {
+			big = &b;
+			small = &a;
+			bigsign = bsign;
+			smallsign = a.sign;
+		}
+		// a carry limb above and a guard limb below the precision of the result
+		uint64_t t[CAP + 2], s[CAP + 2];
+		size_t len = prec + 2;
+		long long off = 64 * ((long long)big->n - (long long)prec - 1);
+		long long offs = 64 * ((long long)small->n - (long long)prec - 1) + (long long)big->exp - small->exp;
+		for (size_t j = 0; j < len; ++j) {
+			t[j] = window(big->m, big->n, off + 64 * (long long)j);
+			s[j] = window(small->m, small->n, offs + 64 * (long long)j);
+		}
+		if (bigsign == smallsign) {
+			uint64_t carry = 0;
+			for (size_t j = 0; j < len; ++j) {
+				uint64_t x = t[j] + carry;
+				carry = (x < carry);
+				t[j] = x + s[j];
+				carry += (t[j] < x);
+			}
+		}
+		else {
+			uint64_t borrow = 0;
+			for (size_t j = 0; j < len; ++j) {
+				uint64_t x = t[j] - borrow;
+				borrow = (t[j] < borrow);
+				borrow += (x < s[j]);
+				t[j] = x - s[j];
+			}
+		}
+		long long lsb = (long long)big->exp - (64 * (long long)(prec + 1) - 1);
+		n = prec;
+		assign(t, len, lsb, bigsign);
+	}
+
+	// this = a * b at the precision of a
+	void mul(const wide_float& a, const wide_float& b) {
+		size_t prec = a.n;
+		if (a.zero || b.zero) {
+			zero = true;
+			sign = false;
+			n = prec;
+			return;
+		}
+		uint64_t p[2 * CAP];
+		size_t la = a.n, lb = b.n;
+		for (size_t i = 0; i < la + lb; ++i) p[i] = 0;
+		for (size_t i = 0; i < la; ++i) {
+			uint64_t carry = 0;
+			for (size_t j = 0; j < lb; ++j) {
+				uint64_t hi, lo = mul64x64(a.m[i], b.m[j], hi);
+				lo += carry;
+				hi += (lo < carry);
+				uint64_t sum = p[i + j] + lo;
+				hi += (sum < lo);
+				p[i + j] = sum;
+				carry = hi;
+			}
+			p[i + lb] = carry;
+		}
+		long long lsb = ((long long)a.exp - (64 * (long long)la - 1)) + ((long long)b.exp - (64 * (long long)lb - 1));
+		bool negative = a.sign ^ b.sign;
+		n = prec;
+		assign(p, la + lb, lsb, negative);
+	}
+
+	// this = a * k
+	void mul(const wide_float& a, uint64_t k) {
+		if (a.zero || k == 0) {
+			zero = true;
+			sign = false;
+			n = a.n;
+			return;
+		}
+		uint64_t p[CAP + 1], carry = 0;
+		for (size_t i = 0; i < a.n; ++i) {
+			uint64_t hi, lo = mul64x64(a.m[i], k, hi);
+			lo += carry;
+			hi += (lo < carry);
+			p[i] = lo;
+			carry = hi;
+		}
+		p[a.n] = carry;
+		n = a.n;
+		assign(p, a.n + 1, (long long)a.exp - (64 * (long long)a.n - 1), a.sign);
+	}
+
+	// this = a / k
+	void div(const wide_float& a, uint64_t k) {
+		if (a.zero) {
+			*this = a;
+			return;
+		}
+		uint64_t q[CAP + 1], rem = 0;
+		for (size_t i = a.n + 1; i-- > 0; ) q[i] = div128by64(rem, (i > 0 ? a.m[i - 1] : 0), k, rem);
+		n = a.n;
+		assign(q, a.n + 1, (long long)a.exp - (64 * (long long)a.n - 1) - 64, a.sign);
+	}
+
+	// this = 1 / a by Newton's iteration y = y + y (1 - a y), which doubles the correct bits per step
+	// the relative error is below 4 units of 2^(1 - 64n)
+	void reciprocal(const wide_float& a) {
+		size_t prec = a.n;
+		int e = a.exp;
+		bool negative = a.sign;
+		wide_float x(a), y(prec), t(prec), one(prec);
+		x.exp = 0;
+		x.sign = false;
+		one.assign(uint64_t(1));
+		y.assign(1.0 / x.to_double());
+		for (long long bits = 50; ; bits *= 2) {
+			t.mul(x, y);
+			t.add(one, t, true);
+			t.mul(y, t);
+			y.add(y, t);
+			if (bits > 64 * (long long)prec + 8) break;
+		}
+		*this = y;
+		exp -= e;
+		sign = negative;
+	}
+
+	// this = a / b, the relative error is below 6 units of 2^(1 - 64n)
+	void div(const wide_float& a, const wide_float& b) {
+		wide_float r(b.n);
+		r.reciprocal(b);
+		r.set_precision(a.n);
+		mul(a, r);
+	}
+
+	// this = sqrt(a) for a > 0 by Newton's iteration on the reciprocal square root, finished with
+	// Karp's correction: the relative error is below 4 units of 2^(1 - 64n)
+	void sqrt(const wide_float& a) {
+		size_t prec = a.n;
+		if (a.zero) {
+			*this = a;
+			return;
+		}
+		int h = (a.exp >= 0 ? a.exp / 2 : -((-a.exp + 1) / 2));
+		wide_float x(a), y(prec), t(prec), one(prec);
+		x.exp = a.exp - 2 * h;   // x in [1, 4)
+		one.assign(uint64_t(1));
+		y.assign(1.0 / std::sqrt(x.to_double()));
+		for (long long bits = 50; ; bits *= 2) {
+			t.mul(y, y);
+			t.mul(x, t);
+			t.add(one, t, true);
+			t.mul(y, t);
+			if (!t.zero) t.exp -= 1;
+			y.add(y, t);
+			if (bits > 64 * (long long)prec + 8) break;
+		}
+		wide_float s(prec);
+		s.mul(x, y);
+		t.mul(s, s);
+		t.add(x, t, true);
+		t.mul(y, t);
+		if (!t.zero) t.exp -= 1;
+		s.add(s, t);
+		*this = s;
+		exp += h;
+	}
+
+	// split this value into the nearest integer q and the remainder f = this - q with |f| <= 1/2:
+	// returns the two least significant bits of q, the remainder carries the precision of this value
+	unsigned split(wide_float& f) const {
+		f.n = n;
+		if (zero || exp < -1) {
+			f = *this;
+			return 0;
+		}
+		const long long bits = 64 * (long long)n;
+		long long i0 = bits - 1 - exp;   // position of the bit of weight 2^0
+		auto bit = [this, bits](long long i) -> unsigned {
+			return (i >= 0 && i < bits) ? unsigned((m[i / 64] >> (i % 64)) & 0x1) : 0u;
+		};
+		unsigned q = bit(i0) | (bit(i0 + 1) << 1);
+		bool half = bit(i0 - 1) != 0;
+		uint64_t fr[CAP];
+		for (size_t i = 0; i < n; ++i) {
+			long long lo = 64 * (long long)i;
+			if (lo + 64 <= i0) fr[i] = m[i];
+			else if (lo >= i0) fr[i] = 0;
+			else fr[i] = m[i] & ((uint64_t(1) << (i0 - lo)) - 1);
+		}
+		bool fsign = sign;
+		if (half) {
+			// f - 1 = -(2^i0 - f) within the i0 fraction bits
+			++q;
+			fsign = !sign;
+			uint64_t carry = 1;
+			for (size_t i = 0; i < n; ++i) {
+				fr[i] = ~fr[i] + carry;
+				carry = (carry && fr[i] == 0);
+				long long lo = 64 * (long long)i;
+				if (lo >= i0) fr[i] = 0;
+				else if (lo + 64 > i0) fr[i] &= (uint64_t(1) << (i0 - lo)) - 1;
+			}
+		}
+		if (sign) q = 0u - q;
+		f.assign(fr, n, (long long)exp - (bits - 1), fsign);
+		return q & 0x3;
+	}
+
+private:
+	static int compare_mantissa(const wide_float& a, const wide_float& b) {
+		size_t len = (a.n > b.n ? a.n : b.n);
+		for (size_t j = 0; j < len; ++j) {
+			uint64_t x = (j < a.n ? a.m[a.n - 1 - j] : 0);
+			uint64_t y = (j < b.n ? b.m[b.n - 1 - j] : 0);
+			if (x != y) return x < y ? -1 : 1;
+		}
+		return 0;
+	}
+};
+
+// Errors are expressed in units of the relative precision u = 2^(1 - 64n) of a wide_float with n limbs.
+// The error of a sum follows from the errors of its terms and the cancellation between them.
+template<size_t CAP>
+inline double sum_error(double ea, const wide_float<CAP>& a, double eb, const wide_float<CAP>& b, const wide_float<CAP>& y) {
+	if (y.zero) return HUGE_VAL;
+	double e = 2.0;
+	if (!a.zero) e += 2.0 * ea * std::ldexp(1.0, a.exp - y.exp);
+	if (!b.zero) e += 2.0 * eb * std::ldexp(1.0, b.exp - y.exp);
+	return e;
+}
+
+// number of terms T of a series in x^i / i! with |x| < 2^-h such that the tail stays below 2^-bits
+inline size_t taylor_terms(int h, long long bits) {
+	double weight = 0.0;
+	for (size_t k = 1; ; ++k) {
+		weight += h + std::log2(double(k));
+		if (weight >= double(bits)) return k - 1;
+	}
+}
+
+// the constants of the kernels at the full precision of the engine, computed once with an extra limb
+template<size_t CAP>
+class wide_constants {
+public:
+	wide_float<CAP> ln2, ln10, pi, half_pi, two_over_pi, two_over_sqrt_pi;
+
+	static const wide_constants& get() {
+		static const wide_constants c;
+		return c;
+	}
+
+private:
+	using guarded = wide_float<CAP + 1>;
+
+	wide_constants() : ln2(CAP), ln10(CAP), pi(CAP), half_pi(CAP), two_over_pi(CAP), two_over_sqrt_pi(CAP) {
+		const size_t prec = CAP + 1;
+		guarded a(prec), b(prec), t(prec);
+		// ln 2 = 2 atanh(1/3), ln 10 = 3 ln 2 + 2 atanh(1/9)
+		atanh_inverse(3, a);
+		a.exp += 1;
+		ln2.assign(a);
+		atanh_inverse(9, b);
+		b.exp += 1;
+		t.mul(a, uint64_t(3));
+		t.add(t, b);
+		ln10.assign(t);
+		// pi = 16 atan(1/5) - 4 atan(1/239)
+		atan_inverse(5, a);
+		a.exp += 4;
+		atan_inverse(239, b);
+		b.exp += 2;
+		t.add(a, b, true);
+		pi.assign(t);
+		half_pi.assign(t);
+		half_pi.exp -= 1;
+		a.reciprocal(t);
+		a.exp += 1;
+		two_over_pi.assign(a);
+		b.sqrt(t);
+		a.reciprocal(b);
+		a.exp += 1;
+		two_over_sqrt_pi.assign(a);
+	}
+	// sum of 1 / ((2k+1) m^(2k+1)), with alternating signs for atan
+	static void series_inverse(uint64_t m, guarded& sum, bool alternate) {
+		size_t prec = sum.n;
+		guarded p(prec), t(prec);
+		p.assign(uint64_t(1));
+		p.div(p, m);
+		sum = p;
+		for (uint64_t k = 1; ; ++k) {
+			p.div(p, m);
+			p.div(p, m);
+			if (p.exp < sum.exp - 64 * (long long)prec - 8) break;
+			t.div(p, 2 * k + 1);
+			sum.add(sum, t, alternate && (k & 0x1));
+		}
+	}
+	static void atanh_inverse(uint64_t m, guarded& sum) { series_inverse(m, sum, false); }
+	static void atan_inverse(uint64_t m, guarded& sum) { series_inverse(m, sum, true); }
+};
+
+// a constant at the precision of y
+template<size_t CAP>
+inline void load_constant(const wide_float<CAP>& c, wide_float<CAP>& y) {
+	y.assign(c);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// kernels: each kernel evaluates its function at the precision of y, for an argument of that
+// precision, and returns the bound on the relative error of y in units of 2^(1 - 64n)
+
+// exp(x) = 2^k exp(r)^(2^s) with r = (x - k ln2) / 2^s
+template<size_t CAP>
+inline double wide_exp(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	real one(n);
+	one.assign(uint64_t(1));
+	if (x.zero) {
+		y = one;
+		return 0.0;
+	}
+	const auto& c = wide_constants<CAP>::get();
+	real ln2(n), r(x), t(n);
+	load_constant(c.ln2, ln2);
+	long long k = std::llround(x.to_double() / 0.69314718055994531);
+	if (k != 0) {
+		t.mul(ln2, uint64_t(k < 0 ? -k : k));
+		t.sign = (k < 0);
+		r.add(r, t, true);
+	}
+	int h = int(std::sqrt(double(bits)) / 2);
+	int s = 0;
+	size_t T = 0;
+	if (!r.zero) {
+		s = r.exp + 1 + h;
+		if (s < 0) s = 0;
+		r.exp -= s;
+		T = taylor_terms(-(r.exp + 1), bits + 4);
+	}
+	real p(one);
+	for (size_t i = T; i >= 1; --i) {
+		p.mul(p, r);
+		p.div(p, uint64_t(i));
+		p.add(one, p);
+	}
+	for (int i = 0; i < s; ++i) p.mul(p, p);
+	p.exp += int(k);
+	y = p;
+	return std::ldexp(3.0 * double(T) + 2.0, s) + 16.0 * (std::fabs(double(k)) + 1.0);
+}
+
+// exp(x) - 1 without cancellation: a Taylor sum of the scaled argument, doubled with e (e + 2)
+template<size_t CAP>
+inline double wide_expm1(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	real one(n);
+	one.assign(uint64_t(1));
+	if (x.zero) {
+		y = x;
+		return 0.0;
+	}
+	if (x.exp >= -1) {
+		real e(n);
+		double ee = wide_exp(x, e);
+		y.add(e, one, true);
+		return sum_error(ee, e, 0.0, one, y);
+	}
+	int h = int(std::sqrt(double(bits)) / 2);
+	int s = x.exp + 1 + h;
+	if (s < 0) s = 0;
+	real r(x), p(one), t(n), two(n);
+	r.exp -= s;
+	two.assign(uint64_t(2));
+	size_t T = taylor_terms(-(r.exp + 1), bits + 4);
+	for (size_t i = T; i >= 2; --i) {
+		p.mul(p, r);
+		p.div(p, uint64_t(i));
+		p.add(one, p);
+	}
+	p.mul(p, r);
+	for (int i = 0; i < s; ++i) {
+		t.add(p, two);
+		p.mul(p, t);
+	}
+	y = p;
+	return (3.0 * double(T) + 3.0 * s + 4.0) * std::pow(1.25, double(s));
+}
+
+// ln(x) for x > 0 as e ln2 + ln(f), f in [1/sqrt2, sqrt2): ln(f) = 2 atanh((f - 1) / (f + 1))
+// returns e and ln(f), the sum is left to the caller so that log2 and log10 keep powers of 2 exact
+template<size_t CAP>
+inline double wide_log_parts(const wide_float<CAP>& x, int& e, wide_float<CAP>& lf) {
+	using real = wide_float<CAP>;
+	const size_t n = lf.n;
+	const long long bits = 64 * (long long)n;
+	real one(n), f(x), num(n), den(n), z(n), w(n), p(n), t(n);
+	one.assign(uint64_t(1));
+	e = x.exp;
+	f.exp = 0;
+	f.sign = false;
+	if (f.m[n - 1] > 0xB504F333F9DE6484ull) {   // f > sqrt(2)
+		f.exp = -1;
+		++e;
+	}
+	num.add(f, one, true);
+	if (num.zero) {
+		lf = num;
+		return 0.0;
+	}
+	den.add(f, one);
+	z.div(num, den);
+	w.mul(z, z);
+	size_t T = size_t((bits + 4) / (-(w.exp + 1))) + 1;
+	p.assign(uint64_t(1));
+	p.div(p, uint64_t(2 * T + 1));
+	for (size_t k = T; k-- > 0; ) {
+		p.mul(p, w);
+		t.assign(uint64_t(1));
+		t.div(t, uint64_t(2 * k + 1));
+		p.add(p, t);
+	}
+	lf.mul(z, p);
+	lf.exp += 1;
+	return 3.0 * double(T) + 24.0;
+}
+
+template<size_t CAP>
+inline double wide_log(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	int e = 0;
+	real lf(n);
+	double el = wide_log_parts(x, e, lf);
+	if (e == 0) {
+		y = lf;
+		return el;
+	}
+	real t(n);
+	load_constant(wide_constants<CAP>::get().ln2, t);
+	t.mul(t, uint64_t(e < 0 ? -(long long)e : e));
+	t.sign = (e < 0);
+	y.add(t, lf);
+	return sum_error(4.0, t, el, lf, y);
+}
+
+template<size_t CAP>
+inline double wide_log2(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	int e = 0;
+	real lf(n), ln2(n), t(n);
+	double el = wide_log_parts(x, e, lf);
+	load_constant(wide_constants<CAP>::get().ln2, ln2);
+	lf.div(lf, ln2);
+	el += 8.0;
+	if (e == 0) {
+		y = lf;
+		return el;
+	}
+	t.assign(uint64_t(e < 0 ? -(long long)e : e), e < 0);
+	y.add(t, lf);
+	return sum_error(0.0, t, el, lf, y);
+}
+
+template<size_t CAP>
+inline double wide_log10(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	real l(y.n), ln10(y.n);
+	double el = wide_log(x, l);
+	load_constant(wide_constants<CAP>::get().ln10, ln10);
+	y.div(l, ln10);
+	return el + 8.0;
+}
+
+// ln(1 + x) for x > -1 with Kahan's correction ln(u) x / (u - 1), u = 1 + x
+template<size_t CAP>
+inline double wide_log1p(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	if (x.zero) {
+		y = x;
+		return 0.0;
+	}
+	real one(n), u(n), d(n), l(n), q(n);
+	one.assign(uint64_t(1));
+	u.add(one, x);
+	if (u.isone()) {   // |x| is below the precision: ln(1 + x) = x (1 - x/2 + ...)
+		y = x;
+		return 2.0;
+	}
+	d.add(u, one, true);
+	double el = wide_log(u, l);
+	q.div(x, d);
+	y.mul(l, q);
+	return el + 10.0;
+}
+
+// reduce x by multiples of pi/2: r = x - q pi/2 with |r| <= pi/4, returns the bound on the relative error of r
+template<size_t CAP>
+inline double wide_reduce_half_pi(const wide_float<CAP>& x, wide_float<CAP>& r, unsigned& q) {
+	using real = wide_float<CAP>;
+	const size_t n = r.n;
+	q = 0;
+	if (x.exp < -1 || (x.exp == -1 && x.m[x.n - 1] <= 0xC90FDAA22168C234ull)) {   // |x| <= pi/4
+		r = x;
+		r.set_precision(n);
+		return 0.0;
+	}
+	// the product x 2/pi needs the integer bits of x on top of the precision of the remainder
+	size_t nr = n + nr_limbs(size_t(x.exp < 0 ? 0 : x.exp) + 64) + 1;
+	if (nr > CAP) nr = CAP;
+	const auto& c = wide_constants<CAP>::get();
+	real xx(x), t(nr), f(nr), k(nr);
+	xx.set_precision(nr);
+	load_constant(c.two_over_pi, k);
+	t.mul(xx, k);
+	q = t.split(f);
+	if (f.zero) return HUGE_VAL;
+	load_constant(c.half_pi, k);
+	r.mul(f, k);
+	r.set_precision(n);
+	// t carries an absolute error below 2^(t.exp + 3 - 64 nr), which is relative to the remainder f
+	long long scale = (long long)t.exp + 3 - 64 * (long long)nr - f.exp + 64 * (long long)n;
+	if (scale > 1000) return HUGE_VAL;
+	return std::ldexp(1.0, int(scale)) + 4.0;
+}
+
+// sin(r) and cos(r) for |r| <= pi/4
+template<size_t CAP>
+inline double wide_sin_series(const wide_float<CAP>& r, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	if (r.zero) {
+		y = r;
+		return 0.0;
+	}
+	real w(n), p(n), one(n);
+	one.assign(uint64_t(1));
+	w.mul(r, r);
+	int h = -(r.exp + 1);
+	size_t T = taylor_terms(h, bits + 4) / 2 + 1;
+	p = one;
+	for (size_t i = T; i >= 1; --i) {
+		p.mul(p, w);
+		p.div(p, uint64_t(2 * i) * uint64_t(2 * i + 1));
+		p.add(one, p, true);
+	}
+	y.mul(r, p);
+	return 4.0 * double(T) + 4.0;
+}
+template<size_t CAP>
+inline double wide_cos_series(const wide_float<CAP>& r, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	real w(n), p(n), one(n);
+	one.assign(uint64_t(1));
+	if (r.zero) {
+		y = one;
+		return 0.0;
+	}
+	w.mul(r, r);
+	int h = -(r.exp + 1);
+	size_t T = taylor_terms(h, bits + 4) / 2 + 1;
+	p = one;
+	for (size_t i = T; i >= 1; --i) {
+		p.mul(p, w);
+		p.div(p, uint64_t(2 * i - 1) * uint64_t(2 * i));
+		p.add(one, p, true);
+	}
+	y = p;
+	return 4.0 * double(T) + 4.0;
+}
+
+enum class trig_function { sin, cos, tan, cot, sec, csc };
+
+// the trigonometric functions from sin(r) and cos(r) of the reduced argument and its quadrant
+template<size_t CAP>
+inline double wide_trig(const wide_float<CAP>& x, wide_float<CAP>& y, trig_function fn) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real r(n), s(n), c(n), one(n);
+	unsigned q = 0;
+	double er = wide_reduce_half_pi(x, r, q);
+	if (er == HUGE_VAL) {
+		y.zero = true;
+		return HUGE_VAL;
+	}
+	double es = wide_sin_series(r, s) + er;
+	double ec = wide_cos_series(r, c) + er;
+	// sin(x) and cos(x) in the quadrant q
+	if (q & 0x1) {
+		std::swap(s, c);
+		std::swap(es, ec);
+	}
+	if (q == 2 || q == 3) s.sign = !s.sign;
+	if (q == 1 || q == 2) c.sign = !c.sign;
+	one.assign(uint64_t(1));
+	switch (fn) {
+	case trig_function::sin: y = s; return es;
+	case trig_function::cos: y = c; return ec;
+	case trig_function::tan: y.div(s, c); return es + ec + 8.0;
+	case trig_function::cot: y.div(c, s); return es + ec + 8.0;
+	case trig_function::sec: y.reciprocal(c); return ec + 6.0;
+	case trig_function::csc: y.reciprocal(s); return es + 6.0;
+	}
+	return HUGE_VAL;
+}
+
+// atan(x): atan(x) = pi/2 - atan(1/x) for |x| > 1, and atan(a) = 2 atan(a / (1 + sqrt(1 + a^2)))
+// until a < 1/8, followed by the alternating series
+template<size_t CAP>
+inline double wide_atan(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	if (x.zero) {
+		y = x;
+		return 0.0;
+	}
+	const auto& c = wide_constants<CAP>::get();
+	real a(x), one(n), t(n), w(n), p(n);
+	one.assign(uint64_t(1));
+	a.sign = false;
+	double ea = 0.0;
+	if (a.isone()) {
+		load_constant(c.pi, y);
+		y.exp -= 2;
+		y.sign = x.sign;
+		return 2.0;
+	}
+	bool invert = (a.exp >= 0);
+	if (invert) {
+		a.reciprocal(a);
+		ea = 4.0;
+	}
+	int j = 0;
+	while (a.exp >= -3) {
+		t.mul(a, a);
+		t.add(one, t);
+		t.sqrt(t);
+		t.add(one, t);
+		a.div(a, t);
+		++j;
+		ea += 16.0;
+	}
+	w.mul(a, a);
+	size_t T = size_t((bits + 4) / (-(w.exp + 1))) + 1;
+	p.assign(uint64_t(1));
+	p.div(p, uint64_t(2 * T + 1));
+	for (size_t k = T; k-- > 0; ) {
+		p.mul(p, w);
+		t.assign(uint64_t(1));
+		t.div(t, uint64_t(2 * k + 1));
+		p.add(t, p, true);
+	}
+	real v(n);
+	v.mul(a, p);
+	v.exp += j;
+	double ev = ea + 3.0 * double(T) + 8.0;
+	if (invert) {
+		load_constant(c.half_pi, t);
+		y.add(t, v, true);
+		ev = sum_error(2.0, t, ev, v, y);
+	}
+	else {
+		y = v;
+	}
+	y.sign = x.sign;
+	return ev;
+}
+
+// asin(x) = atan(x / sqrt((1 - x)(1 + x))) for |x| < 1
+template<size_t CAP>
+inline double wide_asin(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), one(n), d(n), t(n);
+	a.sign = false;
+	one.assign(uint64_t(1));
+	d.add(one, a, true);
+	t.add(one, a);
+	d.mul(d, t);
+	d.sqrt(d);
+	t.div(a, d);
+	t.sign = x.sign;
+	return wide_atan(t, y) + 16.0;
+}
+
+// acos(x) = 2 atan(sqrt((1 - x) / (1 + x))) for -1 < x < 1
+template<size_t CAP>
+inline double wide_acos(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real one(n), d(n), t(n);
+	one.assign(uint64_t(1));
+	d.add(one, x, true);
+	t.add(one, x);
+	d.div(d, t);
+	d.sqrt(d);
+	double e = wide_atan(d, y) + 16.0;
+	y.exp += 1;
+	return e;
+}
+
+// sinh(x) = (e + e / (e + 1)) / 2 with e = expm1(|x|)
+template<size_t CAP>
+inline double wide_sinh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), e(n), d(n), one(n);
+	a.sign = false;
+	one.assign(uint64_t(1));
+	double ee = wide_expm1(a, e);
+	d.add(e, one);
+	d.div(e, d);
+	y.add(e, d);
+	y.exp -= 1;
+	y.sign = x.sign;
+	return 2.0 * ee + 12.0;
+}
+
+// cosh(x) = (e + 1 / e) / 2 with e = exp(|x|)
+template<size_t CAP>
+inline double wide_cosh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), e(n), r(n);
+	a.sign = false;
+	double ee = wide_exp(a, e);
+	r.reciprocal(e);
+	y.add(e, r);
+	y.exp -= 1;
+	return ee + 8.0;
+}
+
+// tanh(x) = e / (e + 2) with e = expm1(2|x|)
+template<size_t CAP>
+inline double wide_tanh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), e(n), d(n), two(n);
+	a.sign = false;
+	a.exp += 1;
+	two.assign(uint64_t(2));
+	double ee = wide_expm1(a, e);
+	d.add(e, two);
+	y.div(e, d);
+	y.sign = x.sign;
+	return 2.0 * ee + 10.0;
+}
+
+// sigmoid(x) = 1 / (1 + e^-x)
+template<size_t CAP>
+inline double wide_sigmoid(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), e(n), d(n), one(n);
+	a.sign = !a.sign;
+	one.assign(uint64_t(1));
+	double ee = wide_exp(a, e);
+	d.add(one, e);
+	y.div(one, d);
+	return ee + 10.0;
+}
+
+// 1 / sqrt(x) for x > 0
+template<size_t CAP>
+inline double wide_rsqrt(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	real s(y.n);
+	s.sqrt(x);
+	y.reciprocal(s);
+	return 10.0;
+}
+
+// asinh(x) = log1p(|x| + x^2 / (1 + sqrt(1 + x^2)))
+template<size_t CAP>
+inline double wide_asinh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), one(n), t(n), s(n);
+	a.sign = false;
+	one.assign(uint64_t(1));
+	t.mul(a, a);
+	s.add(one, t);
+	s.sqrt(s);
+	s.add(one, s);
+	t.div(t, s);
+	t.add(a, t);
+	double e = wide_log1p(t, y) + 20.0;
+	y.sign = x.sign;
+	return e;
+}
+
+// acosh(x) = log1p((x - 1) + sqrt((x - 1)(x + 1))) for x > 1
+template<size_t CAP>
+inline double wide_acosh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real one(n), d(n), t(n);
+	one.assign(uint64_t(1));
+	d.add(x, one, true);
+	t.add(x, one);
+	t.mul(d, t);
+	t.sqrt(t);
+	t.add(d, t);
+	return wide_log1p(t, y) + 12.0;
+}
+
+// atanh(x) = log1p(2x / (1 - x)) / 2 for |x| < 1
+template<size_t CAP>
+inline double wide_atanh(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real a(x), one(n), d(n), t(n);
+	a.sign = false;
+	one.assign(uint64_t(1));
+	d.add(one, a, true);
+	t.div(a, d);
+	t.exp += 1;
+	double e = wide_log1p(t, y) + 12.0;
+	y.exp -= 1;
+	y.sign = x.sign;
+	return e;
+}
+
+// erf(x) = 2/sqrt(pi) x exp(-x^2) sum (2x^2)^k / (1 3 5 ... (2k+1)), a series of positive terms
+template<size_t CAP>
+inline double wide_erf(const wide_float<CAP>& x, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	const long long bits = 64 * (long long)n;
+	if (x.zero) {
+		y = x;
+		return 0.0;
+	}
+	real a(x), w(n), term(n), sum(n), g(n);
+	a.sign = false;
+	w.mul(a, a);
+	double wd = w.to_double();
+	term.assign(uint64_t(1));
+	sum = term;
+	w.exp += 1;
+	size_t K = 0;
+	for (uint64_t k = 1; ; ++k) {
+		term.mul(term, w);
+		term.div(term, 2 * k + 1);
+		sum.add(sum, term);
+		if (double(k) > 2.0 * wd && term.exp < sum.exp - bits - 4) {
+			K = size_t(k);
+			break;
+		}
+	}
+	w.exp -= 1;
+	w.sign = true;
+	double eg = wide_exp(w, g) + wd + 1.0;
+	load_constant(wide_constants<CAP>::get().two_over_sqrt_pi, y);
+	y.mul(y, a);
+	y.mul(y, g);
+	y.mul(y, sum);
+	y.sign = x.sign;
+	return eg + 4.0 * double(K) + 12.0;
+}
+
+// x^y = exp(y ln x) for x > 0: the error of y ln x is amplified by its magnitude
+template<size_t CAP>
+inline double wide_pow(const wide_float<CAP>& x, const wide_float<CAP>& yy, wide_float<CAP>& y) {
+	using real = wide_float<CAP>;
+	const size_t n = y.n;
+	real l(n), z(n);
+	double el = wide_log(x, l);
+	z.mul(l, yy);
+	double ez = wide_exp(z, y);
+	return ez + 2.0 * (std::fabs(z.to_double()) + 1.0) * (el + 2.0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// the fixed-point tier: posits with nbits <= 32 carry at most 30 significand bits, so a single 64-bit
+// word holds the function value with enough guard bits to decide the rounding for all but a handful
+// of arguments. The kernels of this tier reduce the argument with tables, evaluate short polynomials
+// in 64-bit fixed-point, and return a bound on the error in units of the last bit of the result.
+// The logarithm, the series of sin and cos, and the power evaluate their polynomials on the floating-point
+// unit instead, whose independent multiply and add pipelines are shorter than the chains of 64-bit integer
+// products: the posit significand is exact in a double, and the bounds of these kernels cover the rounding
+// errors of the double operations. An argument whose rounding the bound can not decide falls through to the
+// wide_float engine.
+
+// binary floating-point value with a single word significand: (-1)^sign * m * 2^(exp - 63), msb of m set
+struct word_float {
+	bool     sign;
+	int      exp;
+	uint64_t m;
+};
+
+// upper 64 bits of the product of two words
+inline uint64_t word_mulhi(uint64_t a, uint64_t b) {
+	uint64_t hi;
+	mul64x64(a, b, hi);
+	return hi;
+}
+// upper 64 bits of the product of two signed words, rounded toward minus infinity
+inline int64_t word_smulhi(int64_t a, int64_t b) {
+#if LIMBS_HAVE_INT128
+	__extension__ typedef __int128 int128_limb_t;
+	return int64_t((int128_limb_t(a) * b) >> 64);
+#else
+	uint64_t hi = word_mulhi(uint64_t(a), uint64_t(b));
+	if (a < 0) hi -= uint64_t(b);
+	if (b < 0) hi -= uint64_t(a);
+	return int64_t(hi);
+#endif
+}
+// a b with 63 fraction bits on b, truncated toward -infinity
+inline int64_t word_smul(int64_t a, int64_t b) {
+#if LIMBS_HAVE_INT128
+	__extension__ typedef __int128 int128_limb_t;
+	return int64_t((int128_limb_t(a) * b) >> 63);
+#else
+	return int64_t((uint64_t(word_smulhi(a, b)) << 1) | ((uint64_t(a) * uint64_t(b)) >> 63));
+#endif
+}
+// the nonzero 128-bit integer (hi, lo) times 2^lsb, truncated to a word significand
+inline word_float word_normalize(uint64_t hi, uint64_t lo, int lsb, bool negative = false) {
+	// selects rather than branches: the position of the leading bit is data dependent
+	bool upper = (hi != 0);
+	uint64_t w = (upper ? hi : lo), below = (upper ? lo : 0);
+	unsigned s = clz64(w);
+	word_float r;
+	r.sign = negative;
+	r.m = (w << s) | ((below >> 1) >> (63 - s));
+	r.exp = lsb + (upper ? 127 : 63) - int(s);
+	return r;
+}
+// the nonzero word v times 2^lsb
+inline word_float word_from(uint64_t v, int lsb, bool negative = false) {
+	return word_normalize(0, v, lsb, negative);
+}
+// a * b, with an error below 1 unit of the last bit
+inline word_float word_mul(const word_float& a, const word_float& b) {
+	uint64_t hi, lo = mul64x64(a.m, b.m, hi);
+	return word_normalize(hi, lo, a.exp + b.exp - 126, a.sign != b.sign);
+}
+// a v 2^lsb for the nonzero word v, with an error below 1 unit of the last bit
+inline word_float word_scale(const word_float& a, uint64_t v, int lsb) {
+	uint64_t hi, lo = mul64x64(a.m, v, hi);
+	return word_normalize(hi, lo, a.exp - 63 + lsb, a.sign);
+}
+// a / b, with an error below 1 unit of the last bit
+inline word_float word_div(const word_float& a, const word_float& b) {
+	// a.m >= b.m halves the dividend to keep the quotient in a word: a select rather than a branch
+	bool halve = (a.m >= b.m);
+	uint64_t rem;
+	word_float r;
+	r.sign = (a.sign != b.sign);
+	r.m = div128by64(halve ? a.m >> 1 : a.m, halve ? a.m << 63 : 0, b.m, rem);
+	r.exp = a.exp - b.exp - 1 + int(halve);
+	return r;
+}
+// r^2 as a fraction of 64 bits for |r| < 1
+inline uint64_t word_square(const word_float& r) {
+	unsigned shift = unsigned(-2 - 2 * r.exp);
+	return (shift < 64 ? word_mulhi(r.m, r.m) >> shift : 0);
+}
+// the magnitude of r as a fixed-point number with 63 fraction bits, for |r| < 2
+inline uint64_t word_fixed(const word_float& r) {
+	return (r.exp > 0 ? 0 : (-r.exp < 64 ? r.m >> -r.exp : 0));
+}
+// e 2^shift in whole units for e >= 1, rounded up and saturated at 2^40, beyond which no rounding is certified
+inline uint64_t word_error(uint64_t e, int shift) {
+	if (shift <= 0) return (shift > -64 ? ((e - 1) >> -shift) + 1 : 1);
+	return (shift < 40 && e < (uint64_t(1) << (40 - shift)) ? e << shift : uint64_t(1) << 40);
+}
+// negate the 128-bit integer (hi, lo) in two's complement when mask is all ones, keep it when mask is zero
+inline void word_negate_if(uint64_t& hi, uint64_t& lo, uint64_t mask) {
+	hi = (hi ^ mask) + (mask & uint64_t(lo == 0));
+	lo = (lo ^ mask) - mask;
+}
+// the value (-1)^sign sig 2^(scale - 63) truncated to a double, for -1022 <= scale <= 1023
+inline double word_to_double(bool sign, int scale, uint64_t sig) {
+	uint64_t bits = (uint64_t(sign) << 63) | (uint64_t(scale + 1023) << 52) | ((sig << 1) >> 12);
+	double v;
+	std::memcpy(&v, &bits, sizeof(v));
+	return v;
+}
+// the nonzero normal double v
+inline word_float word_from_double(double v) {
+	uint64_t bits;
+	std::memcpy(&bits, &v, sizeof(bits));
+	return { (bits >> 63) != 0, int((bits >> 52) & 0x7FF) - 1023, (bits << 11) | (uint64_t(1) << 63) };
+}
+// the 64 bits of the integer x[len] that start at the bit offset off
+inline uint64_t word_bits(const uint64_t* x, size_t len, size_t off) {
+	size_t q = off >> 6;
+	unsigned r = unsigned(off & 0x3F);
+	uint64_t lo = (q < len ? x[q] : 0);
+	if (r == 0) return lo;
+	uint64_t hi = (q + 1 < len ? x[q + 1] : 0);
+	return (lo >> r) | (hi << (64 - r));
+}
+
+// the tables and polynomial coefficients of the fixed-point kernels, computed once by the wide_float engine
+class word_tables {
+public:
+	uint64_t exp2_table[64];   // 2^(j/64) with 63 fraction bits
+	uint64_t exp2_poly[8];     // ln2^k / k! with 63 fraction bits
+	double   exp2_double[64];  // 2^(j/64) rounded to a double
+	double   log_recip[128];   // 10-bit approximations of the reciprocal of the bins of [1, 2), halved above 1.5
+	double   log_table[128];   // -ln(recip) rounded to a double
+	uint64_t atan_table[65];   // atan(j/64) with 63 fraction bits
+	uint64_t atan_poly[5];     // 1/(2k+1) with 63 fraction bits
+	int64_t  atan_taylor[65][8];  // atan(j/64 + u/64) - atan(j/64) = sum of c[k] u^(k+1), c[k] with 69 fraction bits
+	uint64_t ln2[2];           // ln2 with 128 fraction bits
+	uint64_t log2e[2];         // log2(e) with 126 fraction bits
+	uint64_t log2_10[2];       // log2(10) with 126 fraction bits
+	uint64_t half_pi_multiples[11][2];  // q pi/2 with 124 fraction bits, low word first
+	uint64_t two_over_pi_word;  // 2/pi with 64 fraction bits
+	double   ln2_head, ln2_tail;  // ln2 in 32 bits, whose products with the exponents are exact, and the rest
+	double   log2e_double, log10e_double;
+	word_float half_pi;
+
+	static const word_tables& get() {
+		static const word_tables t;
+		return t;
+	}
+
+private:
+	static constexpr size_t P = 3;   // precision of the table entries in limbs
+	using real = wide_float<P + 1>;
+	using constants = wide_constants<P + 1>;
+
+	word_tables() {
+		const constants& c = constants::get();
+		real x(P), y(P), t(P), ln2c(P), ln10c(P);
+		load_constant(c.ln2, ln2c);
+		load_constant(c.ln10, ln10c);
+		for (unsigned j = 0; j < 64; ++j) {
+			x.assign(uint64_t(j));
+			x.exp -= 6;
+			x.mul(x, ln2c);
+			wide_exp(x, y);
+			exp2_table[j] = round_word(y, -63);
+			exp2_double[j] = std::ldexp(double(exp2_table[j]), -63);
+		}
+		x.assign(uint64_t(1));
+		for (unsigned k = 0; k < 8; ++k) {
+			exp2_poly[k] = round_word(x, -63);
+			x.mul(x, ln2c);
+			x.div(x, uint64_t(k + 1));
+		}
+		for (unsigned i = 0; i < 128; ++i) {
+			// the bin [1 + i/128, 1 + (i+1)/128), halved from 1.5 on, has the center (257 + 2i) / 256 / 2^half
+			// the first and the last bin keep the reciprocal 1, so that ln(x) close to 1 is a polynomial in x - 1
+			unsigned half = i >> 6;
+			uint64_t d = 257 + 2 * i;
+			uint64_t recip = (i == 0 || i == 127) ? 1024 : ((uint64_t(1) << (19 + half)) / d + 1) / 2;
+			log_recip[i] = std::ldexp(double(recip), -10 - int(half));
+			if (recip == 1024) {
+				log_table[i] = 0.0;
+				continue;
+			}
+			x.assign(recip);
+			x.exp -= 10;
+			wide_log(x, y);
+			log_table[i] = -rounded_double(y);
+		}
+		atan_table[0] = 0;
+		for (unsigned j = 1; j <= 64; ++j) {
+			x.assign(uint64_t(j));
+			x.exp -= 6;
+			wide_atan(x, y);
+			atan_table[j] = round_word(y, -63);
+		}
+		for (uint64_t k = 0; k < 5; ++k) atan_poly[k] = reciprocal(2 * k + 1);
+		for (unsigned m = 0; m < 8; ++m) atan_taylor[0][m] = 0;   // below 1/128 the kernel takes the series
+		for (unsigned j = 1; j <= 64; ++j) {
+			// the derivatives d[m] = (m+1) a[m+1] of the Taylor coefficients a of atan about c follow from
+			// (1 + c^2 + 2ch + h^2) atan'(c + h) = 1: s d[m] = -(2c d[m-1] + d[m-2]) with s = 1 + c^2
+			real c(P), s(P), d0(P), d1(P), d(P), one(P);
+			one.assign(uint64_t(1));
+			c.assign(uint64_t(j));
+			c.exp -= 6;
+			s.mul(c, c);
+			s.add(s, one);
+			for (unsigned m = 0; m < 8; ++m) {
+				if (m == 0) d.div(one, s);
+				else {
+					t.mul(c, d1);
+					t.mul(t, uint64_t(2));
+					if (m > 1) t.add(t, d0);
+					d.div(t, s);
+					d.sign = !d.sign;
+				}
+				y.div(d, uint64_t(m + 1));
+				y.exp -= 6 * int(m + 1);
+				uint64_t w = (y.zero ? 0 : round_word(y, -69));
+				atan_taylor[j][m] = (y.sign ? -int64_t(w) : int64_t(w));
+				d0 = d1;
+				d1 = d;
+			}
+		}
+		ln2[0] = truncate_word(ln2c, -128);
+		ln2[1] = truncate_word(ln2c, -64);
+		ln2_head = std::ldexp(double(truncate_word(ln2c, -32)), -32);
+		ln2_tail = std::ldexp(double(truncate_word(ln2c, -96)), -96);
+		t.assign(uint64_t(1));
+		x.div(t, ln2c);
+		log2e[0] = truncate_word(x, -126);
+		log2e[1] = truncate_word(x, -62);
+		log2e_double = rounded_double(x);
+		x.div(ln10c, ln2c);
+		log2_10[0] = truncate_word(x, -126);
+		log2_10[1] = truncate_word(x, -62);
+		x.div(t, ln10c);
+		log10e_double = rounded_double(x);
+		x.assign(c.half_pi);
+		half_pi = rounded(x);
+		half_pi_multiples[0][0] = half_pi_multiples[0][1] = 0;
+		for (unsigned q = 1; q < 11; ++q) {
+			y.mul(x, uint64_t(q));
+			uint64_t up = truncate_word(y, -125) & 0x1;
+			half_pi_multiples[q][0] = truncate_word(y, -124) + up;
+			half_pi_multiples[q][1] = truncate_word(y, -60) + (up & uint64_t(half_pi_multiples[q][0] == 0));
+		}
+		y.div(t, x);
+		two_over_pi_word = round_word(y, -64);
+	}
+	// 2^63 / d rounded to nearest
+	static uint64_t reciprocal(uint64_t d) {
+		return ((uint64_t(1) << 63) + d / 2) / d;
+	}
+	// the 64 bits of |y| that start at the weight 2^lsb, truncated or rounded to nearest
+	static uint64_t truncate_word(const real& y, int lsb) {
+		return real::window(y.m, y.n, (long long)lsb - ((long long)y.exp - 64 * (long long)y.n + 1));
+	}
+	static uint64_t round_word(const real& y, int lsb) {
+		return truncate_word(y, lsb) + (truncate_word(y, lsb - 1) & 0x1);
+	}
+	static word_float rounded(const real& y) {
+		word_float r;
+		r.sign = y.sign;
+		r.exp = y.exp;
+		r.m = round_word(y, y.exp - 63);
+		return r;
+	}
+	static double rounded_double(const real& y) {
+		double v = std::ldexp(double(round_word(y, y.exp - 52)), y.exp - 52);
+		return y.sign ? -v : v;
+	}
+};
+
+// the fixed-point kernels for a posit configuration: each function returns false when the configuration
+// is out of reach of the tier, or when the error bound does not decide the rounding of the argument
+template<size_t nbits, size_t es, bool enabled = (nbits <= 32)>
+class posit_elementary_word {
+public:
+	using Posit = posit<nbits, es>;
+	static bool exp(const Posit&, Posit&) { return false; }
+	static bool exp2(const Posit&, Posit&) { return false; }
+	static bool exp10(const Posit&, Posit&) { return false; }
+	static bool log(const Posit&, Posit&) { return false; }
+	static bool log2(const Posit&, Posit&) { return false; }
+	static bool log10(const Posit&, Posit&) { return false; }
+	static bool trig(const Posit&, trig_function, Posit&) { return false; }
+	static bool atan(const Posit&, Posit&) { return false; }
+	static bool pow(const Posit&, bool, int, uint64_t, Posit&) { return false; }
+	static bool pow(const Posit&, const Posit&, Posit&) { return false; }
+};
+
+template<size_t nbits, size_t es>
+class posit_elementary_word<nbits, es, true> {
+public:
+	using Posit  = posit<nbits, es>;
+	using engine = native_engine<nbits, es>;
+	static constexpr int maxscale = engine::maxscale;
+
+	static bool exp(const Posit& p, Posit& r) { return exponential(p, word_tables::get().log2e, r); }
+	static bool exp2(const Posit& p, Posit& r) {
+		static const uint64_t one[2] = { 0, uint64_t(1) << 62 };
+		return exponential(p, one, r);
+	}
+	static bool exp10(const Posit& p, Posit& r) { return exponential(p, word_tables::get().log2_10, r); }
+
+	static bool log(const Posit& p, Posit& r) { return logarithm(p, 1.0, r); }
+	static bool log2(const Posit& p, Posit& r) { return logarithm(p, word_tables::get().log2e_double, r); }
+	static bool log10(const Posit& p, Posit& r) { return logarithm(p, word_tables::get().log10e_double, r); }
+
+	// sin(x) and cos(x) from the reduced argument, and their quotients
+	static bool trig(const Posit& p, trig_function fn, Posit& result) {
+		bool sign;
+		int scale;
+		uint64_t sig;
+		if (!decode(p, sign, scale, sig) || scale < -1000) return false;
+		double r, rl;
+		unsigned q;
+		if (!reduce_half_pi(scale, sig, r, rl, q)) return false;
+		// evaluate the series that the quadrant and the function need
+		double z = r * r;
+		bool odd = (q & 0x1) != 0;
+		bool want_sin = (fn != trig_function::cos && fn != trig_function::sec);
+		bool want_cos = (fn != trig_function::sin && fn != trig_function::csc);
+		double sx, cx;
+		if (want_sin && want_cos) {
+			double s = trig_series(false, r, rl, z), c = trig_series(true, r, rl, z);
+			sx = odd ? c : s;
+			cx = odd ? s : c;
+		}
+		else {
+			sx = cx = trig_series(want_sin == odd, r, rl, z);
+		}
+		// sin(x) and cos(x) in the quadrant q: the series are accurate to 2^-51, the bound leaves a margin of 4
+		const uint64_t err = 32768;
+		word_float ws = word_from_double(sx), wc = word_from_double(cx);
+		ws.sign = (ws.sign != ((q & 0x2) != 0)) != sign;
+		wc.sign = wc.sign != (((q + 1) & 0x2) != 0);
+		switch (fn) {
+		case trig_function::sin: return certify(ws, err, result);
+		case trig_function::cos: return certify(wc, err, result);
+		case trig_function::tan: return certify(quotient(sx, cx, ws.sign != wc.sign), 2 * err + 4096, result);
+		case trig_function::cot: return certify(quotient(cx, sx, ws.sign != wc.sign), 2 * err + 4096, result);
+		case trig_function::sec: return certify(quotient(1.0, cx, wc.sign), err + 4096, result);
+		case trig_function::csc: return certify(quotient(1.0, sx, ws.sign), err + 4096, result);
+		}
+		return false;
+	}
+
+	// atan(x) by the Taylor expansion about the closest c = j/64, and pi/2 - atan(1/x) for |x| > 1
+	static bool atan(const Posit& p, Posit& result) {
+		bool sign;
+		int scale;
+		uint64_t sig;
+		if (!decode(p, sign, scale, sig)) return false;
+		const word_tables& t = word_tables::get();
+		const uint64_t hidden = uint64_t(1) << 63;
+		bool inverse = (scale > 0 || (scale == 0 && sig > hidden));
+		word_float a = { false, scale, sig };
+		if (inverse) {
+			uint64_t rem;
+			if (sig == hidden) a.exp = -scale;
+			else {
+				a.m = div128by64(hidden, 0, sig, rem);
+				a.exp = -1 - scale;
+			}
+		}
+		word_float r;
+		uint64_t err;
+		if (a.exp < -7) {
+			// a < 1/128: the series alone
+			r = word_scale(a, atan_series(word_square(a)), -63);
+			if (!inverse) {
+				err = 8;
+			}
+			else {
+				r = word_from(t.half_pi.m - word_fixed(r), -63);
+				err = word_error(8, -r.exp) + 2;
+			}
+		}
+		else {
+			// the Taylor expansion about the closest j/64, in u = 64 (a - j/64) within [-1/2, 1/2), by Estrin's scheme
+			uint64_t x = word_fixed(a);
+			uint64_t j = (x + (uint64_t(1) << 56)) >> 57;
+			int64_t u = int64_t((x - (j << 57)) << 6);
+			const int64_t* c = t.atan_taylor[j];
+			int64_t u2 = word_smul(u, u), u4 = word_smul(u2, u2);
+			int64_t p01 = c[0] + word_smul(c[1], u), p23 = c[2] + word_smul(c[3], u);
+			int64_t p45 = c[4] + word_smul(c[5], u), p67 = c[6] + word_smul(c[7], u);
+			int64_t q = p01 + word_smul(p23, u2) + word_smul(p45 + word_smul(p67, u2), u4);
+			uint64_t sum = t.atan_table[j] + uint64_t(word_smul(q, u) >> 6);
+			if (inverse) sum = t.half_pi.m - sum;
+			r = word_from(sum, -63);
+			err = word_error(8, -r.exp) + 2;
+		}
+		r.sign = sign;
+		return certify(r, err, result);
+	}
+
+	// x^y = 2^(y log2 x) for x > 0 and an exponent with a single word significand, within the dynamic range:
+	// z = y log2 x = n/64 + g with |g| <= 1/128, and 2^z = 2^(n/64) 2^g with 2^(j/64) from the table and a Taylor
+	// polynomial of g. The relative error of 2^z is below 2^-51 and ln2 times the absolute error of z, whose
+	// logarithm and products are accurate to 2^-49.5 of z
+	static bool pow(const Posit& p, bool ysign, int yscale, uint64_t ysig, Posit& result) {
+		static constexpr double c[5] = { 0.6931471805599453, 0.24022650695910072, 0.05550410866482158, 0.009618129107628477, 0.0013333558146428443 };
+		bool sign;
+		int scale;
+		uint64_t sig;
+		if (!decode(p, sign, scale, sig) || sign || yscale > 64 || yscale < -960) return false;
+		const word_tables& t = word_tables::get();
+		// y log2(e) does not wait for the logarithm
+		double y = word_to_double(ysign, yscale, ysig) * t.log2e_double;
+		double z = y * log_double(scale, sig);
+		if (!(std::abs(z) < 512.0)) return false;
+		// n = round(64 z) by a truncation of a positive value, and g = z - n/64 is exact
+		long long n = (long long)(z * 64.0 + 32768.5) - 32768;
+		double g = z - double(n) * 0.015625;
+		long long j = n & 0x3F;
+		double g2 = g * g;
+		double a0 = c[0] + c[1] * g, a1 = c[2] + c[3] * g;
+		double h = t.exp2_double[j];
+		word_float r = word_from_double(h + h * (g * (a0 + g2 * (a1 + g2 * c[4]))));
+		r.exp += int((n - j) / 64);
+		return certify(r, 16384 + uint64_t(std::abs(z) * 32768.0), result);
+	}
+	static bool pow(const Posit& x, const Posit& y, Posit& result) {
+		bool ysign;
+		int yscale;
+		uint64_t ysig;
+		return decode(y, ysign, yscale, ysig) && pow(x, ysign, yscale, ysig, result);
+	}
+
+private:
+	static bool decode(const Posit& p, bool& sign, int& scale, uint64_t& sig) {
+		uint64_t raw = uint64_t(p.encoding());
+		if (engine::iszero(raw) || engine::isnar(raw)) return false;
+		engine::decode(raw, sign, scale, sig);
+		return true;
+	}
+
+	// round r with an error below err units of its last bit: succeeds when the interval r -+ err holds no
+	// rounding boundary, so that every value in the interval rounds to the same posit
+	static bool certify(const word_float& r, uint64_t err, Posit& result) {
+		if (err >= (uint64_t(1) << 40)) return false;
+		uint64_t e = err + 1;
+		const uint64_t hidden = uint64_t(1) << 63;
+		int run = (r.exp >= 0 ? (r.exp >> es) + 2 : -(r.exp >> es) + 1);   // regime bits with the termination bit
+		int fraction = int(nbits) - 1 - run - int(es);
+		if (fraction >= 0 && r.m - e >= hidden && r.m + e > r.m) {
+			// the interval stays within the binade, whose rounding boundaries sit half a fraction ulp
+			// above the multiples of the ulp
+			uint64_t ulp = uint64_t(1) << (63 - fraction);
+			uint64_t tail = r.m & (ulp - 1), half = ulp >> 1;
+			if (tail + e - half <= 2 * e) return false;   // |tail - half| <= e
+			// regime, exponent, and fraction of the truncated value, rounded up when the tail passes the half
+			int k = r.exp >> es;
+			uint64_t regime = (k >= 0 ? ((uint64_t(2) << k) - 1) << 1 : uint64_t(1));
+			uint64_t bits = (regime << (nbits - 1 - run)) | ((uint64_t(r.exp) & ((uint64_t(1) << es) - 1)) << fraction);
+			bits |= ((r.m << 1) >> 1) >> (63 - fraction);
+			bits += (tail > half);
+			result.set_raw_bits(r.sign ? (0 - bits) & ((uint64_t(1) << nbits) - 1) : bits);
+			return true;
+		}
+		// otherwise both ends of the interval round to the same posit
+		uint64_t lo = r.m - e, hi = r.m + e;
+		int elo = r.exp, ehi = r.exp;
+		bool sticky = false;
+		if (lo < hidden) {
+			lo <<= 1;
+			--elo;
+		}
+		if (hi < r.m) {
+			sticky = (hi & 0x1);
+			hi = (hi >> 1) | hidden;
+			++ehi;
+		}
+		uint64_t a = engine::encode(r.sign, elo, lo, false);
+		uint64_t b = engine::encode(r.sign, ehi, hi, sticky);
+		if (a != b) return false;
+		result.set_raw_bits(a);
+		return true;
+	}
+
+	// 2^z for z = -+(ipart + frac / 2^64): 2^(j/64) from the table times a Taylor polynomial of the
+	// remainder, with an error below 20 units including the truncation of the fraction
+	static word_float exp2_core(bool negative, uint64_t ipart, uint64_t frac) {
+		const word_tables& t = word_tables::get();
+		// -(ipart + frac) = -(ipart + 1) + (1 - frac) without a branch on the sign
+		uint64_t mask = 0 - uint64_t(negative);
+		long long k = (long long)((ipart ^ mask) - mask) - (long long)(negative & (frac != 0));
+		frac = (frac ^ mask) - mask;
+		unsigned j = unsigned(frac >> 58);
+		uint64_t u = frac & ((uint64_t(1) << 58) - 1);
+		// Estrin's scheme shortens the chain of dependent products
+		const uint64_t* c = t.exp2_poly;
+		uint64_t u2 = word_mulhi(u, u), u4 = word_mulhi(u2, u2);
+		uint64_t a0 = c[0] + word_mulhi(c[1], u), a1 = c[2] + word_mulhi(c[3], u);
+		uint64_t a2 = c[4] + word_mulhi(c[5], u), a3 = c[6] + word_mulhi(c[7], u);
+		uint64_t q = a0 + word_mulhi(a1, u2) + word_mulhi(a2 + word_mulhi(a3, u2), u4);
+		uint64_t hi, lo = mul64x64(t.exp2_table[j], q, hi);
+		word_float r = word_normalize(hi, lo, -126);
+		r.exp += int(k);
+		return r;
+	}
+
+	// 2^(c x) for the constant c with 126 fraction bits
+	static bool exponential(const Posit& p, const uint64_t* c, Posit& result) {
+		bool sign;
+		int scale;
+		uint64_t sig;
+		if (!decode(p, sign, scale, sig)) return false;
+		if (scale > 8) return false;
+		// the significand has at most 32 bits: z = s c 2^(scale - 157)
+		uint64_t s = sig >> 32, z[3], h0, h1;
+		z[0] = mul64x64(s, c[0], h0);
+		z[1] = mul64x64(s, c[1], h1) + h0;
+		z[2] = h1 + (z[1] < h0);
+		size_t off = size_t(93 - scale);
+		uint64_t frac = word_bits(z, 3, off);
+		uint64_t ipart = word_bits(z, 3, off + 64);
+		if (ipart > uint64_t(maxscale) + 2) return false;
+		return certify(exp2_core(sign, ipart, frac), 20, result);
+	}
+
+	// ln(x) = e ln2 + ln(1 + t) - ln(r) with t = m r - 1 exact, for x != 1: the significand has at most 32 bits, so that
+	// m r has at most 43, and ln(1 + t) for |t| < 2^-7 is a polynomial of degree 8. The halving of m above 1.5 keeps
+	// e ln2 from cancelling ln(1 + t) - ln(r), and e ln2 and ln(r) from cancelling ln(1 + t) when e and r are 1,
+	// which bounds the relative error of the sum by 2^-50
+	static double log_double(int scale, uint64_t sig) {
+		static constexpr double c[7] = { -0.5, 0.3333333333333333, -0.25, 0.2, -0.16666666666666666, 0.14285714285714285, -0.125 };
+		const word_tables& tb = word_tables::get();
+		unsigned i = unsigned(sig >> 56) & 0x7F;
+		double e = double(scale + int(i >> 6));
+		double t = word_to_double(false, 0, sig) * tb.log_recip[i] - 1.0;
+		// Estrin's scheme shortens the chain of dependent products
+		double t2 = t * t, t4 = t2 * t2;
+		double a0 = c[0] + c[1] * t, a1 = c[2] + c[3] * t, a2 = c[4] + c[5] * t;
+		double lt = t + t2 * (a0 + t2 * a1 + t4 * (a2 + t2 * c[6]));
+		return (e * tb.ln2_head + tb.log_table[i]) + (lt + e * tb.ln2_tail);
+	}
+	// the logarithm scaled by the constant c, which adds an error of 2^-52
+	static bool logarithm(const Posit& p, double c, Posit& result) {
+		bool sign;
+		int scale;
+		uint64_t sig;
+		if (!decode(p, sign, scale, sig) || sign) return false;
+		double y = log_double(scale, sig) * c;
+		if (y == 0.0) return false;
+		// the logarithm is accurate to 2^-51.8, the scaling to 2^-52: the bound of 2^-47 leaves a margin of 8
+		return certify(word_from_double(y), 65536, result);
+	}
+	// sin(r + rl) for cosine false, cos(r + rl) for cosine true, with |r| <= pi/4, |rl| below an ulp of r, and z = r^2:
+	// the series stop after nine terms, which leaves below 2^-58 of the value, and the correction rl of the argument
+	// enters through the derivative
+	static double trig_series(bool cosine, double r, double rl, double z) {
+		static constexpr double cs[8] = { -0.16666666666666666, 0.008333333333333333, -0.0001984126984126984, 2.7557319223985893e-06,
+			-2.505210838544172e-08, 1.6059043836821613e-10, -7.647163731819816e-13, 2.8114572543455206e-15 };
+		static constexpr double cc[8] = { -0.5, 0.041666666666666664, -0.001388888888888889, 2.48015873015873e-05,
+			-2.755731922398589e-07, 2.08767569878681e-09, -1.1470745597729725e-11, 4.779477332387385e-14 };
+		// the function selects the coefficients, the factor, and the correction, so that the evaluation does not branch
+		const double* c = cosine ? cc : cs;
+		double v = cosine ? 1.0 : r;
+		double d = cosine ? -r * rl : rl;
+		double z2 = z * z, z4 = z2 * z2;
+		double a0 = c[0] + c[1] * z, a1 = c[2] + c[3] * z;
+		double a2 = c[4] + c[5] * z, a3 = c[6] + c[7] * z;
+		return v + (v * z * (a0 + z2 * a1 + z4 * (a2 + z2 * a3)) + d);
+	}
+	// a / b with the sign given, for the quotients of sin and cos
+	static word_float quotient(double a, double b, bool negative) {
+		word_float r = word_from_double(a / b);
+		r.sign = negative;
+		return r;
+	}
+	// sum of (-z)^k / (2k+1) for z = d^2 < 2^-14
+	static uint64_t atan_series(uint64_t z) {
+		const word_tables& t = word_tables::get();
+		uint64_t q = t.atan_poly[4];
+		for (int k = 3; k >= 0; --k) q = t.atan_poly[k] - word_mulhi(q, z);
+		return q;
+	}
+
+	// the reduction of x = sig 2^(scale - 63) to r + rl = x - q pi/2 with |r| <= pi/4 and rl below an ulp of r: below
+	// 2^19 Cody and Waite's on the floating-point unit with pi/2 in three parts of 33 bits, whose products with q are
+	// exact, which leaves an absolute error below 2^-84. A remainder below 2^-30 may have lost its relative precision
+	// to the cancellation: it and the arguments from 2^19 on are reduced in integer arithmetic, and the 64 bits of the
+	// remainder are split into two doubles
+	static bool reduce_half_pi(int scale, uint64_t sig, double& r, double& rl, unsigned& q) {
+		static constexpr double invpio2 = 6.36619772367581382433e-01;
+		static constexpr double pio2_1 = 1.57079632673412561417e+00;
+		static constexpr double pio2_2 = 6.07710050630396597660e-11;
+		static constexpr double pio2_3 = 2.02226624871116645580e-21;
+		if (scale < 19) {
+			// the significand has at most 32 bits, so that x - k pio2_1 is exact for k > 0, and k pio2_2 and k pio2_3 are exact
+			double x = word_to_double(false, scale, sig);
+			long long k = (long long)(x * invpio2 + 0.5);
+			double kd = double(k);
+			double r1 = x - kd * pio2_1, a = kd * pio2_2;
+			// the sum of the second part is kept as s + e
+			double s = r1 - a, b = s - r1;
+			double e = (r1 - (s - b)) - (a + b);
+			double t = e - kd * pio2_3;
+			r = s + t;
+			rl = t - (r - s);
+			q = unsigned(k);
+			if (k == 0 || std::abs(r) >= 9.313225746154785e-10) return true;
+		}
+		word_float w;
+		if (!reduce_half_pi(scale, sig, w, q)) return false;
+		r = word_to_double(w.sign, w.exp, w.m);
+		rl = word_to_double(w.sign, w.exp - 63, uint64_t(1) << 63) * double(w.m & 0x7FF);
+		return true;
+	}
+
+	// the bits of 2/pi down to the weight 2^-(64 glimbs), which covers the reduction of maxpos
+	static constexpr size_t glimbs = nr_limbs(size_t(maxscale) + 320);
+	struct two_over_pi {
+		uint64_t g[glimbs];
+		two_over_pi() {
+			using real = wide_float<glimbs + 1>;
+			const real& c = wide_constants<glimbs + 1>::get().two_over_pi;
+			long long base = 64 * (long long)glimbs + (long long)c.exp - 64 * (long long)c.n + 1;
+			for (size_t k = 0; k < glimbs; ++k) g[k] = real::window(c.m, c.n, 64 * (long long)k - base);
+		}
+	};
+
+	// the reduction of x = sig 2^(scale - 63) >= pi/4 to r = x - q pi/2 with |r| <= pi/4: Cody and Waite's below 16,
+	// and above Payne and Hanek's x 2/pi = q + f with |f| <= 1/2, computed from the 192 bits of 2/pi that matter
+	static bool reduce_half_pi(int scale, uint64_t sig, word_float& r, unsigned& q) {
+		static const two_over_pi table;
+		const word_tables& t = word_tables::get();
+		if (scale <= 3) {
+			// Cody and Waite's reduction for |x| < 16: q = round(x 2/pi), and x - q pi/2 in 128-bit fixed-point
+			// with 124 fraction bits, exact but for the rounding of q pi/2 below 2^-125
+			q = unsigned(((word_mulhi(sig, t.two_over_pi_word) >> 1) + (uint64_t(1) << (61 - scale))) >> (62 - scale));
+			const uint64_t* m = t.half_pi_multiples[q];
+			uint64_t lo = (sig << 60) << (1 + scale), hi = sig >> (3 - scale);
+			uint64_t borrow = uint64_t(lo < m[0]);
+			lo -= m[0];
+			hi = hi - m[1] - borrow;
+			bool negative = (hi >> 63) != 0;
+			word_negate_if(hi, lo, 0 - uint64_t(negative));
+			// a remainder above 2^-60 keeps a relative error below 2^-65
+			if (hi == 0) return false;
+			unsigned lz = clz64(hi);
+			r = { negative, 3 - int(lz), (hi << lz) | ((lo >> 1) >> (63 - lz)) };
+			return true;
+		}
+		int E = scale - 31;                   // x = s 2^E with s < 2^32
+		uint64_t s = sig >> 32;
+		if (E <= 2) {
+			// |x| < 2^34: the three leading words of 2/pi, aligned, and the point at the bit K = 192 - E
+			uint64_t z0, z1, z2, z3, h0, h1, h2;
+			z0 = mul64x64(s, table.g[glimbs - 3], h0);
+			uint64_t l1 = mul64x64(s, table.g[glimbs - 2], h1);
+			uint64_t l2 = mul64x64(s, table.g[glimbs - 1], h2);
+			z1 = l1 + h0;
+			z2 = l2 + h1 + (z1 < h0);
+			z3 = h2 + (z2 < l2 || (z2 == l2 && z1 < h0));
+			// the 128 bits below the point, and the quadrant from the two bits above it
+			unsigned u = unsigned(64 + E);      // 256 - K in [32, 66]
+			uint64_t hi, lo;
+			if (u < 64) {
+				hi = (z3 << u) | (z2 >> (64 - u));
+				lo = (z2 << u) | (z1 >> (64 - u));
+				q = unsigned(z3 >> (64 - u)) & 0x3;
+			}
+			else {
+				u -= 64;
+				hi = (z2 << u) | ((z1 >> 1) >> (63 - u));
+				lo = (z1 << u) | ((z0 >> 1) >> (63 - u));
+				q = unsigned((z3 << u) | ((z2 >> 1) >> (63 - u))) & 0x3;
+			}
+			bool negative = (hi >> 63) != 0;
+			word_negate_if(hi, lo, 0 - uint64_t(negative));
+			q += unsigned(negative);
+			// a remainder below 2^-64 leaves fewer than 64 significant bits
+			if (hi == 0) return false;
+			unsigned lz = clz64(hi);
+			word_float v = { negative, -1 - int(lz), (hi << lz) | ((lo >> 1) >> (63 - lz)) };
+			r = word_mul(v, t.half_pi);
+			return true;
+		}
+		int i0 = (E - 1 > 1 ? E - 1 : 1);    // the bits of weight 2^-i with i < i0 contribute multiples of 4
+		size_t base = 64 * glimbs - size_t(i0) - 191;
+		uint64_t z[4], carry = 0;
+		for (size_t k = 0; k < 3; ++k) {
+			uint64_t hi, lo = mul64x64(s, word_bits(table.g, glimbs, base + 64 * k), hi);
+			z[k] = lo + carry;
+			carry = hi + (z[k] < lo);
+		}
+		z[3] = carry;
+		// the product has K fraction bits, K in [190, 224]: move them to the top of the four words
+		unsigned K = unsigned(i0 + 191 - E);
+		q = unsigned(word_bits(z, 4, K)) & 0x3;
+		limbs_shl<4>(z, 256 - K);
+		uint64_t* f = z + 1;
+		bool negative = (f[2] >> 63) != 0;
+		if (negative) {
+			++q;
+			limbs_twos_complement<3>(f);
+		}
+		// the truncation of 2/pi leaves an absolute error below 2^-158: a remainder above 2^-90 keeps 64 bits
+		if (f[2] == 0 && f[1] < (uint64_t(1) << 38)) return false;
+		int lead = (f[2] ? 191 : 127) - int(clz64(f[2] ? f[2] : f[1]));
+		word_float v = { negative, lead - 192, word_bits(f, 3, size_t(lead - 63)) };
+		r = word_mul(v, t.half_pi);
+		return true;
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// the posit interface of the engine: argument decoding, exact results, and Ziv's rounding loop
+
+template<size_t nbits, size_t es>
+class posit_elementary {
+public:
+	using engine = limb_engine<nbits, es>;
+	using Posit  = posit<nbits, es>;
+	static constexpr size_t nlimbs   = engine::nlimbs;
+	static constexpr size_t flimbs   = engine::flimbs;
+	static constexpr size_t S        = nr_limbs(engine::fhbits + 2);              // significand and guard bit
+	static constexpr int    fhbits   = int(engine::fhbits);
+	static constexpr int    maxscale = engine::maxscale;
+	// the cap covers the argument reduction of maxpos and the cancellation of erfc close to minpos
+	static constexpr size_t CAP      = nr_limbs(2 * size_t(engine::maxscale) + 4 * engine::fhbits + 512);
+	static constexpr size_t first    = nr_limbs(engine::fhbits + 40);
+	using real   = wide_float<CAP>;
+	using native = std::integral_constant<bool, native_engine_supported<nbits, es>::value>;
+	using word   = posit_elementary_word<nbits, es>;
+
+	// a decoded posit argument
+	struct argument {
+		bool     nar, zero, sign;
+		int      scale;
+		uint64_t sig[flimbs];   // left aligned significand
+
+		explicit argument(const Posit& p) : nar(false), zero(false), sign(false), scale(0) {
+			uint64_t raw[nlimbs];
+			get_bits(p, raw);
+			nar = engine::isnar(raw);
+			zero = engine::iszero(raw);
+			for (size_t i = 0; i < flimbs; ++i) sig[i] = 0;
+			if (nar || zero) return;
+			typename engine::triple v;
+			engine::decode(raw, v);
+			sign = v.sign;
+			scale = v.scale;
+			for (size_t i = 0; i < flimbs; ++i) sig[i] = v.sig[i];
+		}
+		// the argument at the precision of x
+		void load(real& x) const {
+			if (zero) {
+				x.zero = true;
+				x.sign = false;
+				return;
+			}
+			x.assign(sig, flimbs, (long long)scale - (64 * (long long)flimbs - 1), sign);
+		}
+		// magnitude of the argument, saturated for scales beyond the range of interest
+		double magnitude() const {
+			if (zero) return 0.0;
+			if (scale > 1000) return HUGE_VAL;
+			if (scale < -1000) return 0.0;
+			return std::ldexp(double(sig[flimbs - 1]), scale - 63);
+		}
+		double value() const { return sign ? -magnitude() : magnitude(); }
+		// number of significant bits below the leading bit
+		int trailing() const {
+			for (size_t i = 0; i < flimbs; ++i) {
+				if (sig[i]) return int(64 * flimbs - 1) - int(64 * i + ctz64(sig[i]));
+			}
+			return 0;
+		}
+		bool is_integer() const { return zero || scale >= trailing(); }
+		bool is_one() const { return !zero && !sign && scale == 0 && trailing() == 0; }
+		bool is_power_of_2() const { return !zero && trailing() == 0; }
+	};
+
+	// the bits lost to an error bound of e units of 2^(1 - 64n)
+	static double error_bits(double e) {
+		return e >= HUGE_VAL ? HUGE_VAL : std::log2(e + 1.0);
+	}
+
+	// Ziv's loop: evaluate the kernel at increasing precision until the rounding is decided,
+	// the kernel returns the binary logarithm of its error bound
+	template<typename Kernel>
+	static Posit correctly_rounded(Kernel kernel) {
+		uint64_t lo[nlimbs], hi[nlimbs];
+		size_t n = first;
+		for (;;) {
+			real y(n);
+			double e = kernel(y);
+			int lost = (e >= double(1 << 30) ? 1 << 30 : int(std::ceil(e)) + 3);
+			if (!y.zero && lost < 64 * int(n) - fhbits - 8) {
+				bound(y, lost, false, lo);
+				bound(y, lost, true, hi);
+				if (limbs_compare<nlimbs>(lo, hi) == 0) return make(lo);
+			}
+			if (n == CAP) {
+				if (y.zero) return minpos_of(false);
+				encode(y.m, n, (long long)y.exp - (64 * (long long)n - 1), y.sign, true, lo);
+				return make(lo);
+			}
+			size_t next = nr_limbs(size_t(fhbits) + size_t(lost < (1 << 20) ? lost : 1 << 20) + 64);
+			if (next < 2 * n) next = 2 * n;
+			n = (next < CAP ? next : CAP);
+		}
+	}
+
+	// round an exact value
+	static Posit exact(const real& v) {
+		uint64_t raw[nlimbs];
+		if (v.zero) return Posit(0);
+		encode(v.m, v.n, (long long)v.exp - (64 * (long long)v.n - 1), v.sign, false, raw);
+		return make(raw);
+	}
+	static Posit integer(long long k) {
+		real v(1);
+		v.assign(uint64_t(k < 0 ? -k : k), k < 0);
+		return exact(v);
+	}
+	static Posit power_of_2(long long k) {
+		real v(1);
+		v.assign(uint64_t(1));
+		if (k > maxscale + 1) k = maxscale + 1;
+		if (k < -maxscale - 1) k = -maxscale - 1;
+		v.exp = int(k);
+		return exact(v);
+	}
+	static Posit nar() {
+		Posit p;
+		p.setnar();
+		return p;
+	}
+	static Posit one() { return Posit(1); }
+	static Posit maxpos_of(bool negative) {
+		Posit p = maxpos<nbits, es>();
+		return negative ? -p : p;
+	}
+	static Posit minpos_of(bool negative) {
+		Posit p = minpos<nbits, es>();
+		return negative ? -p : p;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////
+	// the functions: special values and exact results first, then the kernels
+
+	static Posit exp(const Posit& p) {
+		Posit r;
+		if (word::exp(p, r)) return r;
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return one();
+		double x = a.value();
+		if (x > (maxscale + 1) * 0.6931471805599453) return maxpos_of(false);
+		if (x < -(maxscale + 1) * 0.6931471805599453) return minpos_of(false);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_exp(x, y));
+		});
+	}
+	static Posit exp2(const Posit& p) {
+		Posit r;
+		if (word::exp2(p, r)) return r;
+		argument a(p);
+		if (a.nar) return p;
+		double x = a.value();
+		if (x > maxscale + 1) return maxpos_of(false);
+		if (x < -maxscale - 1) return minpos_of(false);
+		if (a.is_integer()) return power_of_2((long long)x);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n), c(y.n);
+			a.load(x);
+			load_constant(wide_constants<CAP>::get().ln2, c);
+			x.mul(x, c);
+			return error_bits(wide_exp(x, y) + 2.0 * (std::fabs(x.to_double()) + 1.0) * 4.0);
+		});
+	}
+	static Posit exp10(const Posit& p) {
+		Posit r;
+		if (word::exp10(p, r)) return r;
+		argument a(p);
+		if (a.nar) return p;
+		double x = a.value();
+		if (x > (maxscale + 1) * 0.30102999566398120) return maxpos_of(false);
+		if (x < -(maxscale + 1) * 0.30102999566398120) return minpos_of(false);
+		if (a.is_integer() && x >= 0) {
+			// 10^k = 5^k 2^k is a candidate for a rounding boundary when 5^k fits the significand
+			long long k = (long long)x;
+			if (k <= (fhbits + 2) / 2) {
+				real v(flimbs + 1);
+				v.assign(uint64_t(1));
+				for (long long i = 0; i < k; ++i) v.mul(v, uint64_t(5));
+				v.exp += int(k);
+				return exact(v);
+			}
+		}
+		return correctly_rounded([&a](real& y) {
+			real x(y.n), c(y.n);
+			a.load(x);
+			load_constant(wide_constants<CAP>::get().ln10, c);
+			x.mul(x, c);
+			return error_bits(wide_exp(x, y) + 2.0 * (std::fabs(x.to_double()) + 1.0) * 4.0);
+		});
+	}
+	static Posit expm1(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		double x = a.value();
+		if (x > (maxscale + 1) * 0.6931471805599453) return maxpos_of(false);
+		if (x < -(fhbits + 4) * 0.6931471805599453) return Posit(-1);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_expm1(x, y));
+		});
+	}
+
+	static Posit log(const Posit& p) {
+		Posit r;
+		if (word::log(p, r)) return r;
+		argument a(p);
+		if (a.nar || a.zero || a.sign) return nar();
+		if (a.is_one()) return Posit(0);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_log(x, y));
+		});
+	}
+	static Posit log2(const Posit& p) {
+		Posit r;
+		if (word::log2(p, r)) return r;
+		argument a(p);
+		if (a.nar || a.zero || a.sign) return nar();
+		if (a.is_power_of_2()) return integer(a.scale);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_log2(x, y));
+		});
+	}
+	static Posit log10(const Posit& p) {
+		Posit r;
+		if (word::log10(p, r)) return r;
+		argument a(p);
+		if (a.nar || a.zero || a.sign) return nar();
+		// x = 10^k = 5^k 2^k for integer k >= 0, with 5^k within the significand
+		if (a.is_integer()) {
+			real x(flimbs + 1), v(flimbs + 1);
+			a.load(x);
+			v.assign(uint64_t(1));
+			for (int k = 0; k <= fhbits / 2 && v.exp <= x.exp; ++k) {
+				if (real::compare_magnitude(v, x) == 0) return integer(k);
+				v.mul(v, uint64_t(10));
+			}
+		}
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_log10(x, y));
+		});
+	}
+	static Posit log1p(const Posit& p) {
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return p;
+		if (a.sign && a.scale >= 0) return nar();   // x <= -1
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_log1p(x, y));
+		});
+	}
+
+	static Posit trig(const Posit& p, trig_function fn) {
+		Posit r;
+		if (word::trig(p, fn, r)) return r;
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) {
+			switch (fn) {
+			case trig_function::sin:
+			case trig_function::tan: return p;
+			case trig_function::cos:
+			case trig_function::sec: return one();
+			default: return nar();
+			}
+		}
+		return correctly_rounded([&a, fn](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_trig(x, y, fn));
+		});
+	}
+	static Posit atan(const Posit& p) {
+		Posit r;
+		if (word::atan(p, r)) return r;
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_atan(x, y));
+		});
+	}
+	static Posit atan2(const Posit& py, const Posit& px) {
+		argument b(py), a(px);
+		if (a.nar || b.nar || (a.zero && b.zero)) return nar();
+		if (b.zero) return a.sign ? constant_pi(0, false) : Posit(0);
+		if (a.zero) return constant_pi(-1, b.sign);
+		return correctly_rounded([&a, &b](real& y) {
+			const size_t n = y.n;
+			real x(n), yy(n), z(n), v(n);
+			a.load(x);
+			b.load(yy);
+			z.div(yy, x);
+			double e = wide_atan(z, v) + 8.0;
+			if (!x.sign) {
+				y = v;
+				return error_bits(e);
+			}
+			real pi(n);
+			load_constant(wide_constants<CAP>::get().pi, pi);
+			pi.sign = !b.sign;
+			y.add(v, pi, true);
+			return error_bits(sum_error(e, v, 2.0, pi, y));
+		});
+	}
+	static Posit asin(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		if (a.scale > 0 || (a.scale == 0 && !a.is_power_of_2())) return nar();
+		if (a.scale == 0) return constant_pi(-1, a.sign);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_asin(x, y));
+		});
+	}
+	static Posit acos(const Posit& p) {
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return constant_pi(-1, false);
+		if (a.scale > 0 || (a.scale == 0 && !a.is_power_of_2())) return nar();
+		if (a.scale == 0) return a.sign ? constant_pi(0, false) : Posit(0);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_acos(x, y));
+		});
+	}
+
+	static Posit sinh(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		if (a.magnitude() > (maxscale + 2) * 0.6931471805599453) return maxpos_of(a.sign);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_sinh(x, y));
+		});
+	}
+	static Posit cosh(const Posit& p) {
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return one();
+		if (a.magnitude() > (maxscale + 2) * 0.6931471805599453) return maxpos_of(false);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_cosh(x, y));
+		});
+	}
+	static Posit tanh(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		if (a.magnitude() > (fhbits + 4) * 0.6931471805599453 / 2) return a.sign ? Posit(-1) : one();
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_tanh(x, y));
+		});
+	}
+	static Posit sigmoid(const Posit& p) {
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return power_of_2(-1);
+		double x = a.value();
+		if (x > (fhbits + 4) * 0.6931471805599453) return one();
+		if (x < -(maxscale + 1) * 0.6931471805599453) return minpos_of(false);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_sigmoid(x, y));
+		});
+	}
+	static Posit rsqrt(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero || a.sign) return nar();
+		// 1/sqrt(x) is dyadic only for x = 4^k
+		if (a.is_power_of_2() && a.scale % 2 == 0) return power_of_2(-a.scale / 2);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_rsqrt(x, y));
+		});
+	}
+	static Posit asinh(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_asinh(x, y));
+		});
+	}
+	static Posit acosh(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero || a.sign || a.scale < 0) return nar();
+		if (a.is_one()) return Posit(0);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_acosh(x, y));
+		});
+	}
+	static Posit atanh(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		if (a.scale >= 0) return nar();   // |x| >= 1
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_atanh(x, y));
+		});
+	}
+
+	static Posit erf(const Posit& p) {
+		argument a(p);
+		if (a.nar || a.zero) return p;
+		double x = a.magnitude();
+		if (x * x > (fhbits + 4) * 0.6931471805599453) return a.sign ? Posit(-1) : one();
+		return correctly_rounded([&a](real& y) {
+			real x(y.n);
+			a.load(x);
+			return error_bits(wide_erf(x, y));
+		});
+	}
+	static Posit erfc(const Posit& p) {
+		argument a(p);
+		if (a.nar) return p;
+		if (a.zero) return one();
+		double x = a.magnitude();
+		if (a.sign && x * x > (fhbits + 4) * 0.6931471805599453) return Posit(2);
+		if (!a.sign && x * x > (maxscale + 4) * 0.6931471805599453) return minpos_of(false);
+		return correctly_rounded([&a](real& y) {
+			real x(y.n), e(y.n), one(y.n);
+			a.load(x);
+			one.assign(uint64_t(1));
+			double ee = wide_erf(x, e);
+			y.add(one, e, true);
+			// erfc(x) = 1 - erf(x) loses the bits between 1 and erfc(x), which the loop adds to its precision
+			if (y.zero) return a.magnitude() * a.magnitude() * 1.4426950408889634 + 64.0;
+			return error_bits(ee) + (y.exp < 0 ? double(-y.exp) : 0.0) + 2.0;
+		});
+	}
+
+	// x^y for an exponent given as sign, scale, and a left aligned significand of M limbs
+	template<size_t M>
+	static Posit pow(const Posit& px, bool ysign, int yscale, const uint64_t* ysig, bool yzero) {
+		argument a(px);
+		if (yzero) return one();   // x^0 = 1 for every x, zero and NaR included, as in C
+		if (a.nar) return px;
+		// the exponent as an integer y = Y 2^yexp with Y odd
+		int ytrail = 0;
+		for (size_t i = 0; i < M; ++i) {
+			if (ysig[i]) {
+				ytrail = int(64 * M - 1) - int(64 * i + ctz64(ysig[i]));
+				break;
+			}
+		}
+		bool yinteger = yzero || yscale >= ytrail;
+		bool yodd = !yzero && yscale == ytrail;
+		if (a.zero) return ysign ? nar() : px;
+		if (a.sign && !yinteger) return nar();
+		bool negative = a.sign && yodd;
+		if (a.is_one()) return negative ? Posit(-1) : one();
+
+		// the result is dyadic when x is a power of 2 and y x.scale is an integer, or when y > 0 and x is
+		// a perfect power: such results may sit on a rounding boundary and are computed exactly
+		long long ye = (long long)yscale - ytrail;                    // y = Y 2^ye with Y odd
+		uint64_t Y = (ytrail < 64 ? ysig[M - 1] >> (63 - ytrail) : 0);
+		if (a.is_power_of_2()) {
+			// x^y = 2^(scale y) is dyadic when scale y is an integer
+			if (yscale > 40) return ((a.scale > 0) != ysign) ? maxpos_of(negative) : minpos_of(negative);
+			long long s = a.scale;
+			if (Y != 0 && (ye >= 0 || (-ye < 32 && s % (1ll << -ye) == 0))) {
+				long double z = (long double)Y * (ye >= 0 ? std::ldexp((long double)s, int(ye)) : (long double)(s / (1ll << -ye)));
+				if (ysign) z = -z;
+				if (z > maxscale + 1) z = maxscale + 1;
+				if (z < -maxscale - 1) z = -maxscale - 1;
+				Posit r = power_of_2((long long)z);
+				return negative ? -r : r;
+			}
+		}
+		else if (!ysign && yscale < 32 && Y != 0) {
+			// x^y = (x^(1/2^roots))^power
+			Posit r;
+			uint64_t power = (ye >= 0 ? Y << ye : Y);
+			unsigned roots = unsigned(ye >= 0 ? 0 : -ye);
+			if (perfect_power(a, power, roots, r)) return negative ? -r : r;
+		}
+
+		// the range of the result follows from y log2|x|
+		double l2 = a.scale + std::log2(std::ldexp(double(a.sig[flimbs - 1]), -63));
+		double ymag = (yscale > 1000 ? HUGE_VAL : std::ldexp(double(ysig[M - 1]), yscale - 63));
+		double z = (ysign ? -ymag : ymag) * l2;
+		if (z > maxscale + 2) return maxpos_of(negative);
+		if (z < -maxscale - 2) return minpos_of(negative);
+		Posit r;
+		bool single = true;
+		for (size_t i = 0; i + 1 < M; ++i) single = single && (ysig[i] == 0);
+		if (single && word::pow(a.sign ? -px : px, ysign, yscale, ysig[M - 1], r)) return negative ? -r : r;
+		r = correctly_rounded([&a, ysign, yscale, ysig](real& y) {
+			real x(y.n), yy(y.n);
+			a.load(x);
+			x.sign = false;
+			yy.assign(ysig, M, (long long)yscale - (64 * (long long)M - 1), ysign);
+			return error_bits(wide_pow(x, yy, y));
+		});
+		return negative ? -r : r;
+	}
+	static Posit pow(const Posit& x, const Posit& y) {
+		Posit r;
+		if (word::pow(x, y, r)) return r;
+		argument b(y);
+		if (b.nar) return (x == one() ? one() : y);   // 1^y = 1 for every y, NaR included, as in C
+		return pow<flimbs>(x, b.sign, b.scale, b.sig, b.zero);
+	}
+	template<typename Real>
+	static Posit pow(const Posit& x, Real y) {
+		bool sign = false, sticky = false;
+		int scale = 0;
+		uint64_t sig = 0;
+		switch (ieee754_decompose(y, sign, scale, sig, sticky)) {
+		case ieee754_class::nonfinite: return (x == one() ? one() : nar());
+		case ieee754_class::zero:      return pow<1>(x, false, 0, &sig, true);
+		default:                       break;
+		}
+		Posit r;
+		if (!sticky && word::pow(x, sign, scale, sig, r)) return r;
+		return pow<1>(x, sign, scale, &sig, false);
+	}
+
+private:
+	static uint64_t ctz64(uint64_t x) {
+		uint64_t n = 0;
+		while (!(x & 0x1)) {
+			x >>= 1;
+			++n;
+		}
+		return n;
+	}
+
+	static void get_bits(const Posit& p, uint64_t* raw) {
+		bitset_to_limbs<nbits, nlimbs>(p.get(), raw);
+	}
+	static Posit make(const uint64_t* raw) {
+		bitblock<nbits> bits;
+		limbs_to_bitset<nbits, nlimbs>(raw, bits);
+		Posit p;
+		p.set(bits);
+		return p;
+	}
+
+	// round the integer x[len] times 2^lsb to the nearest posit
+	static void encode(const uint64_t* x, size_t len, long long lsb, bool negative, bool sticky, uint64_t* raw) {
+		size_t top = len;
+		while (top > 0 && x[top - 1] == 0) --top;
+		long long msb = 64 * (long long)top - 1 - clz64(x[top - 1]);
+		long long off = msb - (64 * (long long)S - 1);
+		uint64_t sig[S];
+		for (size_t j = 0; j < S; ++j) sig[j] = real::window(x, len, off + 64 * (long long)j);
+		for (long long i = 0; i < off && !sticky; i += 64) {
+			uint64_t w = real::window(x, len, i);
+			if (i + 64 > off) w &= (uint64_t(1) << (off - i)) - 1;
+			sticky = (w != 0);
+		}
+		long long scale = lsb + msb;
+		if (scale > maxscale + 1) scale = maxscale + 1;
+		if (scale < -maxscale - 1) scale = -maxscale - 1;
+		encode_magnitude<nbits, es, S>(int(scale), sig, sticky, raw, native());
+		if (negative) engine::twos_complement(raw);
+	}
+
+	// the posit encodings of the lower and upper bound of the interval y -+ 2^lost ulps
+	static void bound(const real& y, int lost, bool upper, uint64_t* raw) {
+		uint64_t t[CAP + 1];
+		const size_t n = y.n;
+		for (size_t i = 0; i < n; ++i) t[i] = y.m[i];
+		t[n] = 0;
+		size_t w = size_t(lost) / 64;
+		uint64_t d = uint64_t(1) << (lost % 64);
+		if (upper) {
+			for (size_t i = w; i <= n && d; ++i) {
+				t[i] += d;
+				d = (t[i] < d);
+			}
+		}
+		else {
+			for (size_t i = w; i <= n && d; ++i) {
+				uint64_t before = t[i];
+				t[i] -= d;
+				d = (before < d);
+			}
+		}
+		encode(t, n + 1, (long long)y.exp - (64 * (long long)n - 1), y.sign, false, raw);
+	}
+
+	// pi 2^k
+	static Posit constant_pi(int k, bool negative) {
+		return correctly_rounded([k, negative](real& y) {
+			load_constant(wide_constants<CAP>::get().pi, y);
+			y.exp += k;
+			y.sign = negative;
+			return error_bits(2.0);
+		});
+	}
+
+	// x^(power / 2^roots) for x not a power of 2: exact when x is a perfect 2^roots power, and the power
+	// of its root has no more significant bits than a posit midpoint
+	static bool perfect_power(const argument& a, uint64_t Y, unsigned roots, Posit& result) {
+		// x = X 2^e with X odd
+		constexpr size_t XL = flimbs + 1;
+		uint64_t X[XL], root[XL];
+		int t = a.trailing();
+		for (size_t i = 0; i < XL; ++i) X[i] = (i < flimbs ? a.sig[i] : 0);
+		limbs_shr<XL>(X, size_t(64 * flimbs - 1 - t));
+		long long e = (long long)a.scale - t;
+		for (unsigned j = 0; j < roots; ++j) {
+			// take the square root of x = X 2^e
+			if (e % 2 != 0) return false;
+			if (limbs_isqrt<XL>(X, root)) return false;
+			for (size_t i = 0; i < XL; ++i) X[i] = root[i];
+			e /= 2;
+		}
+		// X^Y must fit the significand of a midpoint
+		unsigned xbits = 64 * XL - limbs_clz<XL>(X);
+		if (Y == 0 || double(xbits - 1) * double(Y) > fhbits + 2) return false;
+		real base(XL), v(2 * XL);
+		base.assign(X, XL, 0);
+		base.set_precision(2 * XL);
+		v.assign(uint64_t(1));
+		for (uint64_t i = 0; i < Y; ++i) v.mul(v, base);
+		long long scale = (long long)v.exp + e * (long long)Y;
+		if (scale > maxscale + 1) scale = maxscale + 1;
+		if (scale < -maxscale - 1) scale = -maxscale - 1;
+		v.exp = int(scale);
+		result = exact(v);
+		return true;
+	}
+};
+
+}  // namespace internal
+}  // namespace unum
+}  // namespace sw
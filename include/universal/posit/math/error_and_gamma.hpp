@@ -4,24 +4,25 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "elementary.hpp"
 
 
 namespace sw {
 	namespace unum {
 
-		// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-		// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+		// the posit standard says that every function must be correctly rounded for every input value:
+		// the functions evaluate in the wide_float engine of elementary.hpp, which rounds with Ziv's strategy.
 
 		// Compute the error function erf(x) = 2 over sqrt(PI) times Integral from 0 to x of e ^ (-t)^2 dt
 		template<size_t nbits, size_t es>
 		posit<nbits,es> erf(posit<nbits,es> x) {
-			return posit<nbits,es>(std::erf(double(x)));
+			return internal::posit_elementary<nbits, es>::erf(x);
 		}
 
 		// Compute the complementary error function: 1 - erf(x)
 		template<size_t nbits, size_t es>
 		posit<nbits,es> erfc(posit<nbits,es> x) {
-			return posit<nbits,es>(std::erfc(double(x)));
+			return internal::posit_elementary<nbits, es>::erfc(x);
 		}
 
 	}  // namespace unum
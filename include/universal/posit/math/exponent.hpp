@@ -4,54 +4,43 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "elementary.hpp"
 
 
 namespace sw {
 	namespace unum {
 
-		// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-		// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+		// the posit standard says that every function must be correctly rounded for every input value:
+		// the functions evaluate in the wide_float engine of elementary.hpp, which rounds with Ziv's strategy.
 
 		// Base-e exponential function
 		template<size_t nbits, size_t es>
 		posit<nbits,es> exp(posit<nbits,es> x) {
-			if (isnar(x)) return x;
-			posit<nbits, es> p;
-			double d = std::exp(double(x));
-			if (d == 0.0) {
-				p = minpos<nbits, es>();
-			}
-			else {
-				p = d;
-			}
-			return p;
+			return internal::posit_elementary<nbits, es>::exp(x);
 		}
 
 		// Base-2 exponential function
 		template<size_t nbits, size_t es>
 		posit<nbits,es> exp2(posit<nbits,es> x) {
-			if (isnar(x)) return x;
-			posit<nbits, es> p;
-			double d = std::exp2(double(x));
-			if (d == 0.0) {
-				p = minpos<nbits, es>();
-			}
-			else {
-				p = d;
-			}
-			return p;
+			return internal::posit_elementary<nbits, es>::exp2(x);
 		}
 
 		// Base-10 exponential function
 		template<size_t nbits, size_t es>
 		posit<nbits, es> exp10(posit<nbits, es> x) {
-			return posit<nbits, es>(std::pow(10.0, double(x)));
+			return internal::posit_elementary<nbits, es>::exp10(x);
 		}
 		
 		// Base-e exponential function exp(x)-1
 		template<size_t nbits, size_t es>
 		posit<nbits,es> expm1(posit<nbits,es> x) {
-			return posit<nbits,es>(std::expm1(double(x)));
+			return internal::posit_elementary<nbits, es>::expm1(x);
+		}
+
+		// logistic sigmoid function 1 / (1 + exp(-x))
+		template<size_t nbits, size_t es>
+		posit<nbits, es> sigmoid(posit<nbits, es> x) {
+			return internal::posit_elementary<nbits, es>::sigmoid(x);
 		}
 
 
@@ -0,0 +1,258 @@
+#pragma once
+// function_tables.hpp: lookup tables of the unary math functions for posits up to 16 bits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../native_engine.hpp"
+#include "elementary.hpp"
+#include "sqrt.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define POSIT_FUNCTION_TABLES_MMAP 1
+#else
+#define POSIT_FUNCTION_TABLES_MMAP 0
+#endif
+
+// posit_function_tables<nbits, es> holds, for nbits <= 16, the result of a unary math function for
+// every encoding, so that sw::unum::tabulated::exp(x) and its siblings are a single indexed load.
+// The entries come from the correctly rounded functions of elementary.hpp, the integer sqrt and rsqrt,
+// and the native division, so the tabulated functions are correctly rounded by construction. Each table is
+// generated at its first use. posit_function_tables<nbits, es>::save writes all the tables to a binary
+// file, and posit_function_tables<nbits, es>::map, called before the first lookup, memory-maps such a file, so that processes share one
+// copy instead of generating their own. This generalizes the posit_X_Y_roots arrays of sqrt_tables.hpp
+// to every function and to 16 bits.
+
+namespace sw {
+	namespace unum {
+
+		// unary functions served by the function tables
+		enum class posit_function { exp = 0, log, log2, sin, cos, tanh, sqrt, rsqrt, reciprocal, sigmoid };
+
+		template<size_t nbits, size_t es>
+		class posit_function_tables {
+		public:
+			static_assert(nbits >= 2 && nbits <= 16, "posit_function_tables requires 2 <= nbits <= 16");
+			using storage_t = native_storage_t<nbits>;
+			using Posit = posit<nbits, es>;
+
+			static constexpr size_t nr_of_encodings = size_t(1) << nbits;
+			static constexpr size_t nr_of_functions = 10;
+			static constexpr size_t header_size = 16;
+
+			// table of a function: the result of f(x) is at the index of the encoding of x
+			// A published table stays at its address for the life of the process.
+			static const storage_t* table(posit_function f) {
+				state& s = instance();
+				size_t i = size_t(f);
+				// a lookup is one load once the table exists: the lock is only on the path that generates it
+				const storage_t* t = s.tables[i].load(std::memory_order_acquire);
+				if (t != nullptr) return t;
+				std::lock_guard<std::mutex> guard(s.lock);
+				t = s.tables[i].load(std::memory_order_relaxed);
+				if (t == nullptr) {
+					generate(f, s.generated[i]);
+					t = s.generated[i].data();
+					s.tables[i].store(t, std::memory_order_release);
+				}
+				return t;
+			}
+
+			// write the tables of all the functions to a binary file that map() can share between processes:
+			// tables that are not in use yet are generated for the file without being published
+			static bool save(const std::string& filename) {
+				state& s = instance();
+				FILE* file = std::fopen(filename.c_str(), "wb");
+				if (file == nullptr) return false;
+				uint8_t header[header_size];
+				make_header(header);
+				bool ok = std::fwrite(header, 1, header_size, file) == header_size;
+				std::vector<storage_t> buffer;
+				for (size_t i = 0; i < nr_of_functions && ok; ++i) {
+					const storage_t* t = s.tables[i].load(std::memory_order_acquire);
+					if (t == nullptr) {
+						generate(posit_function(i), buffer);
+						t = buffer.data();
+					}
+					ok = std::fwrite(t, sizeof(storage_t), nr_of_encodings, file) == nr_of_encodings;
+				}
+				return (std::fclose(file) == 0) && ok;
+			}
+
+			// use the tables of a file written by save(): fails once a lookup has published a table,
+			// as the published tables may be in use
+			static bool map(const std::string& filename) {
+				state& s = instance();
+				std::lock_guard<std::mutex> guard(s.lock);
+				for (size_t i = 0; i < nr_of_functions; ++i) {
+					if (s.tables[i].load(std::memory_order_relaxed) != nullptr) return false;
+				}
+				const size_t size = header_size + nr_of_functions * nr_of_encodings * sizeof(storage_t);
+#if POSIT_FUNCTION_TABLES_MMAP
+				int fd = ::open(filename.c_str(), O_RDONLY);
+				if (fd < 0) return false;
+				struct stat st;
+				if (::fstat(fd, &st) != 0 || size_t(st.st_size) != size) {
+					::close(fd);
+					return false;
+				}
+				void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+				::close(fd);
+				if (mapping == MAP_FAILED) return false;
+				const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+				if (!valid_header(bytes)) {
+					::munmap(mapping, size);
+					return false;
+				}
+				s.mapping = mapping;
+				s.mapping_size = size;
+				const storage_t* base = reinterpret_cast<const storage_t*>(bytes + header_size);
+				for (size_t i = 0; i < nr_of_functions; ++i) s.tables[i].store(base + i * nr_of_encodings, std::memory_order_release);
+				return true;
+#else
+				// without memory mapping the file is read into private memory
+				FILE* file = std::fopen(filename.c_str(), "rb");
+				if (file == nullptr) return false;
+				uint8_t header[header_size];
+				bool ok = std::fread(header, 1, header_size, file) == header_size && valid_header(header);
+				std::vector<storage_t> buffer[nr_of_functions];
+				for (size_t i = 0; i < nr_of_functions && ok; ++i) {
+					buffer[i].resize(nr_of_encodings);
+					ok = std::fread(buffer[i].data(), sizeof(storage_t), nr_of_encodings, file) == nr_of_encodings;
+				}
+				std::fclose(file);
+				if (!ok) return false;
+				for (size_t i = 0; i < nr_of_functions; ++i) {
+					s.generated[i].swap(buffer[i]);
+					s.tables[i].store(s.generated[i].data(), std::memory_order_release);
+				}
+				return true;
+#endif
+			}
+
+			// true when the tables are backed by a memory-mapped file
+			static bool mapped() {
+				state& s = instance();
+				std::lock_guard<std::mutex> guard(s.lock);
+				return s.mapping != nullptr;
+			}
+
+		private:
+			// the tables are published once, by a lookup or by map(), and released when the process exits
+			struct state {
+				std::mutex lock;
+				std::atomic<const storage_t*> tables[nr_of_functions];
+				std::vector<storage_t> generated[nr_of_functions];
+				void* mapping = nullptr;
+				size_t mapping_size = 0;
+
+				state() {
+					for (size_t i = 0; i < nr_of_functions; ++i) tables[i].store(nullptr);
+				}
+				~state() {
+#if POSIT_FUNCTION_TABLES_MMAP
+					if (mapping != nullptr) ::munmap(mapping, mapping_size);
+#endif
+				}
+			};
+
+			static state& instance() {
+				static state s;
+				return s;
+			}
+
+			static void make_header(uint8_t* header) {
+				std::memset(header, 0, header_size);
+				std::memcpy(header, "POSITFUN", 8);
+				header[8] = uint8_t(nbits);
+				header[9] = uint8_t(es);
+				header[10] = uint8_t(sizeof(storage_t));
+				header[11] = uint8_t(nr_of_functions);
+			}
+			static bool valid_header(const uint8_t* header) {
+				uint8_t expected[header_size];
+				make_header(expected);
+				return std::memcmp(header, expected, header_size) == 0;
+			}
+
+			// the correctly rounded function value of an encoding
+			static Posit evaluate(posit_function f, const Posit& x) {
+				using engine = internal::posit_elementary<nbits, es>;
+				switch (f) {
+				case posit_function::exp:        return engine::exp(x);
+				case posit_function::log:        return engine::log(x);
+				case posit_function::log2:       return engine::log2(x);
+				case posit_function::sin:        return engine::trig(x, internal::trig_function::sin);
+				case posit_function::cos:        return engine::trig(x, internal::trig_function::cos);
+				case posit_function::tanh:       return engine::tanh(x);
+				case posit_function::sqrt:       return sw::unum::sqrt(x);
+				case posit_function::rsqrt:      return sw::unum::rsqrt(x);
+				case posit_function::reciprocal: {
+					// 1/0 is NaR rather than a division by zero exception
+					Posit r;
+					if (x.iszero() || x.isnar()) {
+						r.setnar();
+						return r;
+					}
+					return Posit(1) / x;
+				}
+				case posit_function::sigmoid:    return engine::sigmoid(x);
+				}
+				return x;
+			}
+
+			static void generate(posit_function f, std::vector<storage_t>& table) {
+				table.assign(nr_of_encodings, 0);
+				Posit x;
+				for (size_t k = 0; k < nr_of_encodings; ++k) {
+					x.set_raw_bits(k);
+					table[k] = storage_t(evaluate(f, x).encoding());
+				}
+			}
+		};
+
+		// the math functions as a single load from the function tables, for posits up to 16 bits
+		namespace tabulated {
+
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> lookup(posit_function f, const posit<nbits, es>& x) {
+				posit<nbits, es> r;
+				r.set_raw_bits(posit_function_tables<nbits, es>::table(f)[size_t(x.encoding())]);
+				return r;
+			}
+
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> exp(const posit<nbits, es>& x) { return lookup(posit_function::exp, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> log(const posit<nbits, es>& x) { return lookup(posit_function::log, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> log2(const posit<nbits, es>& x) { return lookup(posit_function::log2, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> sin(const posit<nbits, es>& x) { return lookup(posit_function::sin, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> cos(const posit<nbits, es>& x) { return lookup(posit_function::cos, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> tanh(const posit<nbits, es>& x) { return lookup(posit_function::tanh, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> sqrt(const posit<nbits, es>& x) { return lookup(posit_function::sqrt, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> rsqrt(const posit<nbits, es>& x) { return lookup(posit_function::rsqrt, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> reciprocal(const posit<nbits, es>& x) { return lookup(posit_function::reciprocal, x); }
+			template<size_t nbits, size_t es>
+			inline posit<nbits, es> sigmoid(const posit<nbits, es>& x) { return lookup(posit_function::sigmoid, x); }
+
+		} // namespace tabulated
+
+	} // namespace unum
+} // namespace sw
@@ -4,13 +4,14 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "elementary.hpp"
 
 
 namespace sw {
 	namespace unum {
 
-		// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-		// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+		// the posit standard says that every function must be correctly rounded for every input value:
+		// the functions evaluate in the wide_float engine of elementary.hpp, which rounds with Ziv's strategy.
 
 		// value representing an angle expressed in radians
 		// One radian is equivalent to 180/PI degrees
@@ -18,37 +19,37 @@ namespace sw {
 		// hyperbolic sine of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> sinh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::sinh(double(x)));
+			return internal::posit_elementary<nbits, es>::sinh(x);
 		}
 
 		// hyperbolic cosine of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> cosh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::cosh(double(x)));
+			return internal::posit_elementary<nbits, es>::cosh(x);
 		}
 
 		// hyperbolic tangent of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> tanh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::tanh(double(x)));
+			return internal::posit_elementary<nbits, es>::tanh(x);
 		}
 
 		// hyperbolic cotangent of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> atanh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::atanh(double(x)));
+			return internal::posit_elementary<nbits, es>::atanh(x);
 		}
 
 		// hyperbolic cosecant of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> acosh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::acosh(double(x)));
+			return internal::posit_elementary<nbits, es>::acosh(x);
 		}
 
 		// hyperbolic secant of an angle of x radians
 		template<size_t nbits, size_t es>
 		posit<nbits,es> asinh(posit<nbits,es> x) {
-			return posit<nbits,es>(std::asinh(double(x)));
+			return internal::posit_elementary<nbits, es>::asinh(x);
 		}
 
 
@@ -4,27 +4,28 @@
 // Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "elementary.hpp"
 
 
 namespace sw {
 namespace unum {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// the posit standard says that every function must be correctly rounded for every input value:
+// the functions evaluate in the wide_float engine of elementary.hpp, which rounds with Ziv's strategy.
 
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, posit<nbits, es> y) {
-	return posit<nbits,es>(std::pow(double(x), double(y)));
+	return internal::posit_elementary<nbits, es>::pow(x, y);
 }
 		
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, int y) {
-	return posit<nbits,es>(std::pow(double(x), double(y)));
+	return internal::posit_elementary<nbits, es>::pow(x, double(y));
 }
 		
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, double y) {
-	return posit<nbits,es>(std::pow(double(x), y));
+	return internal::posit_elementary<nbits, es>::pow(x, y);
 }
 
 // calculate an integer power function base^int
@@ -156,6 +156,12 @@ namespace sw {
 			return vsqrt;
 		}
 
+		// integer engine of the square roots: native words up to 64 bits, limbs beyond.
+		// Both compute the root with the reciprocal square root recurrence of limbs.hpp and round it
+		// with an exact remainder test, so sqrt and rsqrt are correctly rounded without a detour through double.
+		template<size_t nbits, size_t es>
+		using root_engine = typename std::conditional<native_engine_supported<nbits, es>::value, native_engine<nbits, es>, limb_engine<nbits, es>>::type;
+
 #if POSIT_NATIVE_SQRT
 		// sqrt for arbitrary posit
 		template<size_t nbits, size_t es>
@@ -177,17 +183,30 @@ namespace sw {
 			return p;
 		}
 #else
+		// sqrt for arbitrary posit: the integer root of the fraction is correctly rounded for every configuration
 		template<size_t nbits, size_t es>
 		inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
-			return posit<nbits, es>(std::sqrt((long double)a));
+			posit<nbits, es> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) return p;
+			bitblock<nbits> root = root_engine<nbits, es>::sqrt(a.get());
+			return p.set(root);
 		}
 #endif
 
-		// reciprocal sqrt
+		// reciprocal sqrt, correctly rounded rather than the reciprocal of the rounded sqrt
 		template<size_t nbits, size_t es>
 		inline posit<nbits, es> rsqrt(const posit<nbits,es>& a) {
-			posit<nbits,es> v = sqrt(a);
-			return v.reciprocate();
+			posit<nbits, es> p;
+			if (a.isneg() || a.isnar() || a.iszero()) {
+				p.setnar();
+				return p;
+			}
+			bitblock<nbits> root = root_engine<nbits, es>::rsqrt(a.get());
+			return p.set(root);
 		}
 
 		///////////////////////////////////////////////////////////////////
@@ -473,6 +492,57 @@ namespace sw {
 
 #endif // POSIT_FAST_POSIT_32_2
 
+#if POSIT_FAST_POSIT_64_3
+
+		// fast sqrt for posit<64,3>
+		// the fraction is normalized into [1, 4) and its root is taken with the corrected rsqrt recurrence
+		template<>
+		inline posit<64, 3> sqrt(const posit<64, 3>& a) {
+			posit<64, 3> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) return a;
+			return p.set_raw_bits(native_engine<64, 3>::sqrt(a.encoding()));
+		}
+
+#endif // POSIT_FAST_POSIT_64_3
+
+#if POSIT_FAST_POSIT_128_4
+
+		// fast sqrt for posit<128,4>
+		// the fraction is normalized into [1, 4) and its root is taken with the corrected rsqrt recurrence
+		template<>
+		inline posit<128, 4> sqrt(const posit<128, 4>& a) {
+			posit<128, 4> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) return a;
+			return p.set(limb_engine<128, 4>::sqrt(a.get()));
+		}
+
+#endif // POSIT_FAST_POSIT_128_4
+
+#if POSIT_FAST_POSIT_256_5
+
+		// fast sqrt for posit<256,5>
+		// the fraction is normalized into [1, 4) and its root is taken with the corrected rsqrt recurrence
+		template<>
+		inline posit<256, 5> sqrt(const posit<256, 5>& a) {
+			posit<256, 5> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) return a;
+			return p.set(limb_engine<256, 5>::sqrt(a.get()));
+		}
+
+#endif // POSIT_FAST_POSIT_256_5
+
 	}  // namespace unum
 
 }  // namespace sw
@@ -0,0 +1,490 @@
+#pragma once
+// vectorized.hpp: math functions over arrays of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../../utility/parallel.hpp"
+#include "../batch.hpp"
+#include "exponent.hpp"
+#include "logarithm.hpp"
+#include "trigonometry.hpp"
+#include "hyperbolic.hpp"
+#include "sqrt.hpp"
+#include "function_tables.hpp"
+
+// The vectorized math functions apply a function to every element of a posit array:
+//
+//   sw::unum::vexp(in, out, n);         out[i] = exp(in[i])
+//   sw::unum::vsin(in, out, n, 4);      out[i] = sin(in[i]) computed by four threads
+//
+// and produce the same encodings as the scalar functions. Posits up to 16 bits look the results up
+// in the posit_function_tables, with AVX2 gathers when the processor has them. On x86-64 processors
+// with AVX2, posit<32,2> elements are decoded into doubles, evaluated four at a time, and rounded
+// twice, at both ends of a window of relative width 2^-40 around the result. The kernels are accurate
+// to better than 2^-50, so when both ends round to the same posit, that posit is the correctly rounded
+// function value. The rare elements whose window straddles a rounding boundary, and the elements
+// outside the range of the kernels, are evaluated by the scalar functions. Other configurations use
+// the scalar functions. The instruction set is selected by batch::select_isa.
+
+namespace sw {
+	namespace unum {
+		namespace batch {
+			namespace detail {
+
+				// the correctly rounded scalar function, which the vectorized paths reproduce
+				template<size_t nbits, size_t es>
+				posit<nbits, es> evaluate(posit_function f, const posit<nbits, es>& x) {
+					switch (f) {
+					case posit_function::exp:        return sw::unum::exp(x);
+					case posit_function::log:        return sw::unum::log(x);
+					case posit_function::log2:       return sw::unum::log2(x);
+					case posit_function::sin:        return sw::unum::sin(x);
+					case posit_function::cos:        return sw::unum::cos(x);
+					case posit_function::tanh:       return sw::unum::tanh(x);
+					case posit_function::sqrt:       return sw::unum::sqrt(x);
+					case posit_function::rsqrt:      return sw::unum::rsqrt(x);
+					case posit_function::reciprocal: return x.reciprocate();
+					case posit_function::sigmoid:    return sw::unum::sigmoid(x);
+					}
+					return x;
+				}
+
+				// the evaluation path of a posit configuration
+				enum class vector_path { table, lanes, scalar };
+				template<size_t nbits, size_t es>
+				struct vector_path_of {
+					static constexpr vector_path value = (nbits <= 16 ? vector_path::table : (supported<nbits, es>::value ? vector_path::lanes : vector_path::scalar));
+				};
+
+#if POSIT_BATCH_AVX2
+				namespace avx2 {
+
+					POSIT_BATCH_TARGET_AVX2 inline __m256d set1d(double v) { return _mm256_set1_pd(v); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256d selectd(__m256i mask, __m256d t, __m256d f) { return _mm256_blendv_pd(f, t, _mm256_castsi256_pd(mask)); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i lane_mask(__m256d m) { return _mm256_castpd_si256(m); }
+
+					// c[0] + c[1] x + ... + c[n-1] x^(n-1)
+					template<size_t n>
+					POSIT_BATCH_TARGET_AVX2 inline __m256d polynomial(__m256d x, const double (&c)[n]) {
+						__m256d y = set1d(c[n - 1]);
+						for (size_t i = n - 1; i > 0; --i) y = _mm256_add_pd(_mm256_mul_pd(y, x), set1d(c[i - 1]));
+						return y;
+					}
+
+					// 64-bit lanes holding 32-bit integers to double
+					POSIT_BATCH_TARGET_AVX2 inline __m256d int_to_double(__m256i v) {
+						return _mm256_cvtepi32_pd(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6))));
+					}
+					// integral doubles to 64-bit integer lanes
+					POSIT_BATCH_TARGET_AVX2 inline __m256i double_to_int(__m256d v) {
+						return _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(v));
+					}
+					// 2^k for integral -1022 <= k <= 1023
+					POSIT_BATCH_TARGET_AVX2 inline __m256d power_of_2(__m256d k) {
+						return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(double_to_int(k), set1(1023)), 52));
+					}
+
+					// the elementary function kernels on doubles: each is accurate to a few units of 2^-53
+					struct elementary_kernels {
+						static constexpr double ln2_hi = 6.93147180369123816490e-01;    // 32 bits of ln(2): k ln2_hi is exact
+						static constexpr double ln2_lo = 1.90821492927058770002e-10;
+						static constexpr double log2e = 1.4426950408889634;
+						static constexpr double sqrt2 = 1.4142135623730951;
+						static constexpr double invpio2 = 6.36619772367581382433e-01;
+						static constexpr double pio2_1 = 1.57079632673412561417e+00;    // pi/2 in three parts of 33 bits
+						static constexpr double pio2_2 = 6.07710050630396597660e-11;
+						static constexpr double pio2_3 = 2.02226624871116645580e-21;
+
+						// e^v for |v| <= 708: v = k ln(2) + r with |r| <= ln(2)/2, and e^r by its Taylor series
+						static POSIT_BATCH_TARGET_AVX2 __m256d exp(__m256d v) {
+							static constexpr double c[13] = { 1.0, 1.0, 0.5, 0.16666666666666666, 0.041666666666666664, 0.008333333333333333, 0.001388888888888889,
+								0.0001984126984126984, 2.48015873015873e-05, 2.7557319223985893e-06, 2.755731922398589e-07, 2.505210838544172e-08, 2.08767569878681e-09 };
+							__m256d k = _mm256_round_pd(_mm256_mul_pd(v, set1d(log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+							// v - k ln2_hi is exact
+							__m256d r = _mm256_sub_pd(_mm256_sub_pd(v, _mm256_mul_pd(k, set1d(ln2_hi))), _mm256_mul_pd(k, set1d(ln2_lo)));
+							return _mm256_mul_pd(polynomial(r, c), power_of_2(k));
+						}
+						// e^u - 1 for 0 <= u <= 708, without the cancellation of exp(u) - 1 for small u
+						static POSIT_BATCH_TARGET_AVX2 __m256d expm1(__m256d u) {
+							static constexpr double c[13] = { 1.0, 0.5, 0.16666666666666666, 0.041666666666666664, 0.008333333333333333, 0.001388888888888889, 0.0001984126984126984,
+								2.48015873015873e-05, 2.7557319223985893e-06, 2.755731922398589e-07, 2.505210838544172e-08, 2.08767569878681e-09, 1.6059043836821613e-10 };
+							__m256d small = _mm256_mul_pd(u, polynomial(u, c));
+							__m256d large = _mm256_sub_pd(exp(u), set1d(1.0));
+							return selectd(lane_mask(_mm256_cmp_pd(u, set1d(0.34657359027997264), _CMP_LT_OQ)), small, large);
+						}
+						// ln(2^e m) with m = 1 + f / 2^fbits in [1, 2): m is moved into [sqrt(1/2), sqrt(2)), and
+						// ln(m) = 2 atanh(s) with s = (m - 1) / (m + 1) in [-0.1716, 0.1716]
+						static POSIT_BATCH_TARGET_AVX2 __m256d log(__m256i scale, __m256d m, bool base2) {
+							static constexpr double c[10] = { 0.3333333333333333, 0.2, 0.14285714285714285, 0.1111111111111111, 0.09090909090909091,
+								0.07692307692307693, 0.06666666666666667, 0.058823529411764705, 0.05263157894736842, 0.047619047619047616 };
+							__m256i big = lane_mask(_mm256_cmp_pd(m, set1d(sqrt2), _CMP_GT_OQ));
+							m = selectd(big, _mm256_mul_pd(m, set1d(0.5)), m);
+							__m256d e = int_to_double(_mm256_sub_epi64(scale, big));   // big lanes are -1
+							__m256d f = _mm256_sub_pd(m, set1d(1.0));                    // exact
+							__m256d s = _mm256_div_pd(f, _mm256_add_pd(f, set1d(2.0)));
+							__m256d s2 = _mm256_add_pd(s, s);
+							__m256d z = _mm256_mul_pd(s, s);
+							__m256d lm = _mm256_add_pd(s2, _mm256_mul_pd(_mm256_mul_pd(s2, z), polynomial(z, c)));
+							if (base2) return _mm256_add_pd(e, _mm256_mul_pd(lm, set1d(log2e)));
+							return _mm256_add_pd(_mm256_mul_pd(e, set1d(ln2_hi)), _mm256_add_pd(lm, _mm256_mul_pd(e, set1d(ln2_lo))));
+						}
+						// sin(v) or cos(v) for |v| <= 2^19: v = k pi/2 + r with |r| <= pi/4 in double-double precision.
+						// A reduced argument below 2^-30 with k != 0 may have lost relative accuracy and is flagged.
+						static POSIT_BATCH_TARGET_AVX2 __m256d trig(__m256d v, bool cosine, __m256i& uncertain) {
+							static constexpr double cs[9] = { 1.0, -0.16666666666666666, 0.008333333333333333, -0.0001984126984126984, 2.7557319223985893e-06,
+								-2.505210838544172e-08, 1.6059043836821613e-10, -7.647163731819816e-13, 2.8114572543455206e-15 };
+							static constexpr double cc[9] = { 1.0, -0.5, 0.041666666666666664, -0.001388888888888889, 2.48015873015873e-05,
+								-2.755731922398589e-07, 2.08767569878681e-09, -1.1470745597729725e-11, 4.779477332387385e-14 };
+							__m256d k = _mm256_round_pd(_mm256_mul_pd(v, set1d(invpio2)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+							// v - k pio2_1 and k pio2_2 are exact, and the sum of the second part is kept as s + e
+							__m256d r1 = _mm256_sub_pd(v, _mm256_mul_pd(k, set1d(pio2_1)));
+							__m256d a = _mm256_mul_pd(k, set1d(pio2_2));
+							__m256d s = _mm256_sub_pd(r1, a);
+							__m256d bb = _mm256_sub_pd(s, r1);
+							__m256d e = _mm256_sub_pd(_mm256_sub_pd(r1, _mm256_sub_pd(s, bb)), _mm256_add_pd(a, bb));
+							__m256d rl = _mm256_sub_pd(e, _mm256_mul_pd(k, set1d(pio2_3)));
+							__m256d r = _mm256_add_pd(s, rl);
+							rl = _mm256_sub_pd(rl, _mm256_sub_pd(r, s));
+							__m256d z = _mm256_mul_pd(r, r);
+							__m256d sinr = _mm256_add_pd(_mm256_mul_pd(r, polynomial(z, cs)), rl);
+							__m256d cosr = _mm256_sub_pd(polynomial(z, cc), _mm256_mul_pd(r, rl));
+							__m256d absv = _mm256_andnot_pd(set1d(-0.0), v);
+							__m256d absr = _mm256_andnot_pd(set1d(-0.0), r);
+							__m256d cancel = _mm256_and_pd(_mm256_cmp_pd(k, _mm256_setzero_pd(), _CMP_NEQ_OQ), _mm256_cmp_pd(absr, set1d(9.313225746154785e-10), _CMP_LT_OQ));
+							uncertain = _mm256_or_si256(uncertain, lane_mask(_mm256_or_pd(cancel, _mm256_cmp_pd(absv, set1d(524288.0), _CMP_GT_OQ))));
+							// quadrant: sin(k pi/2 + r) is sin r, cos r, -sin r, -cos r for k mod 4 = 0, 1, 2, 3, and cos(v) = sin(v + pi/2)
+							__m256i q = _mm256_add_epi64(double_to_int(k), set1(cosine ? 1 : 0));
+							__m256d y = selectd(_mm256_cmpeq_epi64(_mm256_and_si256(q, set1(1)), set1(1)), cosr, sinr);
+							__m256i negate = _mm256_slli_epi64(_mm256_and_si256(q, set1(2)), 62);
+							return _mm256_xor_pd(y, _mm256_castsi256_pd(negate));
+						}
+					};
+
+					// decode posit lanes into doubles, evaluate a kernel, and round the result with a certificate
+					template<size_t nbits, size_t es>
+					struct elementary_lanes {
+						using L = lanes<nbits, es>;
+						static constexpr int fbits = L::fbits;
+						static constexpr int P = L::P;
+
+						// exact double of lanes that are neither zero nor NaR
+						static POSIT_BATCH_TARGET_AVX2 __m256d to_double(__m256i neg, __m256i scale, __m256i sig) {
+							__m256i bits = _mm256_slli_epi64(_mm256_add_epi64(scale, set1(1023)), 52);
+							bits = _mm256_or_si256(bits, _mm256_slli_epi64(_mm256_and_si256(sig, set1((1ll << fbits) - 1)), 52 - fbits));
+							return _mm256_castsi256_pd(_mm256_or_si256(bits, _mm256_and_si256(neg, set1(1ll << 63))));
+						}
+						// round normal doubles to the nearest posit
+						static POSIT_BATCH_TARGET_AVX2 __m256i round(__m256d d) {
+							__m256i bits = _mm256_castpd_si256(d);
+							__m256i neg = _mm256_cmpgt_epi64(_mm256_setzero_si256(), bits);
+							__m256i scale = _mm256_sub_epi64(_mm256_and_si256(_mm256_srli_epi64(bits, 52), set1(0x7FF)), set1(1023));
+							__m256i mantissa = _mm256_and_si256(bits, set1((1ll << 52) - 1));
+							__m256i sig = _mm256_srli_epi64(_mm256_or_si256(mantissa, set1(1ll << 52)), 52 - P);
+							__m256i sticky = nonzero_bit(_mm256_and_si256(mantissa, set1((1ll << (52 - P)) - 1)));
+							return L::encode(neg, scale, sig, sticky);
+						}
+						// the posit of y when both ends of the window y (1 -+ 2^-40) round to it, otherwise the lane is flagged
+						static POSIT_BATCH_TARGET_AVX2 __m256i certify(__m256d y, __m256i& uncertain) {
+							__m256i lo = round(_mm256_mul_pd(y, set1d(0.9999999999990905)));
+							__m256i hi = round(_mm256_mul_pd(y, set1d(1.0000000000009095)));
+							__m256i exponent = _mm256_and_si256(_mm256_srli_epi64(_mm256_castpd_si256(y), 52), set1(0x7FF));
+							// zero, subnormal, infinite, and NaN results are left to the scalar function
+							uncertain = _mm256_or_si256(uncertain, _mm256_cmpeq_epi64(exponent, _mm256_setzero_si256()));
+							uncertain = _mm256_or_si256(uncertain, _mm256_cmpeq_epi64(exponent, set1(0x7FF)));
+							uncertain = _mm256_or_si256(uncertain, _mm256_andnot_si256(_mm256_cmpeq_epi64(lo, hi), set1(-1)));
+							return lo;
+						}
+
+						template<posit_function f>
+						static POSIT_BATCH_TARGET_AVX2 __m256i evaluate(__m256i x, __m256i& uncertain) {
+							using K = elementary_kernels;
+							uncertain = _mm256_or_si256(L::is_zero(x), L::is_nar(x));
+							__m256i neg, scale, sig;
+							L::decode(L::regular(x), neg, scale, sig);
+							__m256d v = to_double(neg, scale, sig);
+							__m256d absv = _mm256_andnot_pd(set1d(-0.0), v);
+							__m256d y;
+							switch (f) {
+							case posit_function::exp:
+								uncertain = _mm256_or_si256(uncertain, lane_mask(_mm256_cmp_pd(absv, set1d(700.0), _CMP_GT_OQ)));
+								y = K::exp(_mm256_min_pd(_mm256_max_pd(v, set1d(-700.0)), set1d(700.0)));
+								break;
+							case posit_function::log:
+							case posit_function::log2:
+								uncertain = _mm256_or_si256(uncertain, neg);
+								y = K::log(scale, to_double(_mm256_setzero_si256(), _mm256_setzero_si256(), sig), f == posit_function::log2);
+								break;
+							case posit_function::sin:
+							case posit_function::cos:
+								y = K::trig(v, f == posit_function::cos, uncertain);
+								break;
+							case posit_function::tanh: {
+								// tanh|v| = t / (t + 2) with t = e^(2|v|) - 1, which is one to double precision beyond 40
+								__m256d t = K::expm1(_mm256_add_pd(_mm256_min_pd(absv, set1d(40.0)), _mm256_min_pd(absv, set1d(40.0))));
+								y = _mm256_div_pd(t, _mm256_add_pd(t, set1d(2.0)));
+								y = _mm256_or_pd(y, _mm256_and_pd(v, set1d(-0.0)));
+								break;
+							}
+							case posit_function::sqrt:
+								uncertain = _mm256_or_si256(uncertain, neg);
+								y = _mm256_sqrt_pd(v);
+								break;
+							case posit_function::rsqrt:
+								uncertain = _mm256_or_si256(uncertain, neg);
+								y = _mm256_div_pd(set1d(1.0), _mm256_sqrt_pd(v));
+								break;
+							case posit_function::reciprocal:
+								y = _mm256_div_pd(set1d(1.0), v);
+								break;
+							case posit_function::sigmoid:
+								uncertain = _mm256_or_si256(uncertain, lane_mask(_mm256_cmp_pd(v, set1d(-700.0), _CMP_LT_OQ)));
+								y = _mm256_div_pd(set1d(1.0), _mm256_add_pd(set1d(1.0), K::exp(_mm256_min_pd(_mm256_max_pd(_mm256_sub_pd(_mm256_setzero_pd(), v), set1d(-40.0)), set1d(700.0)))));
+								break;
+							}
+							return certify(y, uncertain);
+						}
+					};
+
+					// evaluate encodings 8 at a time, and flag the elements left to the scalar function
+					template<size_t nbits, size_t es, posit_function f>
+					POSIT_BATCH_TARGET_AVX2 size_t elementary(const storage_t<nbits>* a, storage_t<nbits>* out, uint8_t* uncertain, size_t n) {
+						using L = lanes<nbits, es>;
+						size_t i = 0;
+						for (; i + 8 <= n; i += 8) {
+							for (size_t j = i; j < i + 8; j += 4) {
+								__m256i flags;
+								L::store(out + j, elementary_lanes<nbits, es>::template evaluate<f>(L::load(a + j), flags));
+								int m = _mm256_movemask_pd(_mm256_castsi256_pd(flags));
+								for (size_t k = 0; k < 4; ++k) uncertain[j + k] = uint8_t((m >> k) & 1);
+							}
+						}
+						return i;
+					}
+					template<size_t nbits, size_t es>
+					size_t elementary(posit_function f, const storage_t<nbits>* a, storage_t<nbits>* out, uint8_t* uncertain, size_t n) {
+						switch (f) {
+						case posit_function::exp:        return elementary<nbits, es, posit_function::exp>(a, out, uncertain, n);
+						case posit_function::log:        return elementary<nbits, es, posit_function::log>(a, out, uncertain, n);
+						case posit_function::log2:       return elementary<nbits, es, posit_function::log2>(a, out, uncertain, n);
+						case posit_function::sin:        return elementary<nbits, es, posit_function::sin>(a, out, uncertain, n);
+						case posit_function::cos:        return elementary<nbits, es, posit_function::cos>(a, out, uncertain, n);
+						case posit_function::tanh:       return elementary<nbits, es, posit_function::tanh>(a, out, uncertain, n);
+						case posit_function::sqrt:       return elementary<nbits, es, posit_function::sqrt>(a, out, uncertain, n);
+						case posit_function::rsqrt:      return elementary<nbits, es, posit_function::rsqrt>(a, out, uncertain, n);
+						case posit_function::reciprocal: return elementary<nbits, es, posit_function::reciprocal>(a, out, uncertain, n);
+						case posit_function::sigmoid:    return elementary<nbits, es, posit_function::sigmoid>(a, out, uncertain, n);
+						}
+						return 0;
+					}
+
+					// gather 8 table entries at a time: the 32-bit loads start at a multiple of 4 bytes, which keeps them inside the table
+					POSIT_BATCH_TARGET_AVX2 inline __m256i gather(const uint8_t* table, __m256i index) {
+						__m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), _mm256_srli_epi32(index, 2), 4);
+						return _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(index, _mm256_set1_epi32(3)), 3)), _mm256_set1_epi32(0xFF));
+					}
+					POSIT_BATCH_TARGET_AVX2 inline __m256i gather(const uint16_t* table, __m256i index) {
+						__m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), _mm256_srli_epi32(index, 1), 4);
+						return _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(index, _mm256_set1_epi32(1)), 4)), _mm256_set1_epi32(0xFFFF));
+					}
+					template<typename Table>
+					POSIT_BATCH_TARGET_AVX2 size_t lookup(const Table* table, const uint16_t* a, uint16_t* out, size_t n) {
+						size_t i = 0;
+						for (; i + 8 <= n; i += 8) {
+							__m256i r = gather(table, _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))));
+							__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+						}
+						return i;
+					}
+
+				} // namespace avx2
+#endif // POSIT_BATCH_AVX2
+
+				// run a kernel on the encodings of the elements, staged through buffers so that the
+				// flagged elements can be evaluated by the scalar function even when in and out alias
+				template<size_t nbits, size_t es, typename Kernel>
+				size_t stage(posit_function f, const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, Kernel kernel) {
+					using raw_t = storage_t<nbits>;
+					raw_t x[staging_size], r[staging_size];
+					uint8_t uncertain[staging_size];
+					size_t done = 0;
+					while (done < n) {
+						size_t count = (n - done < staging_size ? n - done : staging_size);
+						for (size_t k = 0; k < count; ++k) x[k] = raw_t(in[done + k].encoding());
+						std::memset(uncertain, 0, count);
+						size_t processed = kernel(x, r, uncertain, count);
+						posit<nbits, es> p;
+						for (size_t k = 0; k < processed; ++k) {
+							if (uncertain[k]) {
+								p.set_raw_bits(x[k]);
+								out[done + k] = evaluate(f, p);
+							}
+							else {
+								out[done + k].set_raw_bits(r[k]);
+							}
+						}
+						done += processed;
+						if (processed < count) break;   // the remainder is left to the scalar loop
+					}
+					return done;
+				}
+
+				template<size_t nbits, size_t es>
+				void vectorized(posit_function f, const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, std::integral_constant<vector_path, vector_path::table>) {
+					const auto* table = posit_function_tables<nbits, es>::table(f);
+					size_t i = 0;
+#if POSIT_BATCH_AVX2
+					if (active_isa() == isa::avx2) {
+						i = stage(f, in, out, n, [table](const uint16_t* x, uint16_t* r, uint8_t*, size_t count) { return avx2::lookup(table, x, r, count); });
+					}
+#endif
+					for (; i < n; ++i) out[i].set_raw_bits(table[size_t(in[i].encoding())]);
+				}
+				template<size_t nbits, size_t es>
+				void vectorized(posit_function f, const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, std::integral_constant<vector_path, vector_path::lanes>) {
+					size_t i = 0;
+#if POSIT_BATCH_AVX2
+					using raw_t = storage_t<nbits>;
+					if (active_isa() == isa::avx2) {
+						i = stage(f, in, out, n, [f](const raw_t* x, raw_t* r, uint8_t* uncertain, size_t count) { return avx2::elementary<nbits, es>(f, x, r, uncertain, count); });
+					}
+#endif
+					for (; i < n; ++i) out[i] = evaluate(f, in[i]);
+				}
+				template<size_t nbits, size_t es>
+				void vectorized(posit_function f, const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, std::integral_constant<vector_path, vector_path::scalar>) {
+					for (size_t i = 0; i < n; ++i) out[i] = evaluate(f, in[i]);
+				}
+
+				// smallest part of an array that is given its own thread
+				constexpr size_t min_elements_per_thread = 4096;
+
+				// split the array over nrOfThreads threads, the calling thread takes the first part
+				template<size_t nbits, size_t es>
+				void vectorized(posit_function f, const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads) {
+					using path = std::integral_constant<vector_path, vector_path_of<nbits, es>::value>;
+					size_t threads = parallel_thread_count(n, nrOfThreads, min_elements_per_thread);
+					if (threads <= 1) {
+						vectorized(f, in, out, n, path());
+						return;
+					}
+					size_t chunk = ((n + threads - 1) / threads + staging_size - 1) / staging_size * staging_size;
+					parallel_parts((n + chunk - 1) / chunk, [=](size_t t) {
+						size_t begin = t * chunk;
+						vectorized(f, in + begin, out + begin, std::min(chunk, n - begin), path());
+					});
+				}
+
+			} // namespace detail
+		} // namespace batch
+
+		// out[i] = exp(in[i])
+		template<size_t nbits, size_t es>
+		void vexp(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::exp, in, out, n, nrOfThreads);
+		}
+		// out[i] = log(in[i])
+		template<size_t nbits, size_t es>
+		void vlog(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::log, in, out, n, nrOfThreads);
+		}
+		// out[i] = log2(in[i])
+		template<size_t nbits, size_t es>
+		void vlog2(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::log2, in, out, n, nrOfThreads);
+		}
+		// out[i] = sin(in[i])
+		template<size_t nbits, size_t es>
+		void vsin(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::sin, in, out, n, nrOfThreads);
+		}
+		// out[i] = cos(in[i])
+		template<size_t nbits, size_t es>
+		void vcos(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::cos, in, out, n, nrOfThreads);
+		}
+		// out[i] = tanh(in[i])
+		template<size_t nbits, size_t es>
+		void vtanh(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::tanh, in, out, n, nrOfThreads);
+		}
+		// out[i] = sqrt(in[i])
+		template<size_t nbits, size_t es>
+		void vsqrt(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::sqrt, in, out, n, nrOfThreads);
+		}
+		// out[i] = rsqrt(in[i])
+		template<size_t nbits, size_t es>
+		void vrsqrt(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::rsqrt, in, out, n, nrOfThreads);
+		}
+		// out[i] = in[i].reciprocate()
+		template<size_t nbits, size_t es>
+		void vreciprocal(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::reciprocal, in, out, n, nrOfThreads);
+		}
+		// out[i] = sigmoid(in[i])
+		template<size_t nbits, size_t es>
+		void vsigmoid(const posit<nbits, es>* in, posit<nbits, es>* out, size_t n, size_t nrOfThreads = 1) {
+			batch::detail::vectorized(posit_function::sigmoid, in, out, n, nrOfThreads);
+		}
+
+		// std::vector interface: the output is resized to the size of the input
+		template<size_t nbits, size_t es>
+		void vexp(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vexp(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vlog(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vlog(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vlog2(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vlog2(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vsin(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vsin(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vcos(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vcos(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vtanh(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vtanh(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vsqrt(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vsqrt(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vrsqrt(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vrsqrt(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vreciprocal(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vreciprocal(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+		template<size_t nbits, size_t es>
+		void vsigmoid(const std::vector<posit<nbits, es>>& in, std::vector<posit<nbits, es>>& out, size_t nrOfThreads = 1) {
+			out.resize(in.size());
+			vsigmoid(in.data(), out.data(), in.size(), nrOfThreads);
+		}
+
+	} // namespace unum
+} // namespace sw
@@ -0,0 +1,437 @@
+#pragma once
+// native_engine.hpp: native integer arithmetic engine for posit configurations with nbits <= 64
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "../bitblock/bitblock.hpp"
+#include "../bitblock/limbs.hpp"
+#include "ieee754.hpp"
+
+// The native engine packs a posit<nbits, es> with nbits <= 64 into the smallest unsigned integer
+// that holds the encoding and executes add, sub, mul, div, sqrt, and rsqrt with native integer operations.
+// All field widths and shift amounts derive from nbits and es and are compile-time constants,
+// and the intermediate width of each operator is the narrowest native type that keeps the
+// result exact up to a guard and sticky bit: 64-bit words for the smaller configurations,
+// 128-bit words when the significands get too wide.
+//
+// The engine is selected for the generic posit<nbits, es> by setting POSIT_FAST_NATIVE_ARITHMETIC to 1,
+// and yields the same encodings as the bitblock based arithmetic modules.
+//
+// Decoding, rounding, the conversions from native types, and add, mul, and div are constexpr
+// for posits with nbits <= 32, so that the specialized posits can be evaluated at compile time.
+
+namespace sw {
+namespace unum {
+
+// smallest unsigned integer type that holds an nbits encoding
+template<size_t nbits>
+using native_storage_t = typename std::conditional<(nbits <= 8), uint8_t,
+	typename std::conditional<(nbits <= 16), uint16_t,
+	typename std::conditional<(nbits <= 32), uint32_t, uint64_t>::type>::type>::type;
+
+#if LIMBS_HAVE_INT128
+using native_wide_t = uint128_limb_t;
+#else
+using native_wide_t = uint64_t;
+#endif
+
+// smallest native unsigned integer type that holds a bits wide intermediate
+template<size_t bits>
+using native_intermediate_t = typename std::conditional<(bits <= 64), uint64_t, native_wide_t>::type;
+
+// posit configurations that the native engine supports on this platform
+template<size_t nbits, size_t es>
+struct native_engine_supported {
+	static constexpr bool value = (nbits <= 64) && (LIMBS_HAVE_INT128 || nbits <= 32);
+};
+
+// count leading zeros of the native intermediates
+inline constexpr unsigned native_clz(uint64_t x) { return clz64(x); }
+#if LIMBS_HAVE_INT128
+inline constexpr unsigned native_clz(uint128_limb_t x) {
+	uint64_t hi = uint64_t(x >> 64);
+	return hi ? clz64(hi) : 64 + clz64(uint64_t(x));
+}
+#endif
+
+// take the upper 64 bits of a left aligned intermediate, folding the lower bits into the sticky bit
+inline constexpr uint64_t native_upper(uint64_t x, bool& /* sticky */) { return x; }
+#if LIMBS_HAVE_INT128
+inline constexpr uint64_t native_upper(uint128_limb_t x, bool& sticky) {
+	sticky |= (uint64_t(x) != 0);
+	return uint64_t(x >> 64);
+}
+#endif
+
+template<size_t nbits, size_t es>
+class native_engine {
+public:
+	static_assert(nbits >= 2 && nbits <= 64, "native_engine requires 2 <= nbits <= 64");
+	static_assert(es < 32, "native_engine requires es < 32");
+
+	using storage_t = native_storage_t<nbits>;
+
+	static constexpr size_t   fbits    = (es + 2 >= nbits ? 0 : nbits - 3 - es);  // maximum number of fraction bits
+	static constexpr size_t   fhbits   = fbits + 1;                               // fraction bits + hidden bit
+	static constexpr int      maxscale = int(nbits - 2) * (1 << es);             // scale of maxpos
+	static constexpr uint64_t mask     = (nbits == 64 ? ~uint64_t(0) : (uint64_t(1) << (nbits % 64)) - 1);
+	static constexpr uint64_t sign_mask = uint64_t(1) << (nbits - 1);
+	static constexpr uint64_t maxpos   = mask >> 1;
+
+	// intermediate types: the adder needs a carry bit and two guard bits below the significand,
+	// and the divider a numerator of 2*fhbits + 3 bits
+	using add_t  = native_intermediate_t<fhbits + 3>;
+	using divide_t  = native_intermediate_t<2 * fhbits + 4>;
+
+	// limbs of the square root and reciprocal square root operand: fhbits + 2 root bits and two integer bits
+	static constexpr size_t rlimbs = nr_limbs(fhbits + 4);
+
+	// decode an encoding into sign, scale, and a significand with the hidden bit at bit 63
+	// zero and NaR must be handled by the caller
+	static constexpr void decode(uint64_t raw, bool& sign, int& scale, uint64_t& sig) {
+		sign = (raw & sign_mask) != 0;
+		if (sign) raw = (~raw + 1) & mask;
+		uint64_t tmp = raw << (64 - nbits + 1);  // left align the bits following the sign bit
+		// the regime run length and k = m - 1 for a run of ones, -m for a run of zeros: masks rather than
+		// selects, which compilers turn into branches that mispredict on arguments of random magnitude
+		uint64_t ones = 0 - (tmp >> 63);
+		unsigned m = clz64(tmp ^ ones);
+		int k = (int(m) ^ ~int(ones)) - 1 + 2 * int(~ones & 0x1);
+		tmp = (m + 1 < 64 ? tmp << (m + 1) : 0);    // remove the regime run and its termination bit
+		uint64_t e = 0;
+		if (es > 0) {
+			e = tmp >> (64 - es);
+			tmp <<= es;
+		}
+		scale = k * (1 << es) + int(e);
+		sig = (tmp >> 1) | (uint64_t(1) << 63);
+	}
+
+	// round a (sign, scale, significand, sticky) value with the hidden bit at bit 63 to the nearest encoding
+	static constexpr uint64_t encode(bool sign, int scale, uint64_t sig, bool sticky) {
+		uint64_t bits = 0;
+		if (scale > maxscale) {
+			bits = maxpos;
+		}
+		else if (scale < -maxscale) {
+			bits = 1;   // minpos
+		}
+		else {
+			bool r = (scale >= 0);
+			unsigned run = unsigned(r ? 1 + (scale >> es) : -(scale >> es));
+			uint64_t esval = uint64_t(scale) & ((uint64_t(1) << es) - 1);
+			unsigned rl = run + 1;   // regime bits including the termination bit
+			// left aligned posit body: regime, exponent, fraction
+			uint64_t body = r ? ~uint64_t(0) << (64 - run) : uint64_t(1) << (63 - run);
+			if (es > 0) {
+				int lsb = 64 - int(rl) - int(es);
+				if (lsb >= 0) {
+					body |= esval << lsb;
+				}
+				else {
+					body |= esval >> -lsb;
+					sticky |= (esval & ((uint64_t(1) << -lsb) - 1)) != 0;
+				}
+			}
+			uint64_t fraction = sig << 1;  // remove the hidden bit
+			unsigned fshift = rl + es;
+			if (fshift < 64) {
+				body |= fraction >> fshift;
+				sticky |= (fshift > 0 && (fraction << (64 - fshift)) != 0);
+			}
+			else {
+				sticky |= (fraction != 0);
+			}
+			// the nbits-1 bits of the posit body are followed by the guard bit
+			if (nbits < 64) sticky |= (body & ((uint64_t(1) << (64 - nbits)) - 1)) != 0;
+			bool guard = ((body >> (64 - nbits)) & 0x1) != 0;
+			bits = body >> (64 - nbits + 1);
+			if (guard && (sticky || (bits & 0x1))) ++bits;
+		}
+		if (sign) bits = (~bits + 1) & mask;
+		return bits;
+	}
+
+	static constexpr bool iszero(uint64_t raw) { return raw == 0; }
+	static constexpr bool isnar(uint64_t raw) { return raw == sign_mask; }
+
+	// round an integer to the nearest encoding
+	static constexpr storage_t from_integer(long long v) {
+		if (v == 0) return 0;
+		bool sign = (v < 0);
+		uint64_t magnitude = sign ? ~uint64_t(v) + 1 : uint64_t(v);
+		unsigned lz = clz64(magnitude);
+		return storage_t(encode(sign, 63 - int(lz), magnitude << lz, false));
+	}
+	static constexpr storage_t from_unsigned(unsigned long long v) {
+		if (v == 0) return 0;
+		unsigned lz = clz64(v);
+		return storage_t(encode(false, 63 - int(lz), uint64_t(v) << lz, false));
+	}
+
+	// round an IEEE floating-point value to the nearest encoding: NaN and infinities project to NaR
+	// at run time the value is decomposed on its bit pattern; it is a constant expression only where
+	// POSIT_HAVE_CONSTANT_EVALUATED, elsewhere from_ieee_constexpr is the compile-time conversion
+	template<typename Real>
+	static constexpr storage_t from_ieee(Real v) {
+		return POSIT_CONSTANT_EVALUATED() ? from_ieee_constexpr(v) : from_ieee_native(v);
+	}
+	// the value is normalized by exact power of 2 scaling
+	template<typename Real>
+	static constexpr storage_t from_ieee_constexpr(Real v) {
+		if (v != v || v > std::numeric_limits<Real>::max() || v < -std::numeric_limits<Real>::max()) return storage_t(sign_mask);
+		if (v == 0) return 0;
+		bool sign = (v < 0);
+		if (sign) v = -v;
+		constexpr Real two64 = Real(18446744073709551616.0);
+		int scale = 0;
+		while (v >= two64) { v /= two64; scale += 64; }
+		while (v >= Real(2)) { v /= Real(2); ++scale; }
+		while (v < Real(1) / two64) { v *= two64; scale -= 64; }
+		while (v < Real(1)) { v *= Real(2); --scale; }
+		// v is in [1, 2): left align the significand with the hidden bit at bit 63
+		Real aligned = v * Real(9223372036854775808.0);
+		uint64_t sig = uint64_t(aligned);
+		bool sticky = (aligned - Real(sig)) != Real(0);  // significands wider than 64 bits
+		return storage_t(encode(sign, scale, sig, sticky));
+	}
+
+	// the value of an encoding rounded to nearest even onto an IEEE floating-point type: NaR projects to NaN
+	// like from_ieee, a constant expression only where POSIT_HAVE_CONSTANT_EVALUATED, elsewhere use to_ieee_constexpr
+	template<typename Real>
+	static constexpr Real to_ieee(storage_t raw) {
+		return POSIT_CONSTANT_EVALUATED() ? to_ieee_constexpr<Real>(raw) : to_ieee_native<Real>(raw);
+	}
+	// the significand is rounded once by the integer conversion, the power of 2 scaling is exact outside of the subnormal range
+	template<typename Real>
+	static constexpr Real to_ieee_constexpr(storage_t raw) {
+		if (iszero(raw)) return Real(0);
+		if (isnar(raw)) return std::numeric_limits<Real>::quiet_NaN();
+		bool sign = false;
+		int scale = 0;
+		uint64_t sig = 0;
+		decode(raw, sign, scale, sig);
+		Real v = Real(sig);
+		scale -= 63;
+		constexpr Real two64 = Real(18446744073709551616.0);
+		while (scale >= 64) { v *= two64; scale -= 64; }
+		while (scale > 0) { v *= Real(2); --scale; }
+		while (scale <= -64) { v /= two64; scale += 64; }
+		while (scale < 0) { v /= Real(2); ++scale; }
+		return sign ? -v : v;
+	}
+
+	// a + b, or a - b when subtract is set: operands must not be zero or NaR
+	static constexpr storage_t add(storage_t a, storage_t b, bool subtract = false) {
+		bool sa = false, sb = false;
+		int xa = 0, xb = 0;
+		uint64_t fa = 0, fb = 0;
+		decode(a, sa, xa, fa);
+		decode(b, sb, xb, fb);
+		if (subtract) sb = !sb;
+		constexpr unsigned abits = 8 * sizeof(add_t);
+		// hidden bit one below the msb of the adder to catch the carry
+		add_t x = (add_t(fa) << (abits - 64)) >> 1;
+		add_t y = (add_t(fb) << (abits - 64)) >> 1;
+		if (xa < xb || (xa == xb && x < y)) {
+			bool ts = sa; sa = sb; sb = ts;
+			int tx = xa; xa = xb; xb = tx;
+			add_t tf = x; x = y; y = tf;
+		}
+		unsigned shift = unsigned(xa - xb);
+		bool sticky = false;
+		if (shift >= abits) {
+			sticky = (y != 0);
+			y = 0;
+		}
+		else {
+			sticky = shift > 0 && (y & ((add_t(1) << shift) - 1)) != 0;
+			y >>= shift;
+		}
+		add_t sum = 0;
+		if (sa == sb) {
+			sum = x + y;
+		}
+		else {
+			// the shifted out bits of y reduce the difference below the truncated result
+			sum = x - y - (sticky ? 1 : 0);
+			if (sum == 0) return 0;
+		}
+		unsigned lz = native_clz(sum);
+		sum <<= lz;
+		uint64_t sig = native_upper(sum, sticky);
+		return storage_t(encode(sa, xa + 1 - int(lz), sig, sticky));
+	}
+
+	// a * b: operands must not be zero or NaR
+	static constexpr storage_t mul(storage_t a, storage_t b) {
+		bool sa = false, sb = false;
+		int xa = 0, xb = 0;
+		uint64_t fa = 0, fb = 0;
+		decode(a, sa, xa, fa);
+		decode(b, sb, xb, fb);
+		uint64_t product = 0, lower = 0;
+		if (fhbits <= 32) {
+			// the significands fit in the upper 32 bits, so the product is exact in 64 bits
+			product = (fa >> 32) * (fb >> 32);
+		}
+		else {
+			lower = mul64x64(fa, fb, product);
+		}
+		// the product of two significands with the hidden bit at bit 63 has its msb at bit 127 or 126
+		unsigned lz = unsigned(product >> 63) ? 0 : 1;
+		if (lz) {
+			product = (product << 1) | (lower >> 63);
+			lower <<= 1;
+		}
+		return storage_t(encode(sa ^ sb, xa + xb + 1 - int(lz), product, lower != 0));
+	}
+
+	// a / b: operands must not be zero or NaR
+	static constexpr storage_t div(storage_t a, storage_t b) {
+		bool sa = false, sb = false;
+		int xa = 0, xb = 0;
+		uint64_t fa = 0, fb = 0;
+		decode(a, sa, xa, fa);
+		decode(b, sb, xb, fb);
+		// right align the significands as fhbits integers and scale the dividend
+		// so that the quotient carries fhbits + 3 or fhbits + 4 significant bits
+		int msb = 0;
+		bool sticky = false;
+		uint64_t sig = divide(fa >> (64 - fhbits), fb >> (64 - fhbits), msb, sticky);
+		return storage_t(encode(sa ^ sb, xa - xb + msb - int(fhbits + 3), sig, sticky));
+	}
+
+	// sqrt(a): operand must be positive and not zero or NaR
+	static storage_t sqrt(storage_t a) {
+		uint64_t v[rlimbs], root[rlimbs];
+		int e = root_operand(a, v);
+		bool sticky = limbs_fraction_sqrt<rlimbs>(v, fhbits + 2, root);
+		// root / 2^(fhbits+1) = sqrt(v) in [1, 2)
+		return root_encode(root, sticky, e / 2);
+	}
+
+	// 1 / sqrt(a): operand must be positive and not zero or NaR
+	static storage_t rsqrt(storage_t a) {
+		uint64_t v[rlimbs], root[rlimbs];
+		int e = root_operand(a, v);
+		bool sticky = limbs_fraction_rsqrt<rlimbs>(v, fhbits + 2, root);
+		// root / 2^(fhbits+1) = 1 / sqrt(v) in (1/2, 1]
+		return root_encode(root, sticky, -e / 2);
+	}
+
+	////////////////////////////////////////////////////////////////////
+	// bitblock interface used by the generic posit<nbits, es>
+
+	static bitblock<nbits> add(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return to_bitblock(add(storage_t(a.to_ullong()), storage_t(b.to_ullong()), false));
+	}
+	static bitblock<nbits> sub(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return to_bitblock(add(storage_t(a.to_ullong()), storage_t(b.to_ullong()), true));
+	}
+	static bitblock<nbits> mul(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return to_bitblock(mul(storage_t(a.to_ullong()), storage_t(b.to_ullong())));
+	}
+	static bitblock<nbits> div(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+		return to_bitblock(div(storage_t(a.to_ullong()), storage_t(b.to_ullong())));
+	}
+	static bitblock<nbits> sqrt(const bitblock<nbits>& a) {
+		return to_bitblock(sqrt(storage_t(a.to_ullong())));
+	}
+	static bitblock<nbits> rsqrt(const bitblock<nbits>& a) {
+		return to_bitblock(rsqrt(storage_t(a.to_ullong())));
+	}
+	template<typename Real>
+	static bitblock<nbits> ieee_to_bitblock(Real v) {
+		return to_bitblock(from_ieee_native(v));
+	}
+	template<typename Real>
+	static Real bitblock_to_ieee(const bitblock<nbits>& a) {
+		return to_ieee_native<Real>(storage_t(a.to_ullong()));
+	}
+
+private:
+	// a = v * 2^e with v in [1, 4) and e even: load v as a normalized fraction of rlimbs limbs and return e
+	static int root_operand(storage_t a, uint64_t* v) {
+		bool sa;
+		int xa;
+		uint64_t fa;
+		decode(a, sa, xa, fa);
+		limbs_clear<rlimbs>(v);
+		v[rlimbs - 1] = (xa & 0x1) ? fa : fa >> 1;
+		return xa - (xa & 0x1);
+	}
+	// round a root of fhbits + 2 bits, the last one a guard bit below the significand, that is scaled by 2^scale
+	static storage_t root_encode(uint64_t* root, bool sticky, int scale) {
+		unsigned lz = limbs_clz<rlimbs>(root);
+		limbs_shl<rlimbs>(root, lz);
+		// the root fits the leading limb: the lower limb of a two limb root is zero
+		return storage_t(encode(false, int(64 * rlimbs - 1 - lz) - int(fhbits + 1) + scale, root[rlimbs - 1], sticky));
+	}
+
+	template<typename Real>
+	static storage_t from_ieee_native(Real v) {
+		bool sign = false, sticky = false;
+		int scale = 0;
+		uint64_t sig = 0;
+		switch (ieee754_decompose(v, sign, scale, sig, sticky)) {
+		case ieee754_class::zero:
+			return 0;
+		case ieee754_class::nonfinite:
+			return storage_t(sign_mask);
+		default:
+			return storage_t(encode(sign, scale, sig, sticky));
+		}
+	}
+	template<typename Real>
+	static Real to_ieee_native(storage_t raw) {
+		if (iszero(raw)) return Real(0);
+		if (isnar(raw)) return std::numeric_limits<Real>::quiet_NaN();
+		bool sign = false;
+		int scale = 0;
+		uint64_t sig = 0;
+		decode(raw, sign, scale, sig);
+		return ieee754_round<Real>(sign, scale, sig, false);
+	}
+
+	// quotient a * 2^(fhbits + 3) / b of right aligned significands, left aligned with the position of its msb in msb
+	static constexpr uint64_t divide(uint64_t a, uint64_t b, int& msb, bool& sticky) {
+		constexpr unsigned shift = unsigned(fhbits + 3) % 64;
+		uint64_t q = 0;
+		if (2 * fhbits + 4 <= 64) {
+			uint64_t n = a << shift;
+			q = n / b;
+			sticky = (n - q * b) != 0;
+		}
+		else if (fhbits + 4 <= 64) {
+			// the quotient fits in 64 bits: a single 128 by 64 bit division
+			uint64_t rem = 0;
+			q = div128by64(a >> ((64 - shift) % 64), a << shift, b, rem);
+			sticky = (rem != 0);
+		}
+		else {
+			divide_t n = divide_t(a) << (fhbits + 3);
+			divide_t wq = n / b;
+			sticky = (n - wq * b) != 0;
+			unsigned lz = native_clz(wq);
+			msb = int(8 * sizeof(divide_t)) - 1 - int(lz);
+			return native_upper(wq << lz, sticky);
+		}
+		unsigned lz = clz64(q);
+		msb = 63 - int(lz);
+		return q << lz;
+	}
+
+	static bitblock<nbits> to_bitblock(storage_t bits) {
+		bitblock<nbits> result;
+		result = (unsigned long long)bits;
+		return result;
+	}
+};
+
+}  // namespace unum
+}  // namespace sw
@@ -9,7 +9,6 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
-#include <regex>
 #include <type_traits>
 
 // to yield a fast regression environment for productive development
@@ -69,6 +68,13 @@ typedef __128bitdd double_double;
 // define to non-zero if you want to throw exceptions on arithmetic errors
 // #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 
+// define to non-zero if you want the generic posit to use the 64-bit limb arithmetic engine
+// #define POSIT_LIMB_ARITHMETIC 1
+
+// define to non-zero if you want the generic posit with nbits <= 64 to use the native integer arithmetic engine
+// #define POSIT_FAST_NATIVE_ARITHMETIC 1
+#include "engine_switches.hpp"
+
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 // Posits encode error conditions as NaR (Not a Real), propagating the error through arithmetic operations is preferred
 #include "./exceptions.hpp"
@@ -81,6 +87,9 @@ typedef __128bitdd double_double;
 #include "exponent.hpp"
 #include "regime.hpp"
 #include "posit_functions.hpp"
+#include "limb_engine.hpp"
+#include "native_engine.hpp"
+#include "decimal.hpp"
 
 namespace sw {
 namespace unum {
@@ -486,53 +495,11 @@ posit<nbits, es>& construct(bool s, const regime<nbits, es>& r, const exponent<n
 	return p;
 }
 
-// read a posit ASCII format and make a memory posit out of it
-template<size_t nbits, size_t es>
-bool parse(std::string& txt, posit<nbits, es>& p) {
-	bool bSuccess = false;
-	// check if the txt is of the native posit form: nbits.esXhexvalue
-	std::regex posit_regex("[\\d]+\\.[0123456789][xX][\\w]+[p]*");
-	if (std::regex_match(txt, posit_regex)) {
-		// found a posit representation
-		std::string nbitsStr, esStr, bitStr;
-		auto it = txt.begin();
-		for (; it != txt.end(); it++) {
-			if (*it == '.') break;
-			nbitsStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'x' || *it == 'X') break;
-			esStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'p') break;
-			bitStr.append(1, *it);
-		}
-		size_t nbits_in = nbits;
-		{
-			std::istringstream ss(nbitsStr);
-			ss >> nbits_in;
-		}
-		unsigned long long raw;
-		std::istringstream ss(bitStr);
-		ss >> std::hex >> raw;
-		//std::cout << "[" << nbitsStr << "] [" << esStr << "] [" << bitStr << "] = " << raw << std::endl;
-		// if not aligned, set_raw_bits takes the least significant nbits, so we need to shift to pick up the most significant nbits
-		if (nbits < nbits_in) {
-			raw >>= (nbits_in - nbits);
-		}
-		p.set_raw_bits(raw);  
-		bSuccess = true;
-	}
-	else {
-		// assume it is a float/double/long double representation
-		std::istringstream ss(txt);
-		double d;
-		ss >> d;
-		p = d;
-		bSuccess = true;
-	}
-	return bSuccess;
+// read a posit ASCII format and make a memory posit out of it:
+// a decimal or scientific literal, nar, or the hexadecimal posit format nbits.esxNN...NNp
+template<size_t nbits, size_t es>
+bool parse(const std::string& txt, posit<nbits, es>& p) {
+	return parse(txt.data(), txt.size(), p);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -556,6 +523,16 @@ public:
 	static constexpr size_t mbits   = 2 * fhbits;                 // size of the multiplier output
 	static constexpr size_t divbits = 3 * fhbits + 4;             // size of the divider output
 
+	// word-level arithmetic engines that replace the bitblock arithmetic modules when enabled
+	static constexpr bool native_arithmetic = POSIT_FAST_NATIVE_ARITHMETIC && native_engine_supported<nbits, es>::value;
+	static constexpr bool engine_arithmetic = POSIT_LIMB_ARITHMETIC || native_arithmetic;
+	using arithmetic_engine = typename std::conditional<native_arithmetic, native_engine<nbits, es>, limb_engine<nbits, es>>::type;
+	// the IEEE-754 conversions work on the bit pattern of the native types in either engine
+	using conversion_engine = typename std::conditional<native_engine_supported<nbits, es>::value, native_engine<nbits, es>, limb_engine<nbits, es>>::type;
+	// division always runs on a word-level engine instead of the bit-serial long division of module_divide:
+	// the native division up to 64 bits, and beyond the limb engine, which divides with a table seeded reciprocal
+	using division_engine = typename std::conditional<engine_arithmetic, arithmetic_engine, conversion_engine>::type;
+
 	posit() { setzero();  }
 	
 	posit(const posit&) = default;
@@ -777,6 +754,12 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
+#if POSIT_LIMB_ARITHMETIC || POSIT_FAST_NATIVE_ARITHMETIC
+		if (engine_arithmetic) {
+			_raw_bits = arithmetic_engine::add(_raw_bits, rhs._raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<abits + 1> sum;
 		value<fbits> a, b;
@@ -819,6 +802,12 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
+#if POSIT_LIMB_ARITHMETIC || POSIT_FAST_NATIVE_ARITHMETIC
+		if (engine_arithmetic) {
+			_raw_bits = arithmetic_engine::sub(_raw_bits, rhs._raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<abits + 1> difference;
 		value<fbits> a, b;
@@ -861,6 +850,12 @@ public:
 			return *this;
 		}
 
+#if POSIT_LIMB_ARITHMETIC || POSIT_FAST_NATIVE_ARITHMETIC
+		if (engine_arithmetic) {
+			_raw_bits = arithmetic_engine::mul(_raw_bits, rhs._raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<mbits> product;
 		value<fbits> a, b;
@@ -915,37 +910,7 @@ public:
 			return *this;
 		}
 #endif
-		value<divbits> ratio;
-		value<fbits> a, b;
-		// transform the inputs into (sign,scale,fraction) triples
-		normalize(a);
-		rhs.normalize(b);
-
-		module_divide(a, b, ratio);
-
-		// special case handling on the output
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-		if (ratio.iszero()) {
-			throw division_result_is_zero{};
-		}
-		else if (ratio.isinf()) {
-			throw division_result_is_infinite{};
-		}
-		else {
-			convert<nbits, es, divbits>(ratio, *this);
-		}
-#else
-		if (ratio.iszero()) {
-			setzero();  // this shouldn't happen as we should project back onto minpos
-		}
-		else if (ratio.isinf()) {
-			setnar();  // this shouldn't happen as we should project back onto maxpos
-		}
-		else {
-			convert<nbits, es, divbits>(ratio, *this);
-		}
-#endif
-
+		_raw_bits = division_engine::div(_raw_bits, rhs._raw_bits);
 		return *this;
 	}
 	posit& operator/=(double rhs) {
@@ -973,47 +938,9 @@ public:
 			p.set(raw_bits);
 		}
 		else {
-			bool s;
-			regime<nbits, es> r;
-			exponent<nbits, es> e;
-			fraction<fbits> f;
-			decode(_raw_bits, s, r, e, f);
-
-			constexpr size_t operand_size = fhbits;
-			bitblock<operand_size> one;
-			one.set(operand_size - 1, true);
-			bitblock<operand_size> frac;
-			copy_into(f.get(), 0, frac);
-			frac.set(operand_size - 1, true);
-			constexpr size_t reciprocal_size = 3 * fbits + 4;
-			bitblock<reciprocal_size> reciprocal;
-			divide_with_fraction(one, frac, reciprocal);
-			if (_trace_reciprocate) {
-				std::cout << "one    " << one << std::endl;
-				std::cout << "frac   " << frac << std::endl;
-				std::cout << "recip  " << reciprocal << std::endl;
-			}
-
-			// radix point falls at operand size == reciprocal_size - operand_size - 1
-			reciprocal <<= operand_size - 1;
-			if (_trace_reciprocate) std::cout << "frac   " << reciprocal << std::endl;
-			int new_scale = -scale(*this);
-			int msb = findMostSignificantBit(reciprocal);
-			if (msb > 0) {
-				int shift = reciprocal_size - msb;
-				reciprocal <<= shift;
-				new_scale -= (shift-1);
-				if (_trace_reciprocate) std::cout << "result " << reciprocal << std::endl;
-			}
-			//std::bitset<operand_size> tr;
-			//truncate(reciprocal, tr);
-			//std::cout << "tr     " << tr << std::endl;
-
-			// the following is failing for some reason
-			// value<reciprocal_size> v(old_sign, new_scale, reciprocal);
-			// convert(v, p);
-			// instead the following works
-			convert_<nbits,es, reciprocal_size>(old_sign, new_scale, reciprocal, p);
+			posit<nbits, es> one(1);
+			p._raw_bits = division_engine::div(one._raw_bits, _raw_bits);
+			if (_trace_reciprocate) std::cout << "result " << p._raw_bits << std::endl;
 		}
 		return p;
 	}
@@ -1097,14 +1024,7 @@ public:
 	}
 	// Set the raw bits of the posit given an unsigned value starting from the lsb. Handy for enumerating a posit state space
 	posit<nbits,es>& set_raw_bits(uint64_t value) {
-		clear();
-		bitblock<nbits> raw_bits;
-		uint64_t mask = 1;
-		for ( size_t i = 0; i < nbits; i++ ) {
-			raw_bits.set(i,(value & mask));
-			mask <<= 1;
-		}
-		_raw_bits = raw_bits;
+		_raw_bits = (unsigned long long)value;
 		return *this;
 	}
 
@@ -1245,52 +1165,18 @@ private:
 	}
 #endif
 	float       to_float() const {
-		return (float)to_double();
+		return conversion_engine::template bitblock_to_ieee<float>(_raw_bits);
 	}
 	double      to_double() const {
-		if (iszero())	return 0.0;
-		if (isnar())	return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		double s = (_sign ? -1.0 : 1.0);
-		double r = _regime.value();
-		double e = _exponent.value();
-		double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		return conversion_engine::template bitblock_to_ieee<double>(_raw_bits);
 	}
 	long double to_long_double() const {
-		if (iszero())  return 0.0;
-		if (isnar())   return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		long double s = (_sign ? -1.0 : 1.0);
-		long double r = _regime.value();
-		long double e = _exponent.value();
-		long double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		return conversion_engine::template bitblock_to_ieee<long double>(_raw_bits);
 	}
 	template <typename T>
 	posit<nbits, es>& float_assign(const T& rhs) {
-		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-		value<dfbits> v((T)rhs);
-
-		// special case processing
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-			setnar();
-			return *this;
-		}
-
-		convert(v, *this);
+		// NaN and infinities project to NaR (Not a Real)
+		_raw_bits = conversion_engine::ieee_to_bitblock(rhs);
 		return *this;
 	}
 
@@ -1726,21 +1612,17 @@ inline bool ispowerof2(const posit<nbits, es>& p) {
 // generate a posit format ASCII format nbits.esxNN...NNp
 template<size_t nbits, size_t es>
 inline std::ostream& operator<<(std::ostream& ostr, const posit<nbits, es>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 	// to make certain that setw and left/right operators work properly
 	// we need to transform the posit into a string
 	std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 	ss << nbits << '.' << es << 'x' << to_hex(p.get()) << 'p';
+	return ostr << ss.str();
 #else
-	std::streamsize prec = ostr.precision();
-	std::streamsize width = ostr.width();
-	std::ios_base::fmtflags ff;
-	ff = ostr.flags();
-	ss.flags(ff);
-//	ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
-	ss << std::setw(width) << std::setprecision(prec) << (long double)p;  // TODO: we need a true native serialization function
+	// the digits are generated from the exact value of the posit, there is no rounding through long double,
+	// and the text is padded to the width of the stream through a buffer on the stack
+	return write_decimal(ostr, p, ostr.flags());
 #endif
-	return ostr << ss.str();
 }
 
 // read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
@@ -1776,9 +1658,7 @@ inline std::string to_string(const posit<nbits, es>& p, std::streamsize precisio
 	if (p.isnar()) {
 		return std::string("nar");
 	}
-	std::stringstream ss;
-	ss << std::setprecision(precision) << (long double)p;
-	return ss.str();
+	return to_decimal_string(p, std::ios_base::fmtflags(0), precision);
 }
 
 // binary representation of a posit with delimiters: i.e. 0|10|00|000000 => s|r|e|f
@@ -0,0 +1,426 @@
+#pragma once
+// posit_lut.hpp: lookup table arithmetic for small posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "native_engine.hpp"
+#include "batch.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define POSIT_LUT_MMAP 1
+#else
+#define POSIT_LUT_MMAP 0
+#endif
+
+// posit_lut<nbits, es> is a posit<nbits, es> for nbits <= 10 whose add, sub, mul, and div
+// are a single load from a table indexed by the concatenated encodings of the operands.
+// The tables hold the results of the posit operators for every operand pair, including NaR
+// and zero, and are generated at first use. They can also be written to a binary file with
+// posit_lut_tables<nbits, es>::save and memory-mapped with posit_lut_tables<nbits, es>::map before
+// the first lookup, so that processes share one copy of the tables. Array operators in sw::unum::batch
+// gather eight results per AVX2 instruction.
+//
+// The tables do not raise posit arithmetic exceptions: division by zero yields NaR.
+
+namespace sw {
+	namespace unum {
+
+		// arithmetic operators served by the lookup tables
+		enum class lut_op { add = 0, sub = 1, mul = 2, div = 3 };
+
+		template<size_t nbits, size_t es>
+		class posit_lut_tables {
+		public:
+			static_assert(nbits >= 2 && nbits <= 10, "posit_lut_tables requires 2 <= nbits <= 10");
+			using storage_t = native_storage_t<nbits>;
+			using engine = native_engine<nbits, es>;
+
+			static constexpr size_t nr_of_encodings = size_t(1) << nbits;
+			static constexpr size_t nr_of_ops = 4;
+			// each table is padded so that 32-bit gathers of the last entry stay inside the table
+			static constexpr size_t stride = nr_of_encodings * nr_of_encodings + 4;
+			static constexpr size_t header_size = 16;
+
+			// table of an operator: the result of a op b is at index (a << nbits) | b
+			// Published tables stay at their address for the life of the process.
+			static const storage_t* table(lut_op op) {
+				state& s = instance();
+				// a lookup is one load once the tables exist: the lock is only on the path that generates them
+				const storage_t* t = s.tables.load(std::memory_order_acquire);
+				if (t == nullptr) {
+					std::lock_guard<std::mutex> guard(s.lock);
+					t = s.tables.load(std::memory_order_relaxed);
+					if (t == nullptr) {
+						generate(s.generated);
+						t = s.generated.data();
+						s.tables.store(t, std::memory_order_release);
+					}
+				}
+				return t + size_t(op) * stride;
+			}
+
+			// write the tables to a binary file that map() can share between processes:
+			// tables that are not in use yet are generated for the file without being published
+			static bool save(const std::string& filename) {
+				const storage_t* t = instance().tables.load(std::memory_order_acquire);
+				std::vector<storage_t> buffer;
+				if (t == nullptr) {
+					generate(buffer);
+					t = buffer.data();
+				}
+				FILE* f = std::fopen(filename.c_str(), "wb");
+				if (f == nullptr) return false;
+				uint8_t header[header_size];
+				make_header(header);
+				bool ok = std::fwrite(header, 1, header_size, f) == header_size;
+				ok = ok && std::fwrite(t, sizeof(storage_t), nr_of_ops * stride, f) == nr_of_ops * stride;
+				return (std::fclose(f) == 0) && ok;
+			}
+
+			// use the tables of a file written by save(): fails once a lookup has published the tables,
+			// as the published tables may be in use
+			static bool map(const std::string& filename) {
+				state& s = instance();
+				std::lock_guard<std::mutex> guard(s.lock);
+				if (s.tables.load(std::memory_order_relaxed) != nullptr) return false;
+				const size_t size = header_size + nr_of_ops * stride * sizeof(storage_t);
+#if POSIT_LUT_MMAP
+				int fd = ::open(filename.c_str(), O_RDONLY);
+				if (fd < 0) return false;
+				struct stat st;
+				if (::fstat(fd, &st) != 0 || size_t(st.st_size) != size) {
+					::close(fd);
+					return false;
+				}
+				void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+				::close(fd);
+				if (mapping == MAP_FAILED) return false;
+				const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+				if (!valid_header(bytes)) {
+					::munmap(mapping, size);
+					return false;
+				}
+				s.mapping = mapping;
+				s.mapping_size = size;
+				s.tables.store(reinterpret_cast<const storage_t*>(bytes + header_size), std::memory_order_release);
+				return true;
+#else
+				// without memory mapping the file is read into private memory
+				FILE* f = std::fopen(filename.c_str(), "rb");
+				if (f == nullptr) return false;
+				uint8_t header[header_size];
+				std::vector<storage_t> buffer(nr_of_ops * stride);
+				bool ok = std::fread(header, 1, header_size, f) == header_size && valid_header(header);
+				ok = ok && std::fread(buffer.data(), sizeof(storage_t), buffer.size(), f) == buffer.size();
+				std::fclose(f);
+				if (!ok) return false;
+				s.generated.swap(buffer);
+				s.tables.store(s.generated.data(), std::memory_order_release);
+				return true;
+#endif
+			}
+
+			// true when the tables are backed by a memory-mapped file
+			static bool mapped() {
+				state& s = instance();
+				std::lock_guard<std::mutex> guard(s.lock);
+				return s.mapping != nullptr;
+			}
+
+		private:
+			// the tables are published once, by a lookup or by map(), and released when the process exits
+			struct state {
+				std::mutex lock;
+				std::atomic<const storage_t*> tables{ nullptr };
+				std::vector<storage_t> generated;
+				void* mapping = nullptr;
+				size_t mapping_size = 0;
+
+				~state() {
+#if POSIT_LUT_MMAP
+					if (mapping != nullptr) ::munmap(mapping, mapping_size);
+#endif
+				}
+			};
+
+			static state& instance() {
+				static state s;
+				return s;
+			}
+
+			static void make_header(uint8_t* header) {
+				std::memset(header, 0, header_size);
+				std::memcpy(header, "POSITLUT", 8);
+				header[8] = uint8_t(nbits);
+				header[9] = uint8_t(es);
+				header[10] = uint8_t(sizeof(storage_t));
+				header[11] = uint8_t(nr_of_ops);
+			}
+			static bool valid_header(const uint8_t* header) {
+				uint8_t expected[header_size];
+				make_header(expected);
+				return std::memcmp(header, expected, header_size) == 0;
+			}
+
+			// the results of the posit operators for every pair of encodings
+			static void generate(std::vector<storage_t>& tables) {
+				constexpr storage_t nar = storage_t(engine::sign_mask);
+				tables.assign(nr_of_ops * stride, 0);
+				storage_t* add = tables.data();
+				storage_t* sub = add + stride;
+				storage_t* mul = sub + stride;
+				storage_t* div = mul + stride;
+				for (size_t i = 0; i < nr_of_encodings; ++i) {
+					storage_t a = storage_t(i);
+					for (size_t j = 0; j < nr_of_encodings; ++j) {
+						storage_t b = storage_t(j);
+						storage_t negb = storage_t((~b + 1) & engine::mask);
+						size_t index = (i << nbits) | j;
+						if (engine::isnar(a) || engine::isnar(b)) {
+							add[index] = sub[index] = mul[index] = div[index] = nar;
+							continue;
+						}
+						if (engine::iszero(a)) {
+							add[index] = b;
+							sub[index] = negb;
+							mul[index] = 0;
+							div[index] = engine::iszero(b) ? nar : storage_t(0);
+							continue;
+						}
+						if (engine::iszero(b)) {
+							add[index] = sub[index] = a;
+							mul[index] = 0;
+							div[index] = nar;
+							continue;
+						}
+						add[index] = engine::add(a, b, false);
+						sub[index] = engine::add(a, b, true);
+						mul[index] = engine::mul(a, b);
+						div[index] = engine::div(a, b);
+					}
+				}
+			}
+		};
+
+		template<size_t nbits, size_t es>
+		class posit_lut {
+		public:
+			static_assert(nbits >= 2 && nbits <= 10, "posit_lut requires 2 <= nbits <= 10");
+			using tables = posit_lut_tables<nbits, es>;
+			using storage_t = typename tables::storage_t;
+			static constexpr storage_t sign_mask = storage_t(storage_t(1) << (nbits - 1));
+			static constexpr storage_t mask = storage_t((1u << nbits) - 1);
+
+			posit_lut() : _bits(0) {}
+			posit_lut(const posit_lut&) = default;
+			posit_lut(posit_lut&&) = default;
+			posit_lut& operator=(const posit_lut&) = default;
+			posit_lut& operator=(posit_lut&&) = default;
+
+			// conversions go through posit<nbits, es>
+			posit_lut(const posit<nbits, es>& p) : _bits(storage_t(p.get().to_ullong())) {}
+			posit_lut(int initial_value) { *this = posit<nbits, es>(initial_value); }
+			posit_lut(long long initial_value) { *this = posit<nbits, es>(initial_value); }
+			posit_lut(float initial_value) { *this = posit<nbits, es>(initial_value); }
+			posit_lut(double initial_value) { *this = posit<nbits, es>(initial_value); }
+
+			posit<nbits, es> to_posit() const {
+				posit<nbits, es> p;
+				p.set_raw_bits(_bits);
+				return p;
+			}
+			explicit operator posit<nbits, es>() const { return to_posit(); }
+			explicit operator double() const { return double(to_posit()); }
+			explicit operator float() const { return float(to_posit()); }
+			explicit operator long long() const { return (long long)(to_posit()); }
+			explicit operator int() const { return int(to_posit()); }
+
+			posit_lut& set_raw_bits(uint64_t value) {
+				_bits = storage_t(value & mask);
+				return *this;
+			}
+			storage_t encoding() const { return _bits; }
+			bitblock<nbits> get() const {
+				bitblock<nbits> bb;
+				bb = (unsigned long long)_bits;
+				return bb;
+			}
+
+			// arithmetic operators are a single table load
+			posit_lut& operator+=(const posit_lut& rhs) { _bits = lookup(lut_op::add, _bits, rhs._bits); return *this; }
+			posit_lut& operator-=(const posit_lut& rhs) { _bits = lookup(lut_op::sub, _bits, rhs._bits); return *this; }
+			posit_lut& operator*=(const posit_lut& rhs) { _bits = lookup(lut_op::mul, _bits, rhs._bits); return *this; }
+			posit_lut& operator/=(const posit_lut& rhs) { _bits = lookup(lut_op::div, _bits, rhs._bits); return *this; }
+			posit_lut operator-() const {
+				posit_lut p;
+				return p.set_raw_bits(storage_t(~_bits + 1));
+			}
+
+			bool isnar() const { return _bits == sign_mask; }
+			bool iszero() const { return _bits == 0; }
+			bool isneg() const { return (_bits & sign_mask) != 0; }
+			bool ispos() const { return !isneg(); }
+
+			// the encoding with the sign bit flipped orders posits as unsigned integers
+			storage_t ordinal() const { return storage_t(_bits ^ sign_mask); }
+
+			static storage_t lookup(lut_op op, storage_t a, storage_t b) {
+				return tables::table(op)[(size_t(a) << nbits) | b];
+			}
+
+		private:
+			storage_t _bits;
+		};
+
+		template<size_t nbits, size_t es>
+		inline posit_lut<nbits, es> operator+(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) {
+			posit_lut<nbits, es> result = lhs;
+			return result += rhs;
+		}
+		template<size_t nbits, size_t es>
+		inline posit_lut<nbits, es> operator-(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) {
+			posit_lut<nbits, es> result = lhs;
+			return result -= rhs;
+		}
+		template<size_t nbits, size_t es>
+		inline posit_lut<nbits, es> operator*(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) {
+			posit_lut<nbits, es> result = lhs;
+			return result *= rhs;
+		}
+		template<size_t nbits, size_t es>
+		inline posit_lut<nbits, es> operator/(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) {
+			posit_lut<nbits, es> result = lhs;
+			return result /= rhs;
+		}
+
+		template<size_t nbits, size_t es>
+		inline bool operator==(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return lhs.encoding() == rhs.encoding(); }
+		template<size_t nbits, size_t es>
+		inline bool operator!=(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return !operator==(lhs, rhs); }
+		template<size_t nbits, size_t es>
+		inline bool operator< (const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return lhs.ordinal() < rhs.ordinal(); }
+		template<size_t nbits, size_t es>
+		inline bool operator> (const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return operator< (rhs, lhs); }
+		template<size_t nbits, size_t es>
+		inline bool operator<=(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return !operator< (rhs, lhs); }
+		template<size_t nbits, size_t es>
+		inline bool operator>=(const posit_lut<nbits, es>& lhs, const posit_lut<nbits, es>& rhs) { return !operator< (lhs, rhs); }
+
+		template<size_t nbits, size_t es>
+		inline std::ostream& operator<<(std::ostream& ostr, const posit_lut<nbits, es>& p) {
+			return ostr << p.to_posit();
+		}
+
+		namespace batch {
+			namespace detail {
+
+#if POSIT_BATCH_AVX2
+				namespace avx2 {
+					POSIT_BATCH_TARGET_AVX2 inline __m256i load8(const uint8_t* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+					POSIT_BATCH_TARGET_AVX2 inline __m256i load8(const uint16_t* p) { return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+					POSIT_BATCH_TARGET_AVX2 inline void store8(uint8_t* p, __m256i v) {
+						__m128i words = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(words, _mm_setzero_si128()));
+					}
+					POSIT_BATCH_TARGET_AVX2 inline void store8(uint16_t* p, __m256i v) {
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+					}
+
+					// gather the table entries indexed by (a << nbits) | b, eight elements per gather
+					template<size_t nbits, typename Storage>
+					POSIT_BATCH_TARGET_AVX2 size_t gather(const Storage* table, const Storage* a, const Storage* b, Storage* out, size_t n) {
+						const int* base = reinterpret_cast<const int*>(table);
+						const __m256i entry = _mm256_set1_epi32(sizeof(Storage) == 1 ? 0xFF : 0xFFFF);
+						size_t i = 0;
+						for (; i + 16 <= n; i += 16) {
+							for (size_t j = i; j < i + 16; j += 8) {
+								__m256i index = _mm256_or_si256(_mm256_slli_epi32(load8(a + j), nbits), load8(b + j));
+								__m256i r = _mm256_and_si256(_mm256_i32gather_epi32(base, index, int(sizeof(Storage))), entry);
+								store8(out + j, r);
+							}
+						}
+						return i;
+					}
+				}
+#endif
+
+				template<size_t nbits, size_t es>
+				void lookup(lut_op op, const posit_lut<nbits, es>* a, const posit_lut<nbits, es>* b, posit_lut<nbits, es>* out, size_t n) {
+					using storage_t = typename posit_lut<nbits, es>::storage_t;
+					static_assert(sizeof(posit_lut<nbits, es>) == sizeof(storage_t), "posit_lut arrays must be arrays of encodings");
+					const storage_t* table = posit_lut_tables<nbits, es>::table(op);
+					const storage_t* x = reinterpret_cast<const storage_t*>(a);
+					const storage_t* y = reinterpret_cast<const storage_t*>(b);
+					storage_t* r = reinterpret_cast<storage_t*>(out);
+					size_t i = 0;
+#if POSIT_BATCH_AVX2
+					if (active_isa() == isa::avx2) i = avx2::gather<nbits>(table, x, y, r, n);
+#endif
+					for (; i < n; ++i) r[i] = table[(size_t(x[i]) << nbits) | y[i]];
+				}
+
+			} // namespace detail
+
+			// out[i] = a[i] + b[i]
+			template<size_t nbits, size_t es>
+			void add(const posit_lut<nbits, es>* a, const posit_lut<nbits, es>* b, posit_lut<nbits, es>* out, size_t n) {
+				detail::lookup(lut_op::add, a, b, out, n);
+			}
+			// out[i] = a[i] - b[i]
+			template<size_t nbits, size_t es>
+			void sub(const posit_lut<nbits, es>* a, const posit_lut<nbits, es>* b, posit_lut<nbits, es>* out, size_t n) {
+				detail::lookup(lut_op::sub, a, b, out, n);
+			}
+			// out[i] = a[i] * b[i]
+			template<size_t nbits, size_t es>
+			void mul(const posit_lut<nbits, es>* a, const posit_lut<nbits, es>* b, posit_lut<nbits, es>* out, size_t n) {
+				detail::lookup(lut_op::mul, a, b, out, n);
+			}
+			// out[i] = a[i] / b[i]
+			template<size_t nbits, size_t es>
+			void div(const posit_lut<nbits, es>* a, const posit_lut<nbits, es>* b, posit_lut<nbits, es>* out, size_t n) {
+				detail::lookup(lut_op::div, a, b, out, n);
+			}
+
+			// std::vector interface: the operands must have the same size, and the output is resized to it
+			template<size_t nbits, size_t es>
+			void add(const std::vector<posit_lut<nbits, es>>& a, const std::vector<posit_lut<nbits, es>>& b, std::vector<posit_lut<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "add");
+				out.resize(a.size());
+				add(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void sub(const std::vector<posit_lut<nbits, es>>& a, const std::vector<posit_lut<nbits, es>>& b, std::vector<posit_lut<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "sub");
+				out.resize(a.size());
+				sub(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void mul(const std::vector<posit_lut<nbits, es>>& a, const std::vector<posit_lut<nbits, es>>& b, std::vector<posit_lut<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "mul");
+				out.resize(a.size());
+				mul(a.data(), b.data(), out.data(), a.size());
+			}
+			template<size_t nbits, size_t es>
+			void div(const std::vector<posit_lut<nbits, es>>& a, const std::vector<posit_lut<nbits, es>>& b, std::vector<posit_lut<nbits, es>>& out) {
+				detail::require_size(b.size(), a.size(), "div");
+				out.resize(a.size());
+				div(a.data(), b.data(), out.data(), a.size());
+			}
+
+		} // namespace batch
+
+	} // namespace unum
+} // namespace sw
@@ -4,6 +4,8 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+#include "../utility/span.hpp"
 
 namespace sw {
 	namespace unum {
@@ -86,6 +88,175 @@ inline int min_scale() {
 	return -int(half_range); 
 }
 
+// The capacity of a quire is the number of carry guard bits above the dynamic range of the products.
+// The generic quire grows with its capacity, the fixed-width standard quires of the fast posit<8,0>,
+// posit<16,1>, and posit<32,2> hold as many guard bits as their format has and specialize quire_max_capacity.
+template<size_t nbits, size_t es>
+struct quire_max_capacity {
+	static constexpr size_t value = ~size_t(0);
+};
+// a default capacity, clamped to the capacity of the quire of posit<nbits, es>
+template<size_t nbits, size_t es, size_t capacity>
+struct quire_capacity {
+	static constexpr size_t value = (capacity < quire_max_capacity<nbits, es>::value ? capacity : quire_max_capacity<nbits, es>::value);
+};
+
+// the quire representations share the conversions between values and fixed-point limb arrays
+
+// place the significand of a normalized value, hidden bit included, as an unsigned fixed-point integer
+// with its radix point at bit position radix of a Q limb array: bits that fall outside the array are dropped
+template<size_t Q, size_t fbits>
+inline void quire_fixed_point(const value<fbits>& v, int radix, uint64_t* r) {
+	constexpr size_t N = nr_limbs(fbits + 1);
+	constexpr size_t W = (N > Q ? N : Q) + 1;
+	uint64_t m[W];
+	limbs_clear<W>(m);
+	bitset_to_limbs<fbits, N>(v.fraction(), m);
+	limbs_set<W>(m, fbits);
+	int lsb = radix + v.scale() - int(fbits);
+	if (lsb < 0) limbs_shr<W>(m, size_t(-lsb)); else limbs_shl<W>(m, size_t(lsb));
+	for (size_t i = 0; i < Q; ++i) r[i] = m[i];
+}
+
+// normalize the magnitude of a Q limb fixed-point integer with its radix point at bit position radix into a value
+template<size_t qbits, size_t Q>
+inline value<qbits> quire_normalize(bool sign, const uint64_t* m, int radix) {
+	static_assert(64 * Q >= qbits, "limb array is too small to hold the fraction");
+	bitblock<qbits> fraction;
+	unsigned lz = limbs_clz<Q>(m);
+	if (lz == 64 * Q) return value<qbits>(sign, 0, fraction, true, false);
+	int scale = int(64 * Q - 1 - lz) - radix;
+	uint64_t f[Q];
+	for (size_t i = 0; i < Q; ++i) f[i] = m[i];
+	limbs_shl<Q>(f, lz + 1);                 // remove the leading zeros and the hidden bit
+	limbs_shr<Q>(f, 64 * Q - qbits);         // the fraction is msb aligned in qbits
+	limbs_to_bitset<qbits, Q>(f, fraction);
+	return value<qbits>(sign, scale, fraction, false, false);
+}
+
+// print a sign and the lowest bits of a Q limb magnitude in the quire format "+:capacity_upper.lower"
+template<size_t Q>
+inline std::ostream& quire_print(std::ostream& ostr, bool sign, const uint64_t* m, size_t bits, size_t half_range, size_t upper_range) {
+	ostr << (sign ? "-:" : "+:");
+	for (size_t i = bits; i-- > 0; ) {
+		ostr << (limbs_test<Q>(m, i) ? '1' : '0');
+		if (i == half_range + upper_range) ostr << '_';
+		if (i == half_range) ostr << '.';
+	}
+	return ostr;
+}
+
+// parse the quire format "+:capacity_upper.lower" of quire_print into a sign and the lowest bits of a Q limb magnitude:
+// returns false when the string is not in this format
+template<size_t Q>
+inline bool quire_parse(const std::string& str, size_t bits, size_t half_range, size_t upper_range, bool& sign, uint64_t* m) {
+	limbs_clear<Q>(m);
+	if (str.size() < 2 || (str[0] != '+' && str[0] != '-') || str[1] != ':') return false;
+	sign = (str[0] == '-');
+	size_t i = bits;   // the digits fill the bits from the top, and the separators sit where quire_print puts them
+	for (size_t k = 2; k < str.size(); ++k) {
+		char c = str[k];
+		if (c == '_') {
+			if (i != half_range + upper_range) return false;
+		}
+		else if (c == '.') {
+			if (i != half_range) return false;
+		}
+		else if ((c == '0' || c == '1') && i > 0) {
+			if (c == '1') limbs_set<Q>(m, --i); else --i;
+		}
+		else {
+			return false;
+		}
+	}
+	return i == 0;
+}
+
+/*
+ binary wire format of a quire, little endian:
+   byte  0       'Q'
+   byte  1       format version
+   byte  2       sign
+   byte  3       es
+   bytes 4-7     nbits
+   bytes 8-11    qbits, the size of the quire minus the sign bit
+   bytes 12-15   index of the lowest limb that is sent
+   bytes 16-19   number of limbs that are sent
+   bytes 20-     the limbs of the magnitude, lowest first, 8 bytes each
+ Only the active limbs of the magnitude are sent, and a zero quire sends none.
+ */
+constexpr size_t quire_wire_header_size = 20;
+constexpr uint8_t quire_wire_version = 1;
+
+inline void quire_wire_put(uint8_t* bytes, uint64_t v, size_t n) {
+	for (size_t i = 0; i < n; ++i) bytes[i] = uint8_t(v >> (8 * i));
+}
+inline uint64_t quire_wire_get(const uint8_t* bytes, size_t n) {
+	uint64_t v = 0;
+	for (size_t i = 0; i < n; ++i) v |= uint64_t(bytes[i]) << (8 * i);
+	return v;
+}
+
+// active limbs [lo, hi) of a Q limb magnitude, empty when the magnitude is zero
+template<size_t Q>
+inline void quire_wire_window(const uint64_t* m, size_t& lo, size_t& hi) {
+	lo = 0;
+	hi = Q;
+	while (hi > 0 && m[hi - 1] == 0) --hi;
+	if (hi == 0) return;
+	while (m[lo] == 0) ++lo;
+}
+
+// number of bytes the wire format of the Q limb magnitude m takes
+template<size_t Q>
+inline size_t quire_wire_size(const uint64_t* m) {
+	size_t lo, hi;
+	quire_wire_window<Q>(m, lo, hi);
+	return quire_wire_header_size + 8 * (hi - lo);
+}
+
+// write a quire, given as a sign and a Q limb magnitude, into buffer and return the number of bytes written
+template<size_t Q>
+size_t quire_wire_write(span<uint8_t> buffer, size_t nbits, size_t es, size_t qbits, bool sign, const uint64_t* m) {
+	size_t lo, hi;
+	quire_wire_window<Q>(m, lo, hi);
+	size_t bytes = quire_wire_header_size + 8 * (hi - lo);
+	if (buffer.size() < bytes) throw quire_wire_format_error("buffer too small for the quire wire format");
+	uint8_t* p = buffer.data();
+	p[0] = 'Q';
+	p[1] = quire_wire_version;
+	p[2] = (sign && hi > lo ? 1 : 0);
+	p[3] = uint8_t(es);
+	quire_wire_put(p + 4, nbits, 4);
+	quire_wire_put(p + 8, qbits, 4);
+	quire_wire_put(p + 12, (hi > lo ? lo : 0), 4);
+	quire_wire_put(p + 16, hi - lo, 4);
+	p += quire_wire_header_size;
+	for (size_t i = lo; i < hi; ++i, p += 8) quire_wire_put(p, m[i], 8);
+	return bytes;
+}
+
+// read a quire in wire format into a sign and a Q limb magnitude, and return the number of bytes read
+// the limbs that were sent are [lo, lo + count), the others are cleared
+template<size_t Q>
+size_t quire_wire_read(span<const uint8_t> buffer, size_t nbits, size_t es, size_t qbits, bool& sign, uint64_t* m, size_t& lo, size_t& count) {
+	if (buffer.size() < quire_wire_header_size) throw quire_wire_format_error("truncated quire wire format header");
+	const uint8_t* p = buffer.data();
+	if (p[0] != 'Q' || p[1] != quire_wire_version) throw quire_wire_format_error("not a quire wire format");
+	if (p[3] != es || quire_wire_get(p + 4, 4) != nbits || quire_wire_get(p + 8, 4) != qbits) throw quire_wire_format_error("quire configuration mismatch");
+	sign = (p[2] != 0);
+	lo = size_t(quire_wire_get(p + 12, 4));
+	count = size_t(quire_wire_get(p + 16, 4));
+	if (lo > Q || count > Q - lo) throw quire_wire_format_error("quire wire format limbs out of range");
+	size_t bytes = quire_wire_header_size + 8 * count;
+	if (buffer.size() < bytes) throw quire_wire_format_error("truncated quire wire format limbs");
+	limbs_clear<Q>(m);
+	p += quire_wire_header_size;
+	for (size_t i = lo; i < lo + count; ++i, p += 8) m[i] = quire_wire_get(p, 8);
+	if (((qbits + 1) & 63) && (m[Q - 1] >> ((qbits + 1) & 63)) != 0) throw quire_wire_format_error("quire wire format magnitude too large");
+	return bytes;
+}
+
 /* 
  quire: template class representing a quire associated with a posit configuration
  nbits and es are the same as the posit configuration, 
@@ -94,8 +265,13 @@ inline int min_scale() {
  All values in and out of the quire are normalized (sign, scale, fraction) triplets.
  Even though a quire is very strongly coupled to a posit configuration via the dynamic range
  a particular posit configuration exhibits, the class is designed to NOT depend on the posit<nbits,es> class definition.
+
+ The accumulator is a sign and a single contiguous array of 64-bit limbs holding the fixed-point magnitude:
+ bit 0 is the lsb of the lower segment, the radix point sits at bit half_range, the upper segment follows,
+ and the capacity segment occupies the top bits. Values are shifted into place with word shifts and
+ added or subtracted with word carry chains.
  */
-template<size_t nbits, size_t es, size_t capacity = 30>
+template<size_t nbits, size_t es, size_t capacity = quire_capacity<nbits, es, 30>::value>
 class quire {
 public:
 	static constexpr size_t escale = size_t(1) << es;         // 2^es
@@ -105,9 +281,10 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr size_t qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
+	static constexpr size_t qlimbs = nr_limbs(qbits + 1);     // limbs of the accumulator: lower, upper, and capacity segments
 	
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() : _sign(false) { limbs_clear<qlimbs>(_accu); }
 
 	quire(int8_t initial_value) {
 		*this = initial_value;
@@ -122,7 +299,7 @@ public:
 		*this = initial_value;
 	}
 	quire(uint64_t initial_value) {
-		*this = initial_value;
+		*this = static_cast<unsigned long long>(initial_value);
 	}
 	quire(float initial_value) {
 		*this = initial_value;
@@ -147,7 +324,6 @@ public:
 		reset();
 		if (rhs.iszero()) return *this;
 		if (rhs.isinf() || rhs.isnan()) throw operand_is_nar{};
-		_sign = rhs.sign();
 
 		int scale = rhs.scale();
 		// TODO: we are clamping the values of the RHS to be within the dynamic range of the posit
@@ -157,32 +333,8 @@ public:
 		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
 		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
 
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
+		_sign = rhs.sign();
+		add_value(rhs);
 		return *this;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
@@ -202,30 +354,10 @@ public:
 		return *this;
 	}
 	quire& operator=(int64_t rhs) {
-		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
-		unsigned msb = findMostSignificantBit(magnitude);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		bool negative = rhs < 0;
+		*this = static_cast<unsigned long long>(negative ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs));
+		_sign = negative && !iszero();
 		return *this;
 	}
 	quire& operator=(unsigned long long rhs) {
@@ -234,21 +366,9 @@ public:
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		// the integer lands with its lsb on the radix point
+		uint64_t magnitude = rhs;
+		add_magnitude<1>(&magnitude, int(half_range));
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -292,23 +412,7 @@ public:
 			// _sign stays the same, so nothing new to assign
 		}
 		else {
-			// subtract magnitudes
-			int cmp = CompareMagnitude(rhs);
-			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
-				_sign = rhs.sign();
-			}
-			else if (cmp > 0) {
-				subtract_value(rhs);
-				// _sign stays the same
-			}
-			else {
-				subtract_value(rhs);
-				_sign = false;
-			}
+			subtract_value(rhs);
 		}
 		return *this;
 	}
@@ -326,21 +430,118 @@ public:
 	quire& operator-=(const posit<nbits, es>& rhs) {
 		return operator-=(rhs.to_value());
 	}
+	// fused multiply-accumulate: add the unrounded product of two posits
+	quire& fma(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		return operator+=(quire_mul(a, b));
+	}
+	// batched fused dot product of n posit pairs with deferred normalization
+	// The products are added into two carry-save accumulators, one for the positive and one for the negative products,
+	// that keep a 64-bit sum and a 32-bit carry count per limb, so carries and signs are not resolved per product.
+	// A product increments a carry count by at most one: the accumulators are folded into the quire when the
+	// headroom counter runs out and at the end of the batch.
+	quire& accumulate(const posit<nbits, es>* x, const posit<nbits, es>* y, size_t n) {
+		using engine = limb_engine<nbits, es>;
+		constexpr size_t F = engine::flimbs;
+		constexpr size_t guard = carry_save_guard<F>();
+		constexpr size_t L = guard + qlimbs + 2;
+		uint64_t sums[2][L];
+		uint32_t carries[2][L];
+		size_t lo = 0, hi = 0;     // window [lo, hi) of live limbs of both accumulators
+		size_t headroom = carry_save_headroom;
+		uint64_t raw[engine::nlimbs];
+		typename engine::triple a, b;
+		uint64_t p[2 * F];
+		for (size_t i = 0; i < n; ++i) {
+			if (x[i].isnar() || y[i].isnar()) throw operand_is_nar{};
+			if (x[i].iszero() || y[i].iszero()) continue;
+			bitset_to_limbs<nbits, engine::nlimbs>(x[i].get(), raw);
+			engine::decode(raw, a);
+			bitset_to_limbs<nbits, engine::nlimbs>(y[i].get(), raw);
+			engine::decode(raw, b);
+			limbs_mul<F, F>(p, a.sig, b.sig);
+			// the significands carry their hidden bit at bit 64F-1, so the product has 2(64F-1) fraction bits
+			size_t lsb = size_t(int(64 * guard + half_range) + a.scale + b.scale - 2 * int(64 * F - 1));
+			size_t w = lsb >> 6;
+			unsigned shift = unsigned(lsb) & 63;
+			if (lo == hi) lo = hi = w;
+			while (lo > w) {
+				--lo;
+				sums[0][lo] = sums[1][lo] = 0;
+				carries[0][lo] = carries[1][lo] = 0;
+			}
+			while (hi < w + 2 * F + 2) {
+				sums[0][hi] = sums[1][hi] = 0;
+				carries[0][hi] = carries[1][hi] = 0;
+				++hi;
+			}
+			uint64_t* sum = sums[a.sign != b.sign];
+			uint32_t* carry = carries[a.sign != b.sign];
+			for (size_t k = 0; k <= 2 * F; ++k) {
+				uint64_t word = (k < 2 * F ? p[k] << shift : 0) | (shift && k > 0 ? p[k - 1] >> (64 - shift) : 0);
+				uint64_t t = sum[w + k] + word;
+				carry[w + k + 1] += (t < word);
+				sum[w + k] = t;
+			}
+			if (--headroom == 0) {
+				fold<F>(sums[0], carries[0], lo, hi, false);
+				fold<F>(sums[1], carries[1], lo, hi, true);
+				lo = hi = 0;
+				headroom = carry_save_headroom;
+			}
+		}
+		if (lo < hi) {
+			fold<F>(sums[0], carries[0], lo, hi, false);
+			fold<F>(sums[1], carries[1], lo, hi, true);
+		}
+		return *this;
+	}
+
+	// size in bytes of the binary wire format of the quire
+	size_t wire_size() const { return quire_wire_size<qlimbs>(_accu); }
+	// write the quire in binary wire format into buffer, and return the number of bytes written
+	size_t serialize_into(span<uint8_t> buffer) const {
+		return quire_wire_write<qlimbs>(buffer, nbits, es, qbits, _sign, _accu);
+	}
+	// add a quire in binary wire format to this quire, and return the number of bytes consumed
+	size_t merge_from(span<const uint8_t> buffer) {
+		bool negative;
+		size_t lo, count;
+		uint64_t m[qlimbs];
+		size_t bytes = quire_wire_read<qlimbs>(buffer, nbits, es, qbits, negative, m, lo, count);
+		if (count == 0) return bytes;
+		if (negative == _sign) {
+			add_magnitude(m + lo, count, 64 * lo);
+		}
+		else {
+			subtract_magnitude(m + lo, count, 64 * lo);
+		}
+		return bytes;
+	}
 
-	// add two quires
+	// add two quires: the accumulators are aligned, so this is a single carry chain
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		if (_sign == q._sign) {
+			add_magnitude<qlimbs>(q._accu, 0);
+		}
+		else {
+			subtract_magnitude<qlimbs>(q._accu, 0);
+		}
+		return *this;
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		if (_sign != q._sign) {
+			add_magnitude<qlimbs>(q._accu, 0);
+		}
+		else {
+			subtract_magnitude<qlimbs>(q._accu, 0);
+		}
+		return *this;
 	}
 	
 	// bit addressing operator
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[index];
-		if (index < int(radix_point) + int(upper_range)) return _upper[index - int(radix_point)];
-		if (index < int(radix_point) + int(upper_range) + int(capacity)) return _capacity[index - int(radix_point) - int(upper_range)];
+		if (index >= 0 && index < int(qbits) + 1) return limbs_test<qlimbs>(_accu, size_t(index));
 		throw "index out of range";
 	}
 
@@ -350,98 +551,23 @@ public:
 	// reset the state of a quire to zero
 	void reset() {
 		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		limbs_clear<qlimbs>(_accu);
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
 	void set_sign(bool v) { _sign = v; }
 	bool load_bits(const std::string& string_of_bits) {
 		reset();
-		// format is "+:0000_000000000.000000000"
-		std::string::const_iterator it = string_of_bits.begin();
-		if (*it == '-') {
-			_sign = true;
-		}
-		else if (string_of_bits[0] == '+') {
-			_sign = false;
-		}
-		else {
-			return false; // fail
-		}
-		++it;
-		if (*it == ':') {
-			++it;
-		}
-		else {
-			return false; // fail, wrong format
-		}
-		int segment = 0; // capacity segment = 0, upper segment = 1, lower segment = 2
-		int msb_c = capacity - 1;
-		int msb_u = upper_range - 1;
-		int msb_l = half_range - 1;
-		for (; it != string_of_bits.end(); ++it) {
-			if (*it == '_') {
-				if (msb_c != -1) return false; // fail: incorrect format
-				segment = 1;
-			}
-			else if (*it == '.') {
-				if (msb_u != -1) return false; // fail, incorrect format
-				segment = 2;
-			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
-			else {
-				switch (segment) {
-				case 0:
-					_capacity.reset(msb_c--);
-					break;
-				case 1:
-					_upper.reset(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
-		}
-		return true;
+		// format is "+:0000_000000000.000000000", as the quire prints
+		return quire_parse<qlimbs>(string_of_bits, qbits + 1, half_range, upper_range, _sign, _accu);
 	}
 
 // Selectors
 	
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
 	template<size_t fbits>
-	int CompareMagnitude(const value<fbits>& v) {
-		// inefficient as we are copying a whole quire just to reset the sign bit, but we are leveraging the comparison logic
-		quire<nbits, es, capacity> absq = abs(*this);
-		//value<qbits> absq = abs(*this);
-		value<fbits> absv = abs(v);
-		if (absq < absv) {
-			return -1;
-		}
-		else if (absq > absv) {
-			return 1;
-		}
-		return 0;
+	int CompareMagnitude(const value<fbits>& v) const {
+		return quire_compare_magnitude(*this, v);
 	}
 	// query functions for quire attributes
 	inline int dynamic_range() const { return int(range); }
@@ -451,21 +577,12 @@ public:
 	inline size_t total_bits() const { return qbits + 1; }
 	inline bool isneg() const { return _sign; }
 	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	inline bool iszero() const { return limbs_iszero<qlimbs>(_accu); }
 	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(msb)) break;
-		}
-		if (msb >= 0) return msb + upper_range;
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(msb)) break;
-		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(i)) break;
-		}
-		return msb;
+		unsigned lz = limbs_clz<qlimbs>(_accu);
+		// a zero quire reports the scale just below the lsb of the lower accumulator
+		if (lz == 64 * qlimbs) return -int(half_range) - 1;
+		return int(64 * qlimbs - 1 - lz) - int(half_range);
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
@@ -473,300 +590,146 @@ public:
 	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
 	bitblock<qbits+1> get() const {
 		bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
-		}
+		limbs_to_bitset<qbits + 1, qlimbs>(_accu, q);
 		return q;
 	}
 	value<qbits> to_value() const {
-		// find the MSB and build the fraction
-		bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _lower[i];
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		// find the MSB with a leading zero count over the limbs and build the fraction from the bits that follow it
+		return quire_normalize<qbits, qlimbs>(_sign, _accu, int(half_range));
 	}
 	bool anyAfter(int index) const {
-		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
-		}
-		return false;
+		if (index < 0) return false;
+		return limbs_any_below<qlimbs>(_accu, size_t(index) + 1);
 	}
 
 private:
 	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
+	// contiguous accumulator, least significant limb first
+	uint64_t               _accu[qlimbs];
 
 	// add a value to the quire
 	template<size_t fbits>
 	void add_value(const value<fbits>& v) {
 		if (v.iszero()) return;
-		// scale is the location of the msb in the fixed point representation
-		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - int(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
-		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
-		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
-		}
+		constexpr size_t N = nr_limbs(fbits + 1);
+		uint64_t m[N];
+		fixed_point(v, m);
+		// scale is the location of the msb in the fixed point representation,
+		// so the lsb of the significand lands at bit half_range + scale - fbits of the accumulator
+		add_magnitude<N>(m, int(half_range) + v.scale() - int(fbits));
 	}
 	// subtract a value from the quire
 	template<size_t fbits>
 	void subtract_value(const value<fbits>& v) {
 		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - int(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
+		constexpr size_t N = nr_limbs(fbits + 1);
+		uint64_t m[N];
+		fixed_point(v, m);
+		subtract_magnitude<N>(m, int(half_range) + v.scale() - int(fbits));
+	}
+	// the significand of a value, hidden bit included, as a limb array
+	template<size_t fbits>
+	static void fixed_point(const value<fbits>& v, uint64_t* m) {
+		constexpr size_t N = nr_limbs(fbits + 1);
+		bitset_to_limbs<fbits, N>(v.fraction(), m);
+		limbs_set<N>(m, fbits);
+	}
+
+	// add the N limb magnitude m, shifted to bit position lsb, to the accumulator
+	// bits below the lsb of the accumulator are dropped, as is a carry out of the capacity segment
+	template<size_t N>
+	void add_magnitude(const uint64_t* m, int lsb) {
+		uint64_t aligned[N];
+		if (lsb < 0) {
+			for (size_t i = 0; i < N; ++i) aligned[i] = m[i];
+			limbs_shr<N>(aligned, size_t(-lsb));
+			m = aligned;
+			lsb = 0;
+		}
+		add_magnitude(m, N, size_t(lsb));
+	}
+	void add_magnitude(const uint64_t* m, size_t n, size_t lsb) {
+		size_t w = lsb >> 6;
+		unsigned s = unsigned(lsb) & 63;
+		uint64_t carry = 0;
+		size_t i = w;
+		for (size_t k = 0; k < n + (s ? 1 : 0) && i < qlimbs; ++k, ++i) {
+			uint64_t word = (k < n ? m[k] << s : 0) | (s && k > 0 ? m[k - 1] >> (64 - s) : 0);
+			uint64_t sum = _accu[i] + carry;
+			carry = (sum < carry);
+			_accu[i] = sum + word;
+			carry += (_accu[i] < sum);
+		}
+		for (; carry && i < qlimbs; ++i) carry = (++_accu[i] == 0);
+		_accu[qlimbs - 1] &= top_mask;
+	}
+	// subtract the N limb magnitude m, shifted to bit position lsb, from the accumulator
+	// when the magnitude is larger than the accumulator the result is negated and the sign flips
+	template<size_t N>
+	void subtract_magnitude(const uint64_t* m, int lsb) {
+		uint64_t aligned[N];
+		if (lsb < 0) {
+			for (size_t i = 0; i < N; ++i) aligned[i] = m[i];
+			limbs_shr<N>(aligned, size_t(-lsb));
+			m = aligned;
+			lsb = 0;
+		}
+		subtract_magnitude(m, N, size_t(lsb));
+	}
+	void subtract_magnitude(const uint64_t* m, size_t n, size_t lsb) {
+		size_t w = lsb >> 6;
+		unsigned s = unsigned(lsb) & 63;
+		uint64_t borrow = 0;
+		size_t i = w;
+		for (size_t k = 0; k < n + (s ? 1 : 0) && i < qlimbs; ++k, ++i) {
+			uint64_t word = (k < n ? m[k] << s : 0) | (s && k > 0 ? m[k - 1] >> (64 - s) : 0);
+			uint64_t d = _accu[i] - borrow;
+			borrow = (_accu[i] < borrow);
+			borrow += (d < word);
+			_accu[i] = d - word;
+		}
+		for (; borrow && i < qlimbs; ++i) borrow = (_accu[i]-- == 0);
+		if (borrow) {
+			limbs_twos_complement<qlimbs>(_accu);
+			_accu[qlimbs - 1] &= top_mask;
+			_sign = !_sign;
+		}
+		else if (limbs_iszero<qlimbs>(_accu)) {
+			_sign = false;
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+	}
+	// products of the carry-save accumulation below the lsb of the quire land in guard limbs
+	// the smallest product lsb is -2(64F-1), so two guard limbs per significand limb suffice
+	template<size_t F>
+	static constexpr size_t carry_save_guard() { return 2 * F; }
+	// number of products a carry count can absorb before the accumulators must be folded
+	static constexpr size_t carry_save_headroom = 0xFFFFFFFFul;
+	// resolve the carries of the carry-save limbs [lo, hi) and add or subtract the magnitude to the quire
+	template<size_t F>
+	void fold(const uint64_t* sum, const uint32_t* carry, size_t lo, size_t hi, bool negative) {
+		constexpr size_t guard = carry_save_guard<F>();
+		uint64_t m[guard + qlimbs + 3];
+		size_t k = 0;
+		uint64_t c = 0;
+		for (size_t i = lo; i < hi; ++i) {
+			uint64_t v = sum[i] + c;
+			c = (v < c);
+			v += carry[i];
+			c += (v < carry[i]);
+			m[k++] = v;
+		}
+		m[k++] = c;
+		// the guard limbs of an exact sum of products are zero
+		size_t skip = (lo < guard ? guard - lo : 0);
+		if (negative == _sign) {
+			add_magnitude(m + skip, k - skip, 64 * (lo + skip - guard));
 		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+		else {
+			subtract_magnitude(m + skip, k - skip, 64 * (lo + skip - guard));
 		}
 	}
+	// mask of the valid bits in the most significant limb
+	static constexpr uint64_t top_mask = ((qbits + 1) & 63) ? (uint64_t(1) << ((qbits + 1) & 63)) - 1 : ~uint64_t(0);
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, size_t ncapacity>
@@ -826,18 +789,20 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<size_t nbits, size_t es, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
+	using Quire = quire<nbits, es, capacity>;
+	return quire_print<Quire::qlimbs>(ostr, q._sign, q._accu, Quire::qbits + 1, Quire::half_range, Quire::upper_range);
 }
 
+// read a quire in the format it prints
 template<size_t nbits, size_t es, size_t capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capacity>& q) {
-	istr >> q._accu;
+inline std::istream& operator>> (std::istream& istr, quire<nbits, es, capacity>& q) {
+	std::string bits;
+	if (istr >> bits && !q.load_bits(bits)) istr.setstate(std::ios_base::failbit);
 	return istr;
 }
 
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && limbs_compare<quire<nbits, es, capacity>::qlimbs>(lhs._accu, rhs._accu) == 0; }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
@@ -847,13 +812,7 @@ inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits,
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
+		if (limbs_compare<quire<nbits, es, capacity>::qlimbs>(lhs._accu, rhs._accu) < 0) {
 			bSmaller = true;
 		}
 	}
@@ -866,89 +825,40 @@ inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits,
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
 
-// magnitude comparison between quire and value
+// comparison between quire and value: quire_compare_magnitude returns -1, 0, or 1 when |q| is smaller than,
+// equal to, or larger than |v|, and uses only the public interface, which the fixed-width standard quires share
 template<size_t nbits, size_t es, size_t capacity, size_t fbits>
-inline bool operator== (const quire<nbits, es, capacity>& q, const value<fbits>& v) {
-	// not efficient, but leverages < and >
-	return !(q < v) && !(q > v);
+inline int quire_compare_magnitude(const quire<nbits, es, capacity>& q, const value<fbits>& v) {
+	if (v.iszero()) return (q.iszero() ? 0 : 1);
+	if (q.iszero()) return -1;
+	int qscale = q.scale();
+	int vscale = v.scale();
+	if (qscale != vscale) return (qscale < vscale ? -1 : 1);
+	// compare the bits from the leading bit down: i for the quire, f for the fraction in v
+	bitblock<fbits + 1> fixed = v.get_fixed_point();
+	int i = int(quire<nbits, es, capacity>::radix_point) + qscale, f = int(fbits);
+	for (; i >= 0 && f >= 0; --i, --f) {
+		if (q[i] != fixed[f]) return (q[i] ? 1 : -1);
+	}
+	// the bits that remain on one side make it larger
+	if (i >= 0) return (q.anyAfter(i) ? 1 : 0);
+	for (; f >= 0; --f) if (fixed[f]) return -1;
+	return 0;
 }
 template<size_t nbits, size_t es, size_t capacity, size_t fbits>
-inline bool operator< (const quire<nbits, es, capacity>& q, const value<fbits>& v) {
-	bool bSmaller = false;  // default fall through is quire q is bigger than value v
-	if (!v.sign() && q.sign()) {
-		bSmaller = true;
-	}
-	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale < vscale) {
-			bSmaller = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = quire<nbits, es, capacity>::radix_point + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (!q[i] && fixed[f]) {
-					bSmaller = true;
-					undecided = false;
-					break;
-				}
-				else if (q[i] && !fixed[f]) {
-					bSmaller = false;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-				// any bit set will make the quire bigger than the value
-				if (q.anyAfter(i)) {
-					bSmaller = false;
-				}
-			}
-		}
-	}
-	return bSmaller;
+inline int quire_compare(const quire<nbits, es, capacity>& q, const value<fbits>& v) {
+	bool qnegative = q.sign() && !q.iszero();
+	bool vnegative = v.sign() && !v.iszero();
+	if (qnegative != vnegative) return (qnegative ? -1 : 1);
+	int c = quire_compare_magnitude(q, v);
+	return (qnegative ? -c : c);
 }
 template<size_t nbits, size_t es, size_t capacity, size_t fbits>
-inline bool operator> (const quire<nbits, es, capacity>& q, const value<fbits>& v) { 
-	bool bBigger = false;  // default fall through is quire q is smaller than value v
-	if (!q.sign() && v.sign()) {
-		bBigger = true;
-	}
-	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale > vscale) {
-			bBigger = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed_point = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = quire<nbits, es, capacity>::radix_point + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (q[i] && !fixed_point[f]) {
-					bBigger = true;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-									   // any bit set will make the quire bigger
-				if (q.anyAfter(i)) {
-					bBigger = true;
-				}
-			}
-		}
-	}
-	return bBigger;
-}
-
-
+inline bool operator== (const quire<nbits, es, capacity>& q, const value<fbits>& v) { return quire_compare(q, v) == 0; }
+template<size_t nbits, size_t es, size_t capacity, size_t fbits>
+inline bool operator< (const quire<nbits, es, capacity>& q, const value<fbits>& v) { return quire_compare(q, v) < 0; }
+template<size_t nbits, size_t es, size_t capacity, size_t fbits>
+inline bool operator> (const quire<nbits, es, capacity>& q, const value<fbits>& v) { return quire_compare(q, v) > 0; }
 
 // QUIRE OPERATORS
 
@@ -984,22 +894,62 @@ value<2 * (nbits - 2 - es)> quire_mul(const posit<nbits, es>& lhs, const posit<n
 	static constexpr size_t fhbits = fbits + 1;      // size of fraction + hidden bit
 	static constexpr size_t mbits = 2 * fhbits;      // size of the multiplier output
 
+	using engine = limb_engine<nbits, es>;
+	constexpr size_t N = engine::flimbs;
+
 	value<mbits> product;  // constructs to zero value
-	value<fbits> a, b;
 
 	// special case handling
 	if (lhs.isnar() || rhs.isnar()) { product.setinf(); return product; }
 	if (lhs.iszero() || rhs.iszero()) return product;
 
-	// transform the inputs into (sign,scale,fraction) triples
-	a.set(sign(lhs), scale(lhs), extract_fraction<nbits, es, fbits>(lhs), lhs.iszero(), lhs.isnar());
-	b.set(sign(rhs), scale(rhs), extract_fraction<nbits, es, fbits>(rhs), rhs.iszero(), rhs.isnar());
-
-	module_multiply(a, b, product);    // multiply the two inputs
+	// decode the inputs into (sign, scale, significand) triples on words
+	uint64_t raw[engine::nlimbs];
+	typename engine::triple a, b;
+	bitset_to_limbs<nbits, engine::nlimbs>(lhs.get(), raw);
+	engine::decode(raw, a);
+	bitset_to_limbs<nbits, engine::nlimbs>(rhs.get(), raw);
+	engine::decode(raw, b);
+
+	// the product of two left aligned significands in [1,2) has its msb at the top bit or one below
+	uint64_t p[2 * N];
+	limbs_mul<N, N>(p, a.sig, b.sig);
+	bool carry = limbs_test<2 * N>(p, 128 * N - 1);
+	limbs_shl<2 * N>(p, carry ? 1 : 2);           // remove the hidden bit
+	limbs_shr<2 * N>(p, 128 * N - mbits);         // the fraction is msb aligned in mbits
+	bitblock<mbits> fraction;
+	limbs_to_bitset<mbits, 2 * N>(p, fraction);
+	product.set(a.sign != b.sign, a.scale + b.scale + (carry ? 1 : 0), fraction, false, false);
 
 	return product;
 }
 
+// exact reduction of serialized quires: the quires are merged pairwise in rounds, the shape of a reduction
+// tree over nodes that each merge two serialized quires and forward the serialized result to the next round
+template<typename Quire>
+Quire quire_tree_reduce(const std::vector< span<const uint8_t> >& parts) {
+	std::vector< span<const uint8_t> > level(parts);
+	std::vector< std::vector<uint8_t> > forwarded(parts.size());
+	for (size_t stride = 1; stride < level.size(); stride *= 2) {
+		for (size_t i = 0; i + stride < level.size(); i += 2 * stride) {
+			Quire node;
+			node.merge_from(level[i]);
+			node.merge_from(level[i + stride]);
+			forwarded[i].resize(node.wire_size());
+			size_t bytes = node.serialize_into(forwarded[i]);
+			level[i] = span<const uint8_t>(forwarded[i].data(), bytes);
+		}
+	}
+	Quire root;
+	if (!level.empty()) root.merge_from(level[0]);
+	return root;
+}
+
 }  // namespace unum
 
 }  // namespace sw
+
+// fast specializations of the standard quires
+#include "specialized/quire_8_0.hpp"
+#include "specialized/quire_16_1.hpp"
+#include "specialized/quire_32_2.hpp"
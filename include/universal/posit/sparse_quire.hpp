@@ -0,0 +1,324 @@
+#pragma once
+// sparse_quire.hpp: definition of a quire that only touches the active window of its accumulator
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+
+namespace sw {
+	namespace unum {
+
+// pool of accumulator blocks of N limbs, one free list per thread
+// blocks are handed back cleared, so taking a block from the pool needs no initialization
+template<size_t N>
+class quire_limb_pool {
+public:
+	static uint64_t* acquire() {
+		std::vector<uint64_t*>& blocks = free_list();
+		if (blocks.empty()) return new uint64_t[N]();
+		uint64_t* block = blocks.back();
+		blocks.pop_back();
+		return block;
+	}
+	// the block must be cleared by the caller: a block the free list cannot take is deleted
+	static void release(uint64_t* block) noexcept {
+		try {
+			free_list().push_back(block);
+		}
+		catch (...) {
+			delete[] block;
+		}
+	}
+
+private:
+	struct blocks {
+		std::vector<uint64_t*> free;
+		~blocks() { for (uint64_t* block : free) delete[] block; }
+	};
+	static std::vector<uint64_t*>& free_list() {
+		static thread_local blocks pool;
+		return pool.free;
+	}
+};
+
+/*
+ sparse_quire: a quire with the same dynamic range and capacity as quire<nbits, es, capacity>
+ that tracks the lowest and highest non-zero limb of its accumulator.
+
+ An accumulation only touches the limbs of the addend and the limbs its carry or borrow ripples into,
+ and normalization only scans the active window. The accumulator is not embedded in the object:
+ it is taken from a per-thread pool on the first non-zero accumulation and handed back when the quire
+ returns to zero, so a large collection of quires only holds storage for the quires that are in use.
+ The magnitude is kept in sign-magnitude form: limbs outside the window are zero.
+ */
+template<size_t nbits, size_t es, size_t capacity = 30>
+class sparse_quire {
+public:
+	static constexpr size_t escale = size_t(1) << es;         // 2^es
+	static constexpr size_t range = escale * (4 * nbits - 8); // dynamic range of the posit configuration
+	static constexpr size_t half_range = range >> 1;          // position of the fixed point
+	static constexpr size_t radix_point = half_range;
+	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
+	static constexpr size_t qbits = range + capacity;         // size of the quire minus the sign bit
+	static constexpr size_t qlimbs = nr_limbs(qbits + 1);     // limbs of the accumulator
+	using pool = quire_limb_pool<qlimbs>;
+
+	sparse_quire() : _sign(false), _lo(0), _hi(0), _limbs(nullptr) {}
+	sparse_quire(const sparse_quire& q) : _sign(false), _lo(0), _hi(0), _limbs(nullptr) { *this = q; }
+	sparse_quire(sparse_quire&& q) noexcept : _sign(q._sign), _lo(q._lo), _hi(q._hi), _limbs(q._limbs) { q._limbs = nullptr; q._sign = false; }
+	~sparse_quire() { reset(); }
+
+	sparse_quire& operator=(const sparse_quire& q) {
+		if (this == &q) return *this;
+		reset();
+		if (q._limbs == nullptr) return *this;
+		_limbs = pool::acquire();
+		for (size_t i = q._lo; i <= q._hi; ++i) _limbs[i] = q._limbs[i];
+		_sign = q._sign;
+		_lo = q._lo;
+		_hi = q._hi;
+		return *this;
+	}
+	sparse_quire& operator=(sparse_quire&& q) noexcept {
+		if (this == &q) return *this;
+		reset();
+		_sign = q._sign; _lo = q._lo; _hi = q._hi; _limbs = q._limbs;
+		q._limbs = nullptr;
+		q._sign = false;
+		return *this;
+	}
+	template<size_t fbits>
+	sparse_quire& operator=(const value<fbits>& rhs) {
+		reset();
+		if (rhs.isinf() || rhs.isnan()) throw operand_is_nar{};
+		return *this += rhs;
+	}
+
+	// add a normalized value to the quire
+	template<size_t fbits>
+	sparse_quire& operator+=(const value<fbits>& rhs) {
+		if (rhs.iszero()) return *this;
+		if (rhs.scale() > int(half_range)) throw operand_too_large_for_quire{};
+		if (rhs.scale() < -int(half_range)) throw operand_too_small_for_quire{};
+		constexpr size_t N = nr_limbs(fbits + 1);
+		uint64_t m[N];
+		bitset_to_limbs<fbits, N>(rhs.fraction(), m);
+		limbs_set<N>(m, fbits);
+		accumulate<N>(m, int(half_range) + rhs.scale() - int(fbits), rhs.sign());
+		return *this;
+	}
+	template<size_t fbits>
+	sparse_quire& operator-=(const value<fbits>& rhs) {
+		return *this += -rhs;
+	}
+	// add and subtract quires: only the window of the other quire takes part
+	sparse_quire& operator+=(const sparse_quire& q) {
+		if (q._limbs != nullptr) accumulate(q._limbs + q._lo, q._hi - q._lo + 1, 64 * q._lo, q._sign);
+		return *this;
+	}
+	sparse_quire& operator-=(const sparse_quire& q) {
+		if (q._limbs != nullptr) accumulate(q._limbs + q._lo, q._hi - q._lo + 1, 64 * q._lo, !q._sign);
+		return *this;
+	}
+
+	// fused multiply-accumulate: the product of the significands is added at its scale without normalization
+	sparse_quire& fma(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		if (a.isnar() || b.isnar()) throw operand_is_nar{};
+		if (a.iszero() || b.iszero()) return *this;
+		using engine = limb_engine<nbits, es>;
+		constexpr size_t F = engine::flimbs;
+		uint64_t raw[engine::nlimbs];
+		typename engine::triple va, vb;
+		bitset_to_limbs<nbits, engine::nlimbs>(a.get(), raw);
+		engine::decode(raw, va);
+		bitset_to_limbs<nbits, engine::nlimbs>(b.get(), raw);
+		engine::decode(raw, vb);
+		uint64_t p[2 * F];
+		limbs_mul<F, F>(p, va.sig, vb.sig);
+		// the significands carry their hidden bit at bit 64F-1, so the product has 2(64F-1) fraction bits
+		accumulate<2 * F>(p, int(half_range) + va.scale + vb.scale - 2 * int(64 * F - 1), va.sign != vb.sign);
+		return *this;
+	}
+
+	// release the accumulator back to the pool
+	void reset() {
+		if (_limbs != nullptr) {
+			for (size_t i = _lo; i <= _hi; ++i) _limbs[i] = 0;
+			pool::release(_limbs);
+			_limbs = nullptr;
+		}
+		_sign = false;
+	}
+	void clear() { reset(); }
+
+	// query functions for quire attributes
+	inline int dynamic_range() const { return int(range); }
+	inline int max_scale() const { return int(upper_range); }
+	inline int min_scale() const { return -int(half_range); }
+	inline int capacity_range() const { return int(capacity); }
+	inline size_t total_bits() const { return qbits + 1; }
+	inline bool sign() const { return _sign; }
+	inline bool isneg() const { return _sign; }
+	inline bool iszero() const { return _limbs == nullptr; }
+	// number of limbs in the active window
+	inline size_t active_limbs() const { return (_limbs == nullptr ? 0 : _hi - _lo + 1); }
+	int scale() const {
+		if (_limbs == nullptr) return -int(half_range) - 1;
+		return int(64 * _hi + 63 - clz64(_limbs[_hi])) - int(half_range);
+	}
+	value<qbits> to_value() const {
+		if (_limbs == nullptr) return value<qbits>();
+		// the bits of the window below the leading bit move into the fraction, msb aligned in qbits
+		size_t msb = 64 * _hi + 63 - clz64(_limbs[_hi]);
+		bitblock<qbits> fraction;
+		for (size_t i = _lo; i <= _hi; ++i) {
+			size_t k = 64 * i;
+			for (uint64_t w = _limbs[i]; w != 0 && k < msb; w >>= 1, ++k) {
+				if (w & 0x1) fraction.set(k + qbits - msb);
+			}
+		}
+		return value<qbits>(_sign, int(msb) - int(half_range), fraction, false, false);
+	}
+
+private:
+	bool      _sign;
+	size_t    _lo, _hi;   // lowest and highest limb of the active window, valid when the accumulator is held
+	uint64_t* _limbs;     // accumulator of qlimbs limbs taken from the pool, nullptr when the quire is zero
+
+	// mask of the valid bits in the most significant limb
+	static constexpr uint64_t top_mask = ((qbits + 1) & 63) ? (uint64_t(1) << ((qbits + 1) & 63)) - 1 : ~uint64_t(0);
+
+	// add or subtract the N limb magnitude m with its lsb at bit position lsb of the accumulator
+	template<size_t N>
+	void accumulate(const uint64_t* m, int lsb, bool negative) {
+		// skip the zero limbs at the bottom of the magnitude: a product of significands has many
+		size_t n = N;
+		while (n > 0 && *m == 0) { ++m; --n; lsb += 64; }
+		if (n == 0) return;
+		uint64_t aligned[N];
+		if (lsb < 0) {
+			// the bits below the lsb of the accumulator are dropped
+			for (size_t i = 0; i < n; ++i) aligned[i] = m[i];
+			size_t shift = size_t(-lsb);
+			if (shift >= 64 * n) return;
+			size_t limbShift = shift >> 6, bitShift = shift & 63;
+			for (size_t i = 0; i + limbShift < n; ++i) {
+				uint64_t hi = (i + limbShift + 1 < n ? aligned[i + limbShift + 1] : 0);
+				aligned[i] = (bitShift ? (aligned[i + limbShift] >> bitShift) | (hi << (64 - bitShift)) : aligned[i + limbShift]);
+			}
+			n -= limbShift;
+			m = aligned;
+			lsb = 0;
+		}
+		accumulate(m, n, size_t(lsb), negative);
+	}
+
+	// add or subtract the n limb magnitude m with its lsb at bit position lsb of the accumulator
+	void accumulate(const uint64_t* m, size_t n, size_t lsb, bool negative) {
+		size_t w = lsb >> 6;
+		unsigned s = unsigned(lsb & 63);
+		if (w >= qlimbs) return;
+		// the last limb the shifted magnitude overlaps
+		size_t top = w + n - (s == 0 ? 1 : 0);
+		if (top >= qlimbs) top = qlimbs - 1;
+		if (_limbs == nullptr) {
+			_limbs = pool::acquire();
+			_sign = negative;
+			_lo = w;
+			_hi = top;
+		}
+		else if (negative != _sign) {
+			subtract_window(m, n, w, s, top);
+			return;
+		}
+		else {
+			if (w < _lo) _lo = w;
+			if (top > _hi) _hi = top;
+		}
+		// add with a carry chain that stops at the first limb that absorbs the carry
+		uint64_t carry = 0;
+		size_t i = w;
+		for (size_t k = 0; i <= top; ++k, ++i) {
+			uint64_t word = (k < n ? m[k] << s : 0) | (s && k > 0 ? m[k - 1] >> (64 - s) : 0);
+			uint64_t sum = _limbs[i] + carry;
+			carry = (sum < carry);
+			_limbs[i] = sum + word;
+			carry += (_limbs[i] < sum);
+		}
+		for (; carry && i < qlimbs; ++i) carry = (++_limbs[i] == 0);
+		if (i - 1 > _hi) _hi = i - 1;
+		_limbs[qlimbs - 1] &= top_mask;   // carries beyond the capacity segment are lost
+		trim();
+	}
+
+	// subtract the magnitude from the window: when the magnitude is larger the window is negated and the sign flips
+	void subtract_window(const uint64_t* m, size_t n, size_t w, unsigned s, size_t top) {
+		size_t lo = (w < _lo ? w : _lo);
+		size_t hi = (top > _hi ? top : _hi);
+		uint64_t borrow = 0;
+		size_t i = w;
+		for (size_t k = 0; i <= top; ++k, ++i) {
+			uint64_t word = (k < n ? m[k] << s : 0) | (s && k > 0 ? m[k - 1] >> (64 - s) : 0);
+			uint64_t d = _limbs[i] - borrow;
+			borrow = (_limbs[i] < borrow);
+			borrow += (d < word);
+			_limbs[i] = d - word;
+		}
+		for (; borrow && i <= hi; ++i) borrow = (_limbs[i]-- == 0);
+		if (borrow) {
+			// the result is negative in the two's complement of the window: negate it,
+			// the zero limbs at the bottom stay zero and the first non-zero limb absorbs the increment
+			size_t j = lo;
+			while (_limbs[j] == 0) ++j;
+			_limbs[j] = uint64_t(0) - _limbs[j];
+			for (++j; j <= hi; ++j) _limbs[j] = ~_limbs[j];
+			_sign = !_sign;
+		}
+		_lo = lo;
+		_hi = hi;
+		trim();
+	}
+
+	// shrink the window to its non-zero limbs, and hand the accumulator back when it is zero
+	void trim() {
+		while (_hi > _lo && _limbs[_hi] == 0) --_hi;
+		while (_lo < _hi && _limbs[_lo] == 0) ++_lo;
+		if (_limbs[_lo] == 0) {
+			pool::release(_limbs);
+			_limbs = nullptr;
+			_sign = false;
+		}
+	}
+
+	template<size_t nnbits, size_t nes, size_t ncapacity>
+	friend std::ostream& operator<< (std::ostream& ostr, const sparse_quire<nnbits, nes, ncapacity>& q);
+	template<size_t nnbits, size_t nes, size_t ncapacity>
+	friend bool operator==(const sparse_quire<nnbits, nes, ncapacity>& lhs, const sparse_quire<nnbits, nes, ncapacity>& rhs);
+};
+
+template<size_t nbits, size_t es, size_t capacity>
+inline std::ostream& operator<<(std::ostream& ostr, const sparse_quire<nbits, es, capacity>& q) {
+	using Quire = sparse_quire<nbits, es, capacity>;
+	if (q._limbs == nullptr) {
+		std::vector<uint64_t> zero(Quire::qlimbs, 0);
+		return quire_print<Quire::qlimbs>(ostr, false, zero.data(), Quire::qbits + 1, Quire::half_range, Quire::upper_range);
+	}
+	return quire_print<Quire::qlimbs>(ostr, q._sign, q._limbs, Quire::qbits + 1, Quire::half_range, Quire::upper_range);
+}
+
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator==(const sparse_quire<nbits, es, capacity>& lhs, const sparse_quire<nbits, es, capacity>& rhs) {
+	if (lhs._limbs == nullptr || rhs._limbs == nullptr) return lhs._limbs == rhs._limbs;
+	if (lhs._sign != rhs._sign || lhs._lo != rhs._lo || lhs._hi != rhs._hi) return false;
+	for (size_t i = lhs._lo; i <= lhs._hi; ++i) {
+		if (lhs._limbs[i] != rhs._limbs[i]) return false;
+	}
+	return true;
+}
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator!=(const sparse_quire<nbits, es, capacity>& lhs, const sparse_quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
+
+	}  // namespace unum
+
+}  // namespace sw
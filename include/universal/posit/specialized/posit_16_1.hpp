@@ -25,45 +25,45 @@ namespace sw {
 		static constexpr size_t fhbits = fbits + 1;
 		static constexpr uint16_t sign_mask = 0x8000u;
 
-		posit() { _bits = 0; }
+		constexpr posit() : _bits(0) {}
 		posit(const posit&) = default;
 		posit(posit&&) = default;
 		posit& operator=(const posit&) = default;
 		posit& operator=(posit&&) = default;
 
 		// initializers for native types
-		posit(signed char initial_value)        { *this = initial_value; }
-		posit(short initial_value)              { *this = initial_value; }
-		posit(int initial_value)                { *this = initial_value; }
-		posit(long initial_value)               { *this = initial_value; }
-		posit(long long initial_value)          { *this = initial_value; }
-		posit(char initial_value)               { *this = initial_value; }
-		posit(unsigned short initial_value)     { *this = initial_value; }
-		posit(unsigned int initial_value)       { *this = initial_value; }
-		posit(unsigned long initial_value)      { *this = initial_value; }
-		posit(unsigned long long initial_value) { *this = initial_value; }
-		posit(float initial_value)              { *this = initial_value; }
-		posit(double initial_value)             { *this = initial_value; }
-		posit(long double initial_value)        { *this = initial_value; }
+		constexpr posit(signed char initial_value)        : _bits(0) { *this = initial_value; }
+		constexpr posit(short initial_value)              : _bits(0) { *this = initial_value; }
+		constexpr posit(int initial_value)                : _bits(0) { *this = initial_value; }
+		constexpr posit(long initial_value)               : _bits(0) { *this = initial_value; }
+		constexpr posit(long long initial_value)          : _bits(0) { *this = initial_value; }
+		constexpr posit(char initial_value)               : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned short initial_value)     : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned int initial_value)       : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned long initial_value)      : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned long long initial_value) : _bits(0) { *this = initial_value; }
+		constexpr posit(float initial_value)              : _bits(0) { *this = initial_value; }
+		constexpr posit(double initial_value)             : _bits(0) { *this = initial_value; }
+		constexpr posit(long double initial_value)        : _bits(0) { *this = initial_value; }
 
 		// assignment operators for native types
-		posit& operator=(signed char rhs)       { return integer_assign((long)rhs); }
-		posit& operator=(short rhs)             { return integer_assign((long)rhs); }
-		posit& operator=(int rhs)               { return integer_assign((long)rhs); }
-		posit& operator=(long rhs)              { return integer_assign(rhs); }
-		posit& operator=(long long rhs)         { return integer_assign((long)rhs);	}
-		posit& operator=(char rhs)              { return integer_assign((long)rhs); }
-		posit& operator=(unsigned short rhs)    { return integer_assign((long)rhs); }
-		posit& operator=(unsigned int rhs)      { return integer_assign((long)rhs); }
-		posit& operator=(unsigned long rhs)     { return integer_assign((long)rhs); }
-		posit& operator=(unsigned long long rhs){ return integer_assign((long)rhs); }
-		posit& operator=(float rhs)             { return float_assign(double(rhs)); }
-		posit& operator=(double rhs)            { return float_assign(rhs); }
-		posit& operator=(long double rhs)       { return float_assign(double(rhs)); }
-
-		explicit operator long double() const { return to_long_double(); }
-		explicit operator double() const { return to_double(); }
-		explicit operator float() const { return to_float(); }
+		constexpr posit& operator=(signed char rhs)       { return integer_assign((long)rhs); }
+		constexpr posit& operator=(short rhs)             { return integer_assign((long)rhs); }
+		constexpr posit& operator=(int rhs)               { return integer_assign((long)rhs); }
+		constexpr posit& operator=(long rhs)              { return integer_assign(rhs); }
+		constexpr posit& operator=(long long rhs)         { return integer_assign((long)rhs);	}
+		constexpr posit& operator=(char rhs)              { return integer_assign((long)rhs); }
+		constexpr posit& operator=(unsigned short rhs)    { return integer_assign((long)rhs); }
+		constexpr posit& operator=(unsigned int rhs)      { return integer_assign((long)rhs); }
+		constexpr posit& operator=(unsigned long rhs)     { return integer_assign((long)rhs); }
+		constexpr posit& operator=(unsigned long long rhs){ return integer_assign((long)rhs); }
+		constexpr posit& operator=(float rhs)             { return float_assign(rhs); }
+		constexpr posit& operator=(double rhs)            { return float_assign(rhs); }
+		constexpr posit& operator=(long double rhs)       { return float_assign(rhs); }
+
+		constexpr explicit operator long double() const { return to_long_double(); }
+		constexpr explicit operator double() const { return to_double(); }
+		constexpr explicit operator float() const { return to_float(); }
 		explicit operator long long() const { return to_long_long(); }
 		explicit operator long() const { return to_long(); }
 		explicit operator int() const { return to_int(); }
@@ -71,15 +71,15 @@ namespace sw {
 		explicit operator unsigned long() const { return to_long(); }
 		explicit operator unsigned int() const { return to_int(); }
 
-		posit& set(sw::unum::bitblock<NBITS_IS_16>& raw) {
+		posit& set(const sw::unum::bitblock<NBITS_IS_16>& raw) {
 			_bits = uint16_t(raw.to_ulong());
 			return *this;
 		}
-		posit& set_raw_bits(uint64_t value) {
+		constexpr posit& set_raw_bits(uint64_t value) {
 			_bits = uint16_t(value & 0xffff);
 			return *this;
 		}
-		posit operator-() const {
+		constexpr posit operator-() const {
 			if (iszero()) {
 				return *this;
 			}
@@ -89,7 +89,7 @@ namespace sw {
 			posit p;
 			return p.set_raw_bits((~_bits) + 1);
 		}
-		posit& operator+=(const posit& b) { // derived from SoftPosit
+		constexpr posit& operator+=(const posit& b) { // derived from SoftPosit
 			uint16_t lhs = _bits;
 			uint16_t rhs = b._bits;
 			// process special cases
@@ -106,7 +106,9 @@ namespace sw {
 				lhs = -lhs & 0xFFFF;
 				rhs = -rhs & 0xFFFF;
 			}
-			if (lhs < rhs) std::swap(lhs, rhs);
+			if (lhs < rhs) {
+				uint16_t tmp = lhs; lhs = rhs; rhs = tmp;
+			}
 			
 			// decode the regime of lhs
 			int8_t m = 0; // pattern length
@@ -150,7 +152,7 @@ namespace sw {
 			if (sign) _bits = -_bits & 0xFFFF;
 			return *this;
 		}
-		posit& operator-=(const posit& b) {  // derived from SoftPosit
+		constexpr posit& operator-=(const posit& b) {  // derived from SoftPosit
 			uint16_t lhs = _bits;
 			uint16_t rhs = b._bits;
 			// process special cases
@@ -171,7 +173,7 @@ namespace sw {
 				return *this;
 			}
 			if (lhs < rhs) {
-				std::swap(lhs, rhs);
+				uint16_t tmp = lhs; lhs = rhs; rhs = tmp;
 				sign = !sign;
 			}
 
@@ -222,7 +224,7 @@ namespace sw {
 			if (sign) _bits = -_bits & 0xFFFF;
 			return *this;
 		}
-		posit& operator*=(const posit& b) {
+		constexpr posit& operator*=(const posit& b) {
 			uint16_t lhs = _bits;
 			uint16_t rhs = b._bits;
 			// process special cases
@@ -273,7 +275,7 @@ namespace sw {
 			if (sign) _bits = -_bits & 0xFFFF;
 			return *this;
 		}
-		posit& operator/=(const posit& b) {
+		constexpr posit& operator/=(const posit& b) {
 			uint16_t lhs = _bits;
 			uint16_t rhs = b._bits;
 			// process special cases
@@ -308,9 +310,8 @@ namespace sw {
 			exp -= remaining >> 14;
 			uint16_t rhs_fraction = (0x4000 | remaining);
 
-			div_t result = div(fraction, rhs_fraction);
-			uint32_t result_fraction = result.quot;
-			uint32_t remainder = result.rem;
+			uint32_t result_fraction = fraction / rhs_fraction;
+			uint32_t remainder = fraction % rhs_fraction;
 
 			// adjust the exponent if needed
 			if (exp < 0) {
@@ -332,20 +333,20 @@ namespace sw {
 
 			return *this;
 		}
-		posit& operator++() {
+		constexpr posit& operator++() {
 			++_bits;
 			return *this;
 		}
-		posit operator++(int) {
+		constexpr posit operator++(int) {
 			posit tmp(*this);
 			operator++();
 			return tmp;
 		}
-		posit& operator--() {
+		constexpr posit& operator--() {
 			--_bits;
 			return *this;
 		}
-		posit operator--(int) {
+		constexpr posit operator--(int) {
 			posit tmp(*this);
 			operator--();
 			return tmp;
@@ -355,32 +356,32 @@ namespace sw {
 			return p;
 		}
 		// SELECTORS
-		inline bool isnar() const      { return (_bits == sign_mask); }
-		inline bool iszero() const     { return (_bits == 0x0); }
-		inline bool isone() const      { return (_bits == 0x4000); } // pattern 010000...
-		inline bool isminusone() const { return (_bits == 0xC000); } // pattern 110000...
-		inline bool isneg() const      { return (_bits & sign_mask); }
-		inline bool ispos() const      { return !isneg(); }
-		inline bool ispowerof2() const { return !(_bits & 0x1); }
+		constexpr bool isnar() const      { return (_bits == sign_mask); }
+		constexpr bool iszero() const     { return (_bits == 0x0); }
+		constexpr bool isone() const      { return (_bits == 0x4000); } // pattern 010000...
+		constexpr bool isminusone() const { return (_bits == 0xC000); } // pattern 110000...
+		constexpr bool isneg() const      { return (_bits & sign_mask); }
+		constexpr bool ispos() const      { return !isneg(); }
+		constexpr bool ispowerof2() const { return !(_bits & 0x1); }
 
-		inline int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
+		constexpr int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
 
 		bitblock<NBITS_IS_16> get() const { bitblock<NBITS_IS_16> bb; bb = int(_bits); return bb; }
 		unsigned long long encoding() const { return (unsigned long long)(_bits); }
 
-		inline void clear() { _bits = 0; }
-		inline void setzero() { clear(); }
-		inline void setnar() { _bits = sign_mask; }
-		inline posit twosComplement() const {
+		constexpr void clear() { _bits = 0; }
+		constexpr void setzero() { clear(); }
+		constexpr void setnar() { _bits = sign_mask; }
+		constexpr posit twosComplement() const {
 			posit<NBITS_IS_16, ES_IS_1> p;
-			int16_t v = -*(int16_t*)&_bits;
-			p.set_raw_bits(v);
-			return p;
+			return p.set_raw_bits(uint16_t(~_bits + 1));
 		}
 
 	private:
 		uint16_t _bits;
 
+		using engine = native_engine<NBITS_IS_16, ES_IS_1>;
+
 		// Conversion functions
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		int         to_int() const {
@@ -415,55 +416,19 @@ namespace sw {
 			return long(to_long_double());
 		}
 #endif
-		float       to_float() const {
-			return (float)to_double();
-		}
-		double      to_double() const {
-			if (iszero())	return 0.0;
-			if (isnar())	return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			double s = (_sign ? -1.0 : 1.0);
-			double r = _regime.value();
-			double e = _exponent.value();
-			double f = (1.0 + _fraction.value());
-			return s * r * e * f;
-		}
-		long double to_long_double() const {
-			if (iszero())  return 0.0;
-			if (isnar())   return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			long double s = (_sign ? -1.0 : 1.0);
-			long double r = _regime.value();
-			long double e = _exponent.value();
-			long double f = (1.0 + _fraction.value());
-			return s * r * e * f;
+		constexpr float to_float() const {
+			return engine::to_ieee<float>(_bits);
+		}
+		constexpr double to_double() const {
+			return engine::to_ieee<double>(_bits);
+		}
+		constexpr long double to_long_double() const {
+			return engine::to_ieee<long double>(_bits);
 		}
 
 
 		// helper methods
-		posit& integer_assign(long rhs) {
+		constexpr posit& integer_assign(long rhs) {
 			// special case for speed as this is a common initialization
 			if (rhs == 0) {
 				_bits = 0x0;
@@ -504,35 +469,19 @@ namespace sw {
 			return *this;
 		}
 		
-		// convert a double precision IEEE floating point to a posit<16,1>. You need to use at least doubles to capture
-		// enough bits to correctly round mul/div and elementary function results. That is, if you use a single precision
-		// float, you will inject errors in the validation suites.
-		posit& float_assign(double rhs) {
-			//posit16_t p = posit16_fromf(rhs);
-			//_bits = p.v;
-			constexpr int dfbits = std::numeric_limits<double>::digits - 1;
-			value<dfbits> v((double)rhs);
-
-			// special case processing
-			if (v.iszero()) {
-				setzero();
-				return *this;
-			}
-			if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-				setnar();
-				return *this;
-			}
-
-			bitblock<NBITS_IS_16> ptt;
-			convert_to_bb<NBITS_IS_16, ES_IS_1, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-			_bits = uint16_t(ptt.to_ulong());
+		// convert an IEEE floating point to a posit<16,1>. The value is rounded once, directly from its own precision:
+		// you need to use at least doubles to capture enough bits to correctly round mul/div and elementary function results.
+		// That is, if you use a single precision float, you will inject errors in the validation suites.
+		template<typename Real>
+		constexpr posit& float_assign(Real rhs) {
+			_bits = engine::from_ieee(rhs);
 			return *this;
 		}
 
 
 
 		// decode_regime takes the raw bits of the posit, and returns the regime run-length, m, and the remaining fraction bits in remainder
-		inline void decode_regime(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
+		constexpr void decode_regime(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFF;
 			if (bits & 0x4000) {  // positive regimes
 				while (remaining >> 15) {
@@ -549,7 +498,7 @@ namespace sw {
 				remaining &= 0x7FFF;
 			}
 		}
-		inline void extractAddand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
+		constexpr void extractAddand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFF;
 			if (bits & 0x4000) {  // positive regimes
 				while (remaining >> 15) {
@@ -566,7 +515,7 @@ namespace sw {
 				remaining &= 0x7FFF;
 			}
 		}
-		inline void extractMultiplicand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
+		constexpr void extractMultiplicand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFF;
 			if (bits & 0x4000) {  // positive regimes
 				while (remaining >> 15) {
@@ -583,7 +532,7 @@ namespace sw {
 				remaining &= 0x7FFF;
 			}
 		}
-		inline void extractDividand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
+		constexpr void extractDividand(const uint16_t bits, int8_t& m, uint16_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFF;
 			if (bits & 0x4000) {  // positive regimes
 				while (remaining >> 15) {
@@ -600,8 +549,8 @@ namespace sw {
 				remaining &= 0x7FFF;
 			}
 		}
-		inline uint16_t round(const int8_t m, uint16_t exp, uint32_t fraction) const {
-			uint16_t scale, regime, bits;
+		constexpr uint16_t round(const int8_t m, uint16_t exp, uint32_t fraction) const {
+			uint16_t scale = 0, regime = 0, bits = 0;
 			if (m < 0) {
 				scale = (-m & 0xFFFF);
 				regime = 0x4000 >> scale;
@@ -635,8 +584,8 @@ namespace sw {
 			}
 			return bits;
 		}
-		inline uint16_t divRound(const int8_t m, uint16_t exp, uint32_t fraction, bool nonZeroRemainder) const {
-			uint16_t scale, regime, bits;
+		constexpr uint16_t divRound(const int8_t m, uint16_t exp, uint32_t fraction, bool nonZeroRemainder) const {
+			uint16_t scale = 0, regime = 0, bits = 0;
 			if (m < 0) {
 				scale = (-m & 0xFFFF);
 				regime = 0x4000 >> scale;
@@ -672,8 +621,8 @@ namespace sw {
 			}
 			return bits;
 		}
-		inline uint16_t adjustAndRound(const int8_t m, uint16_t exp, uint32_t fraction) const {
-			uint16_t scale, regime, bits;
+		constexpr uint16_t adjustAndRound(const int8_t m, uint16_t exp, uint32_t fraction) const {
+			uint16_t scale = 0, regime = 0, bits = 0;
 			if (m < 0) {
 				scale = (-m & 0xFFFF);
 				regime = 0x4000 >> scale;
@@ -712,32 +661,27 @@ namespace sw {
 		friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_16, ES_IS_1>& p);
 
 		// posit - posit logic functions
-		friend bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
-		friend bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
-		friend bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
-		friend bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
-		friend bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
-		friend bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
+		friend constexpr bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs);
 
 	};
 
 	// posit I/O operators
 	// generate a posit format ASCII format nbits.esxNN...NNp
 	inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_16, ES_IS_1>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 		// to make certain that setw and left/right operators work properly
 		// we need to transform the posit into a string
 		std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 		ss << NBITS_IS_16 << '.' << ES_IS_1 << 'x' << to_hex(p.get()) << 'p';
+		return ostr << ss.str();
 #else
-		std::streamsize prec = ostr.precision();
-		std::streamsize width = ostr.width();
-		std::ios_base::fmtflags ff;
-		ff = ostr.flags();
-		ss.flags(ff);
-		ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+		return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-		return ostr << ss.str();
 	}
 
 	// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
@@ -761,26 +705,26 @@ namespace sw {
 	}
 
 	// posit - posit binary logic operators
-	inline bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return lhs._bits == rhs._bits;
 	}
-	inline bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return !operator==(lhs, rhs);
 	}
-	inline bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return (signed short)(lhs._bits) < (signed short)(rhs._bits);
 	}
-	inline bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return operator< (rhs, lhs);
 	}
-	inline bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return operator< (lhs, rhs) || operator==(lhs, rhs);
 	}
-	inline bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return !operator< (lhs, rhs);
 	}
 
-	inline posit<NBITS_IS_16, ES_IS_1> operator+(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr posit<NBITS_IS_16, ES_IS_1> operator+(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		posit<NBITS_IS_16, ES_IS_1> result = lhs;
 		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
 			result += rhs;
@@ -790,7 +734,7 @@ namespace sw {
 		}
 		return result;
 	}
-	inline posit<NBITS_IS_16, ES_IS_1> operator-(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr posit<NBITS_IS_16, ES_IS_1> operator-(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		posit<NBITS_IS_16, ES_IS_1> result = lhs;
 		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
 			result -= rhs.twosComplement();
@@ -801,49 +745,55 @@ namespace sw {
 		return result;
 
 	}
-	// binary operator*() is provided by generic class
-	// binary operator/() is provided by generic class
+	inline constexpr posit<NBITS_IS_16, ES_IS_1> operator*(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+		posit<NBITS_IS_16, ES_IS_1> result = lhs;
+		return result *= rhs;
+	}
+	inline constexpr posit<NBITS_IS_16, ES_IS_1> operator/(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+		posit<NBITS_IS_16, ES_IS_1> result = lhs;
+		return result /= rhs;
+	}
 
 #if POSIT_ENABLE_LITERALS
 	// posit - literal logic functions
 
 	// posit - int logic operators
-	inline bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator==(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return operator==(lhs, posit<NBITS_IS_16, ES_IS_1>(rhs));
 	}
-	inline bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator!=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return !operator==(lhs, posit<NBITS_IS_16, ES_IS_1>(rhs));
 	}
-	inline bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator< (const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return operator<(lhs, posit<NBITS_IS_16, ES_IS_1>(rhs));
 	}
-	inline bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator> (const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return operator< (posit<NBITS_IS_16, ES_IS_1>(rhs), lhs);
 	}
-	inline bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator<=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return operator< (lhs, posit<NBITS_IS_16, ES_IS_1>(rhs)) || operator==(lhs, posit<NBITS_IS_16, ES_IS_1>(rhs));
 	}
-	inline bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
+	inline constexpr bool operator>=(const posit<NBITS_IS_16, ES_IS_1>& lhs, int rhs) {
 		return !operator<(lhs, posit<NBITS_IS_16, ES_IS_1>(rhs));
 	}
 
 	// int - posit logic operators
-	inline bool operator==(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator==(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return posit<NBITS_IS_16, ES_IS_1>(lhs) == rhs;
 	}
-	inline bool operator!=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator!=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return !operator==(posit<NBITS_IS_16, ES_IS_1>(lhs), rhs);
 	}
-	inline bool operator< (int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator< (int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return operator<(posit<NBITS_IS_16, ES_IS_1>(lhs), rhs);
 	}
-	inline bool operator> (int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator> (int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return operator< (posit<NBITS_IS_16, ES_IS_1>(rhs), lhs);
 	}
-	inline bool operator<=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator<=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return operator< (posit<NBITS_IS_16, ES_IS_1>(lhs), rhs) || operator==(posit<NBITS_IS_16, ES_IS_1>(lhs), rhs);
 	}
-	inline bool operator>=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
+	inline constexpr bool operator>=(int lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		return !operator<(posit<NBITS_IS_16, ES_IS_1>(lhs), rhs);
 	}
 
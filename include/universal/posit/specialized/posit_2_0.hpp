@@ -314,11 +314,8 @@ namespace sw {
 
 				template <typename T>
 				posit& float_assign(const T& rhs) {
-					constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-					value<dfbits> v((T)rhs);
-
 					// special case processing
-					if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
+					if (std::isinf(rhs) || std::isnan(rhs)) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
 						setnar();
 						return *this;
 					}
@@ -351,20 +348,15 @@ namespace sw {
 
 			// posit I/O operators
 			inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_2, ES_IS_0>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 				// to make certain that setw and left/right operators work properly
 				// we need to transform the posit into a string
 				std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 				ss << nbits << '.' << es << 'x' << to_hex(p.get()) << 'p';
+				return ostr << ss.str();
 #else
-				std::streamsize prec = ostr.precision();
-				std::streamsize width = ostr.width();
-				std::ios_base::fmtflags ff;
-				ff = ostr.flags();
-				ss.flags(ff);
-				ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+				return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-				return ostr << ss.str();
 			}
 
 			// convert a posit value to a string using "nar" as designation of NaR
@@ -25,45 +25,45 @@ namespace sw {
 		static constexpr size_t fhbits = fbits + 1;
 		static constexpr uint32_t sign_mask = 0x80000000ul;  // 0x8000'0000ul;
 
-		posit() { _bits = 0; }
+		constexpr posit() : _bits(0) {}
 		posit(const posit&) = default;
 		posit(posit&&) = default;
 		posit& operator=(const posit&) = default;
 		posit& operator=(posit&&) = default;
 
 		// initializers for native types
-		posit(signed char initial_value)        { *this = initial_value; }
-		posit(short initial_value)              { *this = initial_value; }
-		posit(int initial_value)                { *this = initial_value; }
-		posit(long initial_value)               { *this = initial_value; }
-		posit(long long initial_value)          { *this = initial_value; }
-		posit(char initial_value)               { *this = initial_value; }
-		posit(unsigned short initial_value)     { *this = initial_value; }
-		posit(unsigned int initial_value)       { *this = initial_value; }
-		posit(unsigned long initial_value)      { *this = initial_value; }
-		posit(unsigned long long initial_value) { *this = initial_value; }
-		posit(float initial_value)              { *this = initial_value; }
-		posit(double initial_value)             { *this = initial_value; }
-		posit(long double initial_value)        { *this = initial_value; }
+		constexpr posit(signed char initial_value)        : _bits(0) { *this = initial_value; }
+		constexpr posit(short initial_value)              : _bits(0) { *this = initial_value; }
+		constexpr posit(int initial_value)                : _bits(0) { *this = initial_value; }
+		constexpr posit(long initial_value)               : _bits(0) { *this = initial_value; }
+		constexpr posit(long long initial_value)          : _bits(0) { *this = initial_value; }
+		constexpr posit(char initial_value)               : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned short initial_value)     : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned int initial_value)       : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned long initial_value)      : _bits(0) { *this = initial_value; }
+		constexpr posit(unsigned long long initial_value) : _bits(0) { *this = initial_value; }
+		constexpr posit(float initial_value)              : _bits(0) { *this = initial_value; }
+		constexpr posit(double initial_value)             : _bits(0) { *this = initial_value; }
+		constexpr posit(long double initial_value)        : _bits(0) { *this = initial_value; }
 
 		// assignment operators for native types
-		posit& operator=(signed char rhs)       { return integer_assign((long)(rhs)); }
-		posit& operator=(short rhs)             { return integer_assign((long)(rhs)); }
-		posit& operator=(int rhs)               { return integer_assign((long)(rhs)); }
-		posit& operator=(long rhs)              { return integer_assign(rhs); }
-		posit& operator=(long long rhs)         { return float_assign((long double)(rhs)); }
-		posit& operator=(char rhs)              { return integer_assign((long)(rhs)); }
-		posit& operator=(unsigned short rhs)    { return integer_assign((long)(rhs)); }
-		posit& operator=(unsigned int rhs)      { return integer_assign((long)(rhs)); }
-		posit& operator=(unsigned long rhs)     { return float_assign((long double)(rhs)); }
-		posit& operator=(unsigned long long rhs){ return float_assign((long double)(rhs)); }
-		posit& operator=(float rhs)             { return float_assign((long double)rhs); }
-		posit& operator=(double rhs)            { return float_assign((long double)rhs); }
-		posit& operator=(long double rhs)       { return float_assign(rhs); }
-
-		explicit operator long double() const { return to_long_double(); }
-		explicit operator double() const { return to_double(); }
-		explicit operator float() const { return to_float(); }
+		constexpr posit& operator=(signed char rhs)       { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(short rhs)             { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(int rhs)               { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(long rhs)              { return integer_assign(rhs); }
+		constexpr posit& operator=(long long rhs)         { return float_assign((long double)(rhs)); }
+		constexpr posit& operator=(char rhs)              { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(unsigned short rhs)    { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(unsigned int rhs)      { return integer_assign((long)(rhs)); }
+		constexpr posit& operator=(unsigned long rhs)     { return float_assign((long double)(rhs)); }
+		constexpr posit& operator=(unsigned long long rhs){ return float_assign((long double)(rhs)); }
+		constexpr posit& operator=(float rhs)             { return float_assign(rhs); }
+		constexpr posit& operator=(double rhs)            { return float_assign(rhs); }
+		constexpr posit& operator=(long double rhs)       { return float_assign(rhs); }
+
+		constexpr explicit operator long double() const { return to_long_double(); }
+		constexpr explicit operator double() const { return to_double(); }
+		constexpr explicit operator float() const { return to_float(); }
 		explicit operator long long() const { return to_long_long(); }
 		explicit operator long() const { return to_long(); }
 		explicit operator int() const { return to_int(); }
@@ -71,15 +71,15 @@ namespace sw {
 		explicit operator unsigned long() const { return to_long(); }
 		explicit operator unsigned int() const { return to_int(); }
 
-		posit& set(sw::unum::bitblock<NBITS_IS_32>& raw) {
+		posit& set(const sw::unum::bitblock<NBITS_IS_32>& raw) {
 			_bits = uint32_t(raw.to_ulong());
 			return *this;
 		}
-		posit& set_raw_bits(uint64_t value) {
+		constexpr posit& set_raw_bits(uint64_t value) {
 			_bits = uint32_t(value & 0xFFFFFFFF);
 			return *this;
 		}
-		posit operator-() const {
+		constexpr posit operator-() const {
 			if (iszero()) {
 				return *this;
 			}
@@ -89,7 +89,7 @@ namespace sw {
 			posit p;
 			return p.set_raw_bits((~_bits) + 1);
 		}
-		posit& operator+=(const posit& b) { // derived from SoftPosit
+		constexpr posit& operator+=(const posit& b) { // derived from SoftPosit
 			// special case handling of the inputs
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (isnar() || b.isnar()) {
@@ -112,7 +112,9 @@ namespace sw {
 				lhs = -int32_t(lhs) & 0xFFFFFFFF;
 				rhs = -int32_t(rhs) & 0xFFFFFFFF;
 			}
-			if (lhs < rhs) std::swap(lhs, rhs);
+			if (lhs < rhs) {
+				uint32_t tmp = lhs; lhs = rhs; rhs = tmp;
+			}
 			
 			// decode the regime of lhs
 			int32_t m = 0; // pattern length
@@ -151,10 +153,10 @@ namespace sw {
 			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
 			return *this;
 		}
-		posit& operator+=(double rhs) {
+		constexpr posit& operator+=(double rhs) {
 			return *this += posit<nbits, es>(rhs);
 		}
-		posit& operator-=(const posit& b) {  // derived from SoftPosit
+		constexpr posit& operator-=(const posit& b) {  // derived from SoftPosit
 			// special case handling of the inputs
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (isnar() || b.isnar()) {
@@ -181,7 +183,7 @@ namespace sw {
 				return *this;
 			}
 			if (lhs < rhs) {
-				std::swap(lhs, rhs);
+				uint32_t tmp = lhs; lhs = rhs; rhs = tmp;
 				sign = !sign;
 			}
 
@@ -237,10 +239,10 @@ namespace sw {
 			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
 			return *this;
 		}
-		posit& operator-=(double rhs) {
+		constexpr posit& operator-=(double rhs) {
 			return *this -= posit<nbits, es>(rhs);
 		}
-		posit& operator*=(const posit& b) {
+		constexpr posit& operator*=(const posit& b) {
 			// special case handling of the inputs
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (isnar() || b.isnar()) {
@@ -298,10 +300,10 @@ namespace sw {
 			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
 			return *this;
 		}
-		posit& operator*=(double rhs) {
+		constexpr posit& operator*=(double rhs) {
 			return *this *= posit<nbits, es>(rhs);
 		}
-		posit& operator/=(const posit& b) {
+		constexpr posit& operator/=(const posit& b) {
 			// since we are encoding error conditions as NaR (Not a Real), we need to process that condition first
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (b.iszero()) {
@@ -350,9 +352,8 @@ namespace sw {
 			uint32_t rhs_fraction = ((remaining << 1) | 0x40000000) & 0x7FFFFFFF;
 
 			// execute the integer division of fractions
-			lldiv_t result = lldiv(lhs64, uint64_t(rhs_fraction));
-			uint64_t result_fraction = result.quot;
-			uint64_t remainder = result.rem;
+			uint64_t result_fraction = lhs64 / rhs_fraction;
+			uint64_t remainder = lhs64 % rhs_fraction;
 
 			// adjust exponent if underflowed
 			if (exp < 0) {
@@ -379,24 +380,24 @@ namespace sw {
 			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
 			return *this;
 		}
-		posit& operator/=(double rhs) {
+		constexpr posit& operator/=(double rhs) {
 			return *this /= posit<nbits, es>(rhs);
 		}
 
-		posit& operator++() {
+		constexpr posit& operator++() {
 			++_bits;
 			return *this;
 		}
-		posit operator++(int) {
+		constexpr posit operator++(int) {
 			posit tmp(*this);
 			operator++();
 			return tmp;
 		}
-		posit& operator--() {
+		constexpr posit& operator--() {
 			--_bits;
 			return *this;
 		}
-		posit operator--(int) {
+		constexpr posit operator--(int) {
 			posit tmp(*this);
 			operator--();
 			return tmp;
@@ -406,23 +407,23 @@ namespace sw {
 			return p;
 		}
 		// SELECTORS
-		inline bool isnar() const      { return (_bits == 0x80000000); }
-		inline bool iszero() const     { return (_bits == 0x0); }
-		inline bool isone() const      { return (_bits == 0x40000000); } // pattern 010000...
-		inline bool isminusone() const { return (_bits == 0xC0000000); } // pattern 110000...
-		inline bool isneg() const      { return (_bits & 0x80000000); }
-		inline bool ispos() const      { return !isneg(); }
-		inline bool ispowerof2() const { return !(_bits & 0x1); }
+		constexpr bool isnar() const      { return (_bits == 0x80000000); }
+		constexpr bool iszero() const     { return (_bits == 0x0); }
+		constexpr bool isone() const      { return (_bits == 0x40000000); } // pattern 010000...
+		constexpr bool isminusone() const { return (_bits == 0xC0000000); } // pattern 110000...
+		constexpr bool isneg() const      { return (_bits & 0x80000000); }
+		constexpr bool ispos() const      { return !isneg(); }
+		constexpr bool ispowerof2() const { return !(_bits & 0x1); }
 
-		inline int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
+		constexpr int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
 
 		bitblock<NBITS_IS_32> get() const { bitblock<NBITS_IS_32> bb; bb = long(_bits); return bb; }
 		unsigned long long encoding() const { return (unsigned long long)(_bits); }
 
-		inline void clear() { _bits = 0x0; }
-		inline void setzero() { clear(); }
-		inline void setnar() { _bits = 0x80000000; }
-		inline posit twosComplement() const {
+		constexpr void clear() { _bits = 0x0; }
+		constexpr void setzero() { clear(); }
+		constexpr void setnar() { _bits = 0x80000000; }
+		constexpr posit twosComplement() const {
 			posit<NBITS_IS_32, ES_IS_2> p;
 			int32_t v = -(int32_t)_bits;
 			p.set_raw_bits(v);
@@ -431,6 +432,8 @@ namespace sw {
 	private:
 		uint32_t _bits;
 
+		using engine = native_engine<NBITS_IS_32, ES_IS_2>;
+
 		// Conversion functions
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		int         to_int() const {
@@ -465,54 +468,18 @@ namespace sw {
 			return long(to_long_double());
 		}
 #endif
-		float       to_float() const {
-			return (float)to_double();
-		}
-		double      to_double() const {
-			if (iszero())	return 0.0;
-			if (isnar())	return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			double s = (_sign ? -1.0 : 1.0);
-			double r = _regime.value();
-			double e = _exponent.value();
-			double f = (1.0 + _fraction.value());
-			return s * r * e * f;
-		}
-		long double to_long_double() const {
-			if (iszero())  return 0.0;
-			if (isnar())   return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			long double s = (_sign ? -1.0 : 1.0);
-			long double r = _regime.value();
-			long double e = _exponent.value();
-			long double f = (1.0 + _fraction.value());
-			return s * r * e * f;
+		constexpr float to_float() const {
+			return engine::to_ieee<float>(_bits);
+		}
+		constexpr double to_double() const {
+			return engine::to_ieee<double>(_bits);
+		}
+		constexpr long double to_long_double() const {
+			return engine::to_ieee<long double>(_bits);
 		}
 
 		// helper methods
-		posit& integer_assign(long rhs) {
+		constexpr posit& integer_assign(long rhs) {
 			// special case for speed as this is a common initialization
 			if (rhs == 0) {
 				_bits = 0x0;
@@ -521,7 +488,7 @@ namespace sw {
 
 			bool sign = rhs < 0 ? true : false;
 			uint32_t v = sign ? -rhs : rhs; // project to positive side of the projective reals
-			int32_t raw;          // we can use signed integer representation as we are taking care of the sign bit
+			int32_t raw = 0;      // we can use signed integer representation as we are taking care of the sign bit
 			if (v == sign_mask) { // +-maxpos, 0x8000'0000 is special in int32 arithmetic as it is its own negation
 				raw = 0x7FB00000;     // -2147483648  0x7FB0'0000; 
 			}
@@ -551,28 +518,14 @@ namespace sw {
 			_bits = sign ? -raw : raw;
 			return *this;
 		}
-		posit& float_assign(long double rhs) {
-			constexpr int dfbits = std::numeric_limits<long double>::digits - 1;
-			value<dfbits> v((long double)rhs);
-
-			// special case processing
-			if (v.iszero()) {
-				setzero();
-				return *this;
-			}
-			if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-				setnar();
-				return *this;
-			}
-
-			bitblock<NBITS_IS_32> ptt;
-			convert_to_bb<NBITS_IS_32, ES_IS_2, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-			_bits = uint32_t(ptt.to_ulong());
+		template<typename Real>
+		constexpr posit& float_assign(Real rhs) {
+			_bits = engine::from_ieee(rhs);
 			return *this;
 		}
 
 		// decode_regime takes the raw bits of the posit, and returns the regime run-length, m, and the remaining fraction bits in remainder
-		inline void decode_regime(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
+		constexpr void decode_regime(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFFFFFF;
 			if (bits & 0x40000000) {  // positive regimes
 				while (remaining >> 31) {
@@ -589,7 +542,7 @@ namespace sw {
 				remaining &= 0x7FFFFFFF;
 			}
 		}
-		inline void extractAddand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
+		constexpr void extractAddand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFFFFFF;
 			if (bits & 0x40000000) {  // positive regimes
 				while (remaining >> 31) {
@@ -606,7 +559,7 @@ namespace sw {
 				remaining &= 0x7FFFFFFF;
 			}
 		}
-		inline void extractMultiplicand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
+		constexpr void extractMultiplicand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFFFFFF;
 			if (bits & 0x40000000) {  // positive regimes
 				while (remaining >> 31) {
@@ -623,7 +576,7 @@ namespace sw {
 				remaining &= 0x7FFFFFFF;
 			}
 		}
-		inline void extractDividand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
+		constexpr void extractDividand(const uint32_t bits, int32_t& m, uint32_t& remaining) const {
 			remaining = (bits << 2) & 0xFFFFFFFF;
 			if (bits & 0x40000000) {  // positive regimes
 				while (remaining >> 31) {
@@ -641,8 +594,8 @@ namespace sw {
 			}
 		}
 
-		inline uint32_t round(const int8_t m, uint32_t exp, uint64_t fraction) const {
-			uint32_t scale, regime, bits;
+		constexpr uint32_t round(const int8_t m, uint32_t exp, uint64_t fraction) const {
+			uint32_t scale = 0, regime = 0, bits = 0;
 			if (m < 0) {
 				scale = -m;
 				regime = 0x40000000 >> scale;
@@ -686,8 +639,8 @@ namespace sw {
 			}
 			return bits;
 		}
-		inline uint32_t round_mul(const int8_t m, uint32_t exp, uint64_t fraction) const {
-			uint32_t scale, regime, bits;
+		constexpr uint32_t round_mul(const int8_t m, uint32_t exp, uint64_t fraction) const {
+			uint32_t scale = 0, regime = 0, bits = 0;
 			if (m < 0) {
 				scale = -m;
 				regime = 0x40000000 >> scale;
@@ -745,8 +698,8 @@ namespace sw {
 			}
 			return bits;
 		}
-		inline uint32_t adjustAndRound(const int8_t k, uint32_t exp, uint64_t frac64, bool nonZeroRemainder) const {
-			uint32_t scale, regime, bits;
+		constexpr uint32_t adjustAndRound(const int8_t k, uint32_t exp, uint64_t frac64, bool nonZeroRemainder) const {
+			uint32_t scale = 0, regime = 0, bits = 0;
 			if (k < 0) {
 				scale = -k;
 				regime = 0x40000000 >> scale;
@@ -809,32 +762,27 @@ namespace sw {
 		friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_32, ES_IS_2>& p);
 
 		// posit - posit logic functions
-		friend bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
-		friend bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
-		friend bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
-		friend bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
-		friend bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
-		friend bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
+		friend constexpr bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs);
 
 	};
 
 	// posit I/O operators
 	// generate a posit format ASCII format nbits.esxNN...NNp
 	inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_32, ES_IS_2>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 		// to make certain that setw and left/right operators work properly
 		// we need to transform the posit into a string
 		std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 		ss << NBITS_IS_32 << '.' << ES_IS_2 << 'x' << to_hex(p.get()) << 'p';
+		return ostr << ss.str();
 #else
-		std::streamsize prec = ostr.precision();
-		std::streamsize width = ostr.width();
-		std::ios_base::fmtflags ff;
-		ff = ostr.flags();
-		ss.flags(ff);
-		ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+		return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-		return ostr << ss.str();
 	}
 
 	// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
@@ -858,26 +806,26 @@ namespace sw {
 	}
 
 	// posit - posit binary logic operators
-	inline bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return lhs._bits == rhs._bits;
 	}
-	inline bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return !operator==(lhs, rhs);
 	}
-	inline bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
-		return long(lhs._bits) < long(rhs._bits);
+	inline constexpr bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+		return int32_t(lhs._bits) < int32_t(rhs._bits);
 	}
-	inline bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return operator< (rhs, lhs);
 	}
-	inline bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return operator< (lhs, rhs) || operator==(lhs, rhs);
 	}
-	inline bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return !operator< (lhs, rhs);
 	}
 
-	inline posit<NBITS_IS_32, ES_IS_2> operator+(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr posit<NBITS_IS_32, ES_IS_2> operator+(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		posit<NBITS_IS_32, ES_IS_2> result = lhs;
 		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
 			result += rhs;
@@ -887,7 +835,7 @@ namespace sw {
 		}
 		return result;
 	}
-	inline posit<NBITS_IS_32, ES_IS_2> operator-(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr posit<NBITS_IS_32, ES_IS_2> operator-(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		posit<NBITS_IS_32, ES_IS_2> result = lhs;
 		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
 			result -= rhs.twosComplement();
@@ -898,49 +846,55 @@ namespace sw {
 		return result;
 
 	}
-	// binary operator*() is provided by generic class
-	// binary operator/() is provided by generic class
+	inline constexpr posit<NBITS_IS_32, ES_IS_2> operator*(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+		posit<NBITS_IS_32, ES_IS_2> result = lhs;
+		return result *= rhs;
+	}
+	inline constexpr posit<NBITS_IS_32, ES_IS_2> operator/(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+		posit<NBITS_IS_32, ES_IS_2> result = lhs;
+		return result /= rhs;
+	}
 
 #if POSIT_ENABLE_LITERALS
 	// posit - literal logic functions
 
 	// posit - int logic operators
-	inline bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator==(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return operator==(lhs, posit<NBITS_IS_32, ES_IS_2>(rhs));
 	}
-	inline bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return !operator==(lhs, posit<NBITS_IS_32, ES_IS_2>(rhs));
 	}
-	inline bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return operator<(lhs, posit<NBITS_IS_32, ES_IS_2>(rhs));
 	}
-	inline bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return operator< (posit<NBITS_IS_32, ES_IS_2>(rhs), lhs);
 	}
-	inline bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator<=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return operator< (lhs, posit<NBITS_IS_32, ES_IS_2>(rhs)) || operator==(lhs, posit<NBITS_IS_32, ES_IS_2>(rhs));
 	}
-	inline bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
+	inline constexpr bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, int rhs) {
 		return !operator<(lhs, posit<NBITS_IS_32, ES_IS_2>(rhs));
 	}
 
 	// int - posit logic operators
-	inline bool operator==(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator==(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return posit<NBITS_IS_32, ES_IS_2>(lhs) == rhs;
 	}
-	inline bool operator!=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator!=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return !operator==(posit<NBITS_IS_32, ES_IS_2>(lhs), rhs);
 	}
-	inline bool operator< (int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator< (int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return operator<(posit<NBITS_IS_32, ES_IS_2>(lhs), rhs);
 	}
-	inline bool operator> (int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator> (int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return operator< (posit<NBITS_IS_32, ES_IS_2>(rhs), lhs);
 	}
-	inline bool operator<=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator<=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return operator< (posit<NBITS_IS_32, ES_IS_2>(lhs), rhs) || operator==(posit<NBITS_IS_32, ES_IS_2>(lhs), rhs);
 	}
-	inline bool operator>=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
+	inline constexpr bool operator>=(int lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 		return !operator<(posit<NBITS_IS_32, ES_IS_2>(lhs), rhs);
 	}
 
@@ -327,83 +327,7 @@ namespace sw {
 
 			template <typename T>
 			posit& float_assign(const T& rhs) {
-				constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-				value<dfbits> v((T)rhs);
-
-				// special case processing
-				if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-					setnar();
-					return *this;
-				}
-				if (v.iszero()) {
-					setzero();
-					return *this;
-				}
-				bool _sign = v.sign();
-				int  _scale = v.scale();
-				bitblock<dfbits> fraction_in = v.fraction();
-				if (check_inward_projection_range<nbits, es>(_scale)) {    // regime dominated
-					if (_trace_conversion) std::cout << "inward projection" << std::endl;
-					// we are projecting to minpos/maxpos
-					int k = calculate_unconstrained_k<nbits, es>(_scale);
-					bitblock<NBITS_IS_3> bb = k < 0 ? minpos_pattern<nbits, es>(_sign) : maxpos_pattern<nbits, es>(_sign);
-					_bits = uint8_t(bb.to_ulong());
-					// we are done
-					if (_trace_rounding) std::cout << "projection  rounding ";
-				}
-				else {
-					const size_t pt_len = nbits + 3 + es;
-					bitblock<pt_len> pt_bits;
-					bitblock<pt_len> regime;
-					bitblock<pt_len> exponent;
-					bitblock<pt_len> fraction;
-					bitblock<pt_len> sticky_bit;
-
-					bool s = _sign;
-					int e = _scale;
-					bool r = (e >= 0);
-
-					unsigned run = (r ? 1 + (e >> es) : -(e >> es));
-					regime.set(0, 1 ^ r);
-					for (unsigned i = 1; i <= run; i++) regime.set(i, r);
-
-					unsigned esval = e % (uint32_t(1) << es);
-					exponent = convert_to_bitblock<pt_len>(esval);
-					unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
-					// TODO: what needs to be done if nf > fbits?
-					//assert(nf <= input_fbits);
-					// copy the most significant nf fraction bits into fraction
-					unsigned lsb = nf <= dfbits ? 0 : nf - dfbits;
-					for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[dfbits - nf + i];
-
-					bool sb = anyAfter(fraction_in, dfbits - 1 - nf);
-
-					// construct the untruncated posit
-					// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
-					regime <<= es + nf + 1;
-					exponent <<= nf + 1;
-					fraction <<= 1;
-					sticky_bit.set(0, sb);
-
-					pt_bits |= regime;
-					pt_bits |= exponent;
-					pt_bits |= fraction;
-					pt_bits |= sticky_bit;
-
-					unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
-					bool blast = pt_bits.test(len - nbits);
-					bool bafter = pt_bits.test(len - nbits - 1);
-					bool bsticky = anyAfter(pt_bits, len - nbits - 1 - 1);
-
-					bool rb = (blast & bafter) | (bafter & bsticky);
-
-					bitblock<nbits> ptt;
-					pt_bits <<= pt_len - len;
-					truncate(pt_bits, ptt);
-					if (rb) increment_bitset(ptt);
-					if (s) ptt = twos_complement(ptt);
-					_bits = uint8_t(ptt.to_ulong());
-				}
+				_bits = native_engine<NBITS_IS_3, ES_IS_0>::from_ieee(rhs);
 				return *this;
 			}
 
@@ -423,20 +347,15 @@ namespace sw {
 
 		// posit I/O operators
 		inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_3, ES_IS_0>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 			// to make certain that setw and left/right operators work properly
 			// we need to transform the posit into a string
 			std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 			ss << nbits << '.' << es << 'x' << to_hex(p.get()) << 'p';
+			return ostr << ss.str();
 #else
-			std::streamsize prec = ostr.precision();
-			std::streamsize width = ostr.width();
-			std::ios_base::fmtflags ff;
-			ff = ostr.flags();
-			ss.flags(ff);
-			ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+			return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-			return ostr << ss.str();
 		}
 
 		// convert a posit value to a string using "nar" as designation of NaR
@@ -310,68 +310,18 @@ namespace sw {
 				}
 #endif
 				float       to_float() const {
-					return (float)to_double();
+					return native_engine<NBITS_IS_4, ES_IS_0>::to_ieee<float>(_bits);
 				}
 				double      to_double() const {
-					if (iszero())	return 0.0;
-					if (isnar())	return NAN;
-					bool		     	 _sign;
-					regime<nbits, es>    _regime;
-					exponent<nbits, es>  _exponent;
-					fraction<fbits>      _fraction;
-					bitblock<nbits>		 _raw_bits;
-					_raw_bits.reset();
-					uint64_t mask = 1;
-					for (size_t i = 0; i < nbits; i++) {
-						_raw_bits.set(i, (_bits & mask));
-						mask <<= 1;
-					}
-					decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-					double s = (_sign ? -1.0 : 1.0);
-					double r = _regime.value();
-					double e = _exponent.value();
-					double f = (1.0 + _fraction.value());
-					return s * r * e * f;
+					return native_engine<NBITS_IS_4, ES_IS_0>::to_ieee<double>(_bits);
 				}
 				long double to_long_double() const {
-					if (iszero())  return 0.0;
-					if (isnar())   return NAN;
-					bool		     	 _sign;
-					regime<nbits, es>    _regime;
-					exponent<nbits, es>  _exponent;
-					fraction<fbits>      _fraction;
-					bitblock<nbits>		 _raw_bits;
-					_raw_bits.reset();
-					uint64_t mask = 1;
-					for (size_t i = 0; i < nbits; i++) {
-						_raw_bits.set(i, (_bits & mask));
-						mask <<= 1;
-					}
-					decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-					long double s = (_sign ? -1.0 : 1.0);
-					long double r = _regime.value();
-					long double e = _exponent.value();
-					long double f = (1.0 + _fraction.value());
-					return s * r * e * f;
+					return native_engine<NBITS_IS_4, ES_IS_0>::to_ieee<long double>(_bits);
 				}
 
 				template <typename T>
 				posit& float_assign(const T& rhs) {
-					constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-					value<dfbits> v((T)rhs);
-
-					// special case processing
-					if (v.iszero()) {
-						setzero();
-						return *this;
-					}
-					if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-						setnar();
-						return *this;
-					}
-					bitblock<NBITS_IS_4> ptt;
-					convert_to_bb<NBITS_IS_4, ES_IS_0, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-					_bits = uint8_t(ptt.to_ulong());
+					_bits = native_engine<NBITS_IS_4, ES_IS_0>::from_ieee(rhs);
 					return *this;
 				}
 
@@ -392,20 +342,15 @@ namespace sw {
 			// posit I/O operators
 			// generate a posit format ASCII format nbits.esxNN...NNp
 			inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_4, ES_IS_0>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 				// to make certain that setw and left/right operators work properly
 				// we need to transform the posit into a string
 				std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 				ss << NBITS_IS_4 << '.' << ES_IS_0 << 'x' << to_hex(p.get()) << 'p';
+				return ostr << ss.str();
 #else
-				std::streamsize prec = ostr.precision();
-				std::streamsize width = ostr.width();
-				std::ios_base::fmtflags ff;
-				ff = ostr.flags();
-				ss.flags(ff);
-				ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+				return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-				return ostr << ss.str();
 			}
 
 			// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
@@ -27,45 +27,45 @@ namespace sw {
 			static constexpr size_t fhbits = fbits + 1;
 			static constexpr uint8_t sign_mask = 0x80;
 
-			posit() { _bits = 0; }
+			constexpr posit() : _bits(0) {}
 			posit(const posit&) = default;
 			posit(posit&&) = default;
 			posit& operator=(const posit&) = default;
 			posit& operator=(posit&&) = default;
 
 			// initializers for native types
-			posit(const signed char initial_value)         { *this = initial_value; }
-			posit(const short initial_value)               { *this = initial_value; }
-			posit(const int initial_value)                 { *this = initial_value; }
-			posit(const long initial_value)                { *this = initial_value; }
-			posit(const long long initial_value)           { *this = initial_value; }
-			posit(const char initial_value)                { *this = initial_value; }
-			posit(const unsigned short initial_value)      { *this = initial_value; }
-			posit(const unsigned int initial_value)        { *this = initial_value; }
-			posit(const unsigned long initial_value)       { *this = initial_value; }
-			posit(const unsigned long long initial_value)  { *this = initial_value; }
-			posit(const float initial_value)               { *this = initial_value; }
-			posit(const double initial_value)              { *this = initial_value; }
-			posit(const long double initial_value)         { *this = initial_value; }
+			constexpr posit(const signed char initial_value)         : _bits(0) { *this = initial_value; }
+			constexpr posit(const short initial_value)               : _bits(0) { *this = initial_value; }
+			constexpr posit(const int initial_value)                 : _bits(0) { *this = initial_value; }
+			constexpr posit(const long initial_value)                : _bits(0) { *this = initial_value; }
+			constexpr posit(const long long initial_value)           : _bits(0) { *this = initial_value; }
+			constexpr posit(const char initial_value)                : _bits(0) { *this = initial_value; }
+			constexpr posit(const unsigned short initial_value)      : _bits(0) { *this = initial_value; }
+			constexpr posit(const unsigned int initial_value)        : _bits(0) { *this = initial_value; }
+			constexpr posit(const unsigned long initial_value)       : _bits(0) { *this = initial_value; }
+			constexpr posit(const unsigned long long initial_value)  : _bits(0) { *this = initial_value; }
+			constexpr posit(const float initial_value)               : _bits(0) { *this = initial_value; }
+			constexpr posit(const double initial_value)              : _bits(0) { *this = initial_value; }
+			constexpr posit(const long double initial_value)         : _bits(0) { *this = initial_value; }
 
 			// assignment operators for native types
-			posit& operator=(const signed char rhs)        { return operator=((int)(rhs)); }
-			posit& operator=(const short rhs)              { return operator=((int)(rhs)); }
-			posit& operator=(const int rhs)                { return integer_assign(rhs); }
-			posit& operator=(const long rhs)               { return operator=((int)(rhs)); }
-			posit& operator=(const long long rhs)          { return operator=((int)(rhs)); }
-			posit& operator=(const char rhs)               { return operator=((int)(rhs)); }
-			posit& operator=(const unsigned short rhs)     { return operator=((int)(rhs)); }
-			posit& operator=(const unsigned int rhs)       { return operator=((int)(rhs)); }
-			posit& operator=(const unsigned long rhs)      { return operator=((int)(rhs)); }
-			posit& operator=(const unsigned long long rhs) { return operator=((int)(rhs)); }
-			posit& operator=(const float rhs)              { return float_assign(rhs); }
-			posit& operator=(const double rhs)             { return operator=(float(rhs)); }
-			posit& operator=(const long double rhs)        { return operator=(float(rhs)); }
+			constexpr posit& operator=(const signed char rhs)        { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const short rhs)              { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const int rhs)                { return integer_assign(rhs); }
+			constexpr posit& operator=(const long rhs)               { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const long long rhs)          { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const char rhs)               { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const unsigned short rhs)     { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const unsigned int rhs)       { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const unsigned long rhs)      { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const unsigned long long rhs) { return operator=((int)(rhs)); }
+			constexpr posit& operator=(const float rhs)              { return float_assign(rhs); }
+			constexpr posit& operator=(const double rhs)             { return float_assign(rhs); }
+			constexpr posit& operator=(const long double rhs)        { return float_assign(rhs); }
 
-			explicit operator long double() const          { return to_long_double(); }
-			explicit operator double() const               { return to_double(); }
-			explicit operator float() const                { return to_float(); }
+			constexpr explicit operator long double() const { return to_long_double(); }
+			constexpr explicit operator double() const     { return to_double(); }
+			constexpr explicit operator float() const      { return to_float(); }
 			explicit operator long long() const            { return to_long_long(); }
 			explicit operator long() const                 { return to_long(); }
 			explicit operator int() const                  { return to_int(); }
@@ -77,57 +77,76 @@ namespace sw {
 				_bits = uint8_t(raw.to_ulong());
 				return *this;
 			}
-			posit& set_raw_bits(uint64_t value) {
+			constexpr posit& set_raw_bits(uint64_t value) {
 				_bits = uint8_t(value & 0xff);
 				return *this;
 			}
-			posit operator-() const {
+			constexpr posit operator-() const {
 				posit negated;
-				posit8_1_t b = { { _bits } };
-				return negated.set_raw_bits(posit8_1_negate(b).v);
+				return negated.set_raw_bits(uint8_t(~_bits + 1));
 			}
-			posit& operator+=(const posit& b) {
-				posit8_1_t lhs = { { _bits } };
-				posit8_1_t rhs = { { b._bits} };
-				posit8_1_t add = posit8_1_addp8(lhs, rhs);
-				_bits = add.v;
+			// the arithmetic operators round through the native engine, which is constexpr
+			constexpr posit& operator+=(const posit& b) {
+				if (isnar() || b.isnar()) {
+					setnar();
+					return *this;
+				}
+				if (iszero()) {
+					_bits = b._bits;
+					return *this;
+				}
+				if (b.iszero()) return *this;
+				_bits = engine::add(_bits, b._bits);
 				return *this;
 			}
-			posit& operator-=(const posit& b) {
-				posit8_1_t lhs = { { _bits } };
-				posit8_1_t rhs = { { b._bits } };
-				posit8_1_t sub = posit8_1_subp8(lhs, rhs);
-				_bits = sub.v;
+			constexpr posit& operator-=(const posit& b) {
+				if (isnar() || b.isnar()) {
+					setnar();
+					return *this;
+				}
+				if (iszero()) {
+					_bits = uint8_t(~b._bits + 1);
+					return *this;
+				}
+				if (b.iszero()) return *this;
+				_bits = engine::add(_bits, b._bits, true);
 				return *this;
 			}
-			posit& operator*=(const posit& b) {
-				posit8_1_t lhs = { { _bits } };
-				posit8_1_t rhs = { { b._bits } };
-				posit8_1_t mul = posit8_1_mulp8(lhs, rhs);
-				_bits = mul.v;
+			constexpr posit& operator*=(const posit& b) {
+				if (isnar() || b.isnar()) {
+					setnar();
+					return *this;
+				}
+				if (iszero() || b.iszero()) {
+					setzero();
+					return *this;
+				}
+				_bits = engine::mul(_bits, b._bits);
 				return *this;
 			}
-			posit& operator/=(const posit& b) {
-				posit8_1_t lhs = { { _bits } };
-				posit8_1_t rhs = { { b._bits } };
-				posit8_1_t div = posit8_1_divp8(lhs, rhs);
-				_bits = div.v;
+			constexpr posit& operator/=(const posit& b) {
+				if (isnar() || b.isnar() || b.iszero()) {
+					setnar();
+					return *this;
+				}
+				if (iszero()) return *this;
+				_bits = engine::div(_bits, b._bits);
 				return *this;
 			}
-			posit& operator++() {
+			constexpr posit& operator++() {
 				++_bits;
 				return *this;
 			}
-			posit operator++(int) {
+			constexpr posit operator++(int) {
 				posit tmp(*this);
 				operator++();
 				return tmp;
 			}
-			posit& operator--() {
+			constexpr posit& operator--() {
 				--_bits;
 				return *this;
 			}
-			posit operator--(int) {
+			constexpr posit operator--(int) {
 				posit tmp(*this);
 				operator--();
 				return tmp;
@@ -137,29 +156,28 @@ namespace sw {
 				return p;
 			}
 			// SELECTORS
-			inline bool isnar() const      { return (_bits == 0x80); }
-			inline bool iszero() const     { return (_bits == 0x00); }
-			inline bool isone() const      { return (_bits == 0x40); } // pattern 010000...
-			inline bool isminusone() const { return (_bits == 0xC0); } // pattern 110000...
-			inline bool isneg() const      { return (_bits & 0x80); }
-			inline bool ispos() const      { return !isneg(); }
-			inline bool ispowerof2() const { return !(_bits & 0x1); }
+			constexpr bool isnar() const      { return (_bits == 0x80); }
+			constexpr bool iszero() const     { return (_bits == 0x00); }
+			constexpr bool isone() const      { return (_bits == 0x40); } // pattern 010000...
+			constexpr bool isminusone() const { return (_bits == 0xC0); } // pattern 110000...
+			constexpr bool isneg() const      { return (_bits & 0x80); }
+			constexpr bool ispos() const      { return !isneg(); }
+			constexpr bool ispowerof2() const { return !(_bits & 0x1); }
 
-			inline int sign_value() const  { return (_bits & 0x80 ? -1 : 1); }
+			constexpr int sign_value() const  { return (_bits & 0x80 ? -1 : 1); }
 
 			bitblock<NBITS_IS_8> get() const { bitblock<NBITS_IS_8> bb; bb = int(_bits); return bb; }
 			unsigned long long encoding() const { return (unsigned long long)(_bits); }
 
-			inline void clear() { _bits = 0; }
-			inline void setzero() { clear(); }
-			inline void setnar() { _bits = 0x80; }
-			inline posit twosComplement() const {
+			constexpr void clear() { _bits = 0; }
+			constexpr void setzero() { clear(); }
+			constexpr void setnar() { _bits = 0x80; }
+			constexpr posit twosComplement() const {
 				posit<NBITS_IS_8, ES_IS_1> p;
-				int8_t v = -*(int8_t*)&_bits;
-				p.set_raw_bits(v);
-				return p;
+				return p.set_raw_bits(uint8_t(~_bits + 1));
 			}
 		private:
+			using engine = native_engine<NBITS_IS_8, ES_IS_1>;
 			uint8_t _bits;
 
 			// Conversion functions
@@ -196,26 +214,25 @@ namespace sw {
 				return long(to_long_double());
 			}
 #endif
-			float       to_float() const {
-				posit8_1_t p = { { _bits } };
-				return posit8_1_tof(p);
+			constexpr float to_float() const {
+				return engine::to_ieee<float>(_bits);
 			}
-			double      to_double() const {
-				return (double)to_float();
+			constexpr double to_double() const {
+				return engine::to_ieee<double>(_bits);
 			}
-			long double to_long_double() const {
-				return (long double)to_float();
+			constexpr long double to_long_double() const {
+				return engine::to_ieee<long double>(_bits);
 			}
 
 			// helper method
-			posit& integer_assign(int rhs) {
-				posit8_1_t p = posit8_1_fromsi(rhs);
-				_bits = p.v;
+			constexpr posit& integer_assign(int rhs) {
+				_bits = engine::from_integer(rhs);
 				return *this;
 			}
-			posit& float_assign(float rhs) {
-				posit8_1_t p = posit8_1_fromf(rhs);
-				_bits = p.v;
+			// round float, double, and long double directly: rounding through a float first would round twice
+			template<typename Real>
+			constexpr posit& float_assign(Real rhs) {
+				_bits = engine::from_ieee(rhs);
 				return *this;
 			}
 
@@ -224,32 +241,27 @@ namespace sw {
 			friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_8, ES_IS_1>& p);
 
 			// posit - posit logic functions
-			friend bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
-			friend bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
-			friend bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
-			friend bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
-			friend bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
-			friend bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
+			friend constexpr bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs);
 
 		};
 
 		// posit I/O operators
 		// generate a posit format ASCII format nbits.esxNN...NNp
 		inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_8, ES_IS_1>& p) {
+#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 			// to make certain that setw and left/right operators work properly
 			// we need to transform the posit into a string
 			std::stringstream ss;
-#if POSIT_ROUNDING_ERROR_FREE_IO_FORMAT
 			ss << NBITS_IS_8 << '.' << ES_IS_1 << 'x' << to_hex(p.get()) << 'p';
+			return ostr << ss.str();
 #else
-			std::streamsize prec = ostr.precision();
-			std::streamsize width = ostr.width();
-			std::ios_base::fmtflags ff;
-			ff = ostr.flags();
-			ss.flags(ff);
-			ss << std::showpos << std::setw(width) << std::setprecision(prec) << (long double)p;
+			return write_decimal(ostr, p, ostr.flags() | std::ios_base::showpos);
 #endif
-			return ostr << ss.str();
 		}
 
 		// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
@@ -273,78 +285,85 @@ namespace sw {
 		}
 
 		// posit - posit binary logic operators
-		inline bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return lhs._bits == rhs._bits;
 		}
-		inline bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return !operator==(lhs, rhs);
 		}
-		inline bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return (signed char)(lhs._bits) < (signed char)(rhs._bits);
 		}
-		inline bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return operator< (rhs, lhs);
 		}
-		inline bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return operator< (lhs, rhs) || operator==(lhs, rhs);
 		}
-		inline bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return !operator< (lhs, rhs);
 		}
 
 		/* base class has these operators: no need to specialize */
-		inline posit<NBITS_IS_8, ES_IS_1> operator+(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {				
+		inline constexpr posit<NBITS_IS_8, ES_IS_1> operator+(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {				
 			posit<NBITS_IS_8, ES_IS_1> result = lhs;
 			return result += rhs;
 		}
-		inline posit<NBITS_IS_8, ES_IS_1> operator-(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr posit<NBITS_IS_8, ES_IS_1> operator-(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			posit<NBITS_IS_8, ES_IS_1> result = lhs;
 			return result -= rhs;
 
 		}
 			
-		// binary operator*() is provided by generic class
+		inline constexpr posit<NBITS_IS_8, ES_IS_1> operator*(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+			posit<NBITS_IS_8, ES_IS_1> result = lhs;
+			return result *= rhs;
+		}
+		inline constexpr posit<NBITS_IS_8, ES_IS_1> operator/(const posit<NBITS_IS_8, ES_IS_1>& lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+			posit<NBITS_IS_8, ES_IS_1> result = lhs;
+			return result /= rhs;
+		}
 
 #if POSIT_ENABLE_LITERALS
 		// posit - literal logic functions
 
 		// posit - int logic operators
-		inline bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator==(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return operator==(lhs, posit<NBITS_IS_8, ES_IS_1>(rhs));
 		}
-		inline bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator!=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return !operator==(lhs, posit<NBITS_IS_8, ES_IS_1>(rhs));
 		}
-		inline bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator< (const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return operator<(lhs, posit<NBITS_IS_8, ES_IS_1>(rhs));
 		}
-		inline bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator> (const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return operator< (posit<NBITS_IS_8, ES_IS_1>(rhs), lhs);
 		}
-		inline bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator<=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return operator< (lhs, posit<NBITS_IS_8, ES_IS_1>(rhs)) || operator==(lhs, posit<NBITS_IS_8, ES_IS_1>(rhs));
 		}
-		inline bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
+		inline constexpr bool operator>=(const posit<NBITS_IS_8, ES_IS_1>& lhs, int rhs) {
 			return !operator<(lhs, posit<NBITS_IS_8, ES_IS_1>(rhs));
 		}
 
 		// int - posit logic operators
-		inline bool operator==(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator==(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return posit<NBITS_IS_8, ES_IS_1>(lhs) == rhs;
 		}
-		inline bool operator!=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator!=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return !operator==(posit<NBITS_IS_8, ES_IS_1>(lhs), rhs);
 		}
-		inline bool operator< (int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator< (int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return operator<(posit<NBITS_IS_8, ES_IS_1>(lhs), rhs);
 		}
-		inline bool operator> (int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator> (int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return operator< (posit<NBITS_IS_8, ES_IS_1>(rhs), lhs);
 		}
-		inline bool operator<=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator<=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return operator< (posit<NBITS_IS_8, ES_IS_1>(lhs), rhs) || operator==(posit<NBITS_IS_8, ES_IS_1>(lhs), rhs);
 		}
-		inline bool operator>=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
+		inline constexpr bool operator>=(int lhs, const posit<NBITS_IS_8, ES_IS_1>& rhs) {
 			return !operator<(posit<NBITS_IS_8, ES_IS_1>(lhs), rhs);
 		}
 
@@ -0,0 +1,273 @@
+#pragma once
+// quire_16_1.hpp: specialized 128-bit quire using fast compute specialized for posit<16,1>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+namespace sw {
+	namespace unum {
+
+// the standard quire of posit<16,1> is a 128-bit two's complement fixed-point integer
+// with the radix point at bit 56: minpos^2 is bit 0, maxpos^2 is bit 112, and bits 113-126 are carry guard bits
+#if POSIT_FAST_POSIT_16_1 && LIMBS_HAVE_INT128
+
+	// the standard format holds 15 carry guard bits
+	template<>
+	struct quire_max_capacity<NBITS_IS_16, ES_IS_1> {
+		static constexpr size_t value = 15;
+	};
+
+	// fast specialized quire<16,1>: the capacity is fixed by the standard format
+	template<size_t capacity>
+	class quire<NBITS_IS_16, ES_IS_1, capacity> {
+	public:
+		static constexpr size_t nbits = NBITS_IS_16;
+		static constexpr size_t es = ES_IS_1;
+		static constexpr size_t escale = size_t(1) << es;
+		static constexpr size_t range = escale * (4 * nbits - 8);  // dynamic range of a product
+		static constexpr size_t half_range = range >> 1;           // position of the fixed point
+		static constexpr size_t radix_point = half_range;
+		static constexpr size_t upper_range = half_range + 1;      // size of the upper accumulator
+		static constexpr size_t qbits = 127;                       // size of the quire minus the sign bit
+		static constexpr size_t qlimbs = 2;
+		static_assert(capacity <= qbits - range, "quire<16,1>: the standard 128-bit format holds 15 carry guard bits, a larger capacity needs the generic quire");
+
+		quire() : _accu(0) {}
+		quire(int8_t initial_value) { *this = int64_t(initial_value); }
+		quire(int16_t initial_value) { *this = int64_t(initial_value); }
+		quire(int32_t initial_value) { *this = int64_t(initial_value); }
+		quire(int64_t initial_value) { *this = initial_value; }
+		quire(uint64_t initial_value) { *this = static_cast<unsigned long long>(initial_value); }
+		quire(float initial_value) { *this = initial_value; }
+		quire(double initial_value) { *this = initial_value; }
+		template<size_t fbits>
+		quire(const value<fbits>& rhs) { *this = rhs; }
+		quire(const posit<nbits, es>& rhs) { *this = rhs; }
+
+		template<size_t fbits>
+		quire& operator=(const value<fbits>& rhs) {
+			reset();
+			if (rhs.isinf() || rhs.isnan()) throw operand_is_nar{};
+			return *this += rhs;
+		}
+		quire& operator=(const posit<nbits, es>& rhs) {
+			reset();
+			return *this += rhs;
+		}
+		quire& operator=(int64_t rhs) {
+			uint64_t magnitude = (rhs < 0 ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs));
+			if (findMostSignificantBit((unsigned long long)magnitude) > qbits - half_range) throw operand_too_large_for_quire{};
+			reset();
+			accumulate(rhs < 0, magnitude, int(half_range));
+			return *this;
+		}
+		quire& operator=(unsigned long long rhs) {
+			if (findMostSignificantBit(rhs) > qbits - half_range) throw operand_too_large_for_quire{};
+			reset();
+			accumulate(false, uint64_t(rhs), int(half_range));
+			return *this;
+		}
+		quire& operator=(float rhs) {
+			*this = value<std::numeric_limits<float>::digits - 1>(rhs);
+			return *this;
+		}
+		quire& operator=(double rhs) {
+			*this = value<std::numeric_limits<double>::digits - 1>(rhs);
+			return *this;
+		}
+
+		// add a normalized value to the quire
+		template<size_t fbits>
+		quire& operator+=(const value<fbits>& rhs) {
+			if (rhs.iszero()) return *this;
+			if (rhs.scale() > int(half_range)) throw operand_too_large_for_quire{};
+			if (rhs.scale() < -int(half_range)) throw operand_too_small_for_quire{};
+			uint64_t m[qlimbs];
+			quire_fixed_point<qlimbs>(rhs, int(half_range), m);
+			uint128_limb_t addend = (uint128_limb_t(m[1]) << 64) | m[0];
+			if (rhs.sign()) _accu -= addend; else _accu += addend;
+			return *this;
+		}
+		template<size_t fbits>
+		quire& operator-=(const value<fbits>& rhs) {
+			return *this += -rhs;
+		}
+		quire& operator+=(const posit<nbits, es>& rhs) {
+			if (rhs.isnar()) throw operand_is_nar{};
+			if (rhs.iszero()) return *this;
+			bool negative; int scale; uint64_t sig;
+			engine::decode(rhs.encoding(), negative, scale, sig);
+			accumulate(negative, sig >> (64 - engine::fhbits), int(half_range) + scale - int(engine::fbits));
+			return *this;
+		}
+		quire& operator-=(const posit<nbits, es>& rhs) {
+			return *this += -rhs;
+		}
+		quire& operator+=(const quire& q) {
+			_accu += q._accu;
+			return *this;
+		}
+		quire& operator-=(const quire& q) {
+			_accu -= q._accu;
+			return *this;
+		}
+
+		// fused multiply-accumulate: the 13-bit significands multiply into an exact 26-bit integer product
+		quire& fma(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+			if (a.isnar() || b.isnar()) throw operand_is_nar{};
+			if (a.iszero() || b.iszero()) return *this;
+			bool sa, sb; int ka, kb; uint64_t fa, fb;
+			engine::decode(a.encoding(), sa, ka, fa);
+			engine::decode(b.encoding(), sb, kb, fb);
+			uint64_t product = (fa >> (64 - engine::fhbits)) * (fb >> (64 - engine::fhbits));
+			accumulate(sa != sb, product, int(half_range) + ka + kb - 2 * int(engine::fbits));
+			return *this;
+		}
+		// batched fused dot product: the two's complement accumulator resolves carries per product without sign logic
+		quire& accumulate(const posit<nbits, es>* x, const posit<nbits, es>* y, size_t n) {
+			for (size_t i = 0; i < n; ++i) fma(x[i], y[i]);
+			return *this;
+		}
+
+		// binary wire format of the sign and magnitude, shared with the generic quire
+		size_t wire_size() const {
+			uint64_t m[qlimbs];
+			magnitude(m);
+			return quire_wire_size<qlimbs>(m);
+		}
+		size_t serialize_into(span<uint8_t> buffer) const {
+			uint64_t m[qlimbs];
+			bool negative = magnitude(m);
+			return quire_wire_write<qlimbs>(buffer, nbits, es, qbits, negative, m);
+		}
+		size_t merge_from(span<const uint8_t> buffer) {
+			bool negative;
+			size_t lo, count;
+			uint64_t m[qlimbs];
+			size_t bytes = quire_wire_read<qlimbs>(buffer, nbits, es, qbits, negative, m, lo, count);
+			uint128_limb_t addend = (uint128_limb_t(m[1]) << 64) | m[0];
+			if (negative) _accu -= addend; else _accu += addend;
+			return bytes;
+		}
+
+		void reset() { _accu = 0; }
+		void clear() { reset(); }
+		// a zero quire has no negative encoding and stays positive
+		void set_sign(bool v) {
+			if (v != sign()) _accu = uint128_limb_t(0) - _accu;
+		}
+		// load the quire format "+:capacity_upper.lower" that the quire prints
+		bool load_bits(const std::string& string_of_bits) {
+			bool negative;
+			uint64_t m[qlimbs];
+			reset();
+			if (!quire_parse<qlimbs>(string_of_bits, qbits, half_range, upper_range, negative, m)) return false;
+			uint128_limb_t addend = (uint128_limb_t(m[1]) << 64) | m[0];
+			if (negative) _accu -= addend; else _accu += addend;
+			return true;
+		}
+
+		// query functions for quire attributes
+		inline int dynamic_range() const { return int(range); }
+		inline int max_scale() const { return int(upper_range); }
+		inline int min_scale() const { return -int(half_range); }
+		inline int capacity_range() const { return int(qbits - range); }
+		inline size_t total_bits() const { return qbits + 1; }
+		inline bool sign() const { return (_accu >> qbits) != 0; }
+		inline bool isneg() const { return sign(); }
+		inline bool ispos() const { return !sign(); }
+		inline bool iszero() const { return _accu == 0; }
+		int scale() const {
+			uint64_t m[qlimbs];
+			magnitude(m);
+			unsigned lz = limbs_clz<qlimbs>(m);
+			if (lz == 64 * qlimbs) return -int(half_range) - 1;
+			return int(64 * qlimbs - 1 - lz) - int(half_range);
+		}
+		// the two's complement encoding of the quire
+		bitblock<qbits + 1> get() const {
+			uint64_t m[qlimbs] = { uint64_t(_accu), uint64_t(_accu >> 64) };
+			bitblock<qbits + 1> q;
+			limbs_to_bitset<qbits + 1, qlimbs>(m, q);
+			return q;
+		}
+		value<qbits> to_value() const {
+			uint64_t m[qlimbs];
+			bool negative = magnitude(m);
+			return quire_normalize<qbits, qlimbs>(negative, m, int(half_range));
+		}
+		// bit addressing operator on the magnitude
+		bool operator[](int index) const {
+			if (index < 0 || index > int(qbits)) throw "index out of range";
+			uint64_t m[qlimbs];
+			magnitude(m);
+			return limbs_test<qlimbs>(m, size_t(index));
+		}
+		// is any bit of the magnitude at or below index set
+		bool anyAfter(int index) const {
+			if (index < 0) return false;
+			uint64_t m[qlimbs];
+			magnitude(m);
+			return limbs_any_below<qlimbs>(m, size_t(index) + 1);
+		}
+		template<size_t fbits>
+		int CompareMagnitude(const value<fbits>& v) const {
+			return quire_compare_magnitude(*this, v);
+		}
+
+	private:
+		using engine = native_engine<nbits, es>;
+		uint128_limb_t _accu;
+
+		// add or subtract an integer magnitude with its lsb at bit position lsb of the accumulator
+		void accumulate(bool negative, uint64_t m, int lsb) {
+			uint128_limb_t addend = (lsb < 0 ? uint128_limb_t(m >> -lsb) : uint128_limb_t(m) << lsb);
+			if (negative) _accu -= addend; else _accu += addend;
+		}
+		// sign and magnitude of the two's complement accumulator
+		bool magnitude(uint64_t* m) const {
+			bool negative = sign();
+			uint128_limb_t a = (negative ? uint128_limb_t(0) - _accu : _accu);
+			m[0] = uint64_t(a);
+			m[1] = uint64_t(a >> 64);
+			return negative;
+		}
+
+		template<size_t ncapacity>
+		friend std::ostream& operator<< (std::ostream& ostr, const quire<NBITS_IS_16, ES_IS_1, ncapacity>& q);
+		template<size_t ncapacity>
+		friend bool operator==(const quire<NBITS_IS_16, ES_IS_1, ncapacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, ncapacity>& rhs);
+		template<size_t ncapacity>
+		friend bool operator< (const quire<NBITS_IS_16, ES_IS_1, ncapacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, ncapacity>& rhs);
+	};
+
+	template<size_t capacity>
+	inline std::ostream& operator<<(std::ostream& ostr, const quire<NBITS_IS_16, ES_IS_1, capacity>& q) {
+		using Quire = quire<NBITS_IS_16, ES_IS_1, capacity>;
+		uint64_t m[Quire::qlimbs];
+		bool negative = q.magnitude(m);
+		return quire_print<Quire::qlimbs>(ostr, negative, m, Quire::qbits, Quire::half_range, Quire::upper_range);
+	}
+
+	template<size_t capacity>
+	inline bool operator==(const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) { return lhs._accu == rhs._accu; }
+	template<size_t capacity>
+	inline bool operator!=(const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) { return !operator==(lhs, rhs); }
+	template<size_t capacity>
+	inline bool operator< (const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) {
+		// flipping the sign bits orders the two's complement encodings as unsigned integers
+		constexpr uint128_limb_t sign_bit = uint128_limb_t(1) << 127;
+		return (lhs._accu ^ sign_bit) < (rhs._accu ^ sign_bit);
+	}
+	template<size_t capacity>
+	inline bool operator> (const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) { return  operator< (rhs, lhs); }
+	template<size_t capacity>
+	inline bool operator<=(const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) { return !operator> (lhs, rhs); }
+	template<size_t capacity>
+	inline bool operator>=(const quire<NBITS_IS_16, ES_IS_1, capacity>& lhs, const quire<NBITS_IS_16, ES_IS_1, capacity>& rhs) { return !operator< (lhs, rhs); }
+
+#endif // POSIT_FAST_POSIT_16_1
+
+  }
+}
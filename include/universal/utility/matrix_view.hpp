@@ -0,0 +1,105 @@
+#pragma once
+// matrix_view.hpp: non-owning strided views of dense vectors and matrices
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sw {
+namespace unum {
+
+	// a pointer, a size, and the distance between consecutive elements: element i is data[i * stride]
+	template<typename T>
+	class vector_view {
+	public:
+		using element_type = T;
+		using value_type = typename std::remove_cv<T>::type;
+
+		constexpr vector_view() noexcept : _data(nullptr), _size(0), _stride(1) {}
+		constexpr vector_view(T* data, size_t size, size_t stride = 1) noexcept : _data(data), _size(size), _stride(stride) {}
+		// a vector, or a view of mutable elements, converts to a view of const elements
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		vector_view(std::vector<U>& v) noexcept : _data(v.data()), _size(v.size()), _stride(1) {}
+		template<typename U, typename = typename std::enable_if<std::is_convertible<const U(*)[], T(*)[]>::value>::type>
+		vector_view(const std::vector<U>& v) noexcept : _data(v.data()), _size(v.size()), _stride(1) {}
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		constexpr vector_view(const vector_view<U>& v) noexcept : _data(v.data()), _size(v.size()), _stride(v.stride()) {}
+
+		constexpr T* data() const noexcept { return _data; }
+		constexpr size_t size() const noexcept { return _size; }
+		constexpr size_t stride() const noexcept { return _stride; }
+		constexpr bool empty() const noexcept { return _size == 0; }
+
+		T& operator[](size_t i) const { return _data[i * _stride]; }
+
+	private:
+		T*     _data;
+		size_t _size;
+		size_t _stride;
+	};
+
+	// storage order of the elements of a matrix
+	enum class matrix_layout { row_major, column_major };
+
+	// a pointer, the dimensions, the storage order, and the leading dimension of a matrix:
+	// in row-major order element (i, j) is data[i * ld + j], in column-major order data[i + j * ld]
+	template<typename T>
+	class matrix_view {
+	public:
+		using element_type = T;
+		using value_type = typename std::remove_cv<T>::type;
+
+		constexpr matrix_view() noexcept : _data(nullptr), _rows(0), _cols(0), _ld(0), _layout(matrix_layout::row_major) {}
+		// a densely packed matrix
+		constexpr matrix_view(T* data, size_t rows, size_t cols, matrix_layout layout = matrix_layout::row_major) noexcept
+			: _data(data), _rows(rows), _cols(cols), _ld(layout == matrix_layout::row_major ? cols : rows), _layout(layout) {}
+		// a matrix embedded in a larger array with leading dimension ld
+		constexpr matrix_view(T* data, size_t rows, size_t cols, size_t ld, matrix_layout layout) noexcept
+			: _data(data), _rows(rows), _cols(cols), _ld(ld), _layout(layout) {}
+		// a view of mutable elements converts to a view of const elements
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		constexpr matrix_view(const matrix_view<U>& m) noexcept : _data(m.data()), _rows(m.rows()), _cols(m.cols()), _ld(m.ld()), _layout(m.layout()) {}
+
+		constexpr T* data() const noexcept { return _data; }
+		constexpr size_t rows() const noexcept { return _rows; }
+		constexpr size_t cols() const noexcept { return _cols; }
+		constexpr size_t ld() const noexcept { return _ld; }
+		constexpr matrix_layout layout() const noexcept { return _layout; }
+		constexpr bool empty() const noexcept { return _rows == 0 || _cols == 0; }
+
+		// distance between the elements (i, j) and (i + 1, j), and between (i, j) and (i, j + 1)
+		constexpr size_t row_stride() const noexcept { return _layout == matrix_layout::row_major ? _ld : 1; }
+		constexpr size_t col_stride() const noexcept { return _layout == matrix_layout::row_major ? 1 : _ld; }
+
+		T& operator()(size_t i, size_t j) const { return _data[i * row_stride() + j * col_stride()]; }
+
+		// views of row i and of column j
+		vector_view<T> row(size_t i) const { return vector_view<T>(_data + i * row_stride(), _cols, col_stride()); }
+		vector_view<T> col(size_t j) const { return vector_view<T>(_data + j * col_stride(), _rows, row_stride()); }
+
+		// the rows x cols block starting at element (i, j), clipped to the view
+		matrix_view block(size_t i, size_t j, size_t rows, size_t cols) const {
+			if (i > _rows) i = _rows;
+			if (j > _cols) j = _cols;
+			if (rows > _rows - i) rows = _rows - i;
+			if (cols > _cols - j) cols = _cols - j;
+			return matrix_view(_data + i * row_stride() + j * col_stride(), rows, cols, _ld, _layout);
+		}
+		// the transpose shares the elements and swaps the storage order
+		matrix_view transpose() const {
+			return matrix_view(_data, _cols, _rows, _ld, _layout == matrix_layout::row_major ? matrix_layout::column_major : matrix_layout::row_major);
+		}
+
+	private:
+		T*            _data;
+		size_t        _rows;
+		size_t        _cols;
+		size_t        _ld;
+		matrix_layout _layout;
+	};
+
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,46 @@
+#pragma once
+// parallel.hpp: fork-join of a computation that is split into parts
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace sw {
+namespace unum {
+
+	// run part(t) for every t in [0, nrOfParts): the calling thread takes part 0 and a worker thread each of the others.
+	// An exception that escapes a part is captured, and the first one in part order is rethrown in the calling thread
+	// after all workers have been joined.
+	template<typename Part>
+	void parallel_parts(size_t nrOfParts, Part part) {
+		std::vector<std::exception_ptr> failure(nrOfParts);
+		auto run = [&](size_t t) {
+			try {
+				part(t);
+			}
+			catch (...) {
+				failure[t] = std::current_exception();
+			}
+		};
+		std::vector<std::thread> workers;
+		workers.reserve(nrOfParts > 0 ? nrOfParts - 1 : 0);
+		for (size_t t = 1; t < nrOfParts; ++t) workers.emplace_back(run, t);
+		if (nrOfParts > 0) run(0);
+		for (std::thread& worker : workers) worker.join();
+		for (std::exception_ptr& e : failure) if (e) std::rethrow_exception(e);
+	}
+
+	// number of threads to split work units over: at most requested, and few enough that every thread gets
+	// min_per_thread units, below which starting and joining a thread costs more than it saves.
+	inline size_t parallel_thread_count(size_t work, size_t requested, size_t min_per_thread) {
+		size_t threads = work / min_per_thread;
+		if (requested < threads) threads = requested;
+		return threads > 0 ? threads : 1;
+	}
+
+} // namespace unum
+} // namespace sw
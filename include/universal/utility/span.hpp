@@ -0,0 +1,54 @@
+#pragma once
+// span.hpp: a non-owning view of a contiguous sequence of objects
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sw {
+namespace unum {
+
+	// a pointer and a size: the C++14 subset of std::span that the library interfaces need
+	template<typename T>
+	class span {
+	public:
+		using element_type = T;
+		using value_type = typename std::remove_cv<T>::type;
+		using iterator = T*;
+
+		constexpr span() noexcept : _data(nullptr), _size(0) {}
+		constexpr span(T* data, size_t size) noexcept : _data(data), _size(size) {}
+		template<size_t N>
+		constexpr span(T (&array)[N]) noexcept : _data(array), _size(N) {}
+		// a vector, or a view of mutable elements, converts to a view of const elements
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		span(std::vector<U>& v) noexcept : _data(v.data()), _size(v.size()) {}
+		template<typename U, typename = typename std::enable_if<std::is_convertible<const U(*)[], T(*)[]>::value>::type>
+		span(const std::vector<U>& v) noexcept : _data(v.data()), _size(v.size()) {}
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		constexpr span(const span<U>& s) noexcept : _data(s.data()), _size(s.size()) {}
+
+		constexpr T* data() const noexcept { return _data; }
+		constexpr size_t size() const noexcept { return _size; }
+		constexpr bool empty() const noexcept { return _size == 0; }
+		T& operator[](size_t i) const { return _data[i]; }
+		iterator begin() const noexcept { return _data; }
+		iterator end() const noexcept { return _data + _size; }
+
+		// the count elements starting at offset, clipped to the view
+		span subspan(size_t offset, size_t count = size_t(-1)) const {
+			if (offset > _size) offset = _size;
+			if (count > _size - offset) count = _size - offset;
+			return span(_data + offset, count);
+		}
+
+	private:
+		T*     _data;
+		size_t _size;
+	};
+
+} // namespace unum
+} // namespace sw
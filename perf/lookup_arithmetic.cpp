@@ -0,0 +1,117 @@
+// lookup_arithmetic.cpp: performance of the lookup table posit_lut<8,0> against the fast posit<8,0> specialization
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<8,0>
+#define POSIT_FAST_POSIT_8_0 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <universal/posit/posit>
+#include <universal/posit/posit_lut.hpp>
+
+// time nrOfPasses passes of an element-wise operator over the arrays, in nanoseconds per operation
+template<typename Scalar, typename Op>
+double ElementWise(const std::vector<Scalar>& a, const std::vector<Scalar>& b, std::vector<Scalar>& c, size_t nrOfPasses, Op op) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t pass = 0; pass < nrOfPasses; ++pass) {
+		for (size_t i = 0; i < a.size(); ++i) c[i] = op(a[i], b[i]);
+	}
+	duration<double> elapsed = duration_cast<duration<double>>(steady_clock::now() - begin);
+	return elapsed.count() * 1.0e9 / double(nrOfPasses * a.size());
+}
+
+// a dependent chain of multiply-adds: every operation waits for the previous one, in nanoseconds per multiply-add
+template<typename Scalar>
+double MultiplyAddChain(const std::vector<Scalar>& a, const std::vector<Scalar>& b, size_t nrOfPasses, Scalar& sink) {
+	using namespace std::chrono;
+	Scalar acc = a[0];
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t pass = 0; pass < nrOfPasses; ++pass) {
+		for (size_t i = 0; i < a.size(); ++i) acc = acc * a[i] + b[i];
+	}
+	duration<double> elapsed = duration_cast<duration<double>>(steady_clock::now() - begin);
+	sink = acc;
+	return elapsed.count() * 1.0e9 / double(nrOfPasses * a.size());
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using Posit = posit<8, 0>;
+	using Lut = posit_lut<8, 0>;
+
+	constexpr size_t N = 4096;
+	constexpr size_t nrOfPasses = 2000;
+	mt19937_64 generator(8);
+	uniform_int_distribution<unsigned> encoding(0, 255);
+	vector<Posit> pa(N), pb(N), pc(N);
+	vector<Lut> la(N), lb(N), lc(N);
+	for (size_t i = 0; i < N; ++i) {
+		pa[i].set_raw_bits(encoding(generator));
+		pb[i].set_raw_bits(encoding(generator));
+		// the chain avoids NaR, which would absorb every following result
+		if (pa[i].isnar()) pa[i] = 1;
+		if (pb[i].isnar()) pb[i] = 0;
+		la[i] = Lut(pa[i]);
+		lb[i] = Lut(pb[i]);
+	}
+	// generate the tables before timing
+	Lut::lookup(lut_op::add, 0, 0);
+
+	cout << "posit_lut<8,0> table lookups versus the posit<8,0> specialization, ns/op" << endl;
+	cout << setw(12) << "operator" << setw(12) << "posit_8_0" << setw(12) << "posit_lut" << setw(10) << "speedup" << endl;
+	auto report = [](const char* op, double specialized, double lookup) {
+		cout << setw(12) << op << setw(12) << setprecision(3) << specialized << setw(12) << lookup << setw(10) << specialized / lookup << endl;
+	};
+	report("add", ElementWise(pa, pb, pc, nrOfPasses, [](const Posit& x, const Posit& y) { return x + y; }),
+	              ElementWise(la, lb, lc, nrOfPasses, [](const Lut& x, const Lut& y) { return x + y; }));
+	report("sub", ElementWise(pa, pb, pc, nrOfPasses, [](const Posit& x, const Posit& y) { return x - y; }),
+	              ElementWise(la, lb, lc, nrOfPasses, [](const Lut& x, const Lut& y) { return x - y; }));
+	report("mul", ElementWise(pa, pb, pc, nrOfPasses, [](const Posit& x, const Posit& y) { return x * y; }),
+	              ElementWise(la, lb, lc, nrOfPasses, [](const Lut& x, const Lut& y) { return x * y; }));
+	report("div", ElementWise(pa, pb, pc, nrOfPasses, [](const Posit& x, const Posit& y) { return x / y; }),
+	              ElementWise(la, lb, lc, nrOfPasses, [](const Lut& x, const Lut& y) { return x / y; }));
+	Posit psink;
+	Lut lsink;
+	report("mul-add", MultiplyAddChain(pa, pb, nrOfPasses, psink), MultiplyAddChain(la, lb, nrOfPasses, lsink));
+	// the results of both chains must agree
+	if (psink != lsink.to_posit()) {
+		cerr << "multiply-add chains differ: " << psink << " versus " << lsink << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
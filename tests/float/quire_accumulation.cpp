@@ -1,14 +1,146 @@
 //  quire_accumulations.cpp : computational path experiments with quires
 //
-// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <algorithm>
+#include <random>
+#include <vector>
 // minimum set of include files
 #include "universal/posit/exceptions.hpp"
 #include "universal/bitblock/bitblock.hpp"
 #include "universal/posit/value.hpp"
 #include "universal/float/quire.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// doubles with random signs and significands, and exponents spread over [emin, emax]
+std::vector<double> RandomDoubles(std::mt19937_64& generator, size_t n, int emin, int emax) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(emin, emax);
+	std::vector<double> v(n);
+	for (size_t i = 0; i < n; ++i) v[i] = std::ldexp(distribution(generator), exponent(generator));
+	return v;
+}
+
+// a sum in the quire must not depend on the order of the values, and must cancel exactly
+int ValidateOrderIndependence(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfValues) {
+	using Quire = sw::ieee::quire<64, 11>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nrOfValues);
+	for (int emax : { 10, 300, 1023 }) {
+		// the widest spread reaches down into the subnormals
+		std::vector<double> v = RandomDoubles(generator, nrOfValues, emax == 1023 ? -1074 : -emax, emax);
+		Quire forward, reverse, shuffled;
+		forward.accumulate(v.data(), v.size());
+		for (size_t i = v.size(); i-- > 0; ) reverse += v[i];
+		std::shuffle(v.begin(), v.end(), generator);
+		Quire lower, upper;
+		lower.accumulate(v.data(), v.size() / 2);
+		upper.accumulate(v.data() + v.size() / 2, v.size() - v.size() / 2);
+		shuffled = lower + upper;
+		if (forward != reverse || forward != shuffled) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " exponents up to " << emax << ": " << double(forward) << " " << double(reverse) << " " << double(shuffled) << std::endl;
+		}
+		for (double x : v) forward -= x;
+		if (!forward.iszero()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " cancellation leaves " << double(forward) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the conversion back to double must round to nearest, ties to even, including subnormal and overflowing results
+int ValidateRounding(const std::string& tag, bool bReportIndividualTestCases) {
+	using Quire = sw::ieee::quire<64, 11>;
+	int nrOfFailedTests = 0;
+	const double ulp = std::ldexp(1.0, -52), denorm = std::numeric_limits<double>::denorm_min(), dmax = std::numeric_limits<double>::max();
+	struct { std::vector<double> terms; double expected; } cases[] = {
+		{ { 1.0e100, 1.0, -1.0e100 },                     1.0 },
+		{ { 1.0, ulp / 2 },                               1.0 },                 // tie rounds to even
+		{ { 1.0 + ulp, ulp / 2 },                         1.0 + 2 * ulp },       // tie rounds to even
+		{ { 1.0, ulp / 2, std::ldexp(1.0, -1000) },       1.0 + ulp },           // sticky bit breaks the tie
+		{ { 1.0, -ulp / 4 },                              1.0 },                 // tie below a power of two
+		{ { 1.0, -ulp / 4, -std::ldexp(1.0, -1000) },     1.0 - ulp / 2 },
+		{ { 3 * denorm, -denorm },                        2 * denorm },
+		{ { std::numeric_limits<double>::min(), -denorm }, std::numeric_limits<double>::min() - denorm },
+		{ { dmax, dmax, -dmax },                          dmax },
+		{ { dmax, dmax },                                 std::numeric_limits<double>::infinity() },
+		{ { -0.0, 0.0 },                                  0.0 },
+	};
+	for (const auto& c : cases) {
+		Quire q;
+		q.accumulate(c.terms.data(), c.terms.size());
+		double result = double(q);
+		if (result != c.expected) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " rounding " << result << " != " << c.expected << std::endl;
+		}
+	}
+	// every double must survive the trip through the quire
+	std::mt19937_64 generator(1);
+	for (double x : RandomDoubles(generator, 10000, -1074, 1023)) {
+		Quire q(x);
+		if (double(q) != x || float(q) != float(x)) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " round trip " << double(q) << " != " << x << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the exact dot product must agree with the sum of exact products: float products are exact in double,
+// and doubles scaled by powers of two into the subnormal range must not lose the bits of their products
+int ValidateDotProduct(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfValues) {
+	using Quire = sw::ieee::quire<64, 11>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nrOfValues);
+	std::vector<double> dx = RandomDoubles(generator, nrOfValues, -60, 60), dy = RandomDoubles(generator, nrOfValues, -60, 60);
+	std::vector<float> x(nrOfValues), y(nrOfValues);
+	std::vector<double> products(nrOfValues);
+	for (size_t i = 0; i < nrOfValues; ++i) {
+		x[i] = float(dx[i]);
+		y[i] = float(dy[i]);
+		products[i] = double(x[i]) * double(y[i]);
+	}
+	Quire fdp, reference;
+	fdp.dot(x.data(), y.data(), nrOfValues);
+	reference.accumulate(products.data(), nrOfValues);
+	if (fdp != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " float dot " << double(fdp) << " != " << double(reference) << std::endl;
+	}
+	// scaling the operands by powers of two scales the exact products, even when the products underflow in double
+	for (int k : { 0, 400, 900 }) {
+		std::vector<double> u(nrOfValues), v(nrOfValues);
+		for (size_t i = 0; i < nrOfValues; ++i) {
+			u[i] = std::ldexp(dx[i], -k);
+			v[i] = std::ldexp(dy[i], -100);
+		}
+		Quire scaled, unscaled;
+		scaled.dot(u.data(), v.data(), nrOfValues);
+		for (size_t i = 0; i < nrOfValues; ++i) unscaled.fma(dx[i], dy[i]);
+		sw::unum::value<Quire::qbits> s = scaled.to_value(), r = unscaled.to_value();
+		if (s.iszero() || s.sign() != r.sign() || s.scale() != r.scale() - k - 100 || s.fraction() != r.fraction()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " dot product scaled by 2^-" << (k + 100) << " " << components(s) << " != " << components(r) << std::endl;
+		}
+	}
+	// the products of an ill-conditioned dot product cancel exactly
+	std::vector<double> u(dx), v(dy);
+	u.insert(u.end(), dx.begin(), dx.end());
+	for (double d : dy) v.push_back(-d);
+	Quire cancelled;
+	cancelled.dot(u.data(), v.data(), u.size());
+	if (!cancelled.iszero()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " cancellation leaves " << double(cancelled) << std::endl;
+	}
+	return nrOfFailedTests;
+}
 
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -18,22 +150,25 @@ try {
 	using namespace std;
 	using namespace sw::ieee;
 
-	//bool bReportIndividualTestCases = false;
+	bool bReportIndividualTestCases = false;
 	int nrOfFailedTestCases = 0;
 
 	std::string tag = "Quire Accumulation";
 
 #if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateRounding(tag, true), "quire<64,11>", "rounding");
 
 #else
 
 	cout << "IEEE Floating Point Quire experiments" << endl;
-	
-	cout << "\nTBD\n";
-
-#ifdef STRESS_TESTING
 
+	nrOfFailedTestCases += ReportTestResult(ValidateOrderIndependence(tag, bReportIndividualTestCases, 10000), "quire<64,11>", "order independence");
+	nrOfFailedTestCases += ReportTestResult(ValidateRounding(tag, bReportIndividualTestCases), "quire<64,11>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(ValidateDotProduct(tag, bReportIndividualTestCases, 10000), "quire<64,11>", "dot product");
 
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateOrderIndependence(tag, bReportIndividualTestCases, 10000000), "quire<64,11>", "order independence");
+	nrOfFailedTestCases += ReportTestResult(ValidateDotProduct(tag, bReportIndividualTestCases, 10000000), "quire<64,11>", "dot product");
 #endif // STRESS_TESTING
 
 
@@ -44,6 +179,10 @@ catch (char const* msg) {
 	std::cerr << msg << '\n';
 	return EXIT_FAILURE;
 }
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
 catch (...) {
 	std::cerr << "Caught unknown exception" << '\n';
 	return EXIT_FAILURE;
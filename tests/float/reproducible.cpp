@@ -0,0 +1,177 @@
+//  reproducible.cpp : validation of the bitwise reproducible parallel reductions of float and double arrays
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+// minimum set of include files
+#include "universal/posit/exceptions.hpp"
+#include "universal/bitblock/bitblock.hpp"
+#include "universal/posit/value.hpp"
+#include "universal/float/reproducible.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// values with random signs and significands, and exponents spread over [-emax, emax]
+template<typename Real>
+std::vector<Real> RandomValues(std::mt19937_64& generator, size_t n, int emax) {
+	std::uniform_real_distribution<Real> distribution(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(-emax, emax);
+	std::vector<Real> v(n);
+	for (size_t i = 0; i < n; ++i) v[i] = std::ldexp(distribution(generator), exponent(generator));
+	return v;
+}
+
+template<typename Real>
+bool BitwiseEqual(Real a, Real b) {
+	return std::memcmp(&a, &b, sizeof(Real)) == 0;
+}
+
+// the reductions must produce the same bits for any number of threads and any order of the elements,
+// and match the correctly rounded serial quire results
+template<typename Real>
+int ValidateReproducibility(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfElements, int emax) {
+	using Quire = typename sw::ieee::reproducible_quire<Real>::type;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nrOfElements + size_t(emax));
+	std::vector<Real> x = RandomValues<Real>(generator, nrOfElements, emax), y = RandomValues<Real>(generator, nrOfElements, emax);
+	Quire sum, dot, squares;
+	sum.accumulate(x.data(), nrOfElements);
+	dot.dot(x.data(), y.data(), nrOfElements);
+	Real referenceSum = sum.template to_native<Real>(), referenceDot = dot.template to_native<Real>();
+	Real referenceNrm2 = sw::ieee::reproducible_nrm2(x, 1);
+	for (size_t nrOfThreads : { 1, 2, 3, 4, 7, 16 }) {
+		Real s = sw::ieee::reproducible_sum(x, nrOfThreads);
+		Real d = sw::ieee::reproducible_dot(x, y, nrOfThreads);
+		Real r = sw::ieee::reproducible_nrm2(x, nrOfThreads);
+		if (!BitwiseEqual(s, referenceSum) || !BitwiseEqual(d, referenceDot) || !BitwiseEqual(r, referenceNrm2)) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << nrOfThreads << " threads: " << s << " " << d << " " << r << " != " << referenceSum << " " << referenceDot << " " << referenceNrm2 << std::endl;
+		}
+	}
+	// a different partitioning of a permutation of the elements
+	std::vector<size_t> order(nrOfElements);
+	for (size_t i = 0; i < nrOfElements; ++i) order[i] = i;
+	std::shuffle(order.begin(), order.end(), generator);
+	std::vector<Real> u(nrOfElements), v(nrOfElements);
+	for (size_t i = 0; i < nrOfElements; ++i) {
+		u[i] = x[order[i]];
+		v[i] = y[order[i]];
+	}
+	if (!BitwiseEqual(sw::ieee::reproducible_sum(u, 5), referenceSum) || !BitwiseEqual(sw::ieee::reproducible_dot(u, v, 5), referenceDot) || !BitwiseEqual(sw::ieee::reproducible_nrm2(u, 5), referenceNrm2)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "permuted elements give a different result" << std::endl;
+	}
+	// the norm is the square root of the correctly rounded sum of squares, within an ulp
+	squares.dot(x.data(), x.data(), nrOfElements);
+	long double norm = std::sqrt((long double)(squares.template to_native<double>()));
+	if (std::abs((long double)referenceNrm2 - norm) > norm * std::numeric_limits<Real>::epsilon()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "nrm2 " << referenceNrm2 << " != " << double(norm) << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// sums that lose all their bits in naive floating-point summation, and norms of vectors outside the range of their squares
+int ValidateIllConditioned(const std::string& tag, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(17);
+	std::vector<double> x = RandomValues<double>(generator, 50000, 300);
+	std::vector<double> cancelling(x);
+	for (double d : x) cancelling.push_back(-d);
+	cancelling.push_back(std::numeric_limits<double>::denorm_min());
+	std::shuffle(cancelling.begin(), cancelling.end(), generator);
+	for (size_t nrOfThreads : { 1, 3, 8 }) {
+		double s = sw::ieee::reproducible_sum(cancelling, nrOfThreads);
+		if (s != std::numeric_limits<double>::denorm_min()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << "cancellation " << s << " with " << nrOfThreads << " threads" << std::endl;
+		}
+	}
+	// the squares of these vectors overflow and underflow in double, their norms are exact
+	std::vector<double> large = { std::ldexp(3.0, 600), std::ldexp(4.0, 600) }, small = { std::ldexp(3.0, -600), std::ldexp(-4.0, -600) };
+	std::vector<float> f = { 3.0f, -4.0f, 0.0f };
+	if (sw::ieee::reproducible_nrm2(large) != std::ldexp(5.0, 600) || sw::ieee::reproducible_nrm2(small) != std::ldexp(5.0, -600) || sw::ieee::reproducible_nrm2(f) != 5.0f) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "nrm2 " << sw::ieee::reproducible_nrm2(large) << " " << sw::ieee::reproducible_nrm2(small) << " " << sw::ieee::reproducible_nrm2(f) << std::endl;
+	}
+	if (sw::ieee::reproducible_sum(std::vector<double>()) != 0.0 || sw::ieee::reproducible_nrm2(std::vector<float>()) != 0.0f) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "empty reductions are not zero" << std::endl;
+	}
+	// a non-finite element in the part of a worker thread must surface in the calling thread
+	x.back() = std::numeric_limits<double>::quiet_NaN();
+	try {
+		sw::ieee::reproducible_sum(x, 4);
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "NaN operand not reported" << std::endl;
+	}
+	catch (const quire_exception&) {
+		// correctly reported
+	}
+	// vectors of different lengths have no dot product
+	try {
+		sw::ieee::reproducible_dot(x, std::vector<double>(x.size() - 1), 2);
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << "length mismatch not reported" << std::endl;
+	}
+	catch (const std::invalid_argument&) {
+		// correctly reported
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace std;
+	using namespace sw::ieee;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "reproducible reduction failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateReproducibility<double>(tag, true, 100000, 30), "double", "reproducibility");
+
+#else
+
+	cout << "Reproducible reductions validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateReproducibility<double>(tag, bReportIndividualTestCases, 100000, 30),  "double", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(ValidateReproducibility<double>(tag, bReportIndividualTestCases, 100000, 500), "double", "reproducibility over a wide range");
+	nrOfFailedTestCases += ReportTestResult(ValidateReproducibility<float>(tag, bReportIndividualTestCases, 100000, 30),   "float", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(ValidateIllConditioned(tag, bReportIndividualTestCases), "double", "ill-conditioned reductions");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateReproducibility<double>(tag, bReportIndividualTestCases, 10000000, 300), "double", "reproducibility");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
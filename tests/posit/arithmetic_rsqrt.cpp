@@ -0,0 +1,174 @@
+// arithmetic_rsqrt.cpp: validation of the integer sqrt and rsqrt of arbitrary posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <cmath>
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math/elementary.hpp"
+#include "universal/posit/math/pow.hpp"
+#include "universal/posit/math/sqrt.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// sqrt and rsqrt of the integer engines against the correctly rounded pow(x, 0.5) and rsqrt of the
+		// elementary function engine, which evaluate the roots in wide floating-point arithmetic
+		template<size_t nbits, size_t es>
+		int VerifyIntegerRoots(const std::string& tag, const posit<nbits, es>& x, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			posit<nbits, es> result = sqrt(x), reference = pow(x, 0.5);
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "sqrt(" << x.get() << ") = " << result.get() << " reference " << reference.get() << std::endl;
+			}
+			result = rsqrt(x);
+			reference = internal::posit_elementary<nbits, es>::rsqrt(x);
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "rsqrt(" << x.get() << ") = " << result.get() << " reference " << reference.get() << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// enumerate all positive posits of a small configuration, and the special cases zero, NaR, and negative
+		template<size_t nbits, size_t es>
+		int ValidateIntegerRoots(const std::string& tag, bool bReportIndividualTestCases) {
+			const size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> x;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				x.set_raw_bits(i);
+				if (x.iszero() || x.isneg() || x.isnar()) {
+					// sqrt(0) is 0, and the other special cases are NaR
+					bool sqrt_ok = (x.iszero() ? sqrt(x).iszero() : sqrt(x).isnar());
+					if (!sqrt_ok || !rsqrt(x).isnar()) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "special case " << x.get() << std::endl;
+					}
+					continue;
+				}
+				nrOfFailedTests += VerifyIntegerRoots(tag, x, bReportIndividualTestCases);
+			}
+			return nrOfFailedTests;
+		}
+
+		// random positive encodings of configurations that are too large to enumerate, and the even powers of 2
+		// that have exact roots
+		template<size_t nbits, size_t es>
+		int ValidateIntegerRootsThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 rng(nbits * 13 + es);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> x;
+			for (size_t n = 0; n < nrOfRandoms; ++n) {
+				bitblock<nbits> raw;
+				for (size_t i = 0; i < nbits; i += 64) {
+					uint64_t word = rng();
+					for (size_t j = 0; j < 64 && i + j < nbits; ++j) raw[i + j] = (word >> j) & 0x1;
+				}
+				raw[nbits - 1] = false;
+				x.set(raw);
+				if (x.iszero()) continue;
+				nrOfFailedTests += VerifyIntegerRoots(tag, x, bReportIndividualTestCases);
+			}
+			for (int k = -16; k <= 16; ++k) {
+				x = std::ldexp(1.0, 2 * k);
+				posit<nbits, es> root = std::ldexp(1.0, k), reciprocal = std::ldexp(1.0, -k);
+				if (sqrt(x) != root || rsqrt(x) != reciprocal) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "exact roots of " << x << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "integer roots failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms<256, 5>(tag, true, 100), "posit<256,5>", "sqrt and rsqrt");
+
+#else
+
+	cout << "Posit integer sqrt and rsqrt validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots< 5, 0>(tag, bReportIndividualTestCases), "posit< 5,0>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots< 6, 1>(tag, bReportIndividualTestCases), "posit< 6,1>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots< 8, 1>(tag, bReportIndividualTestCases), "posit< 8,1>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots< 8, 3>(tag, bReportIndividualTestCases), "posit< 8,3>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<10, 2>(tag, bReportIndividualTestCases), "posit<10,2>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "sqrt and rsqrt");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 24, 1>(tag, bReportIndividualTestCases, 5000), "posit< 24,1>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 32, 2>(tag, bReportIndividualTestCases, 5000), "posit< 32,2>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 48, 2>(tag, bReportIndividualTestCases, 2000), "posit< 48,2>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 64, 0>(tag, bReportIndividualTestCases, 2000), "posit< 64,0>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 64, 3>(tag, bReportIndividualTestCases, 2000), "posit< 64,3>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 80, 2>(tag, bReportIndividualTestCases, 1000), "posit< 80,2>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms<256, 5>(tag, bReportIndividualTestCases, 500), "posit<256,5>", "sqrt and rsqrt");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<16, 0>(tag, bReportIndividualTestCases), "posit<16,0>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<16, 2>(tag, bReportIndividualTestCases), "posit<16,2>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRoots<20, 1>(tag, bReportIndividualTestCases), "posit<20,1>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms< 64, 3>(tag, bReportIndividualTestCases, 100000), "posit< 64,3>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms<128, 4>(tag, bReportIndividualTestCases, 50000), "posit<128,4>", "sqrt and rsqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateIntegerRootsThroughRandoms<256, 5>(tag, bReportIndividualTestCases, 20000), "posit<256,5>", "sqrt and rsqrt");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+// batch_arithmetic.cpp: functional tests comparing the batch operators on posit arrays to the scalar posit operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <functional>
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/limb_engine.hpp"
+#include "universal/posit/batch.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// exact a * b + c on a 768-bit fixed-point accumulator, rounded once by the limb engine
+		template<size_t nbits, size_t es>
+		uint64_t ReferenceFma(uint64_t a, uint64_t b, uint64_t c) {
+			using engine = limb_engine<nbits, es>;
+			constexpr size_t N = 12;
+			constexpr int lsb = 400;   // bit position of 2^0
+			const uint64_t nar = uint64_t(1) << (nbits - 1);
+			if (a == nar || b == nar || c == nar) return nar;
+			if (a == 0 || b == 0) return c;
+			typename engine::triple va, vb, vc;
+			engine::decode(&a, va);
+			engine::decode(&b, vb);
+			uint64_t x[N] = { 0 }, y[N] = { 0 };
+			uint64_t hi, lo = mul64x64(va.sig[0], vb.sig[0], hi);
+			x[0] = lo; x[1] = hi;
+			limbs_shl<N>(x, size_t(va.scale + vb.scale - 126 + lsb));
+			bool sx = va.sign ^ vb.sign, sy = false;
+			if (c != 0) {
+				engine::decode(&c, vc);
+				y[0] = vc.sig[0];
+				limbs_shl<N>(y, size_t(vc.scale - 63 + lsb));
+				sy = vc.sign;
+			}
+			uint64_t r[N];
+			bool sign = sx;
+			if (sx == sy) {
+				limbs_add<N>(r, x, y);
+			}
+			else if (limbs_compare<N>(x, y) >= 0) {
+				limbs_sub<N>(r, x, y);
+			}
+			else {
+				limbs_sub<N>(r, y, x);
+				sign = sy;
+			}
+			if (limbs_iszero<N>(r)) return 0;
+			unsigned lz = limbs_clz<N>(r);
+			limbs_shl<N>(r, lz);
+			uint64_t raw = 0;
+			engine::template encode<N>(sign, int(64 * N - 1 - lz) - lsb, r, false, &raw);
+			return raw;
+		}
+
+		template<size_t nbits>
+		uint64_t RandomEncoding(std::mt19937_64& rng) {
+			// mix in the special values and the extremes of the dynamic range
+			const uint64_t mask = (uint64_t(1) << nbits) - 1;
+			const uint64_t specials[] = { 0, uint64_t(1) << (nbits - 1), 1, mask, mask >> 1, (mask >> 1) + 2, uint64_t(1) << (nbits - 2), mask - (uint64_t(1) << (nbits - 2)) + 1 };
+			uint64_t r = rng();
+			if ((r & 0xF) == 0) return specials[(r >> 4) % (sizeof(specials) / sizeof(specials[0]))];
+			return (r >> 8) & mask;
+		}
+
+		template<size_t nbits, size_t es>
+		int VerifyBatchResult(const std::string& tag, const std::string& op, const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& result, const posit<nbits, es>& ref, bool bReportIndividualTestCases) {
+			if (result.get() == ref.get()) return 0;
+			if (bReportIndividualTestCases) {
+				std::cout << tag << op << " " << hex_format(a) << " " << hex_format(b) << " != " << hex_format(result) << " reference " << hex_format(ref) << std::endl;
+			}
+			return 1;
+		}
+
+		// run every batch operator on random arrays on the selected instruction set and compare each element to the scalar operators
+		template<size_t nbits, size_t es>
+		int ValidateBatchOperators(const std::string& tag, batch::isa target, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 rng(nbits * 7 + es);
+			batch::select_isa(target);
+			// odd sizes exercise the scalar tail of the vector loops
+			for (size_t n : { size_t(0), size_t(1), size_t(7), size_t(33), nrOfRandoms }) {
+				std::vector<Posit> a(n), b(n), c(n), r;
+				std::vector<uint8_t> mask;
+				for (size_t i = 0; i < n; ++i) {
+					a[i].set_raw_bits(RandomEncoding<nbits>(rng));
+					b[i].set_raw_bits(RandomEncoding<nbits>(rng));
+					c[i].set_raw_bits(RandomEncoding<nbits>(rng));
+				}
+				batch::add(a, b, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "add", a[i], b[i], r[i], Posit(a[i] + b[i]), bReportIndividualTestCases);
+				batch::sub(a, b, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "sub", a[i], b[i], r[i], Posit(a[i] - b[i]), bReportIndividualTestCases);
+				batch::mul(a, b, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "mul", a[i], b[i], r[i], Posit(a[i] * b[i]), bReportIndividualTestCases);
+				batch::div(a, b, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "div", a[i], b[i], r[i], Posit(a[i] / b[i]), bReportIndividualTestCases);
+				batch::fma(a, b, c, r);
+				for (size_t i = 0; i < n; ++i) {
+					Posit ref;
+					ref.set_raw_bits(ReferenceFma<nbits, es>(a[i].get().to_ullong(), b[i].get().to_ullong(), c[i].get().to_ullong()));
+					nrOfFailedTests += VerifyBatchResult(tag, "fma", a[i], b[i], r[i], ref, bReportIndividualTestCases);
+				}
+				batch::negate(a, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "negate", a[i], a[i], r[i], Posit(-a[i]), bReportIndividualTestCases);
+				batch::abs(a, r);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "abs", a[i], a[i], r[i], a[i].isneg() ? Posit(-a[i]) : a[i], bReportIndividualTestCases);
+				// compare against a copy so that some elements are equal
+				std::vector<Posit> d(b);
+				for (size_t i = 0; i < n; i += 3) d[i] = a[i];
+				batch::less(a, d, mask);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += (mask[i] != uint8_t(a[i] < d[i]));
+				batch::less_equal(a, d, mask);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += (mask[i] != uint8_t(a[i] <= d[i]));
+				batch::equal(a, d, mask);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += (mask[i] != uint8_t(a[i] == d[i]));
+				// the span interface writes into the caller's storage
+				std::vector<Posit> s(n);
+				batch::mul(span<const Posit>(a), span<const Posit>(b), span<Posit>(s));
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += VerifyBatchResult(tag, "span mul", a[i], b[i], s[i], Posit(a[i] * b[i]), bReportIndividualTestCases);
+				batch::fma(span<Posit>(a), span<Posit>(b), span<Posit>(c), span<Posit>(s));
+				batch::fma(a, b, c, r);
+				nrOfFailedTests += (s != r);
+				batch::less(span<const Posit>(a), span<const Posit>(d), span<uint8_t>(mask));
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += (mask[i] != uint8_t(a[i] < d[i]));
+			}
+			// spans of different sizes are rejected
+			std::vector<Posit> a(8), b(7), r(8);
+			try {
+				batch::add(span<const Posit>(a), span<const Posit>(b), span<Posit>(r));
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "span size mismatch not reported" << std::endl;
+			}
+			catch (const std::invalid_argument&) {
+				// correctly reported
+			}
+			// vectors of different sizes are rejected before a kernel reads past the shorter one
+			std::vector<uint8_t> mask;
+			auto rejected = [](std::function<void()> op) {
+				try {
+					op();
+				}
+				catch (const std::invalid_argument&) {
+					return true;
+				}
+				return false;
+			};
+			if (!rejected([&]() { batch::sub(a, b, r); }) || !rejected([&]() { batch::fma(a, a, b, r); }) || !rejected([&]() { batch::equal(a, b, mask); })) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "vector size mismatch not reported" << std::endl;
+			}
+			batch::select_isa(batch::detected_isa());
+			return nrOfFailedTests;
+		}
+
+		// the fused multiply-add rounds once: a product that cancels against the addend leaves the exact residual
+		template<size_t nbits, size_t es>
+		int ValidateFusedRounding(const std::string& tag, bool bReportIndividualTestCases) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			Posit a(1.0), b, c, r;
+			++a;                                                 // 1 + ulp
+			b = a;
+			c = -(b * b);                                        // -(1 + 2ulp) rounded
+			batch::fma(&a, &b, &c, &r, 1);
+			Posit ref;
+			ref.set_raw_bits(ReferenceFma<nbits, es>(a.get().to_ullong(), b.get().to_ullong(), c.get().to_ullong()));
+			if (r.iszero() || r != ref) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "fma residual " << hex_format(r) << " reference " << hex_format(ref) << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Batch operators failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<16, 1>(tag, batch::isa::avx2, true, 100), "posit<16,1>", "batch avx2");
+
+#else
+
+	cout << "Posit batch arithmetic validation" << endl;
+	cout << "detected instruction set: " << (batch::detected_isa() == batch::isa::avx2 ? "avx2" : "scalar") << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<16, 1>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<16,1>", "batch scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<32, 2>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<32,2>", "batch scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<16, 1>(tag, batch::isa::avx2, bReportIndividualTestCases, 100000), "posit<16,1>", "batch avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<32, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 100000), "posit<32,2>", "batch avx2");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedRounding<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "batch fma");
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedRounding<32, 2>(tag, bReportIndividualTestCases), "posit<32,2>", "batch fma");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<16, 1>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000000), "posit<16,1>", "batch avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateBatchOperators<32, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000000), "posit<32,2>", "batch avx2");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
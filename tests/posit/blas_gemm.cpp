@@ -0,0 +1,182 @@
+// blas_gemm.cpp: validation of the blocked matrix-matrix multiplication against element-wise fused dot products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+#include "universal/posit/gemm.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// a rows x cols matrix of random posits stored with leading dimension ld
+		template<size_t nbits, size_t es>
+		std::vector< posit<nbits, es> > RandomMatrix(std::mt19937_64& generator, size_t rows, size_t cols, size_t ld, matrix_layout layout) {
+			std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+			std::uniform_int_distribution<int> exponent(-20, 20);
+			std::vector< posit<nbits, es> > m((layout == matrix_layout::row_major ? rows : cols) * ld);
+			for (posit<nbits, es>& p : m) p = std::ldexp(distribution(generator), exponent(generator));
+			return m;
+		}
+
+		// every element of gemm(A, B, C) must be the fused dot product of a row of A and a column of B
+		template<size_t nbits, size_t es>
+		int CompareToFusedDotProducts(const std::string& tag, bool bReportIndividualTestCases, matrix_view<const posit<nbits, es>> A, matrix_view<const posit<nbits, es>> B, matrix_view<const posit<nbits, es>> C) {
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < C.rows(); ++i) {
+				for (size_t j = 0; j < C.cols(); ++j) {
+					quire<nbits, es, 30> q;
+					for (size_t k = 0; k < A.cols(); ++k) q.fma(A(i, k), B(k, j));
+					posit<nbits, es> reference;
+					convert(q.to_value(), reference);
+					if (C(i, j) != reference) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "C(" << i << ", " << j << ") " << C(i, j) << " != " << reference << std::endl;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// all combinations of layouts, embedded in larger arrays, and partial tiles at the edges
+		template<size_t nbits, size_t es>
+		int ValidateGemm(const std::string& tag, bool bReportIndividualTestCases, size_t M, size_t N, size_t K) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + M + N + K));
+			const matrix_layout layouts[] = { matrix_layout::row_major, matrix_layout::column_major };
+			for (matrix_layout la : layouts) {
+				for (matrix_layout lb : layouts) {
+					for (matrix_layout lc : layouts) {
+						size_t lda = (la == matrix_layout::row_major ? K : M) + 3, ldb = (lb == matrix_layout::row_major ? N : K) + 1;
+						size_t ldc = (lc == matrix_layout::row_major ? N : M) + 2;
+						std::vector<Posit> a = RandomMatrix<nbits, es>(generator, M, K, lda, la), b = RandomMatrix<nbits, es>(generator, K, N, ldb, lb);
+						std::vector<Posit> c((lc == matrix_layout::row_major ? M : N) * ldc);
+						matrix_view<const Posit> A(a.data(), M, K, lda, la), B(b.data(), K, N, ldb, lb);
+						matrix_view<Posit> C(c.data(), M, N, ldc, lc);
+						gemm(A, B, C, 3);
+						nrOfFailedTests += CompareToFusedDotProducts<nbits, es>(tag, bReportIndividualTestCases, A, B, C);
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the large products of the first half of the inner dimension cancel, so that only the small ones survive,
+		// and the result must not depend on the number of threads
+		template<size_t nbits, size_t es>
+		int ValidateGemmCancellation(const std::string& tag, bool bReportIndividualTestCases, size_t M, size_t N, size_t K) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits + es));
+			std::vector<Posit> a = RandomMatrix<nbits, es>(generator, M, 2 * K + 1, 2 * K + 1, matrix_layout::row_major);
+			std::vector<Posit> b = RandomMatrix<nbits, es>(generator, 2 * K + 1, N, N, matrix_layout::row_major);
+			for (size_t i = 0; i < M; ++i) {
+				for (size_t k = 0; k < K; ++k) a[i * (2 * K + 1) + K + k] = -a[i * (2 * K + 1) + k];
+				a[i * (2 * K + 1) + 2 * K] = minpos<nbits, es>();
+			}
+			for (size_t k = 0; k < K; ++k) {
+				for (size_t j = 0; j < N; ++j) b[(K + k) * N + j] = b[k * N + j];
+			}
+			matrix_view<const Posit> A(a.data(), M, 2 * K + 1), B(b.data(), 2 * K + 1, N);
+			std::vector<Posit> reference(M * N), c(M * N);
+			gemm(A, B, matrix_view<Posit>(reference.data(), M, N), 1);
+			nrOfFailedTests += CompareToFusedDotProducts<nbits, es>(tag, bReportIndividualTestCases, A, B, matrix_view<const Posit>(reference.data(), M, N));
+			for (size_t nrOfThreads : { 2, 3, 7, 16 }) {
+				gemm(A, B, matrix_view<Posit>(c.data(), M, N), nrOfThreads);
+				if (c != reference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << nrOfThreads << " threads give a different product" << std::endl;
+				}
+			}
+			// a NaR in the part of a worker thread must surface in the calling thread
+			a.back().setnar();
+			try {
+				gemm(A, B, matrix_view<Posit>(c.data(), M, N), 4);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "NaR operand not reported" << std::endl;
+			}
+			catch (const operand_is_nar&) {
+				// correctly reported
+			}
+			// mismatched inner dimensions
+			try {
+				gemm(matrix_view<const Posit>(a.data(), M, K), B, matrix_view<Posit>(c.data(), M, N), 1);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "dimension mismatch not reported" << std::endl;
+			}
+			catch (const std::invalid_argument&) {
+				// correctly reported
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "gemm failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<32, 2>(tag, true, 67, 35, 300), "posit<32,2>", "gemm");
+
+#else
+
+	cout << "Blocked matrix-matrix multiplication validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<8, 0>(tag, bReportIndividualTestCases, 9, 7, 40), "posit<8,0>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<16, 1>(tag, bReportIndividualTestCases, 33, 6, 70), "posit<16,1>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<32, 2>(tag, bReportIndividualTestCases, 67, 35, 300), "posit<32,2>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<64, 3>(tag, bReportIndividualTestCases, 5, 34, 20), "posit<64,3>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<80, 3>(tag, bReportIndividualTestCases, 5, 6, 7), "posit<80,3>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemmCancellation<32, 2>(tag, bReportIndividualTestCases, 70, 70, 150), "posit<32,2>", "gemm cancellation");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateGemm<32, 2>(tag, bReportIndividualTestCases, 200, 300, 1000), "posit<32,2>", "gemm");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemmCancellation<64, 3>(tag, bReportIndividualTestCases, 70, 70, 500), "posit<64,3>", "gemm cancellation");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
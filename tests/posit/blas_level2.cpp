@@ -0,0 +1,397 @@
+// blas_level2.cpp: validation of the matrix-vector product, the rank-1 update, and the triangular solve against exact references
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+#include "universal/posit/level2.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// products of three posits of up to 32 bits, and their sums, are exact in posit<128,4> and its quire
+		using wide_posit = posit<128, 4>;
+		using wide_quire = quire<128, 4, 30>;
+
+		template<size_t nbits, size_t es>
+		wide_posit Widen(const posit<nbits, es>& p) {
+			static_assert(nbits <= 32, "posits of up to 32 bits convert exactly through double");
+			return wide_posit(double(p));
+		}
+
+		// the exact value of a quire rounded once
+		template<size_t nbits, size_t es, size_t qnbits, size_t qes>
+		posit<nbits, es> Round(const quire<qnbits, qes, 30>& q) {
+			posit<nbits, es> p;
+			convert(q.to_value(), p);
+			return p;
+		}
+
+		// random posits with a spread of exponents
+		template<size_t nbits, size_t es>
+		std::vector< posit<nbits, es> > RandomPosits(std::mt19937_64& generator, size_t size, int emin = -10, int emax = 10) {
+			std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+			std::uniform_int_distribution<int> exponent(emin, emax);
+			std::vector< posit<nbits, es> > v(size);
+			for (posit<nbits, es>& p : v) p = std::ldexp(distribution(generator), exponent(generator));
+			return v;
+		}
+
+		// a rows x cols matrix stored with leading dimension ld
+		inline size_t MatrixStorage(size_t rows, size_t cols, size_t ld, matrix_layout layout) {
+			return (layout == matrix_layout::row_major ? rows : cols) * ld;
+		}
+
+		// the elements between the strided elements of a vector must be untouched
+		template<typename Posit>
+		int CompareGaps(const std::vector<Posit>& v, const std::vector<Posit>& original, size_t inc) {
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < v.size(); ++i) {
+				if (i % inc != 0 && v[i] != original[i]) ++nrOfFailedTests;
+			}
+			return nrOfFailedTests;
+		}
+
+		// alpha * sum of a[j] * x[j] + beta * y rounded once: any alpha through the wide quire
+		template<size_t nbits, size_t es>
+		posit<nbits, es> GemvReference(const posit<nbits, es>& alpha, vector_view<const posit<nbits, es>> a, vector_view<const posit<nbits, es>> x, const posit<nbits, es>& beta, const posit<nbits, es>& y, std::true_type) {
+			wide_quire q;
+			for (size_t j = 0; j < x.size(); ++j) q += Widen(alpha) * Widen(a[j]) * Widen(x[j]);
+			q.fma(Widen(beta), Widen(y));
+			return Round<nbits, es>(q);
+		}
+		// alpha = +-1 through the quire of the posit type
+		template<size_t nbits, size_t es>
+		posit<nbits, es> GemvReference(const posit<nbits, es>& alpha, vector_view<const posit<nbits, es>> a, vector_view<const posit<nbits, es>> x, const posit<nbits, es>& beta, const posit<nbits, es>& y, std::false_type) {
+			quire<nbits, es, 30> q;
+			for (size_t j = 0; j < x.size(); ++j) q.fma(alpha * a[j], x[j]);
+			q.fma(beta, y);
+			return Round<nbits, es>(q);
+		}
+
+		// y = alpha * A * x + beta * y
+		template<size_t nbits, size_t es>
+		int ValidateGemv(const std::string& tag, bool bReportIndividualTestCases, size_t M, size_t N) {
+			using Posit = posit<nbits, es>;
+			constexpr bool wide = (nbits <= 32);
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + M + N));
+			const matrix_layout layouts[] = { matrix_layout::row_major, matrix_layout::column_major };
+			for (matrix_layout layout : layouts) {
+				for (size_t inc : { 1, 3 }) {
+					size_t lda = (layout == matrix_layout::row_major ? N : M) + 2;
+					std::vector<Posit> a = RandomPosits<nbits, es>(generator, MatrixStorage(M, N, lda, layout));
+					std::vector<Posit> x = RandomPosits<nbits, es>(generator, N * inc), y0 = RandomPosits<nbits, es>(generator, M * inc);
+					matrix_view<const Posit> A(a.data(), M, N, lda, layout);
+					vector_view<const Posit> X(x.data(), N, inc);
+					std::vector<Posit> alphas = { Posit(1), Posit(-1) }, betas = { Posit(0), Posit(1), y0[1] };
+					if (wide) alphas.push_back(x[inc]);
+					for (const Posit& alpha : alphas) {
+						for (const Posit& beta : betas) {
+							std::vector<Posit> y(y0);
+							gemv(alpha, A, X, beta, vector_view<Posit>(y.data(), M, inc), 3);
+							for (size_t i = 0; i < M; ++i) {
+								Posit reference = GemvReference(alpha, A.row(i), X, beta, y0[i * inc], std::integral_constant<bool, wide>());
+								if (y[i * inc] != reference) {
+									++nrOfFailedTests;
+									if (bReportIndividualTestCases) std::cout << tag << "alpha " << alpha << " beta " << beta << " y[" << i << "] " << y[i * inc] << " != " << reference << std::endl;
+								}
+							}
+							nrOfFailedTests += CompareGaps(y, y0, inc);
+						}
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// a + alpha * x * y rounded once, through the wide quire or, for alpha = +-1, the quire of the posit type
+		template<size_t nbits, size_t es>
+		posit<nbits, es> GerReference(const posit<nbits, es>& a, const posit<nbits, es>& alpha, const posit<nbits, es>& x, const posit<nbits, es>& y, std::true_type) {
+			wide_quire q;
+			q += Widen(a);
+			q += Widen(alpha) * Widen(x) * Widen(y);
+			return Round<nbits, es>(q);
+		}
+		template<size_t nbits, size_t es>
+		posit<nbits, es> GerReference(const posit<nbits, es>& a, const posit<nbits, es>& alpha, const posit<nbits, es>& x, const posit<nbits, es>& y, std::false_type) {
+			quire<nbits, es, 30> q;
+			q += a;
+			q.fma(alpha * x, y);
+			return Round<nbits, es>(q);
+		}
+
+		// A = A + alpha * x * y^T
+		template<size_t nbits, size_t es>
+		int ValidateGer(const std::string& tag, bool bReportIndividualTestCases, size_t M, size_t N) {
+			using Posit = posit<nbits, es>;
+			constexpr bool wide = (nbits <= 32);
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + M * N));
+			const matrix_layout layouts[] = { matrix_layout::row_major, matrix_layout::column_major };
+			for (matrix_layout layout : layouts) {
+				size_t lda = (layout == matrix_layout::row_major ? N : M) + 1, incx = 2, incy = 1;
+				std::vector<Posit> a0 = RandomPosits<nbits, es>(generator, MatrixStorage(M, N, lda, layout));
+				std::vector<Posit> x = RandomPosits<nbits, es>(generator, M * incx), y = RandomPosits<nbits, es>(generator, N * incy);
+				x[0] = 0;
+				vector_view<const Posit> X(x.data(), M, incx), Y(y.data(), N, incy);
+				std::vector<Posit> alphas = { Posit(1), Posit(-1) };
+				if (wide) alphas.push_back(y[1]);
+				for (const Posit& alpha : alphas) {
+					std::vector<Posit> a(a0);
+					matrix_view<Posit> A(a.data(), M, N, lda, layout);
+					matrix_view<const Posit> A0(a0.data(), M, N, lda, layout);
+					ger(alpha, X, Y, A, 3);
+					for (size_t i = 0; i < M; ++i) {
+						for (size_t j = 0; j < N; ++j) {
+							Posit reference = GerReference(A0(i, j), alpha, X[i], Y[j], std::integral_constant<bool, wide>());
+							if (A(i, j) != reference) {
+								++nrOfFailedTests;
+								if (bReportIndividualTestCases) std::cout << tag << "alpha " << alpha << " A(" << i << ", " << j << ") " << A(i, j) << " != " << reference << std::endl;
+							}
+						}
+					}
+					// the padding beyond the leading dimension is untouched
+					for (size_t k = 0; k < a.size(); ++k) {
+						if (k % lda >= (layout == matrix_layout::row_major ? N : M) && a[k] != a0[k]) ++nrOfFailedTests;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// products far below the elements of A must leave them unchanged, and round to minpos when added to zero
+		template<size_t nbits, size_t es>
+		int ValidateGerExtremes(const std::string& tag, bool bReportIndividualTestCases) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			Posit tiny = minpos<nbits, es>();
+			std::vector<Posit> x = { tiny, -tiny }, y = { tiny, -tiny, tiny };
+			std::vector<Posit> a0 = { Posit(1), Posit(-1), Posit(0), tiny, -tiny, Posit(0) };
+			for (const Posit& alpha : { tiny, -tiny }) {
+				std::vector<Posit> a(a0);
+				ger(alpha, vector_view<const Posit>(x), vector_view<const Posit>(y), matrix_view<Posit>(a.data(), 2, 3), 1);
+				for (size_t k = 0; k < a.size(); ++k) {
+					Posit reference = a0[k];
+					if (reference.iszero()) reference = ((alpha.isneg() != (x[k / 3].isneg() != y[k % 3].isneg())) ? -tiny : tiny);
+					if (a[k] != reference) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "alpha " << alpha << " A(" << k / 3 << ", " << k % 3 << ") " << a[k] << " != " << reference << std::endl;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// b[i] - sum of T(i, j) * x[j] over the solved j - T(i, i) * xi, exactly
+		template<size_t nbits, size_t es>
+		value<quire<nbits, es, 30>::qbits> Residual(matrix_view<const posit<nbits, es>> T, vector_view<const posit<nbits, es>> x, const posit<nbits, es>& b, size_t i, bool lower, const posit<nbits, es>& xi) {
+			quire<nbits, es, 30> q;
+			q += b;
+			size_t n = x.size();
+			for (size_t j = (lower ? 0 : i + 1); j < (lower ? i : n); ++j) q.fma(-T(i, j), x[j]);
+			q.fma(-T(i, i), xi);
+			return sw::unum::abs(q.to_value());
+		}
+
+		// every element of the solution must be the posit nearest to the quotient of its exact numerator and the diagonal,
+		// that is, no neighboring posit may leave a smaller residual
+		template<size_t nbits, size_t es>
+		int ValidateTrsv(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + n));
+			const matrix_layout layouts[] = { matrix_layout::row_major, matrix_layout::column_major };
+			const matrix_triangle triangles[] = { matrix_triangle::lower, matrix_triangle::upper };
+			const matrix_diagonal diagonals[] = { matrix_diagonal::non_unit, matrix_diagonal::unit };
+			for (matrix_layout layout : layouts) {
+				for (matrix_triangle uplo : triangles) {
+					for (matrix_diagonal diag : diagonals) {
+						bool lower = (uplo == matrix_triangle::lower);
+						size_t ld = n + 3, inc = (lower ? 2 : 1);
+						// a dominant diagonal keeps the solution in range
+						std::vector<Posit> t = RandomPosits<nbits, es>(generator, MatrixStorage(n, n, ld, layout), -6, 0);
+						matrix_view<Posit> Tm(t.data(), n, n, ld, layout);
+						std::vector<Posit> d = RandomPosits<nbits, es>(generator, n, 4, 6);
+						for (size_t i = 0; i < n; ++i) Tm(i, i) = (d[i].isneg() ? d[i] - Posit(64) : d[i] + Posit(64));
+						// the other triangle holds NaR, which must not be read
+						for (size_t i = 0; i < n; ++i) {
+							for (size_t j = 0; j < n; ++j) if (lower ? j > i : j < i) Tm(i, j).setnar();
+						}
+						if (diag == matrix_diagonal::unit) {
+							for (size_t i = 0; i < n; ++i) Tm(i, i).setnar();
+						}
+						std::vector<Posit> b = RandomPosits<nbits, es>(generator, n * inc), x(b);
+						matrix_view<const Posit> T(Tm);
+						trsv(uplo, diag, T, vector_view<Posit>(x.data(), n, inc), 3);
+						vector_view<const Posit> X(x.data(), n, inc);
+						for (size_t i = 0; i < n; ++i) {
+							bool nearest = true;
+							if (diag == matrix_diagonal::unit) {
+								quire<nbits, es, 30> q;
+								q += b[i * inc];
+								for (size_t j = (lower ? 0 : i + 1); j < (lower ? i : n); ++j) q.fma(-T(i, j), X[j]);
+								nearest = (X[i] == Round<nbits, es>(q));
+							}
+							else {
+								auto r = Residual<nbits, es>(T, X, b[i * inc], i, lower, X[i]);
+								Posit below(X[i]), above(X[i]);
+								--below;
+								++above;
+								if (!below.isnar() && !below.iszero() && Residual<nbits, es>(T, X, b[i * inc], i, lower, below) < r) nearest = false;
+								if (!above.isnar() && !above.iszero() && Residual<nbits, es>(T, X, b[i * inc], i, lower, above) < r) nearest = false;
+							}
+							if (!nearest) {
+								++nrOfFailedTests;
+								if (bReportIndividualTestCases) std::cout << tag << (lower ? "lower " : "upper ") << "x[" << i << "] " << X[i] << " is not the nearest posit" << std::endl;
+							}
+						}
+						nrOfFailedTests += CompareGaps(x, b, inc);
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// large problems split their rows across threads, and the results must not depend on the number of threads
+		template<size_t nbits, size_t es>
+		int ValidateThreads(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits + es + n));
+			std::vector<Posit> a = RandomPosits<nbits, es>(generator, n * n, -6, 0), x = RandomPosits<nbits, es>(generator, n), y = RandomPosits<nbits, es>(generator, n);
+			for (size_t i = 0; i < n; ++i) a[i * n + i] = (a[i * n + i].isneg() ? Posit(-64) : Posit(64));
+			const matrix_layout layouts[] = { matrix_layout::row_major, matrix_layout::column_major };
+			for (matrix_layout layout : layouts) {
+				matrix_view<const Posit> A(a.data(), n, n, layout);
+				std::vector<Posit> y1(y), b1(x), a1(a);
+				gemv(x[0], A, vector_view<const Posit>(x), y[0], vector_view<Posit>(y1), 1);
+				ger(x[1], vector_view<const Posit>(x), vector_view<const Posit>(y), matrix_view<Posit>(a1.data(), n, n, layout), 1);
+				trsv(matrix_triangle::lower, matrix_diagonal::non_unit, A, vector_view<Posit>(b1), 1);
+				for (size_t nrOfThreads : { 2, 4, 7 }) {
+					std::vector<Posit> yt(y), bt(x), at(a);
+					gemv(x[0], A, vector_view<const Posit>(x), y[0], vector_view<Posit>(yt), nrOfThreads);
+					ger(x[1], vector_view<const Posit>(x), vector_view<const Posit>(y), matrix_view<Posit>(at.data(), n, n, layout), nrOfThreads);
+					trsv(matrix_triangle::lower, matrix_diagonal::non_unit, A, vector_view<Posit>(bt), nrOfThreads);
+					if (yt != y1 || at != a1 || bt != b1) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << nrOfThreads << " threads give a different result" << std::endl;
+					}
+				}
+			}
+			// a NaR in the part of a worker thread must surface in the calling thread
+			a.back().setnar();
+			try {
+				gemv(Posit(1), matrix_view<const Posit>(a.data(), n, n), vector_view<const Posit>(x), Posit(0), vector_view<Posit>(y), 4);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "NaR operand not reported" << std::endl;
+			}
+			catch (const operand_is_nar&) {
+				// correctly reported
+			}
+			// a zero on the diagonal
+			a.back() = 64;
+			a[(n / 2) * n + n / 2] = 0;
+			try {
+				trsv(matrix_triangle::upper, matrix_diagonal::non_unit, matrix_view<const Posit>(a.data(), n, n), vector_view<Posit>(x), 4);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "division by zero not reported" << std::endl;
+			}
+			catch (const divide_by_zero&) {
+				// correctly reported
+			}
+			// mismatched dimensions
+			try {
+				gemv(Posit(1), matrix_view<const Posit>(a.data(), n, n - 1), vector_view<const Posit>(x), Posit(0), vector_view<Posit>(y), 1);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "dimension mismatch not reported" << std::endl;
+			}
+			catch (const std::invalid_argument&) {
+				// correctly reported
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "level 2 failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<32, 2>(tag, true, 37, 70), "posit<32,2>", "gemv");
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<32, 2>(tag, true, 70), "posit<32,2>", "trsv");
+
+#else
+
+	cout << "BLAS level 2 validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<16, 1>(tag, bReportIndividualTestCases, 70, 33), "posit<16,1>", "gemv");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<32, 2>(tag, bReportIndividualTestCases, 37, 70), "posit<32,2>", "gemv");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<64, 3>(tag, bReportIndividualTestCases, 70, 20), "posit<64,3>", "gemv");
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<80, 3>(tag, bReportIndividualTestCases, 9, 7), "posit<80,3>", "gemv");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateGer<16, 1>(tag, bReportIndividualTestCases, 20, 13), "posit<16,1>", "ger");
+	nrOfFailedTestCases += ReportTestResult(ValidateGer<32, 2>(tag, bReportIndividualTestCases, 13, 20), "posit<32,2>", "ger");
+	nrOfFailedTestCases += ReportTestResult(ValidateGer<64, 3>(tag, bReportIndividualTestCases, 20, 13), "posit<64,3>", "ger");
+	nrOfFailedTestCases += ReportTestResult(ValidateGer<80, 3>(tag, bReportIndividualTestCases, 7, 9), "posit<80,3>", "ger");
+	nrOfFailedTestCases += ReportTestResult(ValidateGerExtremes<32, 2>(tag, bReportIndividualTestCases), "posit<32,2>", "ger extremes");
+	nrOfFailedTestCases += ReportTestResult(ValidateGerExtremes<64, 3>(tag, bReportIndividualTestCases), "posit<64,3>", "ger extremes");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<16, 1>(tag, bReportIndividualTestCases, 70), "posit<16,1>", "trsv");
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<32, 2>(tag, bReportIndividualTestCases, 150), "posit<32,2>", "trsv");
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<64, 3>(tag, bReportIndividualTestCases, 70), "posit<64,3>", "trsv");
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<80, 3>(tag, bReportIndividualTestCases, 20), "posit<80,3>", "trsv");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateThreads<32, 2>(tag, bReportIndividualTestCases, 1100), "posit<32,2>", "level 2 threads");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateGemv<32, 2>(tag, bReportIndividualTestCases, 300, 500), "posit<32,2>", "gemv");
+	nrOfFailedTestCases += ReportTestResult(ValidateTrsv<64, 3>(tag, bReportIndividualTestCases, 400), "posit<64,3>", "trsv");
+	nrOfFailedTestCases += ReportTestResult(ValidateThreads<64, 3>(tag, bReportIndividualTestCases, 2500), "posit<64,3>", "level 2 threads");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,237 @@
+// decimal_format.cpp: functional tests for the exact decimal formatting of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <cstdio>
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// the shortest representation must read back as the same posit, and no shorter digit string may do so.
+		// long double holds the value of any posit up to 32 bits exactly, so strtold is an exact reference for them
+		template<size_t nbits, size_t es>
+		int ValidateShortestRoundTrip(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << (nbits < 20 ? nbits : 20));
+			std::mt19937_64 rng(nbits * 7 + es);
+			int nrOfFailedTests = 0;
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS;
+			posit<nbits, es> p, q;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				p.set_raw_bits(nrOfRandoms ? rng() : i);
+				char buffer[max_decimal_chars<nbits, es>()];
+				char* end = to_chars(buffer, buffer + sizeof(buffer), p);
+				if (end == nullptr) {
+					++nrOfFailedTests;
+					continue;
+				}
+				std::string txt(buffer, end);
+				if (p.isnar()) {
+					if (txt != "nar") ++nrOfFailedTests;
+					continue;
+				}
+				q = std::strtold(txt.c_str(), nullptr);
+				bool fail = (p != q);
+				// neither neighbor with one significant digit less may read back as the same posit
+				std::string digits;
+				for (char c : txt) {
+					if (c == 'e') break;
+					if (c >= '0' && c <= '9' && !(digits.empty() && c == '0')) digits += c;
+				}
+				while (!digits.empty() && digits.back() == '0') digits.pop_back();
+				if (!fail && digits.size() > 1) {
+					int x = 0;
+					std::sscanf(std::string(txt).c_str() + (p.isneg() ? 1 : 0), "%*[0-9.]e%d", &x);
+					if (txt.find('e') == std::string::npos) {
+						long double v = std::fabs((long double)p);
+						x = int(std::floor(std::log10(v)));
+					}
+					unsigned long long lead = std::stoull(digits.substr(0, digits.size() - 1));
+					for (unsigned long long candidate : { lead, lead + 1 }) {
+						long double v = (long double)candidate * std::pow(10.0l, (long double)(x - int(digits.size()) + 2));
+						posit<nbits, es> r;
+						r = (p.isneg() ? -v : v);
+						if (r == p) fail = true;
+					}
+				}
+				if (fail) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << hex_format(p) << " " << txt << " reads back as " << hex_format(q) << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the stream operator must format the exact value like the C library formats the same long double
+		template<size_t nbits, size_t es>
+		int ValidateStreamFormat(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << (nbits < 16 ? nbits : 16));
+			std::mt19937_64 rng(nbits * 11 + es);
+			int nrOfFailedTests = 0;
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS;
+			const std::ios_base::fmtflags formats[] = {
+				std::ios_base::fmtflags(0),
+				std::ios_base::fixed,
+				std::ios_base::scientific,
+				std::ios_base::showpos | std::ios_base::uppercase | std::ios_base::scientific,
+				std::ios_base::showpoint | std::ios_base::fixed,
+			};
+			// a precision past the exact digits of the posit pads with zeros
+			const int precisions[] = { 0, 1, 3, 6, 12, 60 };
+			posit<nbits, es> p;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				p.set_raw_bits(nrOfRandoms ? rng() : i);
+				if (p.isnar()) continue;
+				// the text is padded to the width of the stream on either side
+				std::ios_base::fmtflags adjust = ((i & 0x1) ? std::ios_base::left : std::ios_base::right);
+				for (std::ios_base::fmtflags format : formats) {
+					for (int precision : precisions) {
+						std::streamsize width = (precision == 3 ? 20 : 0);
+						std::stringstream s1, s2;
+						s1.flags(format | adjust);
+						s2.flags(format | adjust);
+						s1 << std::setfill('*') << std::setprecision(precision) << std::setw(width) << p;
+						s2 << std::setfill('*') << std::setprecision(precision) << std::setw(width) << (long double)p;
+						if (s1.str() != s2.str()) {
+							++nrOfFailedTests;
+							if (bReportIndividualTestCases) std::cout << tag << hex_format(p) << " " << s1.str() << " reference " << s2.str() << std::endl;
+						}
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// a posit wider than long double must print all the digits of a double it holds exactly: near 1.0 both posits have more than 53 bits of precision
+		template<size_t nbits, size_t es>
+		int ValidateWideFormat(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 rng(nbits + es);
+			std::uniform_real_distribution<double> distribution(-64.0, 64.0);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				double d = std::ldexp(distribution(rng), int(rng() % 80) - 40);
+				posit<nbits, es> p(d);
+				char reference[128];
+				std::snprintf(reference, sizeof(reference), "%.40g", d);
+				std::stringstream ss;
+				ss << std::setprecision(40) << p;
+				// the shortest representation must fit in the buffer bound
+				char buffer[max_decimal_chars<nbits, es>()];
+				char* end = to_chars(buffer, buffer + sizeof(buffer), p);
+				if (ss.str() != reference || end == nullptr) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << hex_format(p) << " " << ss.str() << " reference " << reference << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// spot checks of the layout of the shortest representation
+		int ValidateShortestLayout(const std::string& tag, bool bReportIndividualTestCases) {
+			struct sample { double value; const char* txt; };
+			const sample samples[] = {
+				{ 0.0, "0" }, { 1.0, "1" }, { -2.0, "-2" }, { 0.5, "0.5" }, { 0.1, "0.1" }, { 1.0e-5, "1e-05" },
+				{ 1024.0, "1024" }, { -3.75, "-3.75" }, { 1.0e17, "1e+17" }, { 0.00015, "0.00015" },
+			};
+			int nrOfFailedTests = 0;
+			for (const sample& s : samples) {
+				posit<32, 2> p(s.value);
+				char buffer[max_decimal_chars<32, 2>()];
+				char* end = to_chars(buffer, buffer + sizeof(buffer), p);
+				std::string txt(buffer, end != nullptr ? end : buffer);
+				if (txt != s.txt) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << s.value << " " << txt << " expected " << s.txt << std::endl;
+				}
+			}
+			// a buffer that is too small is reported, and nothing is written past its end
+			char small[4] = { 'x', 'x', 'x', 'x' };
+			if (to_chars(small, small + 3, posit<32, 2>(-3.75)) != nullptr || small[3] != 'x') ++nrOfFailedTests;
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "decimal format failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip<16, 1>(tag, true), "posit<16,1>", "shortest round trip");
+
+#else
+
+	cout << "Posit decimal format validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestLayout(tag, bReportIndividualTestCases), "posit<32,2>", "shortest layout");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip< 5, 3>(tag, bReportIndividualTestCases), "posit< 5,3>", "shortest round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "shortest round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip< 8, 2>(tag, bReportIndividualTestCases), "posit< 8,2>", "shortest round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "shortest round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip<32, 2>(tag, bReportIndividualTestCases, 100000), "posit<32,2>", "shortest round trip");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateStreamFormat< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "stream format");
+	nrOfFailedTestCases += ReportTestResult(ValidateStreamFormat<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "stream format");
+	nrOfFailedTestCases += ReportTestResult(ValidateStreamFormat<32, 2>(tag, bReportIndividualTestCases, 10000), "posit<32,2>", "stream format");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateWideFormat< 80, 2>(tag, bReportIndividualTestCases, 1000), "posit< 80,2>", "wide format");
+	nrOfFailedTestCases += ReportTestResult(ValidateWideFormat<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "wide format");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateShortestRoundTrip<20, 1>(tag, bReportIndividualTestCases), "posit<20,1>", "shortest round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateStreamFormat<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "stream format");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
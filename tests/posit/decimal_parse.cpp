@@ -0,0 +1,253 @@
+// decimal_parse.cpp: functional tests for parsing decimal text into posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// set the encoding of a posit from random limbs, or from the index when enumerating
+		template<size_t nbits, size_t es>
+		void SetPattern(posit<nbits, es>& p, std::mt19937_64& rng, size_t i, bool random) {
+			constexpr size_t nlimbs = nr_limbs(nbits);
+			uint64_t raw[nlimbs];
+			for (size_t j = 0; j < nlimbs; ++j) raw[j] = (random ? rng() : (j == 0 ? uint64_t(i) : 0));
+			if (nbits % 64) raw[nlimbs - 1] &= (~uint64_t(0)) >> (64 - nbits % 64);
+			bitblock<nbits> bits;
+			limbs_to_bitset<nbits, nlimbs>(raw, bits);
+			p.set(bits);
+		}
+
+		// the shortest decimal text and the hexadecimal posit format must both read back as the same posit
+		template<size_t nbits, size_t es>
+		int ValidateRoundTrip(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << (nbits < 20 ? nbits : 20));
+			std::mt19937_64 rng(nbits * 13 + es);
+			int nrOfFailedTests = 0;
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS;
+			posit<nbits, es> p, q, r;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				SetPattern(p, rng, i, nrOfRandoms != 0);
+				char buffer[max_decimal_chars<nbits, es>()];
+				char* end = to_chars(buffer, buffer + sizeof(buffer), p);
+				bool ok = (end != nullptr) && parse(buffer, size_t(end - buffer), q) && (p == q || (p.isnar() && q.isnar()));
+				std::string hex = hex_format(p);
+				ok = ok && parse(hex, r) && (p.get() == r.get());
+				if (!ok) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << hex << " reads back as " << hex_format(q) << " and " << hex_format(r) << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the hard cases of correct rounding: the exact decimal value of the midpoint between two posits rounds to
+		// the even encoding, and a digit far beyond the precision of the posit above or below it decides the rounding.
+		// The midpoints are the posits of nbits+1 bits with an odd encoding.
+		template<size_t nbits, size_t es>
+		int ValidateMidpoints(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << (nbits < 20 ? nbits : 20));
+			std::mt19937_64 rng(nbits * 17 + es);
+			int nrOfFailedTests = 0;
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS / 2;
+			posit<nbits + 1, es> midpoint;
+			posit<nbits, es> lower, upper, p;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				SetPattern(midpoint, rng, 2 * i + 1, nrOfRandoms != 0);
+				bitblock<nbits + 1> m = midpoint.get();
+				m[0] = true;
+				m[nbits] = false;
+				midpoint.set(m);
+				// the neighbors are the encodings around the midpoint: anything in between zero and minpos rounds to minpos,
+				// anything beyond maxpos rounds to maxpos
+				bitblock<nbits> l;
+				for (size_t b = 0; b < nbits; ++b) l[b] = m[b + 1];
+				lower.set(l);
+				upper = lower;
+				++upper;
+				if (lower.iszero()) lower = upper;
+				if (upper.isnar()) upper = lower;
+				posit<nbits, es> even = (lower.get()[0] ? upper : lower);
+
+				// the exact digits of the midpoint
+				std::string digits = to_decimal_string(midpoint, std::ios_base::scientific, 1200);
+				size_t e = digits.find('e');
+				std::string mantissa = digits.substr(0, e), exponent = digits.substr(e);
+				while (mantissa.back() == '0') mantissa.pop_back();
+				if (mantissa.back() == '.') mantissa.pop_back();
+				// just below the midpoint: decrement the last digit and append nines
+				std::string below = mantissa;
+				size_t last = below.size() - 1;
+				while (below[last] == '0' || below[last] == '.') {
+					if (below[last] == '0') below[last] = '9';
+					--last;
+				}
+				--below[last];
+				if (below.find('.') == std::string::npos) below += '.';
+				below += "99999999999999999999";
+				std::string above = mantissa + (mantissa.find('.') == std::string::npos ? "." : "") + "00000000000000000001";
+
+				struct sample { std::string txt; posit<nbits, es> expected; };
+				const sample samples[] = {
+					{ mantissa + exponent, even },
+					{ below + exponent, lower },
+					{ above + exponent, upper },
+					{ "-" + mantissa + exponent, -even },
+					{ "-" + below + exponent, -lower },
+					{ "-" + above + exponent, -upper },
+				};
+				for (const sample& s : samples) {
+					if (!parse(s.txt.data(), s.txt.size(), p) || p != s.expected) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << s.txt << " reads as " << hex_format(p) << " expected " << hex_format(s.expected) << std::endl;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// spot checks of the grammar
+		int ValidateLiterals(const std::string& tag, bool bReportIndividualTestCases) {
+			using Posit = posit<32, 2>;
+			Posit maxpos = sw::unum::maxpos<32, 2>(), minpos = sw::unum::minpos<32, 2>(), nar;
+			nar.setnar();
+			struct sample { const char* txt; Posit expected; };
+			const sample samples[] = {
+				{ "1", Posit(1) }, { "-2.5", Posit(-2.5) }, { "  3e2 ", Posit(300) }, { "1E-5", Posit(1.0e-5) }, { ".5", Posit(0.5) },
+				{ "5.", Posit(5) }, { "+0.125", Posit(0.125) }, { "0", Posit(0) }, { "-0.0e10", Posit(0) }, { "000012.5000", Posit(12.5) },
+				{ "nar", nar }, { "NaR", nar }, { "-nan", nar }, { "inf", nar }, { "-Infinity", nar },
+				{ "32.2x40000000p", Posit(1) }, { "32.2xc0000000", Posit(-1) }, { "64.2x4000000000000000p", Posit(1) },
+				{ "1e100000", maxpos }, { "-1e999999999999", -maxpos }, { "1e-100000", minpos },
+				{ "0.1", Posit(0.1) }, { "3.14159265358979323846264338327950288", Posit(3.14159265358979323846) },
+			};
+			int nrOfFailedTests = 0;
+			Posit p;
+			for (const sample& s : samples) {
+				if (!parse(s.txt, std::strlen(s.txt), p) || p.get() != s.expected.get()) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << s.txt << " reads as " << hex_format(p) << " expected " << hex_format(s.expected) << std::endl;
+				}
+			}
+			// malformed text is rejected and leaves the posit unchanged
+			const char* malformed[] = { "", " ", "abc", "1.2.3", "e5", "-", ".", "1e", "1e+", "0x10", "12 34", "nary", "32.2x" };
+			for (const char* txt : malformed) {
+				p = 7;
+				if (parse(txt, std::strlen(txt), p) || p != Posit(7)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "-" << txt << "- is not a number" << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// bulk parsing of separated values
+		int ValidateParseMany(const std::string& tag, bool bReportIndividualTestCases) {
+			using Posit = posit<16, 1>;
+			int nrOfFailedTests = 0;
+			Posit values[8];
+			const std::string csv = "1, 2.5\n-3e1,,nar\r\n16.1x4000p\n";
+			const Posit expected[] = { Posit(1), Posit(2.5), Posit(-30), Posit(0), Posit(1) };
+			const char* stop = nullptr;
+			size_t n = parse_many(csv.data(), csv.size(), values, 8, &stop);
+			if (n != 5 || stop != csv.data() + csv.size()) ++nrOfFailedTests;
+			for (size_t i = 0; i < 5 && i < n; ++i) {
+				if (i == 3 ? !values[i].isnar() : values[i] != expected[i]) ++nrOfFailedTests;
+			}
+			// parsing stops at the first field that is not a number
+			const std::string bad = "1,2,abc,4";
+			n = parse_many(bad.data(), bad.size(), values, 8, &stop);
+			if (n != 2 || stop != bad.data() + 4) ++nrOfFailedTests;
+			// and at the capacity
+			n = parse_many(csv.data(), csv.size(), values, 2, &stop);
+			if (n != 2 || values[1] != Posit(2.5)) ++nrOfFailedTests;
+			if (nrOfFailedTests > 0 && bReportIndividualTestCases) std::cout << tag << "parse_many" << std::endl;
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "decimal parse failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints<8, 0>(tag, true), "posit<8,0>", "midpoints");
+
+#else
+
+	cout << "Posit decimal parse validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLiterals(tag, bReportIndividualTestCases), "posit<32,2>", "literals");
+	nrOfFailedTestCases += ReportTestResult(ValidateParseMany(tag, bReportIndividualTestCases), "posit<16,1>", "parse_many");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip<  8, 0>(tag, bReportIndividualTestCases), "posit<  8,0>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip< 12, 1>(tag, bReportIndividualTestCases), "posit< 12,1>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip< 32, 2>(tag, bReportIndividualTestCases, 10000), "posit< 32,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip< 64, 3>(tag, bReportIndividualTestCases, 10000), "posit< 64,3>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "round trip");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints<  8, 0>(tag, bReportIndividualTestCases), "posit<  8,0>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints<  8, 2>(tag, bReportIndividualTestCases), "posit<  8,2>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints< 16, 1>(tag, bReportIndividualTestCases), "posit< 16,1>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints< 32, 2>(tag, bReportIndividualTestCases, 2000), "posit< 32,2>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints< 64, 3>(tag, bReportIndividualTestCases, 1000), "posit< 64,3>", "midpoints");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints<128, 4>(tag, bReportIndividualTestCases, 200), "posit<128,4>", "midpoints");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip<20, 1>(tag, bReportIndividualTestCases), "posit<20,1>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateMidpoints<20, 1>(tag, bReportIndividualTestCases), "posit<20,1>", "midpoints");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+// function_tables.cpp: exhaustive tests of the tabulated math functions against the directly computed functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <algorithm>
+#include <cstdio>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/math_functions.hpp"
+#include "universal/posit/math/function_tables.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// compare a tabulated function to the function it tabulates over all posits
+		template<size_t nbits, size_t es, typename Tabulated, typename Function>
+		int ValidateTabulatedFunction(const std::string& tag, bool bReportIndividualTestCases, const char* name, Tabulated t, Function f) {
+			constexpr size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> x, result, reference;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				x.set_raw_bits(i);
+				result = t(x);
+				reference = f(x);
+				if (result != reference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << name << "(" << x << ") = " << result << " reference " << reference << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		template<size_t nbits, size_t es>
+		int ValidateFunctionTables(const std::string& tag, bool bReportIndividualTestCases) {
+			using Posit = posit<nbits, es>;
+			int nrOfFailedTests = 0;
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "exp", [](Posit x) { return tabulated::exp(x); }, [](Posit x) { return exp(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "log", [](Posit x) { return tabulated::log(x); }, [](Posit x) { return log(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "log2", [](Posit x) { return tabulated::log2(x); }, [](Posit x) { return log2(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "sin", [](Posit x) { return tabulated::sin(x); }, [](Posit x) { return sin(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "cos", [](Posit x) { return tabulated::cos(x); }, [](Posit x) { return cos(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "tanh", [](Posit x) { return tabulated::tanh(x); }, [](Posit x) { return tanh(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "sqrt", [](Posit x) { return tabulated::sqrt(x); }, [](Posit x) { return sqrt(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "rsqrt", [](Posit x) { return tabulated::rsqrt(x); }, [](Posit x) { return rsqrt(x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "reciprocal", [](Posit x) { return tabulated::reciprocal(x); }, [](Posit x) { return (x.iszero() || x.isnar() ? Posit(NAR) : Posit(1) / x); });
+			nrOfFailedTests += ValidateTabulatedFunction<nbits, es>(tag, bReportIndividualTestCases, "sigmoid", [](Posit x) { return tabulated::sigmoid(x); }, [](Posit x) { return sigmoid(x); });
+			return nrOfFailedTests;
+		}
+
+		// tables written to a file and mapped back must serve the same results, and a second map must
+		// fail because the mapped tables are in use
+		template<size_t nbits, size_t es>
+		int ValidateFunctionTableFile(const std::string& tag, bool bReportIndividualTestCases) {
+			using tables = posit_function_tables<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::string filename = "posit_functions_" + std::to_string(nbits) + "_" + std::to_string(es) + ".bin";
+			if (!tables::save(filename) || !tables::map(filename) || !tables::mapped()) {
+				if (bReportIndividualTestCases) std::cout << tag << "unable to save and map " << filename << std::endl;
+				std::remove(filename.c_str());
+				return 1;
+			}
+			nrOfFailedTests += ValidateFunctionTables<nbits, es>(tag, bReportIndividualTestCases);
+			if (tables::map(filename)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "mapped over tables in use" << std::endl;
+			}
+			std::remove(filename.c_str());
+			return nrOfFailedTests;
+		}
+
+		// tables published by a lookup are not replaced by a mapped file
+		template<size_t nbits, size_t es>
+		int ValidatePublishedTables(const std::string& tag, bool bReportIndividualTestCases) {
+			using tables = posit_function_tables<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::string filename = "posit_functions_" + std::to_string(nbits) + "_" + std::to_string(es) + ".bin";
+			const typename tables::storage_t* exp = tables::table(posit_function::exp);
+			if (!tables::save(filename)) return 1;
+			if (tables::map(filename) || tables::mapped() || tables::table(posit_function::exp) != exp) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "published tables were replaced" << std::endl;
+			}
+			std::remove(filename.c_str());
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Function tables failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTables<8, 0>(tag, true), "posit<8,0>", "function tables");
+
+#else
+
+	cout << "Posit function table validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTables<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "function tables");
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTables<8, 1>(tag, bReportIndividualTestCases), "posit<8,1>", "function tables");
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTables<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "function tables");
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTables<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "function tables");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTableFile<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "function table file");
+	nrOfFailedTestCases += ReportTestResult(ValidatePublishedTables<8, 1>(tag, bReportIndividualTestCases), "posit<8,1>", "published function tables");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateFunctionTableFile<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "function table file");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
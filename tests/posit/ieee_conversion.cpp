@@ -0,0 +1,261 @@
+// ieee_conversion.cpp: functional tests for the bit level conversions between IEEE-754 floating-point and posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// bit patterns that cover the binades, the subnormals, and the special values of an IEEE-754 type
+		template<typename Real>
+		Real RandomIeee(std::mt19937_64& rng) {
+			using layout = ieee754_layout<Real>;
+			typename layout::bits_t raw = typename layout::bits_t(rng());
+			switch (rng() % 8) {
+			case 0:   // subnormals
+				raw &= (typename layout::bits_t(1) << layout::fbits) - 1;
+				break;
+			case 1:   // short significands that round to a tie
+				raw &= ~((typename layout::bits_t(1) << (layout::fbits - 4)) - 1);
+				break;
+			case 2:   // around 1.0
+				raw = typename layout::bits_t((raw & ((typename layout::bits_t(1) << (layout::fbits + 3)) - 1)) | (typename layout::bits_t(layout::bias - 4) << layout::fbits));
+				break;
+			default:
+				break;
+			}
+			Real v = 0;
+			std::memcpy(&v, &raw, sizeof(Real));
+			return v;
+		}
+
+		// assignment from an IEEE-754 value must round like the value<> reference conversion
+		template<size_t nbits, size_t es, typename Real>
+		int ValidateFromIeee(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			constexpr int dfbits = std::numeric_limits<Real>::digits - 1;
+			std::mt19937_64 rng(nbits * 31 + es);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				Real x = RandomIeee<Real>(rng);
+				posit<nbits, es> p(x), ref;
+				value<dfbits> v(x);
+				if (v.isinf() || v.isnan()) {
+					ref.setnar();
+				}
+				else if (!v.iszero()) {
+					convert(v, ref);
+				}
+				if (p != ref) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << x << " " << hex_format(p) << " reference " << hex_format(ref) << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// a posit that is exact in double must convert exactly, and rounding it to float must match rounding the double
+		template<size_t nbits, size_t es>
+		int ValidateToIeee(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << (nbits < 20 ? nbits : 20));
+			std::mt19937_64 rng(nbits * 17 + es);
+			int nrOfFailedTests = 0;
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS;
+			posit<nbits, es> p;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				p.set_raw_bits(nrOfRandoms ? rng() : i);
+				if (p.isnar()) {
+					if (!std::isnan(double(p)) || !std::isnan(float(p))) ++nrOfFailedTests;
+					continue;
+				}
+				double d = double(p);
+				if (posit<nbits, es>(d) != p) {
+					// only posits with more precision than a double may round
+					if (nbits < 56) ++nrOfFailedTests;
+					continue;
+				}
+				float f = float(p);
+				if (f != float(d) && !(std::isnan(f) && std::isnan(d))) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << hex_format(p) << " " << f << " reference " << float(d) << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// a double must survive the round trip through a posit with more precision than the double across its dynamic range
+		template<size_t nbits, size_t es>
+		int ValidateRoundTrip(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 rng(nbits + es);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				double x = RandomIeee<double>(rng);
+				if (std::isnan(x) || std::isinf(x)) continue;
+				double y = double(posit<nbits, es>(x));
+				if (x != y) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << x << " round trip " << y << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// rounding onto the subnormals, onto infinity, and ties to even
+		int ValidateIeeeRounding(const std::string& tag, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			const uint64_t hidden = uint64_t(1) << 63;
+			// 1 + 2^-53 is a tie between 1 and 1 + 2^-52: even is 1
+			nrOfFailedTests += (ieee754_round<double>(false, 0, hidden | (uint64_t(1) << 10), false) != 1.0);
+			// with a sticky bit it rounds up
+			nrOfFailedTests += (ieee754_round<double>(false, 0, hidden | (uint64_t(1) << 10), true) != 1.0 + std::ldexp(1.0, -52));
+			// the significand carries into the next binade
+			nrOfFailedTests += (ieee754_round<double>(true, 3, ~uint64_t(0), false) != -16.0);
+			// 2^1024 overflows to infinity, the largest normal rounded up does too
+			nrOfFailedTests += (ieee754_round<double>(false, 1024, hidden, false) != std::numeric_limits<double>::infinity());
+			nrOfFailedTests += (ieee754_round<double>(false, 1023, ~uint64_t(0), false) != std::numeric_limits<double>::infinity());
+			// 3 * 2^-1076 rounds to 2^-1074 * (1 or 2): 0.75 of the smallest subnormal rounds to it
+			nrOfFailedTests += (ieee754_round<double>(false, -1075, hidden | (hidden >> 1), false) != std::ldexp(1.0, -1074));
+			// half the smallest subnormal is a tie to zero, above half rounds up
+			nrOfFailedTests += (ieee754_round<double>(false, -1075, hidden, false) != 0.0);
+			nrOfFailedTests += (ieee754_round<double>(false, -1075, hidden, true) != std::ldexp(1.0, -1074));
+			// the largest subnormal rounds up to the smallest normal
+			nrOfFailedTests += (ieee754_round<double>(false, -1023, ~uint64_t(0), false) != std::numeric_limits<double>::min());
+			nrOfFailedTests += (ieee754_round<float>(false, -127, ~uint64_t(0), false) != std::numeric_limits<float>::min());
+			// decomposing a subnormal normalizes it
+			bool sign = false, sticky = false;
+			int scale = 0;
+			uint64_t sig = 0;
+			ieee754_decompose(std::ldexp(3.0, -1074), sign, scale, sig, sticky);
+			nrOfFailedTests += (scale != -1073 || sig != (hidden | (hidden >> 1)));
+			if (nrOfFailedTests && bReportIndividualTestCases) std::cout << tag << "IEEE-754 rounding" << std::endl;
+			return nrOfFailedTests;
+		}
+
+		// the integer rounding that composes long double must round like the bit level rounding: checked on double,
+		// whose layout both can handle, and on the leading limbs of a two limb significand in long double
+		int ValidateComposedRounding(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(1);
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				bool sign = (generator() & 0x1) != 0;
+				int scale = int(generator() % 2200) - 1100;   // through the subnormals and past the overflow
+				uint64_t hi = generator() | (uint64_t(1) << 63);
+				// sparse low bits exercise the ties
+				if (generator() & 0x1) hi &= ~((uint64_t(1) << (generator() % 64)) - 1);
+				uint64_t lo = (generator() & 0x1) ? generator() : 0;
+				bool sticky = (generator() % 4) == 0;
+				double bitlevel = ieee754_round<double>(sign, scale, hi, sticky || lo != 0);
+				double composed = ieee754_compose<double>(sign, scale, hi, lo, sticky);
+				if (bitlevel != composed && !(bitlevel != bitlevel && composed != composed)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "compose " << sign << " " << scale << " " << std::hex << hi << " " << lo << std::dec << " " << composed << " bit level " << bitlevel << std::endl;
+				}
+			}
+			if (std::numeric_limits<long double>::digits == 64) {
+				const uint64_t hidden = uint64_t(1) << 63;
+				const long double ulp = std::ldexp(1.0l, -63);
+				// the guard bit is the leading bit of the second limb: ties go to even, limbs below break the tie
+				nrOfFailedTests += (ieee754_compose<long double>(false, 0, hidden | 1, hidden, false) != 1.0l + 2 * ulp);
+				nrOfFailedTests += (ieee754_compose<long double>(false, 0, hidden | 2, hidden, false) != 1.0l + 2 * ulp);
+				nrOfFailedTests += (ieee754_compose<long double>(false, 0, hidden | 2, hidden, true) != 1.0l + 3 * ulp);
+				nrOfFailedTests += (ieee754_compose<long double>(false, 0, hidden | 2, hidden - 1, true) != 1.0l + 2 * ulp);
+				nrOfFailedTests += (ieee754_compose<long double>(true, 0, ~uint64_t(0), hidden, false) != -2.0l);
+			}
+			if (nrOfFailedTests && bReportIndividualTestCases) std::cout << tag << "composed rounding" << std::endl;
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "IEEE conversion failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<16, 1, double>(tag, true, 1000), "posit<16,1>", "from double");
+
+#else
+
+	cout << "Posit IEEE-754 conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateIeeeRounding(tag, bReportIndividualTestCases), "ieee754", "rounding");
+	nrOfFailedTestCases += ReportTestResult(ValidateComposedRounding(tag, bReportIndividualTestCases, 1000000), "ieee754", "composed rounding");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee< 3, 1, double>(tag, bReportIndividualTestCases, 10000), "posit< 3,1>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee< 8, 0, float >(tag, bReportIndividualTestCases, 10000), "posit< 8,0>", "from float");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee< 8, 0, double>(tag, bReportIndividualTestCases, 10000), "posit< 8,0>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<12, 4, double>(tag, bReportIndividualTestCases, 10000), "posit<12,4>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<16, 1, float >(tag, bReportIndividualTestCases, 10000), "posit<16,1>", "from float");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<16, 1, double>(tag, bReportIndividualTestCases, 10000), "posit<16,1>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<32, 2, float >(tag, bReportIndividualTestCases, 10000), "posit<32,2>", "from float");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<32, 2, double>(tag, bReportIndividualTestCases, 10000), "posit<32,2>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<64, 3, double>(tag, bReportIndividualTestCases, 10000), "posit<64,3>", "from double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<80, 3, double>(tag, bReportIndividualTestCases, 1000), "posit<80,3>", "from double");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee< 3, 1>(tag, bReportIndividualTestCases), "posit< 3,1>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee<12, 4>(tag, bReportIndividualTestCases), "posit<12,4>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee<32, 2>(tag, bReportIndividualTestCases, 100000), "posit<32,2>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee<64, 3>(tag, bReportIndividualTestCases, 100000), "posit<64,3>", "to float/double");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip<128, 4>(tag, bReportIndividualTestCases, 10000), "posit<128,4>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundTrip<256, 5>(tag, bReportIndividualTestCases, 1000), "posit<256,5>", "double round trip");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateToIeee<20, 1>(tag, bReportIndividualTestCases), "posit<20,1>", "to float/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateFromIeee<32, 2, double>(tag, bReportIndividualTestCases, 10000000), "posit<32,2>", "from double");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
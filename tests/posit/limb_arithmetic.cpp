@@ -0,0 +1,232 @@
+// limb_arithmetic.cpp: functional tests comparing the limb arithmetic engine to the bitblock arithmetic modules
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: the posit operators use the bitblock arithmetic modules as the reference
+#define POSIT_LIMB_ARITHMETIC 0
+
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/limb_engine.hpp"
+#include "universal/posit/native_engine.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// compare the result of the limb engine for one operand pair against the posit operators
+		template<size_t nbits, size_t es>
+		int VerifyLimbEngineOperands(const std::string& tag, const bitblock<nbits>& ba, const bitblock<nbits>& bb, bool bReportIndividualTestCases) {
+			using engine = limb_engine<nbits, es>;
+			posit<nbits, es> pa, pb, pref;
+			pa.set(ba);
+			pb.set(bb);
+			// the engine expects the special cases to be filtered out by the caller
+			if (pa.iszero() || pa.isnar() || pb.iszero() || pb.isnar()) return 0;
+
+			int nrOfFailedTests = 0;
+			bitblock<nbits> result;
+			pref = pa + pb;
+			result = engine::add(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " + " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = pa - pb;
+			result = engine::sub(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " - " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = pa * pb;
+			result = engine::mul(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " * " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = ReferenceDivision(pa, pb);
+			result = engine::div(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " / " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// compare the square root of the limb engine against a long double reference
+		// the reference double rounds for nbits > 48 so the comparison is limited to smaller configurations
+		template<size_t nbits, size_t es>
+		int VerifyLimbEngineSqrt(const std::string& tag, const bitblock<nbits>& ba, bool bReportIndividualTestCases) {
+			posit<nbits, es> pa, pref;
+			pa.set(ba);
+			if (pa.iszero() || pa.isnar() || pa.isneg()) return 0;
+			pref = std::sqrt((long double)pa);
+			bitblock<nbits> result = limb_engine<nbits, es>::sqrt(ba);
+			if (result != pref.get()) {
+				if (bReportIndividualTestCases) std::cout << tag << " sqrt(" << ba << ") = " << result << " (reference: " << pref.get() << ")" << std::endl;
+				return 1;
+			}
+			return 0;
+		}
+
+		// compare the square root of the limb engine against the native engine for configurations that have both
+		template<size_t nbits, size_t es>
+		int ValidateLimbEngineSqrtThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 generator;
+			int nrOfFailedTests = 0;
+			for (size_t n = 0; n < nrOfRandoms; ++n) {
+				bitblock<nbits> ba = convert_to_bitblock<nbits>(generator() >> (65 - nbits));  // positive operands
+				if (ba.none()) continue;
+				bitblock<nbits> result = limb_engine<nbits, es>::sqrt(ba);
+				bitblock<nbits> ref = native_engine<nbits, es>::sqrt(ba);
+				if (result != ref) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases) std::cout << tag << " sqrt(" << ba << ") = " << result << " (reference: " << ref << ")" << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// enumerate all operand pairs of a small posit configuration
+		template<size_t nbits, size_t es>
+		int ValidateLimbEngine(const std::string& tag, bool bReportIndividualTestCases) {
+			const size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				bitblock<nbits> ba = convert_to_bitblock<nbits>(i);
+				nrOfFailedTests += VerifyLimbEngineSqrt<nbits, es>(tag, ba, bReportIndividualTestCases);
+				for (size_t j = 0; j < NR_POSITS; ++j) {
+					bitblock<nbits> bb = convert_to_bitblock<nbits>(j);
+					nrOfFailedTests += VerifyLimbEngineOperands<nbits, es>(tag, ba, bb, bReportIndividualTestCases);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// random operand pairs for posit configurations that are too large to enumerate
+		template<size_t nbits, size_t es>
+		int ValidateLimbEngineThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 generator;
+			int nrOfFailedTests = 0;
+			for (size_t n = 0; n < nrOfRandoms; ++n) {
+				bitblock<nbits> ba, bb;
+				for (size_t i = 0; i < nbits; i += 64) {
+					uint64_t a = generator(), b = generator();
+					for (size_t j = 0; j < 64 && i + j < nbits; ++j) {
+						ba[i + j] = (a >> j) & 0x1;
+						bb[i + j] = (b >> j) & 0x1;
+					}
+				}
+				nrOfFailedTests += VerifyLimbEngineOperands<nbits, es>(tag, ba, bb, bReportIndividualTestCases);
+				if (nbits <= 48) nrOfFailedTests += VerifyLimbEngineSqrt<nbits, es>(tag, ba, bReportIndividualTestCases);
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Limb engine failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<3, 0>(tag, true), "posit<3,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<64, 3>(tag, true, 10), "posit<64,3>", "limb arithmetic");
+
+#else
+
+	cout << "Posit limb arithmetic engine validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<2, 0>(tag, bReportIndividualTestCases), "posit<2,0>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<3, 0>(tag, bReportIndividualTestCases), "posit<3,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<3, 1>(tag, bReportIndividualTestCases), "posit<3,1>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<4, 0>(tag, bReportIndividualTestCases), "posit<4,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<4, 1>(tag, bReportIndividualTestCases), "posit<4,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<4, 2>(tag, bReportIndividualTestCases), "posit<4,2>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<5, 0>(tag, bReportIndividualTestCases), "posit<5,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<5, 1>(tag, bReportIndividualTestCases), "posit<5,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<5, 2>(tag, bReportIndividualTestCases), "posit<5,2>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<5, 3>(tag, bReportIndividualTestCases), "posit<5,3>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<6, 0>(tag, bReportIndividualTestCases), "posit<6,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<6, 1>(tag, bReportIndividualTestCases), "posit<6,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<6, 4>(tag, bReportIndividualTestCases), "posit<6,4>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<7, 1>(tag, bReportIndividualTestCases), "posit<7,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<7, 3>(tag, bReportIndividualTestCases), "posit<7,3>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<8, 1>(tag, bReportIndividualTestCases), "posit<8,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<8, 5>(tag, bReportIndividualTestCases), "posit<8,5>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<16, 1>(tag, bReportIndividualTestCases, 1000), "posit<16,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<24, 1>(tag, bReportIndividualTestCases, 1000), "posit<24,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<32, 2>(tag, bReportIndividualTestCases, 1000), "posit<32,2>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<40, 2>(tag, bReportIndividualTestCases, 1000), "posit<40,2>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 1000), "posit<64,3>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<80, 3>(tag, bReportIndividualTestCases, 1000), "posit<80,3>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "limb arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineSqrtThroughRandoms<56, 2>(tag, bReportIndividualTestCases, 10000), "posit<56,2>", "limb sqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineSqrtThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 10000), "posit<64,3>", "limb sqrt");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngine<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "limb arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLimbEngineThroughRandoms<256, 5>(tag, bReportIndividualTestCases, 1000), "posit<256,5>", "limb arithmetic");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+// lookup_arithmetic.cpp: functional tests comparing the lookup table arithmetic of posit_lut to the posit operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/posit_lut.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		template<size_t nbits, size_t es>
+		int VerifyLookup(const std::string& tag, const std::string& op, const posit<nbits, es>& pa, const posit<nbits, es>& pb, const posit_lut<nbits, es>& result, const posit<nbits, es>& ref, bool bReportIndividualTestCases) {
+			if (result.to_posit() == ref) return 0;
+			if (bReportIndividualTestCases) {
+				std::cout << tag << pa << " " << op << " " << pb << " != " << result << " reference " << ref << std::endl;
+			}
+			return 1;
+		}
+
+		// compare the table results of every operand pair, or of a random sample, to the posit operators
+		template<size_t nbits, size_t es>
+		int ValidateLookupArithmetic(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			constexpr size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			std::mt19937_64 rng(nbits * 17 + es);
+			size_t nrOfTests = nrOfRandoms ? nrOfRandoms : NR_POSITS * NR_POSITS;
+			posit<nbits, es> pa, pb;
+			posit_lut<nbits, es> la, lb;
+			for (size_t t = 0; t < nrOfTests; ++t) {
+				size_t i = nrOfRandoms ? size_t(rng() % NR_POSITS) : t / NR_POSITS;
+				size_t j = nrOfRandoms ? size_t(rng() % NR_POSITS) : t % NR_POSITS;
+				pa.set_raw_bits(i);
+				pb.set_raw_bits(j);
+				la.set_raw_bits(i);
+				lb.set_raw_bits(j);
+				nrOfFailedTests += VerifyLookup(tag, "+", pa, pb, la + lb, pa + pb, bReportIndividualTestCases);
+				nrOfFailedTests += VerifyLookup(tag, "-", pa, pb, la - lb, pa - pb, bReportIndividualTestCases);
+				nrOfFailedTests += VerifyLookup(tag, "*", pa, pb, la * lb, pa * pb, bReportIndividualTestCases);
+				nrOfFailedTests += VerifyLookup(tag, "/", pa, pb, la / lb, pa / pb, bReportIndividualTestCases);
+				if ((la < lb) != (pa < pb) || (la == lb) != (pa == pb)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << pa << " comparison " << pb << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the gathered array results must match the scalar table lookups, on every instruction set
+		template<size_t nbits, size_t es>
+		int ValidateLookupArrays(const std::string& tag, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 rng(nbits + es);
+			for (batch::isa target : { batch::isa::scalar, batch::isa::avx2 }) {
+				batch::select_isa(target);
+				for (size_t n : { size_t(0), size_t(5), size_t(16), size_t(1029) }) {
+					std::vector<posit_lut<nbits, es>> a(n), b(n), r;
+					for (size_t i = 0; i < n; ++i) {
+						a[i].set_raw_bits(rng());
+						b[i].set_raw_bits(rng());
+					}
+					// the last encodings of the table exercise the padding of the gather
+					if (n > 0) a[n - 1].set_raw_bits(~0ull), b[n - 1].set_raw_bits(~0ull);
+					batch::add(a, b, r);
+					for (size_t i = 0; i < n; ++i) nrOfFailedTests += (r[i] != a[i] + b[i]);
+					batch::sub(a, b, r);
+					for (size_t i = 0; i < n; ++i) nrOfFailedTests += (r[i] != a[i] - b[i]);
+					batch::mul(a, b, r);
+					for (size_t i = 0; i < n; ++i) nrOfFailedTests += (r[i] != a[i] * b[i]);
+					batch::div(a, b, r);
+					for (size_t i = 0; i < n; ++i) nrOfFailedTests += (r[i] != a[i] / b[i]);
+				}
+			}
+			batch::select_isa(batch::detected_isa());
+			// a shorter second operand is rejected before the gather reads past its end
+			std::vector<posit_lut<nbits, es>> a(8), b(7), r;
+			try {
+				batch::mul(a, b, r);
+				++nrOfFailedTests;
+			}
+			catch (const std::invalid_argument&) {
+				// correctly reported
+			}
+			if (nrOfFailedTests && bReportIndividualTestCases) std::cout << tag << "array lookups differ from scalar lookups" << std::endl;
+			return nrOfFailedTests;
+		}
+
+		// tables written to a file and mapped back must serve the same results, and tables in use
+		// must not be replaced by a second map
+		template<size_t nbits, size_t es>
+		int ValidateLookupTableFile(const std::string& tag, bool bReportIndividualTestCases) {
+			using tables = posit_lut_tables<nbits, es>;
+			int nrOfFailedTests = 0;
+			std::string filename = "posit_lut_" + std::to_string(nbits) + "_" + std::to_string(es) + ".bin";
+			if (!tables::save(filename) || !tables::map(filename) || !tables::mapped()) {
+				if (bReportIndividualTestCases) std::cout << tag << "unable to save and map " << filename << std::endl;
+				std::remove(filename.c_str());
+				return 1;
+			}
+			nrOfFailedTests += ValidateLookupArithmetic<nbits, es>(tag, bReportIndividualTestCases);
+			const typename tables::storage_t* add = tables::table(lut_op::add);
+			if (tables::map(filename) || tables::table(lut_op::add) != add) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "mapped over tables in use" << std::endl;
+			}
+			std::remove(filename.c_str());
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Lookup arithmetic failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<5, 0>(tag, true), "posit_lut<5,0>", "lookup arithmetic");
+
+#else
+
+	cout << "Posit lookup table arithmetic validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<2, 0>(tag, bReportIndividualTestCases), "posit_lut<2,0>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<3, 0>(tag, bReportIndividualTestCases), "posit_lut<3,0>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<4, 1>(tag, bReportIndividualTestCases), "posit_lut<4,1>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<5, 0>(tag, bReportIndividualTestCases), "posit_lut<5,0>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<6, 2>(tag, bReportIndividualTestCases), "posit_lut<6,2>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<8, 0>(tag, bReportIndividualTestCases), "posit_lut<8,0>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<8, 1>(tag, bReportIndividualTestCases), "posit_lut<8,1>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<10, 1>(tag, bReportIndividualTestCases, 100000), "posit_lut<10,1>", "lookup arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArrays<8, 0>(tag, bReportIndividualTestCases), "posit_lut<8,0>", "lookup arrays");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArrays<10, 1>(tag, bReportIndividualTestCases), "posit_lut<10,1>", "lookup arrays");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupTableFile<7, 1>(tag, bReportIndividualTestCases), "posit_lut<7,1>", "lookup table file");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<10, 0>(tag, bReportIndividualTestCases), "posit_lut<10,0>", "lookup arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateLookupArithmetic<10, 2>(tag, bReportIndividualTestCases), "posit_lut<10,2>", "lookup arithmetic");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,366 @@
+// math_elementary.cpp: validation of the correct rounding of the native elementary functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <cmath>
+#include <limits>
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math/exponent.hpp"
+#include "universal/posit/math/logarithm.hpp"
+#include "universal/posit/math/trigonometry.hpp"
+#include "universal/posit/math/hyperbolic.hpp"
+#include "universal/posit/math/error_and_gamma.hpp"
+#include "universal/posit/math/pow.hpp"
+#include "universal/posit/math/sqrt.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// a reference value, and whether it is exact: the exact values of the dyadic results,
+		// such as exp2 of an integer or pow of a perfect power, may sit on a rounding boundary
+		struct reference_value {
+			long double v;
+			bool exact;
+			reference_value(long double v, bool exact = false) : v(v), exact(exact) {}
+		};
+
+		// the long double functions of the C library are accurate to a few units of 2^-63: a posit that rounds
+		// both ends of the window v -+ 2^-50 |v| is the correctly rounded value. An exact value is rounded directly,
+		// ties to even. Returns false when the window of an inexact value straddles a rounding boundary, which the
+		// validation reports as a failure, so that no case is left unchecked.
+		template<size_t nbits, size_t es>
+		bool CorrectlyRoundedReference(const reference_value& ref, posit<nbits, es>& r) {
+			long double v = ref.v;
+			if (std::isnan(v)) {
+				r.setnar();
+				return true;
+			}
+			if (std::isinf(v)) {
+				r = (v < 0 ? -maxpos<nbits, es>() : maxpos<nbits, es>());
+				return true;
+			}
+			if (v == 0) {
+				r = 0;
+				return true;
+			}
+			if (ref.exact) {
+				r = v;
+				return true;
+			}
+			long double d = std::fabs(v) * std::ldexp(1.0l, -50);
+			posit<nbits, es> lo(v - d), hi(v + d);
+			r = lo;
+			return lo == hi;
+		}
+
+		// x^y for y = n / 2^k, exact when the square roots and the long double products are exact, which fma verifies
+		inline bool ExactPower(long double x, long double y, long double& v) {
+			for (int k = 0; std::floor(y) != y; ++k) {
+				if (k == 16 || x <= 0) return false;
+				long double r = std::sqrt(x);
+				if (std::fma(r, r, -x) != 0) return false;
+				x = r;
+				y *= 2;
+			}
+			if (std::fabs(y) > 4096) return false;
+			long long n = (long long)std::fabs(y);
+			long double p = 1, b = x;
+			while (n != 0) {
+				if (n & 0x1) {
+					long double t = p * b;
+					if (std::fma(p, b, -t) != 0 || std::isinf(t)) return false;
+					p = t;
+				}
+				n >>= 1;
+				if (n != 0) {
+					long double t = b * b;
+					if (std::fma(b, b, -t) != 0 || std::isinf(t)) return false;
+					b = t;
+				}
+			}
+			if (y < 0) {
+				// the reciprocal is exact for a power of 2
+				int e = 0;
+				if (p == 0 || std::fabs(std::frexp(p, &e)) != 0.5l) return false;
+				p = 1 / p;
+			}
+			v = p;
+			return p != 0;
+		}
+
+		// the cases the long double window leaves undecided are settled by the kernels of the engine at a fixed
+		// precision of 8 limbs, far beyond the 2^-50 window and the precision at which the engine decides these posits
+		constexpr size_t wide_limbs = 8;
+		using wide = internal::wide_float<wide_limbs>;
+
+		// a wide value as long double with the bits beyond 64 folded into the last bit: the rounding boundaries
+		// of posits narrower than 64 bits have fewer significant bits, so the fold keeps the rounding direction.
+		// Scales beyond the range of long double are clamped, as they are far beyond minpos and maxpos.
+		inline long double Jammed(const wide& v) {
+			if (v.zero) return 0;
+			uint64_t sig = v.m[v.n - 1];
+			for (size_t i = 0; i + 1 < v.n; ++i) if (v.m[i] != 0) sig |= 1;
+			int scale = (v.exp < -16000 ? -16000 : (v.exp > 16000 ? 16000 : v.exp));
+			long double r = std::ldexp((long double)sig, scale - 63);
+			return v.sign ? -r : r;
+		}
+
+		// the posit of a kernel value y with an error bound of e units of 2^(1 - 64n): returns false when
+		// y minus and plus the error bound round to different posits
+		template<size_t nbits, size_t es>
+		bool WideReference(const wide& y, double e, posit<nbits, es>& r) {
+			if (y.zero || !(e < 1.0e300)) return false;
+			wide d(y.n), lo(y.n), hi(y.n);
+			d.assign(uint64_t(1));
+			d.exp = y.exp + 3 + int(std::ceil(std::log2(e + 2.0))) - 64 * int(y.n);
+			lo.add(y, d, true);
+			hi.add(y, d);
+			posit<nbits, es> a(Jammed(lo)), b(Jammed(hi));
+			r = a;
+			return a == b;
+		}
+
+		// the kernel of a function with a single argument at the wide precision: the kernels, as in the engine,
+		// take a nonzero argument
+		template<size_t nbits, size_t es, typename Kernel>
+		bool WideReference(const posit<nbits, es>& x, Kernel kernel, posit<nbits, es>& r) {
+			if (x.iszero()) return false;
+			wide wx(wide_limbs), wy(wide_limbs);
+			wx.assign(double(x));
+			double e = kernel(wx, wy);
+			return WideReference(wy, e, r);
+		}
+
+		// x^y for x > 0, and atan2(y, x), at the wide precision, as the engine composes them
+		template<size_t nbits, size_t es>
+		bool WidePow(const posit<nbits, es>& x, const posit<nbits, es>& y, posit<nbits, es>& r) {
+			if (y.iszero()) return false;
+			wide wx(wide_limbs), wy(wide_limbs), v(wide_limbs);
+			wx.assign(double(x));
+			wy.assign(double(y));
+			double e = internal::wide_pow(wx, wy, v);
+			return WideReference(v, e, r);
+		}
+		template<size_t nbits, size_t es>
+		bool WideAtan2(const posit<nbits, es>& y, const posit<nbits, es>& x, posit<nbits, es>& r) {
+			if (x.iszero() || y.iszero()) return false;
+			wide wx(wide_limbs), wy(wide_limbs), z(wide_limbs), v(wide_limbs), pi(wide_limbs), sum(wide_limbs);
+			wx.assign(double(x));
+			wy.assign(double(y));
+			z.div(wy, wx);
+			double e = internal::wide_atan(z, v) + 8.0;
+			if (!wx.sign) return WideReference(v, e, r);
+			internal::load_constant(internal::wide_constants<wide_limbs>::get().pi, pi);
+			pi.sign = !wy.sign;
+			sum.add(v, pi, true);
+			return WideReference(sum, internal::sum_error(e, v, 2.0, pi, sum), r);
+		}
+
+		// exp(x c) for the constants ln2 and ln10 of the engine
+		inline double WideExpScaled(const wide& x, const wide& c, wide& y) {
+			wide t(y.n);
+			t.mul(x, c);
+			return internal::wide_exp(t, y) + 2.0 * (std::fabs(t.to_double()) + 1.0) * 4.0;
+		}
+
+		// a nonzero result that underflows long double still rounds to minpos, as posits do not underflow to zero
+		inline long double NonZero(long double v) {
+			return (v == 0 ? std::numeric_limits<long double>::denorm_min() : v);
+		}
+
+		// compare f to the correctly rounded reference g over all posits, or over nrOfRandoms random encodings,
+		// with the wide kernel k of the function for the cases g leaves undecided
+		template<size_t nbits, size_t es, typename Function, typename Reference, typename Kernel>
+		int ValidateCorrectRounding(const std::string& tag, bool bReportIndividualTestCases, const char* name, Function f, Reference g, Kernel k, size_t nrOfRandoms) {
+			std::mt19937_64 rng(nbits * 13 + es);
+			size_t nrOfTests = (nrOfRandoms ? nrOfRandoms : (size_t(1) << nbits));
+			int nrOfFailedTests = 0;
+			posit<nbits, es> x, result, reference;
+			for (size_t i = 0; i < nrOfTests; ++i) {
+				x.set_raw_bits(nrOfRandoms ? rng() : i);
+				if (x.isnar()) continue;
+				if (!CorrectlyRoundedReference(g((long double)x), reference) && !WideReference(x, k, reference)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << name << "(" << x << ") is undecided by the reference" << std::endl;
+					continue;
+				}
+				result = f(x);
+				if (result != reference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << name << "(" << x << ") = " << result << " reference " << reference << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		template<size_t nbits, size_t es>
+		int ValidateElementaryFunctions(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms = 0) {
+			using Posit = posit<nbits, es>;
+			const long double nan = std::numeric_limits<long double>::quiet_NaN();
+			int nrOfFailedTests = 0;
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "exp", [](Posit x) { return exp(x); }, [](long double x) { return NonZero(std::exp(x)); }, [](const wide& x, wide& y) { return internal::wide_exp(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "exp2", [](Posit x) { return exp2(x); }, [](long double x) { return reference_value(NonZero(std::exp2(x)), std::floor(x) == x); }, [](const wide& x, wide& y) { return WideExpScaled(x, internal::wide_constants<wide_limbs>::get().ln2, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "exp10", [](Posit x) { return exp10(x); }, [](long double x) { long double v; return (ExactPower(10.0l, x, v) ? reference_value(v, true) : reference_value(NonZero(std::pow(10.0l, x)))); }, [](const wide& x, wide& y) { return WideExpScaled(x, internal::wide_constants<wide_limbs>::get().ln10, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "expm1", [](Posit x) { return expm1(x); }, [](long double x) { return std::expm1(x); }, [](const wide& x, wide& y) { return internal::wide_expm1(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "log", [](Posit x) { return log(x); }, [=](long double x) { return (x <= 0 ? nan : std::log(x)); }, [](const wide& x, wide& y) { return internal::wide_log(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "log2", [](Posit x) { return log2(x); }, [=](long double x) { int e; return (x <= 0 ? reference_value(nan) : reference_value(std::log2(x), std::frexp(x, &e) == 0.5l)); }, [](const wide& x, wide& y) { return internal::wide_log2(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "log10", [](Posit x) { return log10(x); }, [=](long double x) { return (x <= 0 ? nan : std::log10(x)); }, [](const wide& x, wide& y) { return internal::wide_log10(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "log1p", [](Posit x) { return log1p(x); }, [=](long double x) { return (x <= -1 ? nan : std::log1p(x)); }, [](const wide& x, wide& y) { return internal::wide_log1p(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "sin", [](Posit x) { return sin(x); }, [](long double x) { return std::sin(x); }, [](const wide& x, wide& y) { return internal::wide_trig(x, y, internal::trig_function::sin); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "cos", [](Posit x) { return cos(x); }, [](long double x) { return std::cos(x); }, [](const wide& x, wide& y) { return internal::wide_trig(x, y, internal::trig_function::cos); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "tan", [](Posit x) { return tan(x); }, [](long double x) { return std::tan(x); }, [](const wide& x, wide& y) { return internal::wide_trig(x, y, internal::trig_function::tan); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "atan", [](Posit x) { return atan(x); }, [](long double x) { return std::atan(x); }, [](const wide& x, wide& y) { return internal::wide_atan(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "asin", [](Posit x) { return asin(x); }, [](long double x) { return std::asin(x); }, [](const wide& x, wide& y) { return internal::wide_asin(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "acos", [](Posit x) { return acos(x); }, [](long double x) { return std::acos(x); }, [](const wide& x, wide& y) { return internal::wide_acos(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "sinh", [](Posit x) { return sinh(x); }, [](long double x) { return std::sinh(x); }, [](const wide& x, wide& y) { return internal::wide_sinh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "cosh", [](Posit x) { return cosh(x); }, [](long double x) { return std::cosh(x); }, [](const wide& x, wide& y) { return internal::wide_cosh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "tanh", [](Posit x) { return tanh(x); }, [](long double x) { return std::tanh(x); }, [](const wide& x, wide& y) { return internal::wide_tanh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "sigmoid", [](Posit x) { return sigmoid(x); }, [](long double x) { return NonZero(1.0l / (1.0l + std::exp(-x))); }, [](const wide& x, wide& y) { return internal::wide_sigmoid(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "rsqrt", [](Posit x) { return rsqrt(x); }, [=](long double x) { return (x <= 0 ? nan : 1.0l / std::sqrt(x)); }, [](const wide& x, wide& y) { return internal::wide_rsqrt(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "asinh", [](Posit x) { return asinh(x); }, [](long double x) { return std::asinh(x); }, [](const wide& x, wide& y) { return internal::wide_asinh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "acosh", [](Posit x) { return acosh(x); }, [=](long double x) { return (x < 1 ? nan : std::acosh(x)); }, [](const wide& x, wide& y) { return internal::wide_acosh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "atanh", [](Posit x) { return atanh(x); }, [=](long double x) { return (std::fabs(x) >= 1 ? nan : std::atanh(x)); }, [](const wide& x, wide& y) { return internal::wide_atanh(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "erf", [](Posit x) { return erf(x); }, [](long double x) { return std::erf(x); }, [](const wide& x, wide& y) { return internal::wide_erf(x, y); }, nrOfRandoms);
+			nrOfFailedTests += ValidateCorrectRounding<nbits, es>(tag, bReportIndividualTestCases, "erfc", [](Posit x) { return erfc(x); }, [](long double x) { return NonZero(std::erfc(x)); }, [](const wide& x, wide& y) { wide e(y.n), one(y.n); one.assign(uint64_t(1)); double ee = internal::wide_erf(x, e); y.add(one, e, true); return internal::sum_error(ee, e, 0.0, one, y); }, nrOfRandoms);
+			return nrOfFailedTests;
+		}
+
+		// pow(x, y) and atan2(y, x) over all pairs of posits
+		template<size_t nbits, size_t es>
+		int ValidateBinaryFunctions(const std::string& tag, bool bReportIndividualTestCases) {
+			constexpr size_t NR_POSITS = (size_t(1) << nbits);
+			const long double nan = std::numeric_limits<long double>::quiet_NaN();
+			int nrOfFailedTests = 0;
+			posit<nbits, es> x, y, result, reference;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				x.set_raw_bits(i);
+				if (x.isnar()) continue;
+				long double lx = (long double)x;
+				for (size_t j = 0; j < NR_POSITS; ++j) {
+					y.set_raw_bits(j);
+					if (y.isnar()) continue;
+					long double ly = (long double)y, v;
+					bool exact = false;
+					if (ly == 0) v = 1;
+					else if ((lx == 0 && ly < 0) || (lx < 0 && std::floor(ly) != ly)) v = nan;
+					else if (ExactPower(lx, ly, v)) exact = true;
+					else {
+						v = std::pow(lx, ly);
+						if (v == 0 && lx != 0) v = std::copysign(std::numeric_limits<long double>::denorm_min(), v);
+					}
+					bool decided = CorrectlyRoundedReference(reference_value(v, exact), reference);
+					if (!decided && lx > 0) decided = WidePow(x, y, reference);
+					if (!decided && lx < 0) {
+						// a negative base has an integer exponent: the sign follows from its parity
+						decided = WidePow(-x, y, reference);
+						if (std::fmod(ly, 2.0l) != 0) reference = -reference;
+					}
+					if (decided) {
+						result = pow(x, y);
+						if (result != reference) {
+							++nrOfFailedTests;
+							if (bReportIndividualTestCases) std::cout << tag << "pow(" << x << ", " << y << ") = " << result << " reference " << reference << std::endl;
+						}
+					}
+					else {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "pow(" << x << ", " << y << ") is undecided by the reference" << std::endl;
+					}
+					v = (lx == 0 && ly == 0 ? nan : std::atan2(ly, lx));
+					if (CorrectlyRoundedReference(v, reference) || WideAtan2(y, x, reference)) {
+						result = atan2(y, x);
+						if (result != reference) {
+							++nrOfFailedTests;
+							if (bReportIndividualTestCases) std::cout << tag << "atan2(" << y << ", " << x << ") = " << result << " reference " << reference << std::endl;
+						}
+					}
+					else {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "atan2(" << y << ", " << x << ") is undecided by the reference" << std::endl;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "correct rounding failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<16, 1>(tag, true), "posit<16,1>", "elementary functions");
+
+#else
+
+	cout << "Posit elementary function correct rounding validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions< 8, 2>(tag, bReportIndividualTestCases), "posit< 8,2>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<16, 0>(tag, bReportIndividualTestCases), "posit<16,0>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<16, 2>(tag, bReportIndividualTestCases), "posit<16,2>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<32, 2>(tag, bReportIndividualTestCases, 20000), "posit<32,2>", "elementary functions");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryFunctions< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "pow and atan2");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryFunctions< 8, 1>(tag, bReportIndividualTestCases), "posit< 8,1>", "pow and atan2");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateElementaryFunctions<24, 1>(tag, bReportIndividualTestCases, 200000), "posit<24,1>", "elementary functions");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryFunctions<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "pow and atan2");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryFunctions<12, 2>(tag, bReportIndividualTestCases), "posit<12,2>", "pow and atan2");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
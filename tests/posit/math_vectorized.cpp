@@ -0,0 +1,156 @@
+// math_vectorized.cpp: functional tests comparing the vectorized math functions on posit arrays to the scalar functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/math/vectorized.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// random arrays mix arbitrary encodings, which reach the extremes of the dynamic range,
+		// with values of moderate magnitude, which the vector kernels evaluate
+		template<size_t nbits, size_t es>
+		std::vector<posit<nbits, es>> RandomArguments(std::mt19937_64& rng, size_t n) {
+			std::uniform_real_distribution<double> moderate(-12.0, 12.0);
+			std::vector<posit<nbits, es>> a(n);
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t r = rng();
+				if (r & 1) a[i] = moderate(rng);
+				else a[i].set_raw_bits(r >> 1);
+			}
+			if (n > 2) a[0] = 0, a[1].setnar(), a[2] = 1;
+			return a;
+		}
+
+		template<size_t nbits, size_t es>
+		struct VectorizedFunction {
+			using Posit = posit<nbits, es>;
+			const char* name;
+			void (*vectorized)(const Posit*, Posit*, size_t, size_t);
+			Posit (*scalar)(Posit);
+		};
+
+		// run every vectorized function on random arrays on the selected instruction set and compare each element to the scalar function
+		template<size_t nbits, size_t es>
+		int ValidateVectorizedFunctions(const std::string& tag, batch::isa target, bool bReportIndividualTestCases, size_t nrOfRandoms, size_t nrOfThreads = 1) {
+			using Posit = posit<nbits, es>;
+			const VectorizedFunction<nbits, es> functions[] = {
+				{ "exp",        vexp<nbits, es>,        [](Posit x) { return exp(x); } },
+				{ "log",        vlog<nbits, es>,        [](Posit x) { return log(x); } },
+				{ "log2",       vlog2<nbits, es>,       [](Posit x) { return log2(x); } },
+				{ "sin",        vsin<nbits, es>,        [](Posit x) { return sin(x); } },
+				{ "cos",        vcos<nbits, es>,        [](Posit x) { return cos(x); } },
+				{ "tanh",       vtanh<nbits, es>,       [](Posit x) { return tanh(x); } },
+				{ "sqrt",       vsqrt<nbits, es>,       [](Posit x) { return sqrt(x); } },
+				{ "rsqrt",      vrsqrt<nbits, es>,      [](Posit x) { return rsqrt(x); } },
+				{ "reciprocal", vreciprocal<nbits, es>, [](Posit x) { return x.reciprocate(); } },
+				{ "sigmoid",    vsigmoid<nbits, es>,    [](Posit x) { return sigmoid(x); } },
+			};
+			int nrOfFailedTests = 0;
+			std::mt19937_64 rng(nbits * 11 + es);
+			batch::select_isa(target);
+			// odd sizes exercise the scalar tail of the vector loops
+			for (size_t n : { size_t(0), size_t(1), size_t(7), size_t(33), nrOfRandoms }) {
+				std::vector<Posit> a = RandomArguments<nbits, es>(rng, n);
+				std::vector<Posit> r(n);
+				for (const VectorizedFunction<nbits, es>& f : functions) {
+					f.vectorized(a.data(), r.data(), n, nrOfThreads);
+					for (size_t i = 0; i < n; ++i) {
+						Posit ref = f.scalar(a[i]);
+						if (r[i] != ref) {
+							++nrOfFailedTests;
+							if (bReportIndividualTestCases) std::cout << tag << f.name << "(" << hex_format(a[i]) << ") = " << hex_format(r[i]) << " reference " << hex_format(ref) << std::endl;
+						}
+					}
+				}
+				// in place through the std::vector interface
+				std::vector<Posit> b(a);
+				vexp(b, b, nrOfThreads);
+				for (size_t i = 0; i < n; ++i) nrOfFailedTests += (b[i] != exp(a[i]));
+			}
+			batch::select_isa(batch::detected_isa());
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Vectorized math functions failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<32, 2>(tag, batch::isa::avx2, true, 1000), "posit<32,2>", "vectorized avx2");
+
+#else
+
+	cout << "Posit vectorized math function validation" << endl;
+	cout << "detected instruction set: " << (batch::detected_isa() == batch::isa::avx2 ? "avx2" : "scalar") << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<8, 0>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<8,0>", "vectorized scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<16, 1>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<16,1>", "vectorized scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<20, 1>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<20,1>", "vectorized scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<32, 2>(tag, batch::isa::scalar, bReportIndividualTestCases, 1000), "posit<32,2>", "vectorized scalar");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<8, 0>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000), "posit<8,0>", "vectorized avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<8, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000), "posit<8,2>", "vectorized avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<12, 1>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000), "posit<12,1>", "vectorized avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<16, 1>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000), "posit<16,1>", "vectorized avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<32, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 100000), "posit<32,2>", "vectorized avx2");
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<32, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 100000, 4), "posit<32,2>", "vectorized threads");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateVectorizedFunctions<32, 2>(tag, batch::isa::avx2, bReportIndividualTestCases, 10000000), "posit<32,2>", "vectorized avx2");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
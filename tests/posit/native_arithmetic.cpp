@@ -0,0 +1,216 @@
+// native_arithmetic.cpp: functional tests comparing the native integer arithmetic engine to the bitblock arithmetic modules
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: the posit operators use the bitblock arithmetic modules as the reference
+#define POSIT_LIMB_ARITHMETIC 0
+#define POSIT_FAST_NATIVE_ARITHMETIC 0
+
+#include <random>
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/native_engine.hpp"
+#include "universal/posit/math_functions.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// compare the result of the native engine for one operand pair against the posit operators
+		template<size_t nbits, size_t es>
+		int VerifyNativeEngineOperands(const std::string& tag, const bitblock<nbits>& ba, const bitblock<nbits>& bb, bool bReportIndividualTestCases) {
+			using engine = native_engine<nbits, es>;
+			posit<nbits, es> pa, pb, pref;
+			pa.set(ba);
+			pb.set(bb);
+			// the engine expects the special cases to be filtered out by the caller
+			if (pa.iszero() || pa.isnar() || pb.iszero() || pb.isnar()) return 0;
+
+			int nrOfFailedTests = 0;
+			bitblock<nbits> result;
+			pref = pa + pb;
+			result = engine::add(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " + " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = pa - pb;
+			result = engine::sub(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " - " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = pa * pb;
+			result = engine::mul(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " * " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			pref = ReferenceDivision(pa, pb);
+			result = engine::div(ba, bb);
+			if (result != pref.get()) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << tag << " " << ba << " / " << bb << " = " << result << " (reference: " << pref.get() << ")" << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// compare the native square root against the long double reference
+		// the reference double rounds for nbits > 48 so the comparison is limited to smaller configurations
+		template<size_t nbits, size_t es>
+		int VerifyNativeEngineSqrt(const std::string& tag, const bitblock<nbits>& ba, bool bReportIndividualTestCases) {
+			posit<nbits, es> pa, pref;
+			pa.set(ba);
+			if (pa.iszero() || pa.isnar() || pa.isneg()) return 0;
+			pref = std::sqrt((long double)pa);
+			bitblock<nbits> result = native_engine<nbits, es>::sqrt(ba);
+			if (result != pref.get()) {
+				if (bReportIndividualTestCases) std::cout << tag << " sqrt(" << ba << ") = " << result << " (reference: " << pref.get() << ")" << std::endl;
+				return 1;
+			}
+			return 0;
+		}
+
+		// enumerate all operand pairs of a small posit configuration
+		template<size_t nbits, size_t es>
+		int ValidateNativeEngine(const std::string& tag, bool bReportIndividualTestCases) {
+			const size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				bitblock<nbits> ba = convert_to_bitblock<nbits>(i);
+				nrOfFailedTests += VerifyNativeEngineSqrt<nbits, es>(tag, ba, bReportIndividualTestCases);
+				for (size_t j = 0; j < NR_POSITS; ++j) {
+					bitblock<nbits> bb = convert_to_bitblock<nbits>(j);
+					nrOfFailedTests += VerifyNativeEngineOperands<nbits, es>(tag, ba, bb, bReportIndividualTestCases);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// random operand pairs for posit configurations that are too large to enumerate
+		template<size_t nbits, size_t es>
+		int ValidateNativeEngineThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 generator;
+			int nrOfFailedTests = 0;
+			for (size_t n = 0; n < nrOfRandoms; ++n) {
+				bitblock<nbits> ba, bb;
+				for (size_t i = 0; i < nbits; i += 64) {
+					uint64_t a = generator(), b = generator();
+					for (size_t j = 0; j < 64 && i + j < nbits; ++j) {
+						ba[i + j] = (a >> j) & 0x1;
+						bb[i + j] = (b >> j) & 0x1;
+					}
+				}
+				nrOfFailedTests += VerifyNativeEngineOperands<nbits, es>(tag, ba, bb, bReportIndividualTestCases);
+				if (nbits <= 48) nrOfFailedTests += VerifyNativeEngineSqrt<nbits, es>(tag, ba, bReportIndividualTestCases);
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Native engine failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<3, 0>(tag, true), "posit<3,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<24, 2>(tag, true, 10), "posit<64,3>", "native arithmetic");
+
+#else
+
+	cout << "Posit native integer arithmetic engine validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<2, 0>(tag, bReportIndividualTestCases), "posit<2,0>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<3, 0>(tag, bReportIndividualTestCases), "posit<3,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<3, 1>(tag, bReportIndividualTestCases), "posit<3,1>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<4, 0>(tag, bReportIndividualTestCases), "posit<4,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<4, 1>(tag, bReportIndividualTestCases), "posit<4,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<4, 2>(tag, bReportIndividualTestCases), "posit<4,2>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<5, 0>(tag, bReportIndividualTestCases), "posit<5,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<5, 1>(tag, bReportIndividualTestCases), "posit<5,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<5, 2>(tag, bReportIndividualTestCases), "posit<5,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<5, 3>(tag, bReportIndividualTestCases), "posit<5,3>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<6, 0>(tag, bReportIndividualTestCases), "posit<6,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<6, 1>(tag, bReportIndividualTestCases), "posit<6,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<6, 4>(tag, bReportIndividualTestCases), "posit<6,4>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<7, 1>(tag, bReportIndividualTestCases), "posit<7,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<7, 3>(tag, bReportIndividualTestCases), "posit<7,3>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<8, 1>(tag, bReportIndividualTestCases), "posit<8,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<8, 5>(tag, bReportIndividualTestCases), "posit<8,5>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<12, 1>(tag, bReportIndividualTestCases, 1000), "posit<12,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<16, 1>(tag, bReportIndividualTestCases, 1000), "posit<16,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<20, 1>(tag, bReportIndividualTestCases, 1000), "posit<20,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<24, 2>(tag, bReportIndividualTestCases, 1000), "posit<24,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<32, 2>(tag, bReportIndividualTestCases, 1000), "posit<32,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<40, 2>(tag, bReportIndividualTestCases, 1000), "posit<40,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<48, 2>(tag, bReportIndividualTestCases, 1000), "posit<48,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<64, 0>(tag, bReportIndividualTestCases, 1000), "posit<64,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 1000), "posit<64,3>", "native arithmetic");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngine<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<20, 1>(tag, bReportIndividualTestCases, 1000000), "posit<20,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(ValidateNativeEngineThroughRandoms<24, 2>(tag, bReportIndividualTestCases, 1000000), "posit<24,2>", "native arithmetic");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+// quire_limbs.cpp: validation of the word-level carry and borrow chains of the limb accumulator of the quire
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// a single product must be held exactly, and a sum of products must cancel exactly to a positive zero
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateQuireProducts(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es));
+			std::vector< posit<nbits, es> > x(nrOfRandoms), y(nrOfRandoms);
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				x[i] = RandomPosit<nbits, es>(generator, true);
+				y[i] = RandomPosit<nbits, es>(generator, true);
+			}
+			quire<nbits, es, capacity> q;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				auto product = quire_mul(x[i], y[i]);
+				quire<nbits, es, capacity> single;
+				single += product;
+				if (!(single == product)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << x[i] << " * " << y[i] << " quire " << single << " product " << product << std::endl;
+				}
+				q += product;
+			}
+			// the quire of a sum must double exactly, and subtracting the products in reverse order must cancel the sum
+			quire<nbits, es, capacity> q2 = q;
+			q2 += q;
+			q2 -= q;
+			if (!(q2 == q)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "quire addition " << q2 << " != " << q << std::endl;
+			}
+			for (size_t i = nrOfRandoms; i-- > 0; ) q -= quire_mul(x[i], y[i]);
+			if (!q.iszero() || q.sign()) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "cancellation " << q << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// the carry-save batch accumulation must match the product by product accumulation, across batch boundaries and through cancellation
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateQuireAccumulate(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + 1));
+			std::vector< posit<nbits, es> > x(nrOfRandoms), y(nrOfRandoms), minus_y(nrOfRandoms);
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				x[i] = (i % 17 == 0 ? posit<nbits, es>(0) : RandomPosit<nbits, es>(generator, true));
+				y[i] = RandomPosit<nbits, es>(generator, true);
+				minus_y[i] = -y[i];
+			}
+			quire<nbits, es, capacity> q, batch;
+			for (size_t i = 0; i < nrOfRandoms; ++i) q.fma(x[i], y[i]);
+			size_t half = nrOfRandoms / 2;
+			batch.accumulate(x.data(), y.data(), half);
+			batch.accumulate(x.data() + half, y.data() + half, nrOfRandoms - half);
+			if (!(batch == q)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "batch " << batch << " != " << q << std::endl;
+			}
+			batch.accumulate(x.data(), minus_y.data(), nrOfRandoms);
+			if (!batch.iszero() || batch.sign()) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "batch cancellation " << batch << std::endl;
+			}
+			// a negative batch into an empty quire flips its sign
+			batch.accumulate(x.data(), minus_y.data(), nrOfRandoms);
+			q.set_sign(!q.sign());
+			if (!(batch == q)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "negative batch " << batch << " != " << q << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// an increment of the lsb of a quire that has all its lower and upper bits set must ripple into the capacity segment
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateQuireRipple(const std::string& tag, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			using Quire = quire<nbits, es, capacity>;
+			Quire q, ones;
+			ones.load_bits("+:" + std::string(capacity, '0') + "_" + std::string(Quire::upper_range, '1') + "." + std::string(Quire::half_range, '1'));
+			q = ones;
+			bitblock<1> fraction;
+			value<1> lsb(false, -int(Quire::half_range), fraction, false, false);
+			q += lsb;
+			if (q.scale() != int(Quire::upper_range) || q.anyAfter(int(Quire::half_range + Quire::upper_range) - 1)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "carry " << q << std::endl;
+			}
+			q -= lsb;
+			if (!(q == ones)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "borrow " << q << std::endl;
+			}
+			// subtracting a larger magnitude flips the sign of the quire
+			q = lsb;
+			q -= ones.to_value();
+			ones.set_sign(true);
+			q -= lsb;
+			if (!(q == ones)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "sign flip " << q << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "quire limbs failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts<64, 3>(tag, true, 100), "quire<64,3>", "products");
+
+#else
+
+	cout << "Quire limb accumulator validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireRipple<  8, 0>(tag, bReportIndividualTestCases), "quire<  8,0>", "carry chain");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireRipple< 16, 1>(tag, bReportIndividualTestCases), "quire< 16,1>", "carry chain");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireRipple< 32, 2>(tag, bReportIndividualTestCases), "quire< 32,2>", "carry chain");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireRipple< 64, 3>(tag, bReportIndividualTestCases), "quire< 64,3>", "carry chain");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireRipple<128, 4>(tag, bReportIndividualTestCases), "quire<128,4>", "carry chain");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts<  8, 0>(tag, bReportIndividualTestCases, 1000), "quire<  8,0>", "products");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts< 16, 1>(tag, bReportIndividualTestCases, 1000), "quire< 16,1>", "products");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts< 32, 2>(tag, bReportIndividualTestCases, 1000), "quire< 32,2>", "products");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts< 64, 3>(tag, bReportIndividualTestCases, 500), "quire< 64,3>", "products");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts<128, 4>(tag, bReportIndividualTestCases, 200), "quire<128,4>", "products");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulate<  8, 0>(tag, bReportIndividualTestCases, 1000), "quire<  8,0>", "carry-save accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulate< 16, 1>(tag, bReportIndividualTestCases, 1000), "quire< 16,1>", "carry-save accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulate< 32, 2>(tag, bReportIndividualTestCases, 1000), "quire< 32,2>", "carry-save accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulate< 64, 3>(tag, bReportIndividualTestCases, 500), "quire< 64,3>", "carry-save accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulate<128, 4>(tag, bReportIndividualTestCases, 200), "quire<128,4>", "carry-save accumulation");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts<256, 5>(tag, bReportIndividualTestCases, 100), "quire<256,5>", "products");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,122 @@
+// quire_parallel.cpp: validation of the multi-threaded fused dot product against the serial fused dot product
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+#include "universal/posit/fdp.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// the parallel fused dot product must reproduce the serial one for any thread count,
+		// including the ill-conditioned case where large products cancel and only the small ones survive
+		template<size_t nbits, size_t es>
+		int ValidateParallelFusedDotProduct(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfElements) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es));
+			std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+			std::uniform_int_distribution<int> exponent(-30, 30);
+			std::vector< posit<nbits, es> > x(nrOfElements), y(nrOfElements);
+			for (size_t i = 0; i < nrOfElements; ++i) {
+				x[i] = std::ldexp(distribution(generator), exponent(generator));
+				y[i] = std::ldexp(distribution(generator), exponent(generator));
+			}
+			// the second half cancels the large products of the first half
+			std::vector< posit<nbits, es> > u(x), v(y);
+			for (size_t i = 0; i < nrOfElements / 2; ++i) {
+				u[nrOfElements - 1 - i] = -u[i];
+				v[nrOfElements - 1 - i] = v[i];
+			}
+			u[nrOfElements / 2] = minpos<nbits, es>();
+			posit<nbits, es> reference = fdp(x, y), cancelled = fdp(u, v);
+			for (size_t nrOfThreads : { 1, 2, 3, 4, 7, 16 }) {
+				posit<nbits, es> result = fdp_parallel(x, y, nrOfThreads);
+				if (result != reference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << nrOfThreads << " threads " << result << " != " << reference << std::endl;
+				}
+				result = fdp_parallel(u, v, nrOfThreads);
+				if (result != cancelled) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << nrOfThreads << " threads cancellation " << result << " != " << cancelled << std::endl;
+				}
+			}
+			// a NaR in the part of a worker thread must surface in the calling thread
+			x[nrOfElements - 1].setnar();
+			try {
+				fdp_parallel(x, y, 4);
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "NaR operand not reported" << std::endl;
+			}
+			catch (const operand_is_nar&) {
+				// correctly reported
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "parallel fdp failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateParallelFusedDotProduct<32, 2>(tag, true, 20000), "posit<32,2>", "fdp_parallel");
+
+#else
+
+	cout << "Parallel fused dot product validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateParallelFusedDotProduct<16, 1>(tag, bReportIndividualTestCases, 50000), "posit<16,1>", "fdp_parallel");
+	nrOfFailedTestCases += ReportTestResult(ValidateParallelFusedDotProduct<32, 2>(tag, bReportIndividualTestCases, 50000), "posit<32,2>", "fdp_parallel");
+	nrOfFailedTestCases += ReportTestResult(ValidateParallelFusedDotProduct<64, 3>(tag, bReportIndividualTestCases, 20000), "posit<64,3>", "fdp_parallel");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateParallelFusedDotProduct<128, 4>(tag, bReportIndividualTestCases, 100000), "posit<128,4>", "fdp_parallel");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
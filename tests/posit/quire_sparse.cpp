@@ -0,0 +1,131 @@
+// quire_sparse.cpp: validation of the windowed accumulation of the sparse quire against the dense quire
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+#include "universal/posit/sparse_quire.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// the sparse quire must track the dense quire through products, value subtractions, and quire additions,
+		// and hand its accumulator back when the sum cancels to zero
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateSparseQuire(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms, bool narrow) {
+			// containers of sparse quires move them on reallocation instead of copying their accumulators
+			static_assert(std::is_nothrow_move_constructible<sparse_quire<nbits, es, capacity>>::value && std::is_nothrow_move_assignable<sparse_quire<nbits, es, capacity>>::value, "sparse_quire moves must not throw");
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es));
+			std::vector< posit<nbits, es> > x(nrOfRandoms), y(nrOfRandoms);
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				x[i] = RandomPosit<nbits, es>(generator, false, narrow ? 4.0 : 0.0);
+				y[i] = RandomPosit<nbits, es>(generator, false, narrow ? 4.0 : 0.0);
+			}
+			quire<nbits, es, capacity> q;
+			sparse_quire<nbits, es, capacity> s, s2;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				if (i % 4 == 3) {
+					q -= quire_mul(x[i], y[i]);
+					s -= quire_mul(x[i], y[i]);
+				}
+				else {
+					q.fma(x[i], y[i]);
+					s.fma(x[i], y[i]);
+				}
+				value<quire<nbits, es, capacity>::qbits> v = q.to_value(), sv = s.to_value();
+				if (v.iszero() != sv.iszero() || v.sign() != sv.sign() || v.scale() != sv.scale() || v.fraction() != sv.fraction() || q.scale() != s.scale()) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "accumulation " << i << " quire " << v << " sparse quire " << sv << std::endl;
+				}
+				if (i % 7 == 0) {
+					s2 = s;
+					s2 += s;
+					s2 -= s;
+					if (s2 != s) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cout << tag << "quire addition " << s2 << " != " << s << std::endl;
+					}
+				}
+			}
+			for (size_t i = nrOfRandoms; i-- > 0; ) {
+				if (i % 4 == 3) s += quire_mul(x[i], y[i]); else s -= quire_mul(x[i], y[i]);
+			}
+			if (!s.iszero() || s.sign() || s.active_limbs() != 0) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "cancellation " << s << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "sparse quire failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire<64, 3>(tag, true, 100, false), "sparse_quire<64,3>", "accumulation");
+
+#else
+
+	cout << "Sparse quire validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire<  8, 0>(tag, bReportIndividualTestCases, 1000, false), "sparse_quire<  8,0>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire< 16, 1>(tag, bReportIndividualTestCases, 1000, false), "sparse_quire< 16,1>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire< 32, 2>(tag, bReportIndividualTestCases, 1000, false), "sparse_quire< 32,2>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire< 32, 2>(tag, bReportIndividualTestCases, 1000, true),  "sparse_quire< 32,2>", "accumulation in [-4,4]");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire< 64, 3>(tag, bReportIndividualTestCases, 500, false),  "sparse_quire< 64,3>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire< 64, 3>(tag, bReportIndividualTestCases, 500, true),   "sparse_quire< 64,3>", "accumulation in [-4,4]");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire<128, 4>(tag, bReportIndividualTestCases, 200, false),  "sparse_quire<128,4>", "accumulation");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire<256, 5>(tag, bReportIndividualTestCases, 200, false),  "sparse_quire<256,5>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateSparseQuire<256, 5>(tag, bReportIndividualTestCases, 200, true),   "sparse_quire<256,5>", "accumulation in [-4,4]");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+// quire_wire.cpp: validation of the binary wire format of the quire and of the exact reduction of serialized quires
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <random>
+#include <thread>
+// type definitions for the important types, posit<> and quire<>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/quire.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// a quire must survive the trip through its wire format, and the wire format must only carry the active limbs
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateWireRoundTrip(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			using Quire = quire<nbits, es, capacity>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es));
+			std::vector<uint8_t> buffer(quire_wire_header_size + 8 * Quire::qlimbs);
+			Quire zero;
+			if (zero.wire_size() != quire_wire_header_size || zero.serialize_into(buffer) != quire_wire_header_size) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "zero quire takes " << zero.wire_size() << " bytes" << std::endl;
+			}
+			Quire q;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				q.fma(RandomPosit<nbits, es>(generator), RandomPosit<nbits, es>(generator));
+				size_t bytes = q.serialize_into(buffer);
+				Quire copy;
+				if (bytes != q.wire_size() || copy.merge_from(span<const uint8_t>(buffer.data(), bytes)) != bytes || !(copy == q)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "round trip " << copy << " != " << q << std::endl;
+				}
+				// merging a quire into itself doubles it, merging its negation cancels it
+				copy.merge_from(buffer);
+				Quire twice(q);
+				twice += q;
+				copy -= twice;
+				copy += q;
+				if (!(copy == q)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "merge " << copy << " != " << q << std::endl;
+				}
+				Quire negated(q);
+				negated.set_sign(!q.sign());
+				negated.merge_from(buffer);
+				if (!negated.iszero() || negated.sign()) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << "cancellation " << negated << std::endl;
+				}
+			}
+			// a mismatched configuration, a truncated buffer, and a short output buffer must be rejected
+			size_t bytes = q.serialize_into(buffer);
+			quire<nbits, es, capacity + 64> other;
+			int nrOfRejections = 0;
+			try { other.merge_from(buffer); } catch (const quire_wire_format_error&) { ++nrOfRejections; }
+			try { q.merge_from(span<const uint8_t>(buffer.data(), bytes - 1)); } catch (const quire_wire_format_error&) { ++nrOfRejections; }
+			try { q.serialize_into(span<uint8_t>(buffer.data(), bytes - 1)); } catch (const quire_wire_format_error&) { ++nrOfRejections; }
+			if (nrOfRejections != 3) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << "malformed buffers rejected: " << nrOfRejections << " of 3" << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// workers compute partial dot products and publish their quires in slots of a shared byte region,
+		// the stand-in for the shared memory segment of cooperating processes, and the reduction must be exact
+		template<size_t nbits, size_t es, size_t capacity = 10>
+		int ValidateWireReduction(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfWorkers, size_t nrOfElements) {
+			using Quire = quire<nbits, es, capacity>;
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(uint64_t(nbits * 64 + es + nrOfWorkers));
+			std::vector< posit<nbits, es> > x(nrOfElements), y(nrOfElements);
+			for (size_t i = 0; i < nrOfElements; ++i) {
+				x[i] = RandomPosit<nbits, es>(generator);
+				y[i] = RandomPosit<nbits, es>(generator);
+			}
+			Quire reference;
+			reference.accumulate(x.data(), y.data(), nrOfElements);
+
+			constexpr size_t slot = quire_wire_header_size + 8 * Quire::qlimbs;
+			std::vector<uint8_t> shared(nrOfWorkers * slot);
+			std::vector<size_t> published(nrOfWorkers);
+			std::vector<std::thread> workers;
+			size_t chunk = (nrOfElements + nrOfWorkers - 1) / nrOfWorkers;
+			for (size_t w = 0; w < nrOfWorkers; ++w) {
+				workers.emplace_back([&, w]() {
+					size_t begin = std::min(w * chunk, nrOfElements);
+					Quire partial;
+					partial.accumulate(x.data() + begin, y.data() + begin, std::min(chunk, nrOfElements - begin));
+					published[w] = partial.serialize_into(span<uint8_t>(shared.data() + w * slot, slot));
+				});
+			}
+			for (std::thread& worker : workers) worker.join();
+
+			std::vector< span<const uint8_t> > parts;
+			for (size_t w = 0; w < nrOfWorkers; ++w) parts.push_back(span<const uint8_t>(shared.data() + w * slot, published[w]));
+			Quire reduced = quire_tree_reduce<Quire>(parts);
+			if (!(reduced == reference)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << nrOfWorkers << " workers " << reduced << " != " << reference << std::endl;
+			}
+			// the partial quires concatenated into one stream merge back into the same sum
+			std::vector<uint8_t> stream;
+			for (const span<const uint8_t>& part : parts) stream.insert(stream.end(), part.begin(), part.end());
+			Quire merged;
+			span<const uint8_t> remaining(stream);
+			while (!remaining.empty()) remaining = remaining.subspan(merged.merge_from(remaining));
+			if (!(merged == reference)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << nrOfWorkers << " workers stream " << merged << " != " << reference << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "quire wire format failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip<32, 2>(tag, true, 100), "quire<32,2>", "wire round trip");
+
+#else
+
+	cout << "Quire wire format validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip<  8, 0>(tag, bReportIndividualTestCases, 200), "quire<  8,0>", "wire round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip< 16, 1>(tag, bReportIndividualTestCases, 200), "quire< 16,1>", "wire round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip< 32, 2>(tag, bReportIndividualTestCases, 200), "quire< 32,2>", "wire round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip< 64, 3>(tag, bReportIndividualTestCases, 100), "quire< 64,3>", "wire round trip");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireRoundTrip<128, 4>(tag, bReportIndividualTestCases, 50),  "quire<128,4>", "wire round trip");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateWireReduction< 16, 1>(tag, bReportIndividualTestCases, 5, 5000),  "quire< 16,1>", "tree reduction");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireReduction< 32, 2>(tag, bReportIndividualTestCases, 1, 1000),  "quire< 32,2>", "tree reduction");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireReduction< 32, 2>(tag, bReportIndividualTestCases, 8, 10000), "quire< 32,2>", "tree reduction");
+	nrOfFailedTestCases += ReportTestResult(ValidateWireReduction< 64, 3>(tag, bReportIndividualTestCases, 7, 5000),  "quire< 64,3>", "tree reduction");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateWireReduction<128, 4>(tag, bReportIndividualTestCases, 16, 50000), "quire<128,4>", "tree reduction");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
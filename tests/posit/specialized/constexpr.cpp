@@ -0,0 +1,154 @@
+// constexpr.cpp: compile-time construction, comparison, and arithmetic of the fast specialized posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specialized posits that offer constexpr arithmetic
+#define POSIT_FAST_POSIT_8_0 1
+#define POSIT_FAST_POSIT_8_1 1
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// construction from integer literals, and the IEEE conversions of the engine, evaluated by the compiler
+		static_assert(posit<8, 0>(1).isone(), "posit<8,0>(1) is not constexpr");
+		static_assert(posit<8, 0>(-1).isminusone(), "posit<8,0>(-1) is not constexpr");
+		static_assert(posit<16, 1>().set_raw_bits(native_engine<16, 1>::from_ieee_constexpr(0.375)) == posit<16, 1>(3) / posit<16, 1>(8), "from_ieee_constexpr is not constexpr");
+		static_assert(native_engine<16, 1>::to_ieee_constexpr<double>(native_engine<16, 1>::from_integer(-6)) == -6.0, "to_ieee_constexpr is not constexpr");
+
+#if POSIT_HAVE_CONSTANT_EVALUATED
+		// construction from IEEE literals, and the four operators, evaluated by the compiler
+		static_assert(posit<8, 1>(0.5f) + posit<8, 1>(0.25f) == posit<8, 1>(0.75f), "posit<8,1> addition is not constexpr");
+		static_assert(posit<16, 1>(1.5) * posit<16, 1>(2) == posit<16, 1>(3), "posit<16,1> multiplication is not constexpr");
+		static_assert(posit<16, 1>(1) / posit<16, 1>(4) == posit<16, 1>(0.25), "posit<16,1> division is not constexpr");
+		static_assert(posit<32, 2>(10) - posit<32, 2>(0.125) == posit<32, 2>(9.875), "posit<32,2> subtraction is not constexpr");
+		static_assert(posit<32, 2>(-2) < posit<32, 2>(1.0e-3), "posit<32,2> comparison is not constexpr");
+		static_assert(double(posit<16, 1>(0.375)) == 0.375, "posit<16,1> conversion to double is not constexpr");
+		static_assert(posit<32, 2>().set_raw_bits(0x40000000).isone(), "posit<32,2> set_raw_bits is not constexpr");
+
+		// constants rounded at compile time
+		static_assert(pi_v<posit<32, 2>>() > posit<32, 2>(3.14159) && pi_v<posit<32, 2>>() < posit<32, 2>(3.1416), "pi is not constexpr");
+		static_assert(e_v<posit<16, 1>>() > posit<16, 1>(2.71) && e_v<posit<16, 1>>() < posit<16, 1>(2.72), "e is not constexpr");
+		static_assert(ln2_v<posit<8, 0>>() == posit<8, 0>(0.6875f), "ln2 is not constexpr");
+#endif
+
+		// a table of polynomial values generated by the compiler
+		template<typename Posit, size_t N>
+		struct polynomial_table {
+			Posit v[N];
+		};
+
+		template<typename Posit, size_t N>
+		constexpr polynomial_table<Posit, N> GeneratePolynomialTable() {
+			polynomial_table<Posit, N> table{};
+			for (size_t i = 0; i < N; ++i) {
+				// x^2 / 8 - 3x + 0.5 by Horner's scheme
+				Posit x = Posit(int(i) - int(N / 2));
+				table.v[i] = (x / Posit(8) - Posit(3)) * x + Posit(1) / Posit(2);
+			}
+			return table;
+		}
+
+		// the table evaluated by the compiler must match the same evaluation at run time
+		template<typename Posit, size_t N>
+		int ValidateCompileTimeTable(const std::string& tag, bool bReportIndividualTestCases) {
+			constexpr polynomial_table<Posit, N> table = GeneratePolynomialTable<Posit, N>();
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < N; ++i) {
+				Posit x = Posit(int(i) - int(N / 2));
+				Posit ref = (x / Posit(8) - Posit(3)) * x + Posit(1) / Posit(2);
+				if (table.v[i] != ref) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << " x = " << x << " compile time " << table.v[i] << " run time " << ref << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+#if POSIT_HAVE_CONSTANT_EVALUATED
+		// the compile-time constants must round like the run-time conversion
+		template<typename Posit>
+		int ValidateConstants(const std::string& tag, bool bReportIndividualTestCases) {
+			constexpr Posit pi = pi_v<Posit>(), e = e_v<Posit>(), ln2 = ln2_v<Posit>();
+			volatile double dpi = m_pi, de = m_e, dln2 = m_ln2;
+			int nrOfFailedTests = 0;
+			if (pi != Posit(double(dpi))) ++nrOfFailedTests;
+			if (e != Posit(double(de))) ++nrOfFailedTests;
+			if (ln2 != Posit(double(dln2))) ++nrOfFailedTests;
+			if (nrOfFailedTests && bReportIndividualTestCases) std::cout << tag << " constants " << pi << " " << e << " " << ln2 << std::endl;
+			return nrOfFailedTests;
+		}
+#endif
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "constexpr evaluation failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateCompileTimeTable<posit<16, 1>, 32>(tag, true), "posit<16,1>", "compile-time table");
+
+#else
+
+	cout << "Fast specialized posit constexpr validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateCompileTimeTable<posit<8, 0>, 64>(tag, bReportIndividualTestCases), "posit<8,0>", "compile-time table");
+	nrOfFailedTestCases += ReportTestResult(ValidateCompileTimeTable<posit<8, 1>, 64>(tag, bReportIndividualTestCases), "posit<8,1>", "compile-time table");
+	nrOfFailedTestCases += ReportTestResult(ValidateCompileTimeTable<posit<16, 1>, 64>(tag, bReportIndividualTestCases), "posit<16,1>", "compile-time table");
+	nrOfFailedTestCases += ReportTestResult(ValidateCompileTimeTable<posit<32, 2>, 64>(tag, bReportIndividualTestCases), "posit<32,2>", "compile-time table");
+
+#if POSIT_HAVE_CONSTANT_EVALUATED
+	nrOfFailedTestCases += ReportTestResult(ValidateConstants<posit<8, 0>>(tag, bReportIndividualTestCases), "posit<8,0>", "constants");
+	nrOfFailedTestCases += ReportTestResult(ValidateConstants<posit<8, 1>>(tag, bReportIndividualTestCases), "posit<8,1>", "constants");
+	nrOfFailedTestCases += ReportTestResult(ValidateConstants<posit<16, 1>>(tag, bReportIndividualTestCases), "posit<16,1>", "constants");
+	nrOfFailedTestCases += ReportTestResult(ValidateConstants<posit<32, 2>>(tag, bReportIndividualTestCases), "posit<32,2>", "constants");
+#endif
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
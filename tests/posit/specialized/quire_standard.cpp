@@ -0,0 +1,265 @@
+// quire_standard.cpp: Functionality tests for the specialized standard quires of posit<8,0>, posit<16,1>, and posit<32,2>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posits and their quires
+//#define POSIT_FAST_SPECIALIZATION
+#define POSIT_FAST_POSIT_8_0 1
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <random>
+#include <sstream>
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../../utils/test_helpers.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// a single fused multiply-accumulate must hold the exact product: rounding it must yield the posit product,
+		// and the integer product path of fma must match the normalized value path of quire_mul
+		template<size_t nbits, size_t es>
+		int VerifyQuireProduct(const std::string& tag, const posit<nbits, es>& a, const posit<nbits, es>& b, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			quire<nbits, es> q, qref;
+			q.fma(a, b);
+			qref += quire_mul(a, b);
+			posit<nbits, es> result, reference = a * b;
+			convert(q.to_value(), result);
+			if (!(q == qref) || result != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " fma(" << a << ", " << b << ") = " << q << " reference " << qref << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// exhaustive products of all posit pairs
+		template<size_t nbits, size_t es>
+		int ValidateQuireProducts(const std::string& tag, bool bReportIndividualTestCases) {
+			constexpr size_t NR_POSITS = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> a, b;
+			for (size_t i = 0; i < NR_POSITS; ++i) {
+				a.set_raw_bits(i);
+				if (a.isnar()) continue;
+				for (size_t j = 0; j < NR_POSITS; ++j) {
+					b.set_raw_bits(j);
+					if (b.isnar()) continue;
+					nrOfFailedTests += VerifyQuireProduct(tag, a, b, bReportIndividualTestCases);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// random products, and a dot product that must cancel to zero when the products are subtracted again
+		template<size_t nbits, size_t es>
+		int ValidateQuireProductsThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(nbits);
+			std::vector< posit<nbits, es> > x(nrOfRandoms), y(nrOfRandoms);
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				do { x[i].set_raw_bits(generator()); } while (x[i].isnar());
+				do { y[i].set_raw_bits(generator()); } while (y[i].isnar());
+				nrOfFailedTests += VerifyQuireProduct(tag, x[i], y[i], bReportIndividualTestCases);
+			}
+			quire<nbits, es> q, qref;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				q.fma(x[i], y[i]);
+				qref += quire_mul(x[i], y[i]);
+			}
+			quire<nbits, es> batch;
+			batch.accumulate(x.data(), y.data(), nrOfRandoms);
+			posit<nbits, es> rounded;
+			convert(qref.to_value(), rounded);
+			if (!(q == qref) || !(batch == qref) || fdp(x, y) != rounded) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " dot product " << q << " reference " << qref << std::endl;
+			}
+			for (size_t i = nrOfRandoms; i-- > 0; ) q -= quire_mul(x[i], y[i]);
+			if (!q.iszero() || q.sign()) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " cancellation " << q << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// the two's complement encoding must order, negate, and assign like the sign-magnitude value
+		template<size_t nbits, size_t es>
+		int ValidateQuireTwosComplement(const std::string& tag, bool bReportIndividualTestCases) {
+			int nrOfFailedTests = 0;
+			quire<nbits, es> one(int64_t(1)), minus_one(int64_t(-1)), zero;
+			quire<nbits, es> minpos_sq, q;
+			minpos_sq.fma(minpos<nbits, es>(), minpos<nbits, es>());
+			q = minus_one;
+			q += minpos_sq;
+			if (!(minus_one < q) || !(q < zero) || !(zero < one) || !(minus_one < one) || !q.sign() || q.scale() != -1) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " ordering " << minus_one << " " << q << " " << one << std::endl;
+			}
+			q -= minpos_sq;
+			q += one;
+			if (!q.iszero()) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " negation " << q << std::endl;
+			}
+			q = posit<nbits, es>(-0.75);
+			posit<nbits, es> p;
+			convert(q.to_value(), p);
+			if (p != posit<nbits, es>(-0.75) || minpos_sq.scale() != -int(quire<nbits, es>::half_range)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " assignment " << q << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+		// the two's complement accumulator must travel through the sign and magnitude wire format
+		template<size_t nbits, size_t es>
+		int ValidateQuireWire(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			int nrOfFailedTests = 0;
+			std::mt19937_64 generator(nbits + 1);
+			std::vector<uint8_t> buffer(quire_wire_header_size + 8 * quire<nbits, es>::qlimbs);
+			quire<nbits, es> q;
+			posit<nbits, es> a, b;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				do { a.set_raw_bits(generator()); } while (a.isnar());
+				do { b.set_raw_bits(generator()); } while (b.isnar());
+				q.fma(a, b);
+				size_t bytes = q.serialize_into(buffer);
+				quire<nbits, es> copy, negated;
+				copy.merge_from(span<const uint8_t>(buffer.data(), bytes));
+				negated -= q;
+				negated.merge_from(buffer);
+				if (bytes != q.wire_size() || !(copy == q) || !negated.iszero()) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << " wire format " << copy << " != " << q << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the standard quires share the interface of the generic quire: text format, bit access, sign, and comparisons with values
+		template<size_t nbits, size_t es>
+		int ValidateQuireInterface(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			using Quire = quire<nbits, es>;
+			int nrOfFailedTests = 0;
+			if (Quire().capacity_range() != int(quire_max_capacity<nbits, es>::value)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " default capacity " << quire_max_capacity<nbits, es>::value << std::endl;
+			}
+			Quire five(uint64_t(5)), r;
+			if (!(five == value<8>(5.0)) || !five[int(Quire::radix_point)] || five[int(Quire::radix_point) + 1] || five.anyAfter(int(Quire::radix_point) - 1)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " integer assignment " << five << std::endl;
+			}
+			if (r.load_bits("+:0101") || r.load_bits("5") || !r.iszero()) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " malformed text accepted " << r << std::endl;
+			}
+			std::mt19937_64 generator(nbits + 2);
+			Quire minpos_sq;
+			minpos_sq.fma(minpos<nbits, es>(), minpos<nbits, es>());
+			posit<nbits, es> a, b;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				do { a.set_raw_bits(generator()); } while (a.isnar() || a.iszero());
+				do { b.set_raw_bits(generator()); } while (b.isnar() || b.iszero());
+				Quire q, negated, larger;
+				q.fma(a, b);
+				if (i & 0x1) q += Quire(int64_t(i));
+				// the text format reads back into the same quire
+				std::stringstream ss;
+				ss << q;
+				ss >> r;
+				negated = q;
+				negated.set_sign(!q.sign());
+				negated += q;
+				if (!ss || !(r == q) || !negated.iszero()) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << " text format " << r << " != " << q << std::endl;
+				}
+				// comparisons of values on both sides of the quire, of either sign
+				larger = q;
+				larger += minpos_sq;
+				value<Quire::qbits> v = q.to_value(), w = larger.to_value();
+				if (!(q == v) || q < v || q > v || !(q < w) || q > w || !(larger > v) || q.CompareMagnitude(-v) != 0 || q.CompareMagnitude(w) != (q.sign() ? 1 : -1)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << " comparison " << q << " " << larger << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+	}
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Fast specialization standard quire tests" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProductsThroughRandoms<32, 2>(" quire<32,2>", true, 100), "quire<32,2>", "fma");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireTwosComplement< 8, 0>(" quire< 8,0>", bReportIndividualTestCases), "quire< 8,0>", "two's complement");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireTwosComplement<16, 1>(" quire<16,1>", bReportIndividualTestCases), "quire<16,1>", "two's complement");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireTwosComplement<32, 2>(" quire<32,2>", bReportIndividualTestCases), "quire<32,2>", "two's complement");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts< 8, 0>(" quire< 8,0>", bReportIndividualTestCases), "quire< 8,0>", "fma (exhaustive)");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProductsThroughRandoms< 8, 0>(" quire< 8,0>", bReportIndividualTestCases, 1000), "quire< 8,0>", "fma");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProductsThroughRandoms<16, 1>(" quire<16,1>", bReportIndividualTestCases, 10000), "quire<16,1>", "fma");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProductsThroughRandoms<32, 2>(" quire<32,2>", bReportIndividualTestCases, 10000), "quire<32,2>", "fma");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireWire< 8, 0>(" quire< 8,0>", bReportIndividualTestCases, 1000), "quire< 8,0>", "wire format");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireWire<16, 1>(" quire<16,1>", bReportIndividualTestCases, 1000), "quire<16,1>", "wire format");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireWire<32, 2>(" quire<32,2>", bReportIndividualTestCases, 1000), "quire<32,2>", "wire format");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireInterface< 8, 0>(" quire< 8,0>", bReportIndividualTestCases, 1000), "quire< 8,0>", "interface");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireInterface<16, 1>(" quire<16,1>", bReportIndividualTestCases, 1000), "quire<16,1>", "interface");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireInterface<32, 2>(" quire<32,2>", bReportIndividualTestCases, 1000), "quire<32,2>", "interface");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireProducts<16, 1>(" quire<16,1>", bReportIndividualTestCases), "quire<16,1>", "fma (exhaustive)");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
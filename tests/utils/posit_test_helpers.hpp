@@ -802,6 +802,26 @@ namespace sw {
 			return nrOfFailedTests;
 		}
 
+		// division through the bitblock arithmetic module: the reference for the division engines of posit::operator/=
+		template<size_t nbits, size_t es>
+		posit<nbits, es> ReferenceDivision(const posit<nbits, es>& pa, const posit<nbits, es>& pb) {
+			constexpr size_t fbits = posit<nbits, es>::fbits;
+			constexpr size_t divbits = posit<nbits, es>::divbits;
+			posit<nbits, es> pref;
+			if (pa.isnar() || pb.isnar() || pb.iszero()) {
+				pref.setnar();
+				return pref;
+			}
+			if (pa.iszero()) return pref;
+			value<fbits> a, b;
+			value<divbits> ratio;
+			pa.normalize(a);
+			pb.normalize(b);
+			module_divide(a, b, ratio);
+			convert<nbits, es, divbits>(ratio, pref);
+			return pref;
+		}
+
 		// enumerate all division cases for a posit configuration: is within 10sec till about nbits = 14
 		template<size_t nbits, size_t es>
 		int ValidateDivision(std::string tag, bool bReportIndividualTestCases) {
@@ -1113,6 +1133,30 @@ namespace sw {
 			return nrOfFailedTestCases;
 		}
 
+		// generate a random posit that is not NaR, drawn from all the encodings, or from [-range, range] when range
+		// is positive: nonzero also rejects zero
+		template<size_t nbits, size_t es>
+		posit<nbits, es> RandomPosit(std::mt19937_64& generator, bool nonzero = false, double range = 0.0) {
+			posit<nbits, es> p;
+			if (range > 0.0) {
+				std::uniform_real_distribution<double> distribution(-range, range);
+				do {
+					p = distribution(generator);
+				} while (nonzero && p.iszero());
+				return p;
+			}
+			bitblock<nbits> raw;
+			do {
+				uint64_t word = 0;
+				for (size_t i = 0; i < nbits; ++i) {
+					if ((i & 63) == 0) word = generator();
+					raw[i] = (word >> (i & 63)) & 0x1;
+				}
+				p.set(raw);
+			} while (p.isnar() || (nonzero && p.iszero()));
+			return p;
+		}
+
 	} // namespace unum
 
 } // namespace sw